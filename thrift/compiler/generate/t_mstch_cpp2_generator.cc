@@ -217,12 +217,49 @@ class cpp2_generator_context {
     return cpp2::is_orderable(seen, memo, type);
   }
 
+  bool is_union_member(t_field const* field) const {
+    return union_members_.count(field) != 0;
+  }
+
  private:
-  explicit cpp2_generator_context(t_program const*) {}
+  explicit cpp2_generator_context(t_program const* program) {
+    for (auto const* strct : program->get_structs()) {
+      if (strct->is_union()) {
+        for (auto const* field : strct->get_members()) {
+          union_members_.insert(field);
+        }
+      }
+    }
+  }
 
   std::unordered_map<t_type const*, bool> is_orderable_memo_;
+  std::unordered_set<t_field const*> union_members_;
 };
 
+// With the `lazy_fields` option, fields annotated with cpp.experimental.lazy
+// keep their serialized bytes until first access (see
+// thrift/lib/cpp2/protocol/LazyField.h). Only plain, non-required container
+// and struct fields qualify, and not with options that serialize or lay out
+// fields without going through the generated accessors. Union members are
+// never lazy: the active member is read eagerly to know which one it is.
+bool is_lazy_field(
+    const t_field* f,
+    const mstch_base& context,
+    const cpp2_generator_context& cpp2_context) {
+  if (!context.has_option("lazy_fields") || context.has_option("tablebased") ||
+      context.has_option("frozen2") ||
+      !f->annotations_.count("cpp.experimental.lazy") ||
+      cpp2_context.is_union_member(f)) {
+    return false;
+  }
+  auto t = f->get_type()->get_true_type();
+  bool is_struct = t->is_struct() || t->is_xception();
+  bool terse = context.has_option("terse_writes") &&
+      f->get_req() != t_field::e_req::T_OPTIONAL && !is_struct;
+  return f->get_req() != t_field::e_req::T_REQUIRED && !cpp2::is_cpp_ref(f) &&
+      (t->is_container() || is_struct) && !terse;
+}
+
 class t_mstch_cpp2_generator : public t_mstch_generator {
  public:
   t_mstch_cpp2_generator(
@@ -594,8 +631,10 @@ class mstch_cpp2_field : public mstch_field {
       std::shared_ptr<mstch_generators const> generators,
       std::shared_ptr<mstch_cache> cache,
       ELEMENT_POSITION const pos,
-      int32_t index)
-      : mstch_field(field, generators, cache, pos, index) {
+      int32_t index,
+      std::shared_ptr<cpp2_generator_context> context)
+      : mstch_field(field, generators, cache, pos, index),
+        context_(std::move(context)) {
     register_methods(
         this,
         {
@@ -616,6 +655,7 @@ class mstch_cpp2_field : public mstch_field {
             {"field:cpp_noncopyable?", &mstch_cpp2_field::cpp_noncopyable},
             {"field:enum_has_value", &mstch_cpp2_field::enum_has_value},
             {"field:terse_writes?", &mstch_cpp2_field::terse_writes},
+            {"field:lazy?", &mstch_cpp2_field::lazy},
             {"field:fatal_annotations?",
              &mstch_cpp2_field::has_fatal_annotations},
             {"field:fatal_annotations", &mstch_cpp2_field::fatal_annotations},
@@ -696,6 +736,9 @@ class mstch_cpp2_field : public mstch_field {
         (is_cpp_ref_unique_either(field_) ||
          (!t->is_struct() && !t->is_xception()));
   }
+  mstch::node lazy() {
+    return is_lazy_field(field_, *this, *context_);
+  }
   mstch::node has_fatal_annotations() {
     return get_fatal_annotations(field_->annotations_).size() > 0;
   }
@@ -734,6 +777,8 @@ class mstch_cpp2_field : public mstch_field {
     auto suffix = key >= 0 ? std::to_string(key) : "_" + std::to_string(-key);
     return field_->get_name() + "_" + suffix;
   }
+
+  std::shared_ptr<cpp2_generator_context> context_;
 };
 
 class mstch_cpp2_struct : public mstch_struct {
@@ -755,10 +800,13 @@ class mstch_cpp2_struct : public mstch_struct {
              &mstch_cpp2_struct::fields_in_key_order},
             {"struct:fields_in_layout_order",
              &mstch_cpp2_struct::fields_in_layout_order},
+            {"struct:frozen_fields_in_layout_order",
+             &mstch_cpp2_struct::frozen_fields_in_layout_order},
             {"struct:is_struct_orderable?",
              &mstch_cpp2_struct::is_struct_orderable},
             {"struct:fields_contain_cpp_ref_unique_either?",
              &mstch_cpp2_struct::has_cpp_ref_unique_either},
+            {"struct:out_of_line_copy?", &mstch_cpp2_struct::out_of_line_copy},
             {"struct:cpp_methods", &mstch_cpp2_struct::cpp_methods},
             {"struct:cpp_declare_hash", &mstch_cpp2_struct::cpp_declare_hash},
             {"struct:cpp_declare_equal_to",
@@ -850,6 +898,16 @@ class mstch_cpp2_struct : public mstch_struct {
     }
     return false;
   }
+  mstch::node out_of_line_copy() {
+    // Lazy fields have to be copied together with their deserialization
+    // state.
+    for (auto const* f : strct_->get_members()) {
+      if (is_cpp_ref_unique_either(f) || is_lazy_field(f, *this, *context_)) {
+        return true;
+      }
+    }
+    return false;
+  }
   mstch::node cpp_methods() {
     if (strct_->annotations_.count("cpp.methods")) {
       return strct_->annotations_.at("cpp.methods");
@@ -1076,6 +1134,16 @@ class mstch_cpp2_struct : public mstch_struct {
     return generate_fields(get_members_in_layout_order());
   }
 
+  // Returns the struct members with the ones annotated cpp.frozen_hot first,
+  // so Frozen2 places them, and the data they point to, next to each other.
+  mstch::node frozen_fields_in_layout_order() {
+    std::vector<t_field*> fields(strct_->get_members());
+    std::stable_partition(fields.begin(), fields.end(), [](t_field* field) {
+      return field->annotations_.count("cpp.frozen_hot") != 0;
+    });
+    return generate_fields(fields);
+  }
+
   // Returns the struct members ordered by the key.
   const std::vector<t_field*>& get_members_in_key_order() {
     auto const& members = strct_->get_members();
@@ -1313,6 +1381,7 @@ class mstch_cpp2_program : public mstch_program {
         });
     register_has_option("program:tablebased?", "tablebased");
     register_has_option("program:no_metadata?", "no_metadata");
+    register_has_option("program:lazy_fields?", "lazy_fields");
     register_has_option(
         "program:enforce_required?", "deprecated_enforce_required");
   }
@@ -1690,7 +1759,9 @@ class type_cpp2_generator : public type_generator {
 
 class field_cpp2_generator : public field_generator {
  public:
-  field_cpp2_generator() = default;
+  explicit field_cpp2_generator(
+      std::shared_ptr<cpp2_generator_context> context)
+      : context_(std::move(context)) {}
   ~field_cpp2_generator() override = default;
   std::shared_ptr<mstch_base> generate(
       t_field const* field,
@@ -1699,8 +1770,11 @@ class field_cpp2_generator : public field_generator {
       ELEMENT_POSITION pos = ELEMENT_POSITION::NONE,
       int32_t index = 0) const override {
     return std::make_shared<mstch_cpp2_field>(
-        field, generators, cache, pos, index);
+        field, generators, cache, pos, index, context_);
   }
+
+ private:
+  std::shared_ptr<cpp2_generator_context> context_;
 };
 
 class function_cpp2_generator : public function_generator {
@@ -1879,7 +1953,8 @@ void t_mstch_cpp2_generator::set_mstch_generators() {
   generators_->set_enum_value_generator(
       std::make_unique<enum_value_cpp2_generator>());
   generators_->set_type_generator(std::make_unique<type_cpp2_generator>());
-  generators_->set_field_generator(std::make_unique<field_cpp2_generator>());
+  generators_->set_field_generator(
+      std::make_unique<field_cpp2_generator>(context_));
   generators_->set_function_generator(
       std::make_unique<function_cpp2_generator>());
   generators_->set_struct_generator(
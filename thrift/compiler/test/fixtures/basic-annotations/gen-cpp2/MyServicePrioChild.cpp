@@ -66,6 +66,8 @@ const MyServicePrioChildAsyncProcessor::ProcessMap& MyServicePrioChildAsyncProce
 
 const MyServicePrioChildAsyncProcessor::ProcessMap MyServicePrioChildAsyncProcessor::binaryProcessMap_ {
   {"pang", &MyServicePrioChildAsyncProcessor::setUpAndProcess_pang<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
+  {"ping", &MyServicePrioChildAsyncProcessor::setUpAndProcess_ping<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
+  {"pong", &MyServicePrioChildAsyncProcessor::setUpAndProcess_pong<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
 };
 
 const MyServicePrioChildAsyncProcessor::ProcessMap& MyServicePrioChildAsyncProcessor::getCompactProtocolProcessMap() {
@@ -74,6 +76,8 @@ const MyServicePrioChildAsyncProcessor::ProcessMap& MyServicePrioChildAsyncProce
 
 const MyServicePrioChildAsyncProcessor::ProcessMap MyServicePrioChildAsyncProcessor::compactProcessMap_ {
   {"pang", &MyServicePrioChildAsyncProcessor::setUpAndProcess_pang<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
+  {"ping", &MyServicePrioChildAsyncProcessor::setUpAndProcess_ping<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
+  {"pong", &MyServicePrioChildAsyncProcessor::setUpAndProcess_pong<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
 };
 
 } // cpp2
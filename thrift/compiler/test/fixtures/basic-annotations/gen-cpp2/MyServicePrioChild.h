@@ -71,7 +71,9 @@ class MyServicePrioChildAsyncProcessor : public ::cpp2::MyServicePrioParentAsync
  private:
   static const MyServicePrioChildAsyncProcessor::ProcessMap binaryProcessMap_;
   static const MyServicePrioChildAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_pang(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
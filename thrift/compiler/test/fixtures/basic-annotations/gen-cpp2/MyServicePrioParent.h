@@ -78,7 +78,9 @@ class MyServicePrioParentAsyncProcessor : public ::apache::thrift::GeneratedAsyn
  private:
   static const MyServicePrioParentAsyncProcessor::ProcessMap binaryProcessMap_;
   static const MyServicePrioParentAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_ping(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
@@ -94,7 +94,9 @@ class MyServiceAsyncProcessor : public ::apache::thrift::GeneratedAsyncProcessor
  private:
   static const MyServiceAsyncProcessor::ProcessMap binaryProcessMap_;
   static const MyServiceAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_hasDataById(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
@@ -70,7 +70,9 @@ class MyServiceFastAsyncProcessor : public ::apache::thrift::GeneratedAsyncProce
  private:
   static const MyServiceFastAsyncProcessor::ProcessMap binaryProcessMap_;
   static const MyServiceFastAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_hasDataById(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
@@ -78,7 +78,9 @@ class DbMixedStackArgumentsAsyncProcessor : public ::apache::thrift::GeneratedAs
  private:
   static const DbMixedStackArgumentsAsyncProcessor::ProcessMap binaryProcessMap_;
   static const DbMixedStackArgumentsAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_getDataByKey0(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
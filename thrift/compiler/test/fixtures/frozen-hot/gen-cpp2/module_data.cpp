@@ -0,0 +1,38 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_data.h"
+
+#include <thrift/lib/cpp2/gen/module_data_cpp.h>
+
+namespace apache {
+namespace thrift {
+
+
+
+const std::size_t TStructDataStorage<::some::ns::Entry>::fields_size;
+const std::array<folly::StringPiece, TStructDataStorage<::some::ns::Entry>::fields_size> TStructDataStorage<::some::ns::Entry>::fields_names = {{
+  "name",
+  "history",
+  "id",
+  "index",
+}};
+const std::array<int16_t, TStructDataStorage<::some::ns::Entry>::fields_size> TStructDataStorage<::some::ns::Entry>::fields_ids = {{
+  1,
+  2,
+  3,
+  4,
+}};
+const std::array<apache::thrift::protocol::TType, TStructDataStorage<::some::ns::Entry>::fields_size> TStructDataStorage<::some::ns::Entry>::fields_types = {{
+  TType::T_STRING,
+  TType::T_LIST,
+  TType::T_I64,
+  TType::T_MAP,
+}};
+
+} // namespace thrift
+} // namespace apache
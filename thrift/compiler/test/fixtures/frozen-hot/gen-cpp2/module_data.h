@@ -0,0 +1,22 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_data_h.h>
+
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_types.h"
+
+namespace apache { namespace thrift {
+
+template <> struct TStructDataStorage<::some::ns::Entry> {
+  static constexpr const std::size_t fields_size = 4;
+  static const std::array<folly::StringPiece, fields_size> fields_names;
+  static const std::array<int16_t, fields_size> fields_ids;
+  static const std::array<apache::thrift::protocol::TType, fields_size> fields_types;
+};
+
+}} // apache::thrift
@@ -0,0 +1,50 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_layouts.h"
+
+namespace apache { namespace thrift { namespace frozen {
+
+
+FROZEN_CTOR(::some::ns::Entry,
+  FROZEN_CTOR_FIELD(name, 1)
+  FROZEN_CTOR_FIELD(history, 2)
+  FROZEN_CTOR_FIELD(id, 3)
+  FROZEN_CTOR_FIELD(index, 4))
+FROZEN_MAXIMIZE(::some::ns::Entry,
+  FROZEN_MAXIMIZE_FIELD(id)
+  FROZEN_MAXIMIZE_FIELD(index)
+  FROZEN_MAXIMIZE_FIELD(name)
+  FROZEN_MAXIMIZE_FIELD(history))
+FROZEN_LAYOUT(::some::ns::Entry,
+  FROZEN_LAYOUT_FIELD(id)
+  FROZEN_LAYOUT_FIELD(index)
+  FROZEN_LAYOUT_FIELD(name)
+  FROZEN_LAYOUT_FIELD(history))
+FROZEN_FREEZE(::some::ns::Entry,
+  FROZEN_FREEZE_FIELD(id)
+  FROZEN_FREEZE_FIELD(index)
+  FROZEN_FREEZE_FIELD(name)
+  FROZEN_FREEZE_FIELD(history))
+FROZEN_THAW(::some::ns::Entry,
+  FROZEN_THAW_FIELD(name)
+  FROZEN_THAW_FIELD(history)
+  FROZEN_THAW_FIELD(id)
+  FROZEN_THAW_FIELD(index))
+FROZEN_DEBUG(::some::ns::Entry,
+  FROZEN_DEBUG_FIELD(name)
+  FROZEN_DEBUG_FIELD(history)
+  FROZEN_DEBUG_FIELD(id)
+  FROZEN_DEBUG_FIELD(index))
+FROZEN_CLEAR(::some::ns::Entry,
+  FROZEN_CLEAR_FIELD(name)
+  FROZEN_CLEAR_FIELD(history)
+  FROZEN_CLEAR_FIELD(id)
+  FROZEN_CLEAR_FIELD(index))
+
+
+
+}}} // apache::thrift::frozen
@@ -0,0 +1,38 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/frozen/Frozen.h>
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_types.h"
+namespace apache { namespace thrift { namespace frozen {
+
+
+
+FROZEN_TYPE(::some::ns::Entry,
+  FROZEN_FIELD(name, 1, ::std::string)
+  FROZEN_FIELD(history, 2, ::std::vector<int64_t>)
+  FROZEN_FIELD(id, 3, int64_t)
+  FROZEN_FIELD(index, 4, ::std::map<int64_t, int64_t>)
+  FROZEN_VIEW(
+    FROZEN_VIEW_FIELD(name, ::std::string)
+    FROZEN_VIEW_FIELD(history, ::std::vector<int64_t>)
+    FROZEN_VIEW_FIELD(id, int64_t)
+    FROZEN_VIEW_FIELD(index, ::std::map<int64_t, int64_t>))
+  FROZEN_SAVE_INLINE(
+    FROZEN_SAVE_FIELD(name)
+    FROZEN_SAVE_FIELD(history)
+    FROZEN_SAVE_FIELD(id)
+    FROZEN_SAVE_FIELD(index))
+  FROZEN_LOAD_INLINE(
+    FROZEN_LOAD_FIELD(name, 1)
+    FROZEN_LOAD_FIELD(history, 2)
+    FROZEN_LOAD_FIELD(id, 3)
+    FROZEN_LOAD_FIELD(index, 4)));
+
+
+
+}}} // apache::thrift::frozen
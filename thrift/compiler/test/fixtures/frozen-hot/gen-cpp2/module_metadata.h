@@ -0,0 +1,26 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_metadata_h.h>
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_types.h"
+
+
+namespace apache {
+namespace thrift {
+namespace detail {
+namespace md {
+
+template <>
+class StructMetadata<::some::ns::Entry> {
+ public:
+  static const ::apache::thrift::metadata::ThriftStruct& gen(ThriftMetadata& metadata);
+};
+} // namespace md
+} // namespace detail
+} // namespace thrift
+} // namespace apache
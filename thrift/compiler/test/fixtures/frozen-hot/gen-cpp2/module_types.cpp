@@ -0,0 +1,138 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_types.h"
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_types.tcc"
+
+#include <thrift/lib/cpp2/gen/module_types_cpp.h>
+
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_data.h"
+
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+void TccStructTraits<::some::ns::Entry>::translateFieldName(
+    folly::StringPiece _fname,
+    int16_t& fid,
+    apache::thrift::protocol::TType& _ftype) noexcept {
+  using data = apache::thrift::TStructDataStorage<::some::ns::Entry>;
+  static const st::translate_field_name_table table{
+      data::fields_size,
+      data::fields_names.data(),
+      data::fields_ids.data(),
+      data::fields_types.data()};
+  st::translate_field_name(_fname, fid, _ftype, table);
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+namespace some { namespace ns {
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+Entry::Entry(apache::thrift::FragileConstructor, ::std::string name__arg, ::std::vector<int64_t> history__arg, int64_t id__arg, ::std::map<int64_t, int64_t> index__arg) :
+    name(std::move(name__arg)),
+    history(std::move(history__arg)),
+    id(std::move(id__arg)),
+    index(std::move(index__arg)) {
+  __isset.name = true;
+  __isset.history = true;
+  __isset.id = true;
+  __isset.index = true;
+}
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+void Entry::__clear() {
+  // clear all fields
+  name = apache::thrift::StringTraits< std::string>::fromStringLiteral("");
+  history.clear();
+  id = 0;
+  index.clear();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset = {};
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+bool Entry::operator==(const Entry& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.name == rhs.name)) {
+    return false;
+  }
+  if (!(lhs.history == rhs.history)) {
+    return false;
+  }
+  if (!(lhs.id == rhs.id)) {
+    return false;
+  }
+  if (!(lhs.index == rhs.index)) {
+    return false;
+  }
+  return true;
+}
+
+bool Entry::operator<(const Entry& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.name == rhs.name)) {
+    return lhs.name < rhs.name;
+  }
+  if (!(lhs.history == rhs.history)) {
+    return lhs.history < rhs.history;
+  }
+  if (!(lhs.id == rhs.id)) {
+    return lhs.id < rhs.id;
+  }
+  if (!(lhs.index == rhs.index)) {
+    return lhs.index < rhs.index;
+  }
+  return false;
+}
+
+const ::std::vector<int64_t>& Entry::get_history() const& {
+  return history;
+}
+
+::std::vector<int64_t> Entry::get_history() && {
+  return std::move(history);
+}
+
+const ::std::map<int64_t, int64_t>& Entry::get_index() const& {
+  return index;
+}
+
+::std::map<int64_t, int64_t> Entry::get_index() && {
+  return std::move(index);
+}
+
+
+void swap(Entry& a, Entry& b) {
+  using ::std::swap;
+  swap(a.name_ref().value(), b.name_ref().value());
+  swap(a.history_ref().value(), b.history_ref().value());
+  swap(a.id_ref().value(), b.id_ref().value());
+  swap(a.index_ref().value(), b.index_ref().value());
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  swap(a.__isset, b.__isset);
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+template void Entry::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+template uint32_t Entry::write<>(apache::thrift::BinaryProtocolWriter*) const;
+template uint32_t Entry::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+template uint32_t Entry::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+template void Entry::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+template uint32_t Entry::write<>(apache::thrift::CompactProtocolWriter*) const;
+template uint32_t Entry::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+template uint32_t Entry::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+
+
+}} // some::ns
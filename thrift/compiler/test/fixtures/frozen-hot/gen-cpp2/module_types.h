@@ -0,0 +1,289 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_types_h.h>
+
+
+
+namespace apache {
+namespace thrift {
+namespace tag {
+struct name;
+struct history;
+struct id;
+struct index;
+} // namespace tag
+namespace detail {
+#ifndef APACHE_THRIFT_ACCESSOR_name
+#define APACHE_THRIFT_ACCESSOR_name
+APACHE_THRIFT_DEFINE_ACCESSOR(name);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_history
+#define APACHE_THRIFT_ACCESSOR_history
+APACHE_THRIFT_DEFINE_ACCESSOR(history);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_id
+#define APACHE_THRIFT_ACCESSOR_id
+APACHE_THRIFT_DEFINE_ACCESSOR(id);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_index
+#define APACHE_THRIFT_ACCESSOR_index
+APACHE_THRIFT_DEFINE_ACCESSOR(index);
+#endif
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+// BEGIN declare_enums
+
+// END declare_enums
+// BEGIN forward_declare
+namespace some { namespace ns {
+class Entry;
+}} // some::ns
+// END forward_declare
+// BEGIN typedefs
+
+// END typedefs
+// BEGIN hash_and_equal_to
+// END hash_and_equal_to
+namespace some { namespace ns {
+class Entry final  {
+ private:
+  friend struct ::apache::thrift::detail::st::struct_private_access;
+
+  //  used by a static_assert in the corresponding source
+  static constexpr bool __fbthrift_cpp2_gen_json = false;
+  static constexpr bool __fbthrift_cpp2_gen_nimble = false;
+  static constexpr bool __fbthrift_cpp2_gen_has_thrift_uri = false;
+
+ public:
+  using __fbthrift_cpp2_type = Entry;
+  static constexpr bool __fbthrift_cpp2_is_union =
+    false;
+
+
+ public:
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  Entry() :
+      id(0) {}
+  // FragileConstructor for use in initialization lists only.
+  [[deprecated("This constructor is deprecated")]]
+  Entry(apache::thrift::FragileConstructor, ::std::string name__arg, ::std::vector<int64_t> history__arg, int64_t id__arg, ::std::map<int64_t, int64_t> index__arg);
+
+  Entry(Entry&&) = default;
+
+  Entry(const Entry&) = default;
+
+
+  Entry& operator=(Entry&&) = default;
+
+  Entry& operator=(const Entry&) = default;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  void __clear();
+ private:
+  ::std::string name;
+ private:
+  ::std::vector<int64_t> history;
+ private:
+  int64_t id;
+ private:
+  ::std::map<int64_t, int64_t> index;
+
+ public:
+  [[deprecated("__isset field is deprecated in Thrift struct. Use _ref() accessors instead.")]]
+  struct __isset {
+    bool name;
+    bool history;
+    bool id;
+    bool index;
+  } __isset = {};
+  bool operator==(const Entry& rhs) const;
+#ifndef SWIG
+  friend bool operator!=(const Entry& __x, const Entry& __y) {
+    return !(__x == __y);
+  }
+#endif
+  bool operator<(const Entry& rhs) const;
+#ifndef SWIG
+  friend bool operator>(const Entry& __x, const Entry& __y) {
+    return __y < __x;
+  }
+  friend bool operator<=(const Entry& __x, const Entry& __y) {
+    return !(__y < __x);
+  }
+  friend bool operator>=(const Entry& __x, const Entry& __y) {
+    return !(__x < __y);
+  }
+#endif
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> name_ref() const& {
+    return {this->name, __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> name_ref() const&& {
+    return {std::move(this->name), __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> name_ref() & {
+    return {this->name, __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> name_ref() && {
+    return {std::move(this->name), __isset.name};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> history_ref() const& {
+    return {this->history, __isset.history};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> history_ref() const&& {
+    return {std::move(this->history), __isset.history};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> history_ref() & {
+    return {this->history, __isset.history};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> history_ref() && {
+    return {std::move(this->history), __isset.history};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = int64_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> id_ref() const& {
+    return {this->id, __isset.id};
+  }
+
+  template <typename..., typename T = int64_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> id_ref() const&& {
+    return {std::move(this->id), __isset.id};
+  }
+
+  template <typename..., typename T = int64_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> id_ref() & {
+    return {this->id, __isset.id};
+  }
+
+  template <typename..., typename T = int64_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> id_ref() && {
+    return {std::move(this->id), __isset.id};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::map<int64_t, int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> index_ref() const& {
+    return {this->index, __isset.index};
+  }
+
+  template <typename..., typename T = ::std::map<int64_t, int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> index_ref() const&& {
+    return {std::move(this->index), __isset.index};
+  }
+
+  template <typename..., typename T = ::std::map<int64_t, int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> index_ref() & {
+    return {this->index, __isset.index};
+  }
+
+  template <typename..., typename T = ::std::map<int64_t, int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> index_ref() && {
+    return {std::move(this->index), __isset.index};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+  const ::std::string& get_name() const& {
+    return name;
+  }
+
+  ::std::string get_name() && {
+    return std::move(name);
+  }
+
+  template <typename T_Entry_name_struct_setter = ::std::string>
+  ::std::string& set_name(T_Entry_name_struct_setter&& name_) {
+    name = std::forward<T_Entry_name_struct_setter>(name_);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.name = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return name;
+  }
+  const ::std::vector<int64_t>& get_history() const&;
+  ::std::vector<int64_t> get_history() &&;
+
+  template <typename T_Entry_history_struct_setter = ::std::vector<int64_t>>
+  ::std::vector<int64_t>& set_history(T_Entry_history_struct_setter&& history_) {
+    history = std::forward<T_Entry_history_struct_setter>(history_);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.history = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return history;
+  }
+
+  int64_t get_id() const {
+    return id;
+  }
+
+  int64_t& set_id(int64_t id_) {
+    id = id_;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.id = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return id;
+  }
+  const ::std::map<int64_t, int64_t>& get_index() const&;
+  ::std::map<int64_t, int64_t> get_index() &&;
+
+  template <typename T_Entry_index_struct_setter = ::std::map<int64_t, int64_t>>
+  ::std::map<int64_t, int64_t>& set_index(T_Entry_index_struct_setter&& index_) {
+    index = std::forward<T_Entry_index_struct_setter>(index_);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.index = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return index;
+  }
+
+  template <class Protocol_>
+  uint32_t read(Protocol_* iprot);
+  template <class Protocol_>
+  uint32_t serializedSize(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t serializedSizeZC(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t write(Protocol_* prot_) const;
+
+ private:
+  template <class Protocol_>
+  void readNoXfer(Protocol_* iprot);
+
+  friend class ::apache::thrift::Cpp2Ops< Entry >;
+  friend void swap(Entry& a, Entry& b);
+};
+
+template <class Protocol_>
+uint32_t Entry::read(Protocol_* iprot) {
+  auto _xferStart = iprot->getCursorPosition();
+  readNoXfer(iprot);
+  return iprot->getCursorPosition() - _xferStart;
+}
+
+}} // some::ns
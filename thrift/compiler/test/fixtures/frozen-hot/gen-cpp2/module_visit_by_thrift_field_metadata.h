@@ -0,0 +1,36 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/visitation/visit_by_thrift_field_metadata.h>
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_metadata.h"
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+template <>
+struct VisitByThriftId<::some::ns::Entry> {
+  template <typename F, typename T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, size_t id, FOLLY_MAYBE_UNUSED T&& t) const {
+    switch (id) {
+    case 1:
+      return f(0, static_cast<T&&>(t).name_ref());
+    case 2:
+      return f(1, static_cast<T&&>(t).history_ref());
+    case 3:
+      return f(2, static_cast<T&&>(t).id_ref());
+    case 4:
+      return f(3, static_cast<T&&>(t).index_ref());
+    default:
+      throwInvalidThriftId(id, "::some::ns::Entry");
+    }
+  }
+};
+} // namespace detail
+} // namespace thrift
+} // namespace apache
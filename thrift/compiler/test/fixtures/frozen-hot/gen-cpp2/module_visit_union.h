@@ -0,0 +1,18 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include "thrift/compiler/test/fixtures/frozen-hot/gen-cpp2/module_metadata.h"
+#include <thrift/lib/cpp2/visitation/visit_union.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
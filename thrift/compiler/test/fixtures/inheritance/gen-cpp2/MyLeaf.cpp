@@ -66,6 +66,8 @@ const MyLeafAsyncProcessor::ProcessMap& MyLeafAsyncProcessor::getBinaryProtocolP
 
 const MyLeafAsyncProcessor::ProcessMap MyLeafAsyncProcessor::binaryProcessMap_ {
   {"do_leaf", &MyLeafAsyncProcessor::setUpAndProcess_do_leaf<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
+  {"do_mid", &MyLeafAsyncProcessor::setUpAndProcess_do_mid<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
+  {"do_root", &MyLeafAsyncProcessor::setUpAndProcess_do_root<apache::thrift::BinaryProtocolReader, apache::thrift::BinaryProtocolWriter>},
 };
 
 const MyLeafAsyncProcessor::ProcessMap& MyLeafAsyncProcessor::getCompactProtocolProcessMap() {
@@ -74,6 +76,8 @@ const MyLeafAsyncProcessor::ProcessMap& MyLeafAsyncProcessor::getCompactProtocol
 
 const MyLeafAsyncProcessor::ProcessMap MyLeafAsyncProcessor::compactProcessMap_ {
   {"do_leaf", &MyLeafAsyncProcessor::setUpAndProcess_do_leaf<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
+  {"do_mid", &MyLeafAsyncProcessor::setUpAndProcess_do_mid<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
+  {"do_root", &MyLeafAsyncProcessor::setUpAndProcess_do_root<apache::thrift::CompactProtocolReader, apache::thrift::CompactProtocolWriter>},
 };
 
 } // cpp2
@@ -135,7 +135,9 @@ class MyServiceAsyncProcessor : public ::apache::thrift::GeneratedAsyncProcessor
   static const MyServiceAsyncProcessor::ProcessMap binaryProcessMap_;
   static const MyServiceAsyncProcessor::ProcessMap compactProcessMap_;
   static const MyServiceAsyncProcessor::InteractionConstructorMap interactionConstructorMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   std::unique_ptr<apache::thrift::Tile> createMyInteraction() {
     return iface_->createMyInteraction();
   }
@@ -0,0 +1,19 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_constants_h.h>
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.h"
+
+namespace some { namespace ns {
+
+struct module_constants {
+
+};
+
+}} // some::ns
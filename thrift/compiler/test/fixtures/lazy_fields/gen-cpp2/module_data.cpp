@@ -0,0 +1,83 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_data.h"
+
+#include <thrift/lib/cpp2/gen/module_data_cpp.h>
+
+namespace apache {
+namespace thrift {
+
+
+const std::size_t TEnumDataStorage<::some::ns::LazyUnion::Type>::size;
+const std::array<::some::ns::LazyUnion::Type, 2> TEnumDataStorage<::some::ns::LazyUnion::Type>::values = {{
+  type::values,
+  type::inner,
+}};
+const std::array<folly::StringPiece, 2> TEnumDataStorage<::some::ns::LazyUnion::Type>::names = {{
+  "values",
+  "inner",
+}};
+
+
+
+const std::size_t TStructDataStorage<::some::ns::Inner>::fields_size;
+const std::array<folly::StringPiece, TStructDataStorage<::some::ns::Inner>::fields_size> TStructDataStorage<::some::ns::Inner>::fields_names = {{
+  "value",
+}};
+const std::array<int16_t, TStructDataStorage<::some::ns::Inner>::fields_size> TStructDataStorage<::some::ns::Inner>::fields_ids = {{
+  1,
+}};
+const std::array<apache::thrift::protocol::TType, TStructDataStorage<::some::ns::Inner>::fields_size> TStructDataStorage<::some::ns::Inner>::fields_types = {{
+  TType::T_I32,
+}};
+
+const std::size_t TStructDataStorage<::some::ns::Lazy>::fields_size;
+const std::array<folly::StringPiece, TStructDataStorage<::some::ns::Lazy>::fields_size> TStructDataStorage<::some::ns::Lazy>::fields_names = {{
+  "id",
+  "values",
+  "byName",
+  "inner",
+  "name",
+  "ids",
+  "boxed",
+}};
+const std::array<int16_t, TStructDataStorage<::some::ns::Lazy>::fields_size> TStructDataStorage<::some::ns::Lazy>::fields_ids = {{
+  1,
+  2,
+  3,
+  4,
+  5,
+  6,
+  7,
+}};
+const std::array<apache::thrift::protocol::TType, TStructDataStorage<::some::ns::Lazy>::fields_size> TStructDataStorage<::some::ns::Lazy>::fields_types = {{
+  TType::T_I32,
+  TType::T_LIST,
+  TType::T_MAP,
+  TType::T_STRUCT,
+  TType::T_STRING,
+  TType::T_LIST,
+  TType::T_STRUCT,
+}};
+
+const std::size_t TStructDataStorage<::some::ns::LazyUnion>::fields_size;
+const std::array<folly::StringPiece, TStructDataStorage<::some::ns::LazyUnion>::fields_size> TStructDataStorage<::some::ns::LazyUnion>::fields_names = {{
+  "values",
+  "inner",
+}};
+const std::array<int16_t, TStructDataStorage<::some::ns::LazyUnion>::fields_size> TStructDataStorage<::some::ns::LazyUnion>::fields_ids = {{
+  1,
+  2,
+}};
+const std::array<apache::thrift::protocol::TType, TStructDataStorage<::some::ns::LazyUnion>::fields_size> TStructDataStorage<::some::ns::LazyUnion>::fields_types = {{
+  TType::T_LIST,
+  TType::T_STRUCT,
+}};
+
+} // namespace thrift
+} // namespace apache
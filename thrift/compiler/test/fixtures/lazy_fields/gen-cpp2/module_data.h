@@ -0,0 +1,43 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_data_h.h>
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.h"
+
+namespace apache { namespace thrift {
+
+template <> struct TEnumDataStorage<::some::ns::LazyUnion::Type> {
+  using type = ::some::ns::LazyUnion::Type;
+  static constexpr const std::size_t size = 2;
+  static const std::array<type, size> values;
+  static const std::array<folly::StringPiece, size> names;
+};
+
+template <> struct TStructDataStorage<::some::ns::Inner> {
+  static constexpr const std::size_t fields_size = 1;
+  static const std::array<folly::StringPiece, fields_size> fields_names;
+  static const std::array<int16_t, fields_size> fields_ids;
+  static const std::array<apache::thrift::protocol::TType, fields_size> fields_types;
+};
+
+template <> struct TStructDataStorage<::some::ns::Lazy> {
+  static constexpr const std::size_t fields_size = 7;
+  static const std::array<folly::StringPiece, fields_size> fields_names;
+  static const std::array<int16_t, fields_size> fields_ids;
+  static const std::array<apache::thrift::protocol::TType, fields_size> fields_types;
+};
+
+template <> struct TStructDataStorage<::some::ns::LazyUnion> {
+  static constexpr const std::size_t fields_size = 2;
+  static const std::array<folly::StringPiece, fields_size> fields_names;
+  static const std::array<int16_t, fields_size> fields_ids;
+  static const std::array<apache::thrift::protocol::TType, fields_size> fields_types;
+};
+
+}} // apache::thrift
@@ -0,0 +1,48 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_metadata.h"
+#include <thrift/lib/cpp2/visitation/for_each.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+template <>
+struct ForEachField<::some::ns::Inner> {
+  template <typename F, typename... T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, FOLLY_MAYBE_UNUSED T&&... t) const {
+    f(0, static_cast<T&&>(t).value_ref()...);
+  }
+};
+
+template <>
+struct ForEachField<::some::ns::Lazy> {
+  template <typename F, typename... T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, FOLLY_MAYBE_UNUSED T&&... t) const {
+    f(0, static_cast<T&&>(t).id_ref()...);
+    f(1, static_cast<T&&>(t).values_ref()...);
+    f(2, static_cast<T&&>(t).byName_ref()...);
+    f(3, static_cast<T&&>(t).inner_ref()...);
+    f(4, static_cast<T&&>(t).name_ref()...);
+    f(5, static_cast<T&&>(t).ids_ref()...);
+    f(6, static_cast<T&&>(t).boxed_ref()...);
+  }
+};
+
+template <>
+struct ForEachField<::some::ns::LazyUnion> {
+  template <typename F, typename... T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, FOLLY_MAYBE_UNUSED T&&... t) const {
+    f(0, static_cast<T&&>(t).values_ref()...);
+    f(1, static_cast<T&&>(t).inner_ref()...);
+  }
+};
+} // namespace detail
+} // namespace thrift
+} // namespace apache
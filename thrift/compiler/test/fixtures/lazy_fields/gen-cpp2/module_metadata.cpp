@@ -0,0 +1,105 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#include <thrift/lib/cpp2/gen/module_metadata_cpp.h>
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_metadata.h"
+
+namespace apache {
+namespace thrift {
+namespace detail {
+namespace md {
+using ThriftMetadata = ::apache::thrift::metadata::ThriftMetadata;
+using ThriftPrimitiveType = ::apache::thrift::metadata::ThriftPrimitiveType;
+using ThriftType = ::apache::thrift::metadata::ThriftType;
+using ThriftService = ::apache::thrift::metadata::ThriftService;
+using ThriftServiceContext = ::apache::thrift::metadata::ThriftServiceContext;
+using ThriftFunctionGenerator = void (*)(ThriftMetadata&, ThriftService&);
+
+
+const ::apache::thrift::metadata::ThriftStruct&
+StructMetadata<::some::ns::Inner>::gen(ThriftMetadata& metadata) {
+  auto res = metadata.structs_ref()->emplace("module.Inner", ::apache::thrift::metadata::ThriftStruct{});
+  if (!res.second) {
+    return res.first->second;
+  }
+  ::apache::thrift::metadata::ThriftStruct& module_Inner = res.first->second;
+  module_Inner.name_ref() = "module.Inner";
+  module_Inner.is_union_ref() = false;
+  static const EncodedThriftField
+  module_Inner_fields[] = {
+    std::make_tuple(1, "value", false, std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_I32_TYPE), std::vector<ThriftConstStruct>{}),
+  };
+  for (const auto& f : module_Inner_fields) {
+    ::apache::thrift::metadata::ThriftField field;
+    field.id_ref() = std::get<0>(f);
+    field.name_ref() = std::get<1>(f);
+    field.is_optional_ref() = std::get<2>(f);
+    std::get<3>(f)->writeAndGenType(*field.type_ref(), metadata);
+    field.structured_annotations_ref() = std::get<4>(f);
+    module_Inner.fields_ref()->push_back(std::move(field));
+  }
+  return res.first->second;
+}
+const ::apache::thrift::metadata::ThriftStruct&
+StructMetadata<::some::ns::Lazy>::gen(ThriftMetadata& metadata) {
+  auto res = metadata.structs_ref()->emplace("module.Lazy", ::apache::thrift::metadata::ThriftStruct{});
+  if (!res.second) {
+    return res.first->second;
+  }
+  ::apache::thrift::metadata::ThriftStruct& module_Lazy = res.first->second;
+  module_Lazy.name_ref() = "module.Lazy";
+  module_Lazy.is_union_ref() = false;
+  static const EncodedThriftField
+  module_Lazy_fields[] = {
+    std::make_tuple(1, "id", false, std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_I32_TYPE), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(2, "values", false, std::make_unique<List>(std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_I64_TYPE)), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(3, "byName", true, std::make_unique<Map>(std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_STRING_TYPE), std::make_unique<Struct< ::some::ns::Inner>>("module.Inner")), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(4, "inner", false, std::make_unique<Struct< ::some::ns::Inner>>("module.Inner"), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(5, "name", false, std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_STRING_TYPE), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(6, "ids", false, std::make_unique<List>(std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_I32_TYPE)), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(7, "boxed", false, std::make_unique<Struct< ::some::ns::Inner>>("module.Inner"), std::vector<ThriftConstStruct>{}),
+  };
+  for (const auto& f : module_Lazy_fields) {
+    ::apache::thrift::metadata::ThriftField field;
+    field.id_ref() = std::get<0>(f);
+    field.name_ref() = std::get<1>(f);
+    field.is_optional_ref() = std::get<2>(f);
+    std::get<3>(f)->writeAndGenType(*field.type_ref(), metadata);
+    field.structured_annotations_ref() = std::get<4>(f);
+    module_Lazy.fields_ref()->push_back(std::move(field));
+  }
+  return res.first->second;
+}
+const ::apache::thrift::metadata::ThriftStruct&
+StructMetadata<::some::ns::LazyUnion>::gen(ThriftMetadata& metadata) {
+  auto res = metadata.structs_ref()->emplace("module.LazyUnion", ::apache::thrift::metadata::ThriftStruct{});
+  if (!res.second) {
+    return res.first->second;
+  }
+  ::apache::thrift::metadata::ThriftStruct& module_LazyUnion = res.first->second;
+  module_LazyUnion.name_ref() = "module.LazyUnion";
+  module_LazyUnion.is_union_ref() = true;
+  static const EncodedThriftField
+  module_LazyUnion_fields[] = {
+    std::make_tuple(1, "values", false, std::make_unique<List>(std::make_unique<Primitive>(ThriftPrimitiveType::THRIFT_I64_TYPE)), std::vector<ThriftConstStruct>{}),
+    std::make_tuple(2, "inner", false, std::make_unique<Struct< ::some::ns::Inner>>("module.Inner"), std::vector<ThriftConstStruct>{}),
+  };
+  for (const auto& f : module_LazyUnion_fields) {
+    ::apache::thrift::metadata::ThriftField field;
+    field.id_ref() = std::get<0>(f);
+    field.name_ref() = std::get<1>(f);
+    field.is_optional_ref() = std::get<2>(f);
+    std::get<3>(f)->writeAndGenType(*field.type_ref(), metadata);
+    field.structured_annotations_ref() = std::get<4>(f);
+    module_LazyUnion.fields_ref()->push_back(std::move(field));
+  }
+  return res.first->second;
+}
+
+} // namespace md
+} // namespace detail
+} // namespace thrift
+} // namespace apache
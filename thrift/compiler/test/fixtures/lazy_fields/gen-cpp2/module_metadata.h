@@ -0,0 +1,36 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_metadata_h.h>
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.h"
+
+
+namespace apache {
+namespace thrift {
+namespace detail {
+namespace md {
+
+template <>
+class StructMetadata<::some::ns::Inner> {
+ public:
+  static const ::apache::thrift::metadata::ThriftStruct& gen(ThriftMetadata& metadata);
+};
+template <>
+class StructMetadata<::some::ns::Lazy> {
+ public:
+  static const ::apache::thrift::metadata::ThriftStruct& gen(ThriftMetadata& metadata);
+};
+template <>
+class StructMetadata<::some::ns::LazyUnion> {
+ public:
+  static const ::apache::thrift::metadata::ThriftStruct& gen(ThriftMetadata& metadata);
+};
+} // namespace md
+} // namespace detail
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,491 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.h"
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.tcc"
+
+#include <thrift/lib/cpp2/gen/module_types_cpp.h>
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_data.h"
+
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+void TccStructTraits<::some::ns::Inner>::translateFieldName(
+    folly::StringPiece _fname,
+    int16_t& fid,
+    apache::thrift::protocol::TType& _ftype) noexcept {
+  using data = apache::thrift::TStructDataStorage<::some::ns::Inner>;
+  static const st::translate_field_name_table table{
+      data::fields_size,
+      data::fields_names.data(),
+      data::fields_ids.data(),
+      data::fields_types.data()};
+  st::translate_field_name(_fname, fid, _ftype, table);
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+namespace some { namespace ns {
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+Inner::Inner(apache::thrift::FragileConstructor, int32_t value__arg) :
+    value(std::move(value__arg)) {
+  __isset.value = true;
+}
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+void Inner::__clear() {
+  // clear all fields
+  value = 0;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset = {};
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+bool Inner::operator==(const Inner& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.value == rhs.value)) {
+    return false;
+  }
+  return true;
+}
+
+bool Inner::operator<(const Inner& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.value == rhs.value)) {
+    return lhs.value < rhs.value;
+  }
+  return false;
+}
+
+
+void swap(Inner& a, Inner& b) {
+  using ::std::swap;
+  swap(a.value_ref().value(), b.value_ref().value());
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  swap(a.__isset, b.__isset);
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+template void Inner::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+template uint32_t Inner::write<>(apache::thrift::BinaryProtocolWriter*) const;
+template uint32_t Inner::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+template uint32_t Inner::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+template void Inner::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+template uint32_t Inner::write<>(apache::thrift::CompactProtocolWriter*) const;
+template uint32_t Inner::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+template uint32_t Inner::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+
+
+}} // some::ns
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+void TccStructTraits<::some::ns::Lazy>::translateFieldName(
+    folly::StringPiece _fname,
+    int16_t& fid,
+    apache::thrift::protocol::TType& _ftype) noexcept {
+  using data = apache::thrift::TStructDataStorage<::some::ns::Lazy>;
+  static const st::translate_field_name_table table{
+      data::fields_size,
+      data::fields_names.data(),
+      data::fields_ids.data(),
+      data::fields_types.data()};
+  st::translate_field_name(_fname, fid, _ftype, table);
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+namespace some { namespace ns {
+
+Lazy::Lazy(const Lazy& srcObj) {
+  id = srcObj.id;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset.id = srcObj.__isset.id;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  __fbthrift_lazy_values.copy(values, srcObj.__fbthrift_lazy_values, srcObj.values);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset.values = srcObj.__isset.values;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  __fbthrift_lazy_byName.copy(byName, srcObj.__fbthrift_lazy_byName, srcObj.byName);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset.byName = srcObj.__isset.byName;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  __fbthrift_lazy_inner.copy(inner, srcObj.__fbthrift_lazy_inner, srcObj.inner);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset.inner = srcObj.__isset.inner;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  name = srcObj.name;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset.name = srcObj.__isset.name;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  ids = srcObj.ids;
+  if (srcObj.boxed) boxed.reset(new  ::some::ns::Inner(*srcObj.boxed));
+}
+
+Lazy& Lazy::operator=(const Lazy& src) {
+  Lazy tmp(src);
+  swap(*this, tmp);
+  return *this;
+}
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+Lazy::Lazy() :
+      id(0),
+      boxed(std::make_unique< ::some::ns::Inner>()) {}
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+
+Lazy::~Lazy() {}
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+Lazy::Lazy(apache::thrift::FragileConstructor, int32_t id__arg, ::std::vector<int64_t> values__arg, ::std::map<::std::string,  ::some::ns::Inner> byName__arg,  ::some::ns::Inner inner__arg, ::std::string name__arg, ::std::vector<int32_t> ids__arg, std::unique_ptr< ::some::ns::Inner> boxed__arg) :
+    id(std::move(id__arg)),
+    values(std::move(values__arg)),
+    byName(std::move(byName__arg)),
+    inner(std::move(inner__arg)),
+    name(std::move(name__arg)),
+    ids(std::move(ids__arg)),
+    boxed(std::move(boxed__arg)) {
+  __isset.id = true;
+  __isset.values = true;
+  __isset.byName = true;
+  __isset.inner = true;
+  __isset.name = true;
+}
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+void Lazy::__clear() {
+  // clear all fields
+  id = 0;
+  values.clear();
+  __fbthrift_lazy_values.reset();
+  byName.clear();
+  __fbthrift_lazy_byName.reset();
+  inner.__clear();
+  __fbthrift_lazy_inner.reset();
+  name = apache::thrift::StringTraits< std::string>::fromStringLiteral("");
+  ids.clear();
+  if (boxed) boxed->__clear();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  __isset = {};
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+bool Lazy::operator==(const Lazy& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.id == rhs.id)) {
+    return false;
+  }
+  lhs.__fbthrift_lazy_values.load(lhs.values);
+  rhs.__fbthrift_lazy_values.load(rhs.values);
+  if (!(lhs.values == rhs.values)) {
+    return false;
+  }
+  lhs.__fbthrift_lazy_byName.load(lhs.byName);
+  rhs.__fbthrift_lazy_byName.load(rhs.byName);
+  if (lhs.byName_ref() != rhs.byName_ref()) {
+    return false;
+  }
+  lhs.__fbthrift_lazy_inner.load(lhs.inner);
+  rhs.__fbthrift_lazy_inner.load(rhs.inner);
+  if (!(lhs.inner == rhs.inner)) {
+    return false;
+  }
+  if (!(lhs.name == rhs.name)) {
+    return false;
+  }
+  if (!(lhs.ids == rhs.ids)) {
+    return false;
+  }
+  if (!!lhs.boxed != !!rhs.boxed) {
+    return false;
+  }
+  if (!!lhs.boxed) {
+    if (lhs.boxed != rhs.boxed && !(*lhs.boxed == *rhs.boxed)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Lazy::operator<(const Lazy& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (!(lhs.id == rhs.id)) {
+    return lhs.id < rhs.id;
+  }
+  lhs.__fbthrift_lazy_values.load(lhs.values);
+  rhs.__fbthrift_lazy_values.load(rhs.values);
+  if (!(lhs.values == rhs.values)) {
+    return lhs.values < rhs.values;
+  }
+  lhs.__fbthrift_lazy_byName.load(lhs.byName);
+  rhs.__fbthrift_lazy_byName.load(rhs.byName);
+  if (lhs.byName_ref() != rhs.byName_ref()) {
+    return lhs.byName_ref() < rhs.byName_ref();
+  }
+  lhs.__fbthrift_lazy_inner.load(lhs.inner);
+  rhs.__fbthrift_lazy_inner.load(rhs.inner);
+  if (!(lhs.inner == rhs.inner)) {
+    return lhs.inner < rhs.inner;
+  }
+  if (!(lhs.name == rhs.name)) {
+    return lhs.name < rhs.name;
+  }
+  if (!(lhs.ids == rhs.ids)) {
+    return lhs.ids < rhs.ids;
+  }
+  if (!!lhs.boxed != !!rhs.boxed) {
+    return !!lhs.boxed < !!rhs.boxed;
+  }
+  if (!!lhs.boxed) {
+    if (lhs.boxed != rhs.boxed && !(*lhs.boxed == *rhs.boxed)) {
+      return *lhs.boxed < *rhs.boxed;
+    }
+  }
+  return false;
+}
+
+const ::std::vector<int64_t>& Lazy::get_values() const& {
+  __fbthrift_lazy_values.load(values);
+  return values;
+}
+
+::std::vector<int64_t> Lazy::get_values() && {
+  __fbthrift_lazy_values.loadForWrite(values);
+  return std::move(values);
+}
+
+const ::std::map<::std::string,  ::some::ns::Inner>* Lazy::get_byName() const& {
+  return byName_ref().has_value() ? std::addressof(byName) : nullptr;
+}
+
+::std::map<::std::string,  ::some::ns::Inner>* Lazy::get_byName() & {
+  return byName_ref().has_value() ? std::addressof(byName) : nullptr;
+}
+
+const  ::some::ns::Inner& Lazy::get_inner() const& {
+  __fbthrift_lazy_inner.load(inner);
+  return inner;
+}
+
+ ::some::ns::Inner Lazy::get_inner() && {
+  __fbthrift_lazy_inner.loadForWrite(inner);
+  return std::move(inner);
+}
+
+const ::std::vector<int32_t>& Lazy::get_ids() const& {
+  return ids;
+}
+
+::std::vector<int32_t> Lazy::get_ids() && {
+  return std::move(ids);
+}
+
+
+void swap(Lazy& a, Lazy& b) {
+  using ::std::swap;
+  swap(a.id_ref().value(), b.id_ref().value());
+  swap(a.values, b.values);
+  swap(a.__fbthrift_lazy_values, b.__fbthrift_lazy_values);
+  swap(a.byName, b.byName);
+  swap(a.__fbthrift_lazy_byName, b.__fbthrift_lazy_byName);
+  swap(a.inner, b.inner);
+  swap(a.__fbthrift_lazy_inner, b.__fbthrift_lazy_inner);
+  swap(a.name_ref().value(), b.name_ref().value());
+  swap(a.ids_ref().value(), b.ids_ref().value());
+  swap(a.boxed, b.boxed);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  swap(a.__isset, b.__isset);
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+}
+
+template void Lazy::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+template uint32_t Lazy::write<>(apache::thrift::BinaryProtocolWriter*) const;
+template uint32_t Lazy::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+template uint32_t Lazy::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+template void Lazy::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+template uint32_t Lazy::write<>(apache::thrift::CompactProtocolWriter*) const;
+template uint32_t Lazy::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+template uint32_t Lazy::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+static_assert(
+    ::apache::thrift::detail::st::gen_check_json<
+        Lazy,
+        ::apache::thrift::type_class::map<::apache::thrift::type_class::string, ::apache::thrift::type_class::structure>,
+        ::std::map<::std::string,  ::some::ns::Inner>>,
+    "inconsistent use of json option");
+static_assert(
+    ::apache::thrift::detail::st::gen_check_json<
+        Lazy,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of json option");
+static_assert(
+    ::apache::thrift::detail::st::gen_check_json<
+        Lazy,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of json option");
+
+static_assert(
+    ::apache::thrift::detail::st::gen_check_nimble<
+        Lazy,
+        ::apache::thrift::type_class::map<::apache::thrift::type_class::string, ::apache::thrift::type_class::structure>,
+        ::std::map<::std::string,  ::some::ns::Inner>>,
+    "inconsistent use of nimble option");
+static_assert(
+    ::apache::thrift::detail::st::gen_check_nimble<
+        Lazy,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of nimble option");
+static_assert(
+    ::apache::thrift::detail::st::gen_check_nimble<
+        Lazy,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of nimble option");
+
+}} // some::ns
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+void TccStructTraits<::some::ns::LazyUnion>::translateFieldName(
+    folly::StringPiece _fname,
+    int16_t& fid,
+    apache::thrift::protocol::TType& _ftype) noexcept {
+  using data = apache::thrift::TStructDataStorage<::some::ns::LazyUnion>;
+  static const st::translate_field_name_table table{
+      data::fields_size,
+      data::fields_names.data(),
+      data::fields_ids.data(),
+      data::fields_types.data()};
+  st::translate_field_name(_fname, fid, _ftype, table);
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+namespace apache { namespace thrift {
+
+constexpr std::size_t const TEnumTraits<::some::ns::LazyUnion::Type>::size;
+folly::Range<::some::ns::LazyUnion::Type const*> const TEnumTraits<::some::ns::LazyUnion::Type>::values = folly::range(TEnumDataStorage<::some::ns::LazyUnion::Type>::values);
+folly::Range<folly::StringPiece const*> const TEnumTraits<::some::ns::LazyUnion::Type>::names = folly::range(TEnumDataStorage<::some::ns::LazyUnion::Type>::names);
+
+char const* TEnumTraits<::some::ns::LazyUnion::Type>::findName(type value) {
+  using factory = detail::TEnumMapFactory<::some::ns::LazyUnion::Type>;
+  static folly::Indestructible<factory::ValuesToNamesMapType> const map{
+      factory::makeValuesToNamesMap()};
+  auto found = map->find(value);
+  return found == map->end() ? nullptr : found->second;
+}
+
+bool TEnumTraits<::some::ns::LazyUnion::Type>::findValue(char const* name, type* out) {
+  using factory = detail::TEnumMapFactory<::some::ns::LazyUnion::Type>;
+  static folly::Indestructible<factory::NamesToValuesMapType> const map{
+      factory::makeNamesToValuesMap()};
+  auto found = map->find(name);
+  return found == map->end() ? false : (*out = found->second, true);
+}
+}} // apache::thrift
+namespace some { namespace ns {
+
+void LazyUnion::__clear() {
+  // clear all fields
+  if (type_ == Type::__EMPTY__) { return; }
+  switch(type_) {
+    case Type::values:
+      destruct(value_.values);
+      break;
+    case Type::inner:
+      destruct(value_.inner);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+  type_ = Type::__EMPTY__;
+}
+
+bool LazyUnion::operator==(const LazyUnion& rhs) const {
+  if (type_ != rhs.type_) { return false; }
+  switch(type_) {
+    case Type::values:
+      return value_.values == rhs.value_.values;
+    case Type::inner:
+      return value_.inner == rhs.value_.inner;
+    default:
+      return true;
+  }
+}
+
+bool LazyUnion::operator<(const LazyUnion& rhs) const {
+  (void)rhs;
+  auto& lhs = *this;
+  (void)lhs;
+  if (lhs.type_ != rhs.type_) {
+    return lhs.type_ < rhs.type_;
+  }
+  switch (lhs.type_) {
+    case Type::values:
+      return lhs.value_.values < rhs.value_.values;
+    case Type::inner:
+      return lhs.value_.inner < rhs.value_.inner;
+    default:
+      return false;
+  }
+}
+
+void swap(LazyUnion& a, LazyUnion& b) {
+  LazyUnion temp(std::move(a));
+  a = std::move(b);
+  b = std::move(temp);
+}
+
+template void LazyUnion::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+template uint32_t LazyUnion::write<>(apache::thrift::BinaryProtocolWriter*) const;
+template uint32_t LazyUnion::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+template uint32_t LazyUnion::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+template void LazyUnion::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+template uint32_t LazyUnion::write<>(apache::thrift::CompactProtocolWriter*) const;
+template uint32_t LazyUnion::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+template uint32_t LazyUnion::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+static_assert(
+    ::apache::thrift::detail::st::gen_check_json<
+        LazyUnion,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of json option");
+
+static_assert(
+    ::apache::thrift::detail::st::gen_check_nimble<
+        LazyUnion,
+        ::apache::thrift::type_class::structure,
+         ::some::ns::Inner>,
+    "inconsistent use of nimble option");
+
+}} // some::ns
@@ -0,0 +1,855 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/gen/module_types_h.h>
+
+#include <thrift/lib/cpp2/protocol/LazyField.h>
+
+
+namespace apache {
+namespace thrift {
+namespace tag {
+struct value;
+struct id;
+struct values;
+struct byName;
+struct inner;
+struct name;
+struct ids;
+struct boxed;
+struct values;
+struct inner;
+} // namespace tag
+namespace detail {
+#ifndef APACHE_THRIFT_ACCESSOR_value
+#define APACHE_THRIFT_ACCESSOR_value
+APACHE_THRIFT_DEFINE_ACCESSOR(value);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_id
+#define APACHE_THRIFT_ACCESSOR_id
+APACHE_THRIFT_DEFINE_ACCESSOR(id);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_values
+#define APACHE_THRIFT_ACCESSOR_values
+APACHE_THRIFT_DEFINE_ACCESSOR(values);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_byName
+#define APACHE_THRIFT_ACCESSOR_byName
+APACHE_THRIFT_DEFINE_ACCESSOR(byName);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_inner
+#define APACHE_THRIFT_ACCESSOR_inner
+APACHE_THRIFT_DEFINE_ACCESSOR(inner);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_name
+#define APACHE_THRIFT_ACCESSOR_name
+APACHE_THRIFT_DEFINE_ACCESSOR(name);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_ids
+#define APACHE_THRIFT_ACCESSOR_ids
+APACHE_THRIFT_DEFINE_ACCESSOR(ids);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_boxed
+#define APACHE_THRIFT_ACCESSOR_boxed
+APACHE_THRIFT_DEFINE_ACCESSOR(boxed);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_values
+#define APACHE_THRIFT_ACCESSOR_values
+APACHE_THRIFT_DEFINE_ACCESSOR(values);
+#endif
+#ifndef APACHE_THRIFT_ACCESSOR_inner
+#define APACHE_THRIFT_ACCESSOR_inner
+APACHE_THRIFT_DEFINE_ACCESSOR(inner);
+#endif
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+// BEGIN declare_enums
+
+// END declare_enums
+// BEGIN forward_declare
+namespace some { namespace ns {
+class Inner;
+class Lazy;
+class LazyUnion;
+}} // some::ns
+// END forward_declare
+// BEGIN typedefs
+
+// END typedefs
+// BEGIN hash_and_equal_to
+// END hash_and_equal_to
+namespace some { namespace ns {
+class Inner final  {
+ private:
+  friend struct ::apache::thrift::detail::st::struct_private_access;
+
+  //  used by a static_assert in the corresponding source
+  static constexpr bool __fbthrift_cpp2_gen_json = false;
+  static constexpr bool __fbthrift_cpp2_gen_nimble = false;
+  static constexpr bool __fbthrift_cpp2_gen_has_thrift_uri = false;
+
+ public:
+  using __fbthrift_cpp2_type = Inner;
+  static constexpr bool __fbthrift_cpp2_is_union =
+    false;
+
+
+ public:
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  Inner() :
+      value(0) {}
+  // FragileConstructor for use in initialization lists only.
+  [[deprecated("This constructor is deprecated")]]
+  Inner(apache::thrift::FragileConstructor, int32_t value__arg);
+
+  Inner(Inner&&) = default;
+
+  Inner(const Inner&) = default;
+
+
+  Inner& operator=(Inner&&) = default;
+
+  Inner& operator=(const Inner&) = default;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  void __clear();
+ private:
+  int32_t value;
+
+ public:
+  [[deprecated("__isset field is deprecated in Thrift struct. Use _ref() accessors instead.")]]
+  struct __isset {
+    bool value;
+  } __isset = {};
+  bool operator==(const Inner& rhs) const;
+#ifndef SWIG
+  friend bool operator!=(const Inner& __x, const Inner& __y) {
+    return !(__x == __y);
+  }
+#endif
+  bool operator<(const Inner& rhs) const;
+#ifndef SWIG
+  friend bool operator>(const Inner& __x, const Inner& __y) {
+    return __y < __x;
+  }
+  friend bool operator<=(const Inner& __x, const Inner& __y) {
+    return !(__y < __x);
+  }
+  friend bool operator>=(const Inner& __x, const Inner& __y) {
+    return !(__x < __y);
+  }
+#endif
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> value_ref() const& {
+    return {this->value, __isset.value};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> value_ref() const&& {
+    return {std::move(this->value), __isset.value};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> value_ref() & {
+    return {this->value, __isset.value};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> value_ref() && {
+    return {std::move(this->value), __isset.value};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+  int32_t get_value() const {
+    return value;
+  }
+
+  int32_t& set_value(int32_t value_) {
+    value = value_;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.value = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return value;
+  }
+
+  template <class Protocol_>
+  uint32_t read(Protocol_* iprot);
+  template <class Protocol_>
+  uint32_t serializedSize(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t serializedSizeZC(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t write(Protocol_* prot_) const;
+
+ private:
+  template <class Protocol_>
+  void readNoXfer(Protocol_* iprot);
+
+  friend class ::apache::thrift::Cpp2Ops< Inner >;
+  friend void swap(Inner& a, Inner& b);
+};
+
+template <class Protocol_>
+uint32_t Inner::read(Protocol_* iprot) {
+  auto _xferStart = iprot->getCursorPosition();
+  readNoXfer(iprot);
+  return iprot->getCursorPosition() - _xferStart;
+}
+
+}} // some::ns
+namespace some { namespace ns {
+class Lazy final  {
+ private:
+  friend struct ::apache::thrift::detail::st::struct_private_access;
+
+  //  used by a static_assert in the corresponding source
+  static constexpr bool __fbthrift_cpp2_gen_json = false;
+  static constexpr bool __fbthrift_cpp2_gen_nimble = false;
+  static constexpr bool __fbthrift_cpp2_gen_has_thrift_uri = false;
+
+ public:
+  using __fbthrift_cpp2_type = Lazy;
+  static constexpr bool __fbthrift_cpp2_is_union =
+    false;
+
+
+ public:
+
+  Lazy();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+
+  // FragileConstructor for use in initialization lists only.
+  [[deprecated("This constructor is deprecated")]]
+  Lazy(apache::thrift::FragileConstructor, int32_t id__arg, ::std::vector<int64_t> values__arg, ::std::map<::std::string,  ::some::ns::Inner> byName__arg,  ::some::ns::Inner inner__arg, ::std::string name__arg, ::std::vector<int32_t> ids__arg, std::unique_ptr< ::some::ns::Inner> boxed__arg);
+
+  Lazy(Lazy&&) = default;
+  Lazy(const Lazy& src);
+
+
+  Lazy& operator=(Lazy&&) = default;
+  Lazy& operator=(const Lazy& src);
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  void __clear();
+
+  ~Lazy();
+
+ private:
+  int32_t id;
+ private:
+  ::apache::thrift::detail::LazyField< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>> __fbthrift_lazy_values;
+  mutable ::std::vector<int64_t> values;
+ private:
+  ::apache::thrift::detail::LazyField< ::apache::thrift::type_class::map<::apache::thrift::type_class::string, ::apache::thrift::type_class::structure>> __fbthrift_lazy_byName;
+  mutable ::std::map<::std::string,  ::some::ns::Inner> byName;
+ private:
+  ::apache::thrift::detail::LazyField< ::apache::thrift::type_class::structure> __fbthrift_lazy_inner;
+  mutable  ::some::ns::Inner inner;
+ private:
+  ::std::string name;
+ public:
+  ::std::vector<int32_t> ids;
+ public:
+  std::unique_ptr< ::some::ns::Inner> boxed;
+
+ public:
+  [[deprecated("__isset field is deprecated in Thrift struct. Use _ref() accessors instead.")]]
+  struct __isset {
+    bool id;
+    bool values;
+    bool byName;
+    bool inner;
+    bool name;
+  } __isset = {};
+  bool operator==(const Lazy& rhs) const;
+#ifndef SWIG
+  friend bool operator!=(const Lazy& __x, const Lazy& __y) {
+    return !(__x == __y);
+  }
+#endif
+  bool operator<(const Lazy& rhs) const;
+#ifndef SWIG
+  friend bool operator>(const Lazy& __x, const Lazy& __y) {
+    return __y < __x;
+  }
+  friend bool operator<=(const Lazy& __x, const Lazy& __y) {
+    return !(__y < __x);
+  }
+  friend bool operator>=(const Lazy& __x, const Lazy& __y) {
+    return !(__x < __y);
+  }
+#endif
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> id_ref() const& {
+    return {this->id, __isset.id};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> id_ref() const&& {
+    return {std::move(this->id), __isset.id};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> id_ref() & {
+    return {this->id, __isset.id};
+  }
+
+  template <typename..., typename T = int32_t>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> id_ref() && {
+    return {std::move(this->id), __isset.id};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> values_ref() const& {
+    __fbthrift_lazy_values.load(this->values);
+    return {this->values, __isset.values};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> values_ref() const&& {
+    __fbthrift_lazy_values.load(this->values);
+    return {std::move(this->values), __isset.values};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> values_ref() & {
+    __fbthrift_lazy_values.loadForWrite(this->values);
+    return {this->values, __isset.values};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> values_ref() && {
+    __fbthrift_lazy_values.loadForWrite(this->values);
+    return {std::move(this->values), __isset.values};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::map<::std::string,  ::some::ns::Inner>>
+  FOLLY_ERASE ::apache::thrift::optional_field_ref<const T&> byName_ref() const& {
+    __fbthrift_lazy_byName.load(this->byName);
+    return {this->byName, __isset.byName};
+  }
+
+  template <typename..., typename T = ::std::map<::std::string,  ::some::ns::Inner>>
+  FOLLY_ERASE ::apache::thrift::optional_field_ref<const T&&> byName_ref() const&& {
+    __fbthrift_lazy_byName.load(this->byName);
+    return {std::move(this->byName), __isset.byName};
+  }
+
+  template <typename..., typename T = ::std::map<::std::string,  ::some::ns::Inner>>
+  FOLLY_ERASE ::apache::thrift::optional_field_ref<T&> byName_ref() & {
+    __fbthrift_lazy_byName.loadForWrite(this->byName);
+    return {this->byName, __isset.byName};
+  }
+
+  template <typename..., typename T = ::std::map<::std::string,  ::some::ns::Inner>>
+  FOLLY_ERASE ::apache::thrift::optional_field_ref<T&&> byName_ref() && {
+    __fbthrift_lazy_byName.loadForWrite(this->byName);
+    return {std::move(this->byName), __isset.byName};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> inner_ref() const& {
+    __fbthrift_lazy_inner.load(this->inner);
+    return {this->inner, __isset.inner};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> inner_ref() const&& {
+    __fbthrift_lazy_inner.load(this->inner);
+    return {std::move(this->inner), __isset.inner};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> inner_ref() & {
+    __fbthrift_lazy_inner.loadForWrite(this->inner);
+    return {this->inner, __isset.inner};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> inner_ref() && {
+    __fbthrift_lazy_inner.loadForWrite(this->inner);
+    return {std::move(this->inner), __isset.inner};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&> name_ref() const& {
+    return {this->name, __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<const T&&> name_ref() const&& {
+    return {std::move(this->name), __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&> name_ref() & {
+    return {this->name, __isset.name};
+  }
+
+  template <typename..., typename T = ::std::string>
+  FOLLY_ERASE ::apache::thrift::field_ref<T&&> name_ref() && {
+    return {std::move(this->name), __isset.name};
+  }
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+  template <typename..., typename T = ::std::vector<int32_t>>
+  FOLLY_ERASE ::apache::thrift::required_field_ref<const T&> ids_ref() const& {
+    return ::apache::thrift::required_field_ref<const T&>{this->ids};
+  }
+
+  template <typename..., typename T = ::std::vector<int32_t>>
+  FOLLY_ERASE ::apache::thrift::required_field_ref<const T&&> ids_ref() const&& {
+    return ::apache::thrift::required_field_ref<const T&&>{std::move(this->ids)};
+  }
+
+  template <typename..., typename T = ::std::vector<int32_t>>
+  FOLLY_ERASE ::apache::thrift::required_field_ref<T&> ids_ref() & {
+    return ::apache::thrift::required_field_ref<T&>{this->ids};
+  }
+
+  template <typename..., typename T = ::std::vector<int32_t>>
+  FOLLY_ERASE ::apache::thrift::required_field_ref<T&&> ids_ref() && {
+    return ::apache::thrift::required_field_ref<T&&>{std::move(this->ids)};
+  }
+  template <typename ..., typename T = std::unique_ptr< ::some::ns::Inner>>
+  FOLLY_ERASE T& boxed_ref() & { return boxed; }
+
+  template <typename ..., typename T = std::unique_ptr< ::some::ns::Inner>>
+  FOLLY_ERASE const T& boxed_ref() const& { return boxed; }
+
+  template <typename ..., typename T = std::unique_ptr< ::some::ns::Inner>>
+  FOLLY_ERASE T&& boxed_ref() && { return std::move(boxed); }
+
+  template <typename ..., typename T = std::unique_ptr< ::some::ns::Inner>>
+  FOLLY_ERASE const T&& boxed_ref() const&& { return std::move(boxed); }
+
+  int32_t get_id() const {
+    return id;
+  }
+
+  int32_t& set_id(int32_t id_) {
+    id = id_;
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.id = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return id;
+  }
+  const ::std::vector<int64_t>& get_values() const&;
+  ::std::vector<int64_t> get_values() &&;
+
+  template <typename T_Lazy_values_struct_setter = ::std::vector<int64_t>>
+  ::std::vector<int64_t>& set_values(T_Lazy_values_struct_setter&& values_) {
+    values = std::forward<T_Lazy_values_struct_setter>(values_);
+    __fbthrift_lazy_values.reset();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.values = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return values;
+  }
+  const ::std::map<::std::string,  ::some::ns::Inner>* get_byName() const&;
+  ::std::map<::std::string,  ::some::ns::Inner>* get_byName() &;
+  ::std::map<::std::string,  ::some::ns::Inner>* get_byName() && = delete;
+
+  template <typename T_Lazy_byName_struct_setter = ::std::map<::std::string,  ::some::ns::Inner>>
+  ::std::map<::std::string,  ::some::ns::Inner>& set_byName(T_Lazy_byName_struct_setter&& byName_) {
+    byName = std::forward<T_Lazy_byName_struct_setter>(byName_);
+    __fbthrift_lazy_byName.reset();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.byName = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return byName;
+  }
+  const  ::some::ns::Inner& get_inner() const&;
+   ::some::ns::Inner get_inner() &&;
+
+  template <typename T_Lazy_inner_struct_setter =  ::some::ns::Inner>
+   ::some::ns::Inner& set_inner(T_Lazy_inner_struct_setter&& inner_) {
+    inner = std::forward<T_Lazy_inner_struct_setter>(inner_);
+    __fbthrift_lazy_inner.reset();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.inner = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return inner;
+  }
+
+  const ::std::string& get_name() const& {
+    return name;
+  }
+
+  ::std::string get_name() && {
+    return std::move(name);
+  }
+
+  template <typename T_Lazy_name_struct_setter = ::std::string>
+  ::std::string& set_name(T_Lazy_name_struct_setter&& name_) {
+    name = std::forward<T_Lazy_name_struct_setter>(name_);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    __isset.name = true;
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    return name;
+  }
+  const ::std::vector<int32_t>& get_ids() const&;
+  ::std::vector<int32_t> get_ids() &&;
+
+  template <typename T_Lazy_ids_struct_setter = ::std::vector<int32_t>>
+  ::std::vector<int32_t>& set_ids(T_Lazy_ids_struct_setter&& ids_) {
+    ids = std::forward<T_Lazy_ids_struct_setter>(ids_);
+    return ids;
+  }
+
+  template <class Protocol_>
+  uint32_t read(Protocol_* iprot);
+  template <class Protocol_>
+  uint32_t serializedSize(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t serializedSizeZC(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t write(Protocol_* prot_) const;
+
+ private:
+  template <class Protocol_>
+  void readNoXfer(Protocol_* iprot);
+
+  friend class ::apache::thrift::Cpp2Ops< Lazy >;
+  friend void swap(Lazy& a, Lazy& b);
+};
+
+template <class Protocol_>
+uint32_t Lazy::read(Protocol_* iprot) {
+  auto _xferStart = iprot->getCursorPosition();
+  readNoXfer(iprot);
+  return iprot->getCursorPosition() - _xferStart;
+}
+
+}} // some::ns
+namespace some { namespace ns {
+class LazyUnion final  {
+ private:
+  friend struct ::apache::thrift::detail::st::struct_private_access;
+
+  //  used by a static_assert in the corresponding source
+  static constexpr bool __fbthrift_cpp2_gen_json = false;
+  static constexpr bool __fbthrift_cpp2_gen_nimble = false;
+  static constexpr bool __fbthrift_cpp2_gen_has_thrift_uri = false;
+
+ public:
+  using __fbthrift_cpp2_type = LazyUnion;
+  static constexpr bool __fbthrift_cpp2_is_union =
+    true;
+
+
+ public:
+  enum Type : int {
+    __EMPTY__ = 0,
+    values = 1,
+    inner = 2,
+  } ;
+
+  LazyUnion()
+      : type_(Type::__EMPTY__) {}
+
+  LazyUnion(LazyUnion&& rhs)
+      : type_(Type::__EMPTY__) {
+    if (this == &rhs) { return; }
+    if (rhs.type_ == Type::__EMPTY__) { return; }
+    switch (rhs.type_) {
+      case Type::values:
+      {
+        set_values(std::move(rhs.value_.values));
+        break;
+      }
+      case Type::inner:
+      {
+        set_inner(std::move(rhs.value_.inner));
+        break;
+      }
+      default:
+      {
+        assert(false);
+        break;
+      }
+    }
+    rhs.__clear();
+  }
+
+  LazyUnion(const LazyUnion& rhs)
+      : type_(Type::__EMPTY__) {
+    if (this == &rhs) { return; }
+    if (rhs.type_ == Type::__EMPTY__) { return; }
+    switch (rhs.type_) {
+      case Type::values:
+      {
+        set_values(rhs.value_.values);
+        break;
+      }
+      case Type::inner:
+      {
+        set_inner(rhs.value_.inner);
+        break;
+      }
+      default:
+      {
+        assert(false);
+        break;
+      }
+    }
+  }
+
+  LazyUnion& operator=(LazyUnion&& rhs) {
+    if (this == &rhs) { return *this; }
+    __clear();
+    if (rhs.type_ == Type::__EMPTY__) { return *this; }
+    switch (rhs.type_) {
+      case Type::values:
+      {
+        set_values(std::move(rhs.value_.values));
+        break;
+      }
+      case Type::inner:
+      {
+        set_inner(std::move(rhs.value_.inner));
+        break;
+      }
+      default:
+      {
+        assert(false);
+        break;
+      }
+    }
+    rhs.__clear();
+    return *this;
+  }
+
+  LazyUnion& operator=(const LazyUnion& rhs) {
+    if (this == &rhs) { return *this; }
+    __clear();
+    if (rhs.type_ == Type::__EMPTY__) { return *this; }
+    switch (rhs.type_) {
+      case Type::values:
+      {
+        set_values(rhs.value_.values);
+        break;
+      }
+      case Type::inner:
+      {
+        set_inner(rhs.value_.inner);
+        break;
+      }
+      default:
+      {
+        assert(false);
+        break;
+      }
+    }
+    return *this;
+  }
+  void __clear();
+
+  ~LazyUnion() {
+    __clear();
+  }
+  union storage_type {
+    ::std::vector<int64_t> values;
+     ::some::ns::Inner inner;
+
+    storage_type() {}
+    ~storage_type() {}
+  } ;
+  bool operator==(const LazyUnion& rhs) const;
+#ifndef SWIG
+  friend bool operator!=(const LazyUnion& __x, const LazyUnion& __y) {
+    return !(__x == __y);
+  }
+#endif
+  bool operator<(const LazyUnion& rhs) const;
+#ifndef SWIG
+  friend bool operator>(const LazyUnion& __x, const LazyUnion& __y) {
+    return __y < __x;
+  }
+  friend bool operator<=(const LazyUnion& __x, const LazyUnion& __y) {
+    return !(__y < __x);
+  }
+  friend bool operator>=(const LazyUnion& __x, const LazyUnion& __y) {
+    return !(__x < __y);
+  }
+#endif
+
+  ::std::vector<int64_t>& set_values(::std::vector<int64_t> const &t) {
+    __clear();
+    type_ = Type::values;
+    ::new (std::addressof(value_.values)) ::std::vector<int64_t>(t);
+    return value_.values;
+  }
+
+  ::std::vector<int64_t>& set_values(::std::vector<int64_t>&& t) {
+    __clear();
+    type_ = Type::values;
+    ::new (std::addressof(value_.values)) ::std::vector<int64_t>(std::move(t));
+    return value_.values;
+  }
+
+  template<typename... T, typename = ::apache::thrift::safe_overload_t<::std::vector<int64_t>, T...>> ::std::vector<int64_t>& set_values(T&&... t) {
+    __clear();
+    type_ = Type::values;
+    ::new (std::addressof(value_.values)) ::std::vector<int64_t>(std::forward<T>(t)...);
+    return value_.values;
+  }
+
+   ::some::ns::Inner& set_inner( ::some::ns::Inner const &t) {
+    __clear();
+    type_ = Type::inner;
+    ::new (std::addressof(value_.inner))  ::some::ns::Inner(t);
+    return value_.inner;
+  }
+
+   ::some::ns::Inner& set_inner( ::some::ns::Inner&& t) {
+    __clear();
+    type_ = Type::inner;
+    ::new (std::addressof(value_.inner))  ::some::ns::Inner(std::move(t));
+    return value_.inner;
+  }
+
+  template<typename... T, typename = ::apache::thrift::safe_overload_t< ::some::ns::Inner, T...>>  ::some::ns::Inner& set_inner(T&&... t) {
+    __clear();
+    type_ = Type::inner;
+    ::new (std::addressof(value_.inner))  ::some::ns::Inner(std::forward<T>(t)...);
+    return value_.inner;
+  }
+
+  ::std::vector<int64_t> const & get_values() const {
+    assert(type_ == Type::values);
+    return value_.values;
+  }
+
+   ::some::ns::Inner const & get_inner() const {
+    assert(type_ == Type::inner);
+    return value_.inner;
+  }
+
+  ::std::vector<int64_t> & mutable_values() {
+    assert(type_ == Type::values);
+    return value_.values;
+  }
+
+   ::some::ns::Inner & mutable_inner() {
+    assert(type_ == Type::inner);
+    return value_.inner;
+  }
+
+  ::std::vector<int64_t> move_values() {
+    assert(type_ == Type::values);
+    return std::move(value_.values);
+  }
+
+   ::some::ns::Inner move_inner() {
+    assert(type_ == Type::inner);
+    return std::move(value_.inner);
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<const T&> values_ref() const& {
+    return {value_.values, type_, values, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<const T&&> values_ref() const&& {
+    return {std::move(value_.values), type_, values, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<T&> values_ref() & {
+    return {value_.values, type_, values, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T = ::std::vector<int64_t>>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<T&&> values_ref() && {
+    return {std::move(value_.values), type_, values, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<const T&> inner_ref() const& {
+    return {value_.inner, type_, inner, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<const T&&> inner_ref() const&& {
+    return {std::move(value_.inner), type_, inner, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<T&> inner_ref() & {
+    return {value_.inner, type_, inner, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+
+  template <typename..., typename T =  ::some::ns::Inner>
+  FOLLY_ERASE ::apache::thrift::union_field_ref<T&&> inner_ref() && {
+    return {std::move(value_.inner), type_, inner, this, ::apache::thrift::detail::union_field_ref_owner_vtable_for<decltype(*this)>};
+  }
+  Type getType() const { return static_cast<Type>(type_); }
+
+  template <class Protocol_>
+  uint32_t read(Protocol_* iprot);
+  template <class Protocol_>
+  uint32_t serializedSize(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t serializedSizeZC(Protocol_ const* prot_) const;
+  template <class Protocol_>
+  uint32_t write(Protocol_* prot_) const;
+ protected:
+  template <class T>
+  void destruct(T &val) {
+    (&val)->~T();
+  }
+
+  storage_type value_;
+  std::underlying_type_t<Type> type_;
+
+ private:
+  template <class Protocol_>
+  void readNoXfer(Protocol_* iprot);
+
+  friend class ::apache::thrift::Cpp2Ops< LazyUnion >;
+  friend void swap(LazyUnion& a, LazyUnion& b);
+};
+
+template <class Protocol_>
+uint32_t LazyUnion::read(Protocol_* iprot) {
+  auto _xferStart = iprot->getCursorPosition();
+  readNoXfer(iprot);
+  return iprot->getCursorPosition() - _xferStart;
+}
+
+}} // some::ns
+
+namespace apache { namespace thrift {
+
+template <> struct TEnumDataStorage<::some::ns::LazyUnion::Type>;
+
+template <> struct TEnumTraits<::some::ns::LazyUnion::Type> {
+  using type = ::some::ns::LazyUnion::Type;
+
+  static constexpr std::size_t const size = 2;
+  static folly::Range<type const*> const values;
+  static folly::Range<folly::StringPiece const*> const names;
+
+  static char const* findName(type value);
+  static bool findValue(char const* name, type* out);
+
+};
+}} // apache::thrift
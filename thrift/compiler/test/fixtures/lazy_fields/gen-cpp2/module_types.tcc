@@ -0,0 +1,622 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.h"
+
+#include <thrift/lib/cpp2/gen/module_types_tcc.h>
+
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+template <>
+struct TccStructTraits<::some::ns::Inner> {
+  static void translateFieldName(
+      folly::StringPiece _fname,
+      int16_t& fid,
+      apache::thrift::protocol::TType& _ftype) noexcept;
+};
+template <>
+struct TccStructTraits<::some::ns::Lazy> {
+  static void translateFieldName(
+      folly::StringPiece _fname,
+      int16_t& fid,
+      apache::thrift::protocol::TType& _ftype) noexcept;
+};
+template <>
+struct TccStructTraits<::some::ns::LazyUnion> {
+  static void translateFieldName(
+      folly::StringPiece _fname,
+      int16_t& fid,
+      apache::thrift::protocol::TType& _ftype) noexcept;
+};
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
+
+namespace some { namespace ns {
+
+template <class Protocol_>
+void Inner::readNoXfer(Protocol_* iprot) {
+  apache::thrift::detail::ProtocolReaderStructReadState<Protocol_> _readState;
+
+  _readState.readStructBegin(iprot);
+
+  using apache::thrift::TProtocolException;
+
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          0,
+          1,
+          apache::thrift::protocol::T_I32))) {
+    goto _loop;
+  }
+_readField_value:
+  {
+    ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->value, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.value = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          1,
+          0,
+          apache::thrift::protocol::T_STOP))) {
+    goto _loop;
+  }
+
+_end:
+  _readState.readStructEnd(iprot);
+
+  return;
+
+_loop:
+  _readState.afterAdvanceFailure(iprot);
+  if (_readState.atStop()) {
+    goto _end;
+  }
+  if (iprot->kUsesFieldNames()) {
+    _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<Inner>>();
+  }
+
+  switch (_readState.fieldId) {
+    case 1:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
+        goto _readField_value;
+      } else {
+        goto _skip;
+      }
+    }
+    default:
+    {
+_skip:
+      _readState.skip(iprot);
+      _readState.readFieldEnd(iprot);
+      _readState.readFieldBeginNoInline(iprot);
+      goto _loop;
+    }
+  }
+}
+
+template <class Protocol_>
+uint32_t Inner::serializedSize(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("Inner");
+  xfer += prot_->serializedFieldSize("value", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(*prot_, this->value);
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t Inner::serializedSizeZC(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("Inner");
+  xfer += prot_->serializedFieldSize("value", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(*prot_, this->value);
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t Inner::write(Protocol_* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->writeStructBegin("Inner");
+  xfer += prot_->writeFieldBegin("value", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::write(*prot_, this->value);
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldStop();
+  xfer += prot_->writeStructEnd();
+  return xfer;
+}
+
+extern template void Inner::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+extern template uint32_t Inner::write<>(apache::thrift::BinaryProtocolWriter*) const;
+extern template uint32_t Inner::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template uint32_t Inner::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template void Inner::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+extern template uint32_t Inner::write<>(apache::thrift::CompactProtocolWriter*) const;
+extern template uint32_t Inner::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+extern template uint32_t Inner::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+}} // some::ns
+namespace some { namespace ns {
+
+template <class Protocol_>
+void Lazy::readNoXfer(Protocol_* iprot) {
+  apache::thrift::detail::ProtocolReaderStructReadState<Protocol_> _readState;
+
+  _readState.readStructBegin(iprot);
+
+  using apache::thrift::TProtocolException;
+
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          0,
+          1,
+          apache::thrift::protocol::T_I32))) {
+    goto _loop;
+  }
+_readField_id:
+  {
+    ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->id, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.id = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          1,
+          2,
+          apache::thrift::protocol::T_LIST))) {
+    goto _loop;
+  }
+_readField_values:
+  {
+    _readState.beforeSubobject(iprot);
+    this->values = ::std::vector<int64_t>();
+    this->__fbthrift_lazy_values.read(*iprot, this->values, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.values = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+    _readState.afterSubobject(iprot);
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          2,
+          3,
+          apache::thrift::protocol::T_MAP))) {
+    goto _loop;
+  }
+_readField_byName:
+  {
+    _readState.beforeSubobject(iprot);
+    this->byName = ::std::map<::std::string,  ::some::ns::Inner>();
+    this->__fbthrift_lazy_byName.read(*iprot, this->byName, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.byName = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+    _readState.afterSubobject(iprot);
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          3,
+          4,
+          apache::thrift::protocol::T_STRUCT))) {
+    goto _loop;
+  }
+_readField_inner:
+  {
+    _readState.beforeSubobject(iprot);
+    this->__fbthrift_lazy_inner.read(*iprot, this->inner, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.inner = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+    _readState.afterSubobject(iprot);
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          4,
+          5,
+          apache::thrift::protocol::T_STRING))) {
+    goto _loop;
+  }
+_readField_name:
+  {
+    ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::string, ::std::string>::readWithContext(*iprot, this->name, _readState);
+    THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+    this->__isset.name = true;
+    THRIFT_IGNORE_ISSET_USE_WARNING_END
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          5,
+          6,
+          apache::thrift::protocol::T_LIST))) {
+    goto _loop;
+  }
+_readField_ids:
+  {
+    _readState.beforeSubobject(iprot);
+    this->ids = ::std::vector<int32_t>();
+    ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int32_t>>::readWithContext(*iprot, this->ids, _readState);
+    _readState.afterSubobject(iprot);
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          6,
+          7,
+          apache::thrift::protocol::T_STRUCT))) {
+    goto _loop;
+  }
+_readField_boxed:
+  {
+    _readState.beforeSubobject(iprot);
+    auto ptr = std::make_unique< ::some::ns::Inner>();
+    ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::readWithContext(*iprot, *ptr, _readState);
+    this->boxed = std::move(ptr);
+    _readState.afterSubobject(iprot);
+  }
+
+  if (UNLIKELY(!_readState.advanceToNextField(
+          iprot,
+          7,
+          0,
+          apache::thrift::protocol::T_STOP))) {
+    goto _loop;
+  }
+
+_end:
+  _readState.readStructEnd(iprot);
+
+  return;
+
+_loop:
+  _readState.afterAdvanceFailure(iprot);
+  if (_readState.atStop()) {
+    goto _end;
+  }
+  if (iprot->kUsesFieldNames()) {
+    _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<Lazy>>();
+  }
+
+  switch (_readState.fieldId) {
+    case 1:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
+        goto _readField_id;
+      } else {
+        goto _skip;
+      }
+    }
+    case 2:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
+        goto _readField_values;
+      } else {
+        goto _skip;
+      }
+    }
+    case 3:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
+        goto _readField_byName;
+      } else {
+        goto _skip;
+      }
+    }
+    case 4:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
+        goto _readField_inner;
+      } else {
+        goto _skip;
+      }
+    }
+    case 5:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
+        goto _readField_name;
+      } else {
+        goto _skip;
+      }
+    }
+    case 6:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
+        goto _readField_ids;
+      } else {
+        goto _skip;
+      }
+    }
+    case 7:
+    {
+      if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
+        goto _readField_boxed;
+      } else {
+        goto _skip;
+      }
+    }
+    default:
+    {
+_skip:
+      _readState.skip(iprot);
+      _readState.readFieldEnd(iprot);
+      _readState.readFieldBeginNoInline(iprot);
+      goto _loop;
+    }
+  }
+}
+
+template <class Protocol_>
+uint32_t Lazy::serializedSize(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("Lazy");
+  xfer += prot_->serializedFieldSize("id", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(*prot_, this->id);
+  xfer += prot_->serializedFieldSize("values", apache::thrift::protocol::T_LIST, 2);
+  xfer += this->__fbthrift_lazy_values.serializedSize<false>(*prot_, this->values);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  if (this->__isset.byName) {
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    xfer += prot_->serializedFieldSize("byName", apache::thrift::protocol::T_MAP, 3);
+    xfer += this->__fbthrift_lazy_byName.serializedSize<false>(*prot_, this->byName);
+  }
+  xfer += prot_->serializedFieldSize("inner", apache::thrift::protocol::T_STRUCT, 4);
+  xfer += this->__fbthrift_lazy_inner.serializedSize<false>(*prot_, this->inner);
+  xfer += prot_->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 5);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::string, ::std::string>::serializedSize<false>(*prot_, this->name);
+  xfer += prot_->serializedFieldSize("ids", apache::thrift::protocol::T_LIST, 6);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int32_t>>::serializedSize<false>(*prot_, this->ids);
+  xfer += prot_->serializedFieldSize("boxed", apache::thrift::protocol::T_STRUCT, 7);
+  if (this->boxed) {
+    xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::serializedSize<false>(*prot_, *this->boxed);
+  }
+  else {
+    xfer += prot_->serializedStructSize("Inner");
+    xfer += prot_->serializedSizeStop();
+  }
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t Lazy::serializedSizeZC(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("Lazy");
+  xfer += prot_->serializedFieldSize("id", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(*prot_, this->id);
+  xfer += prot_->serializedFieldSize("values", apache::thrift::protocol::T_LIST, 2);
+  xfer += this->__fbthrift_lazy_values.serializedSize<false>(*prot_, this->values);
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  if (this->__isset.byName) {
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    xfer += prot_->serializedFieldSize("byName", apache::thrift::protocol::T_MAP, 3);
+    xfer += this->__fbthrift_lazy_byName.serializedSize<false>(*prot_, this->byName);
+  }
+  xfer += prot_->serializedFieldSize("inner", apache::thrift::protocol::T_STRUCT, 4);
+  xfer += this->__fbthrift_lazy_inner.serializedSize<true>(*prot_, this->inner);
+  xfer += prot_->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 5);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::string, ::std::string>::serializedSize<false>(*prot_, this->name);
+  xfer += prot_->serializedFieldSize("ids", apache::thrift::protocol::T_LIST, 6);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int32_t>>::serializedSize<false>(*prot_, this->ids);
+  xfer += prot_->serializedFieldSize("boxed", apache::thrift::protocol::T_STRUCT, 7);
+  if (this->boxed) {
+    xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::serializedSize<true>(*prot_, *this->boxed);
+  }
+  else {
+    xfer += prot_->serializedStructSize("Inner");
+    xfer += prot_->serializedSizeStop();
+  }
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t Lazy::write(Protocol_* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->writeStructBegin("Lazy");
+  xfer += prot_->writeFieldBegin("id", apache::thrift::protocol::T_I32, 1);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::write(*prot_, this->id);
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldBegin("values", apache::thrift::protocol::T_LIST, 2);
+  xfer += this->__fbthrift_lazy_values.write(*prot_, this->values);
+  xfer += prot_->writeFieldEnd();
+THRIFT_IGNORE_ISSET_USE_WARNING_BEGIN
+  if (this->__isset.byName) {
+THRIFT_IGNORE_ISSET_USE_WARNING_END
+    xfer += prot_->writeFieldBegin("byName", apache::thrift::protocol::T_MAP, 3);
+    xfer += this->__fbthrift_lazy_byName.write(*prot_, this->byName);
+    xfer += prot_->writeFieldEnd();
+  }
+  xfer += prot_->writeFieldBegin("inner", apache::thrift::protocol::T_STRUCT, 4);
+  xfer += this->__fbthrift_lazy_inner.write(*prot_, this->inner);
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldBegin("name", apache::thrift::protocol::T_STRING, 5);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::string, ::std::string>::write(*prot_, this->name);
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldBegin("ids", apache::thrift::protocol::T_LIST, 6);
+  xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int32_t>>::write(*prot_, this->ids);
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldBegin("boxed", apache::thrift::protocol::T_STRUCT, 7);
+  if (this->boxed) {
+    xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::write(*prot_, *this->boxed);
+  }
+  else {
+    xfer += prot_->writeStructBegin("Inner");
+    xfer += prot_->writeStructEnd();
+    xfer += prot_->writeFieldStop();
+  }
+  xfer += prot_->writeFieldEnd();
+  xfer += prot_->writeFieldStop();
+  xfer += prot_->writeStructEnd();
+  return xfer;
+}
+
+extern template void Lazy::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+extern template uint32_t Lazy::write<>(apache::thrift::BinaryProtocolWriter*) const;
+extern template uint32_t Lazy::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template uint32_t Lazy::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template void Lazy::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+extern template uint32_t Lazy::write<>(apache::thrift::CompactProtocolWriter*) const;
+extern template uint32_t Lazy::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+extern template uint32_t Lazy::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+}} // some::ns
+namespace some { namespace ns {
+
+template <class Protocol_>
+void LazyUnion::readNoXfer(Protocol_* iprot) {
+  apache::thrift::detail::ProtocolReaderStructReadState<Protocol_> _readState;
+  _readState.fieldId = 0;
+
+  _readState.readStructBegin(iprot);
+
+  _readState.readFieldBegin(iprot);
+  if (_readState.atStop()) {
+    this->__clear();
+  } else {
+    if (iprot->kUsesFieldNames()) {
+      _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<LazyUnion>>();
+    }
+    switch (_readState.fieldId) {
+      case 1:
+      {
+        if (_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST)) {
+          this->set_values();
+          _readState.beforeSubobject(iprot);
+          this->mutable_values() = ::std::vector<int64_t>();
+          ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int64_t>>::readWithContext(*iprot, this->mutable_values(), _readState);
+          _readState.afterSubobject(iprot);
+        } else {
+          _readState.skip(iprot);
+        }
+        break;
+      }
+      case 2:
+      {
+        if (_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT)) {
+          this->set_inner();
+          _readState.beforeSubobject(iprot);
+          ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::readWithContext(*iprot, this->mutable_inner(), _readState);
+          _readState.afterSubobject(iprot);
+        } else {
+          _readState.skip(iprot);
+        }
+        break;
+      }
+      default:
+      {
+        _readState.skip(iprot);
+        break;
+      }
+    }
+    _readState.readFieldEnd(iprot);
+    _readState.readFieldBegin(iprot);
+    if (UNLIKELY(!_readState.atStop())) {
+      using apache::thrift::protocol::TProtocolException;
+      TProtocolException::throwUnionMissingStop();
+    }
+  }
+  _readState.readStructEnd(iprot);
+}
+template <class Protocol_>
+uint32_t LazyUnion::serializedSize(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("LazyUnion");
+  switch(this->getType()) {
+    case LazyUnion::Type::values:
+    {
+      xfer += prot_->serializedFieldSize("values", apache::thrift::protocol::T_LIST, 1);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int64_t>>::serializedSize<false>(*prot_, this->get_values());
+      break;
+    }
+    case LazyUnion::Type::inner:
+    {
+      xfer += prot_->serializedFieldSize("inner", apache::thrift::protocol::T_STRUCT, 2);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::serializedSize<false>(*prot_, this->get_inner());
+      break;
+    }
+    case LazyUnion::Type::__EMPTY__:;
+  }
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t LazyUnion::serializedSizeZC(Protocol_ const* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->serializedStructSize("LazyUnion");
+  switch(this->getType()) {
+    case LazyUnion::Type::values:
+    {
+      xfer += prot_->serializedFieldSize("values", apache::thrift::protocol::T_LIST, 1);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int64_t>>::serializedSize<false>(*prot_, this->get_values());
+      break;
+    }
+    case LazyUnion::Type::inner:
+    {
+      xfer += prot_->serializedFieldSize("inner", apache::thrift::protocol::T_STRUCT, 2);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::serializedSize<true>(*prot_, this->get_inner());
+      break;
+    }
+    case LazyUnion::Type::__EMPTY__:;
+  }
+  xfer += prot_->serializedSizeStop();
+  return xfer;
+}
+
+template <class Protocol_>
+uint32_t LazyUnion::write(Protocol_* prot_) const {
+  uint32_t xfer = 0;
+  xfer += prot_->writeStructBegin("LazyUnion");
+  switch(this->getType()) {
+    case LazyUnion::Type::values:
+    {
+      xfer += prot_->writeFieldBegin("values", apache::thrift::protocol::T_LIST, 1);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::list<::apache::thrift::type_class::integral>, ::std::vector<int64_t>>::write(*prot_, this->get_values());
+      xfer += prot_->writeFieldEnd();
+      break;
+    }
+    case LazyUnion::Type::inner:
+    {
+      xfer += prot_->writeFieldBegin("inner", apache::thrift::protocol::T_STRUCT, 2);
+      xfer += ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::structure,  ::some::ns::Inner>::write(*prot_, this->get_inner());
+      xfer += prot_->writeFieldEnd();
+      break;
+    }
+    case LazyUnion::Type::__EMPTY__:;
+  }
+  xfer += prot_->writeFieldStop();
+  xfer += prot_->writeStructEnd();
+  return xfer;
+}
+
+extern template void LazyUnion::readNoXfer<>(apache::thrift::BinaryProtocolReader*);
+extern template uint32_t LazyUnion::write<>(apache::thrift::BinaryProtocolWriter*) const;
+extern template uint32_t LazyUnion::serializedSize<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template uint32_t LazyUnion::serializedSizeZC<>(apache::thrift::BinaryProtocolWriter const*) const;
+extern template void LazyUnion::readNoXfer<>(apache::thrift::CompactProtocolReader*);
+extern template uint32_t LazyUnion::write<>(apache::thrift::CompactProtocolWriter*) const;
+extern template uint32_t LazyUnion::serializedSize<>(apache::thrift::CompactProtocolWriter const*) const;
+extern template uint32_t LazyUnion::serializedSizeZC<>(apache::thrift::CompactProtocolWriter const*) const;
+
+}} // some::ns
@@ -0,0 +1,18 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+
+/**
+ * This header file includes the tcc files of the corresponding header file
+ * and the header files of its dependent types. Include this header file
+ * only when you need to use custom protocols (e.g. DebugProtocol,
+ * VirtualProtocol) to read/write thrift structs.
+ */
+
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_types.tcc"
+
@@ -0,0 +1,70 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+
+#include <thrift/lib/cpp2/visitation/visit_by_thrift_field_metadata.h>
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_metadata.h"
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+template <>
+struct VisitByThriftId<::some::ns::Inner> {
+  template <typename F, typename T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, size_t id, FOLLY_MAYBE_UNUSED T&& t) const {
+    switch (id) {
+    case 1:
+      return f(0, static_cast<T&&>(t).value_ref());
+    default:
+      throwInvalidThriftId(id, "::some::ns::Inner");
+    }
+  }
+};
+
+template <>
+struct VisitByThriftId<::some::ns::Lazy> {
+  template <typename F, typename T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, size_t id, FOLLY_MAYBE_UNUSED T&& t) const {
+    switch (id) {
+    case 1:
+      return f(0, static_cast<T&&>(t).id_ref());
+    case 2:
+      return f(1, static_cast<T&&>(t).values_ref());
+    case 3:
+      return f(2, static_cast<T&&>(t).byName_ref());
+    case 4:
+      return f(3, static_cast<T&&>(t).inner_ref());
+    case 5:
+      return f(4, static_cast<T&&>(t).name_ref());
+    case 6:
+      return f(5, static_cast<T&&>(t).ids_ref());
+    case 7:
+      return f(6, static_cast<T&&>(t).boxed_ref());
+    default:
+      throwInvalidThriftId(id, "::some::ns::Lazy");
+    }
+  }
+};
+
+template <>
+struct VisitByThriftId<::some::ns::LazyUnion> {
+  template <typename F, typename T>
+  void operator()(FOLLY_MAYBE_UNUSED F&& f, size_t id, FOLLY_MAYBE_UNUSED T&& t) const {
+    switch (id) {
+    case 1:
+      return f(0, static_cast<T&&>(t).values_ref());
+    case 2:
+      return f(1, static_cast<T&&>(t).inner_ref());
+    default:
+      throwInvalidThriftId(id, "::some::ns::LazyUnion");
+    }
+  }
+};
+} // namespace detail
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,9 @@
+/**
+ * Autogenerated by Thrift for src/module.thrift
+ *
+ * DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+ *  @generated
+ */
+#pragma once
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_for_each_field.h"
+#include "thrift/compiler/test/fixtures/lazy_fields/gen-cpp2/module_visit_union.h"
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace cpp2 some.ns
+
+struct Inner {
+  1: i32 value;
+}
+
+struct Lazy {
+  1: i32 id;
+  2: list<i64> values (cpp.experimental.lazy);
+  3: optional map<string, Inner> byName (cpp.experimental.lazy);
+  4: Inner inner (cpp.experimental.lazy);
+  # Stay eager: scalars, required fields and references.
+  5: string name (cpp.experimental.lazy);
+  6: required list<i32> ids (cpp.experimental.lazy);
+  7: Inner boxed (cpp.experimental.lazy, cpp.ref_type = "unique");
+}
+
+union LazyUnion {
+  1: list<i64> values (cpp.experimental.lazy);
+  2: Inner inner (cpp.experimental.lazy);
+}
@@ -64,7 +64,9 @@ class EmptyServiceAsyncProcessor : public ::apache::thrift::GeneratedAsyncProces
  private:
   static const EmptyServiceAsyncProcessor::ProcessMap binaryProcessMap_;
   static const EmptyServiceAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
  public:
   EmptyServiceAsyncProcessor(EmptyServiceSvIf* iface) :
       iface_(iface) {}
@@ -102,7 +102,9 @@ class NestedContainersAsyncProcessor : public ::apache::thrift::GeneratedAsyncPr
  private:
   static const NestedContainersAsyncProcessor::ProcessMap binaryProcessMap_;
   static const NestedContainersAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_mapList(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
@@ -93,7 +93,9 @@ class PubSubStreamingServiceAsyncProcessor : public ::apache::thrift::GeneratedA
  private:
   static const PubSubStreamingServiceAsyncProcessor::ProcessMap binaryProcessMap_;
   static const PubSubStreamingServiceAsyncProcessor::ProcessMap compactProcessMap_;
- private:
+ protected:
+  // Protected so that the processors of services extending this one can
+  // list these methods in their own process maps.
   template <typename ProtocolIn_, typename ProtocolOut_>
   void setUpAndProcess_returnstream(apache::thrift::ResponseChannelRequest::UniquePtr req, apache::thrift::SerializedRequest&& serializedRequest, apache::thrift::Cpp2RequestContext* ctx, folly::EventBase* eb, apache::thrift::concurrency::ThreadManager* tm);
   template <typename ProtocolIn_, typename ProtocolOut_>
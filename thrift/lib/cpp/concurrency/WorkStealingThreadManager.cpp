@@ -0,0 +1,847 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp/concurrency/WorkStealingThreadManager.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <glog/logging.h>
+
+#include <folly/Conv.h>
+#include <folly/ExceptionString.h>
+#include <folly/GLog.h>
+#include <folly/Random.h>
+#include <folly/lang/Bits.h>
+#include <folly/lang/Align.h>
+#include <folly/io/async/Request.h>
+#include <folly/tracing/StaticTracepoint.h>
+
+#include <thrift/lib/cpp/concurrency/Exception.h>
+#include <thrift/lib/cpp/concurrency/FunctionRunner.h>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+namespace {
+
+constexpr size_t kNumLanes = N_PRIORITIES * ThreadManager::N_SOURCES;
+static_assert(kNumLanes <= 32, "lane masks are 32 bits wide");
+
+size_t laneOf(PRIORITY priority, ThreadManager::Source source) {
+  DCHECK(priority < N_PRIORITIES);
+  return static_cast<size_t>(priority) * ThreadManager::N_SOURCES +
+      static_cast<size_t>(source);
+}
+
+PRIORITY priorityOf(size_t lane) {
+  return static_cast<PRIORITY>(lane / ThreadManager::N_SOURCES);
+}
+
+bool isUpstreamLane(size_t lane) {
+  return lane % ThreadManager::N_SOURCES !=
+      static_cast<size_t>(ThreadManager::Source::INTERNAL);
+}
+
+/* Translates from wangle priorities (normal at 0, higher is higher)
+   to thrift priorities */
+PRIORITY translatePriority(int8_t priority) {
+  if (priority >= 3) {
+    return PRIORITY::HIGH_IMPORTANT;
+  } else if (priority == 2) {
+    return PRIORITY::HIGH;
+  } else if (priority == 1) {
+    return PRIORITY::IMPORTANT;
+  } else if (priority == 0) {
+    return PRIORITY::NORMAL;
+  }
+  return PRIORITY::BEST_EFFORT;
+}
+
+// The worker running on the current thread, if any.
+struct CurrentWorker {
+  const WorkStealingThreadManager* manager{nullptr};
+  size_t index{0};
+};
+thread_local CurrentWorker currentWorker;
+
+} // namespace
+
+class WorkStealingThreadManager::Task {
+ public:
+  Task(
+      std::shared_ptr<Runnable> runnable,
+      const std::chrono::milliseconds& expiration,
+      size_t lane)
+      : runnable_(std::move(runnable)),
+        queueBeginTime_(std::chrono::steady_clock::now()),
+        expireTime_(
+            expiration > std::chrono::milliseconds::zero()
+                ? queueBeginTime_ + expiration
+                : std::chrono::steady_clock::time_point()),
+        context_(folly::RequestContext::saveContext()),
+        lane_(lane) {}
+
+  void run() {
+    folly::RequestContextScopeGuard rctx(context_);
+    runnable_->run();
+  }
+
+  const std::shared_ptr<Runnable>& getRunnable() const {
+    return runnable_;
+  }
+
+  std::chrono::steady_clock::time_point getExpireTime() const {
+    return expireTime_;
+  }
+
+  std::chrono::steady_clock::time_point getQueueBeginTime() const {
+    return queueBeginTime_;
+  }
+
+  bool canExpire() const {
+    return expireTime_ != std::chrono::steady_clock::time_point();
+  }
+
+  const std::shared_ptr<folly::RequestContext>& getContext() const {
+    return context_;
+  }
+
+  size_t lane() const {
+    return lane_;
+  }
+
+ private:
+  std::shared_ptr<Runnable> runnable_;
+  std::chrono::steady_clock::time_point queueBeginTime_;
+  std::chrono::steady_clock::time_point expireTime_;
+  std::shared_ptr<folly::RequestContext> context_;
+  size_t lane_;
+};
+
+// A worker's local queue. The owner and thieves both take the oldest task of
+// the highest-priority lane; the lock is only contended while stealing.
+struct alignas(folly::hardware_destructive_interference_size)
+    WorkStealingThreadManager::WorkerQueue {
+  // Bit i is set while lanes[i] is non-empty. Only written under lock, read
+  // without it to skip empty queues.
+  std::atomic<uint32_t> nonEmpty{0};
+  std::atomic<size_t> size{0};
+  // Set by removeWorker() to ask the owner of this queue to exit.
+  std::atomic<bool> stopRequested{false};
+  folly::MicroSpinLock lock{0};
+  std::array<std::deque<std::unique_ptr<Task>>, kNumLanes> lanes;
+
+  void push(std::unique_ptr<Task> task) {
+    auto const lane = task->lane();
+    folly::MSLGuard g(lock);
+    lanes[lane].push_back(std::move(task));
+    size.fetch_add(1, std::memory_order_relaxed);
+    nonEmpty.store(
+        nonEmpty.load(std::memory_order_relaxed) | (1u << lane),
+        std::memory_order_seq_cst);
+  }
+
+  std::unique_ptr<Task> pop() {
+    if (nonEmpty.load(std::memory_order_seq_cst) == 0) {
+      return nullptr;
+    }
+    folly::MSLGuard g(lock);
+    auto const mask = nonEmpty.load(std::memory_order_relaxed);
+    if (mask == 0) {
+      return nullptr;
+    }
+    auto const lane = folly::findFirstSet(mask) - 1;
+    auto& q = lanes[lane];
+    auto task = std::move(q.front());
+    q.pop_front();
+    if (q.empty()) {
+      nonEmpty.store(mask & ~(1u << lane), std::memory_order_relaxed);
+    }
+    size.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  size_t upstreamSize() {
+    folly::MSLGuard g(lock);
+    size_t count = 0;
+    for (size_t lane = 0; lane < kNumLanes; ++lane) {
+      if (isUpstreamLane(lane)) {
+        count += lanes[lane].size();
+      }
+    }
+    return count;
+  }
+};
+
+class WorkStealingThreadManager::Worker : public Runnable {
+ public:
+  Worker(WorkStealingThreadManager& manager, size_t index)
+      : manager_(manager), index_(index) {}
+
+  /**
+   * Worker entry point
+   *
+   * Runs tasks from the local queue, or stolen from other workers, until
+   * asked to exit.
+   */
+  void run() override {
+    manager_.workerStarted(*this);
+    currentWorker = {&manager_, index_};
+
+    while (auto task = manager_.waitOnTask(index_)) {
+      manager_.runTask(*task);
+    }
+
+    currentWorker = {};
+    manager_.workerExiting(*this);
+  }
+
+  size_t index() const {
+    return index_;
+  }
+
+ private:
+  WorkStealingThreadManager& manager_;
+  const size_t index_;
+};
+
+class WorkStealingThreadManager::LaneExecutor : public folly::Executor {
+ public:
+  LaneExecutor(
+      WorkStealingThreadManager& manager,
+      PRIORITY priority,
+      Source source)
+      : manager_(manager), priority_(priority), source_(source) {}
+
+  void add(folly::Func f) override {
+    manager_.add(
+        priority_, FunctionRunner::create(std::move(f)), 0, 0, source_);
+  }
+
+  bool keepAliveAcquire() noexcept override {
+    return Executor::keepAliveAcquire(&manager_);
+  }
+
+  void keepAliveRelease() noexcept override {
+    Executor::keepAliveRelease(&manager_);
+  }
+
+ private:
+  WorkStealingThreadManager& manager_;
+  const PRIORITY priority_;
+  const Source source_;
+};
+
+WorkStealingThreadManager::WorkStealingThreadManager(
+    size_t numWorkers,
+    bool enableTaskStats,
+    size_t maxWorkers)
+    : numWorkers_(numWorkers),
+      enableTaskStats_(enableTaskStats),
+      codelEnabled_(FLAGS_codel_enabled),
+      threadFactory_(Factory(PosixThreadFactory::NORMAL_PRI)) {
+  auto const numQueues = std::max(numWorkers, maxWorkers);
+  CHECK_GT(numQueues, 0) << "WorkStealingThreadManager needs a worker";
+  queues_.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  executors_.reserve(kNumLanes);
+  for (int i = 0; i < N_PRIORITIES; ++i) {
+    for (int j = 0; j < N_SOURCES; ++j) {
+      executors_.push_back(std::make_unique<LaneExecutor>(
+          *this, static_cast<PRIORITY>(i), static_cast<Source>(j)));
+    }
+  }
+  setSeriesNames();
+}
+
+WorkStealingThreadManager::~WorkStealingThreadManager() {
+  stop();
+}
+
+void WorkStealingThreadManager::joinKeepAliveOnce() {
+  if (!std::exchange(keepAliveJoined_, true)) {
+    joinKeepAlive();
+  }
+}
+
+void WorkStealingThreadManager::start() {
+  std::unique_lock<std::mutex> sl(stateUpdateMutex_);
+  std::unique_lock<std::mutex> l(mutex_);
+
+  if (state_ != UNINITIALIZED) {
+    return;
+  }
+  if (threadFactory_ == nullptr) {
+    throw InvalidArgumentException();
+  }
+  state_ = STARTED;
+  addWorkerImpl(l, numWorkers_);
+}
+
+void WorkStealingThreadManager::stop() {
+  stopImpl(false);
+}
+
+void WorkStealingThreadManager::join() {
+  stopImpl(true);
+}
+
+void WorkStealingThreadManager::stopImpl(bool joinArg) {
+  std::unique_lock<std::mutex> sl(stateUpdateMutex_);
+
+  if (state_ == UNINITIALIZED) {
+    // Never started, just ignore the stop() call.
+    joinKeepAliveOnce();
+    state_ = STOPPED;
+  } else if (state_ == STARTED) {
+    joinKeepAliveOnce();
+    std::unique_lock<std::mutex> l(mutex_);
+    state_ = joinArg ? JOINING : STOPPING;
+    removeWorkerImpl(l, activeWorkers_.load(), joinArg);
+    // Drop whatever did not get to run.
+    for (auto& queue : queues_) {
+      while (queue->pop()) {
+      }
+    }
+    state_ = STOPPED;
+  }
+
+  DCHECK_EQ(workerCount_, 0);
+}
+
+ThreadManager::STATE WorkStealingThreadManager::state() const {
+  return state_;
+}
+
+std::shared_ptr<ThreadFactory> WorkStealingThreadManager::threadFactory()
+    const {
+  std::unique_lock<std::mutex> l(mutex_);
+  return threadFactory_;
+}
+
+void WorkStealingThreadManager::threadFactory(
+    std::shared_ptr<ThreadFactory> value) {
+  std::unique_lock<std::mutex> l(mutex_);
+  threadFactory_ = std::move(value);
+}
+
+std::string WorkStealingThreadManager::getNamePrefix() const {
+  std::unique_lock<std::mutex> l(mutex_);
+  return namePrefix_;
+}
+
+void WorkStealingThreadManager::setNamePrefix(const std::string& name) {
+  std::unique_lock<std::mutex> l(mutex_);
+  namePrefix_ = name;
+  setSeriesNames();
+}
+
+void WorkStealingThreadManager::setSeriesNames() {
+  for (int i = 0; i < N_PRIORITIES; ++i) {
+    seriesNames_[i] = folly::to<std::string>(namePrefix_, "-pri", i);
+  }
+}
+
+void WorkStealingThreadManager::addWorker(size_t value) {
+  std::unique_lock<std::mutex> l(mutex_);
+  addWorkerImpl(l, value);
+}
+
+void WorkStealingThreadManager::addWorkerImpl(
+    std::unique_lock<std::mutex>& lock,
+    size_t value) {
+  DCHECK(lock.owns_lock());
+  if (state_ != STARTED) {
+    throw IllegalStateException(
+        "WorkStealingThreadManager::addWorker(): "
+        "ThreadManager not running");
+  }
+  if (activeWorkers_.load() + value > queues_.size()) {
+    throw InvalidArgumentException();
+  }
+
+  for (size_t ix = 0; ix < value; ++ix) {
+    auto const index = activeWorkers_.load();
+    queues_[index]->stopRequested.store(false);
+    auto worker = std::make_shared<Worker>(*this, index);
+    auto thread = threadFactory_->newThread(worker, ThreadFactory::ATTACHED);
+    // Counted as idle until it calls workerStarted().
+    ++idleCount_;
+    try {
+      thread->start();
+    } catch (...) {
+      --idleCount_;
+      throw;
+    }
+    ++workerCount_;
+    activeWorkers_.store(index + 1);
+    if (usedQueues_.load() <= index) {
+      usedQueues_.store(index + 1);
+    }
+  }
+}
+
+void WorkStealingThreadManager::removeWorker(size_t value) {
+  std::unique_lock<std::mutex> l(mutex_);
+  removeWorkerImpl(l, value, false);
+}
+
+void WorkStealingThreadManager::removeWorkerImpl(
+    std::unique_lock<std::mutex>& lock,
+    size_t value,
+    bool afterTasks) {
+  DCHECK(lock.owns_lock());
+  // afterTasks is carried by state_ == JOINING: workers then only exit once
+  // they find nothing left to run.
+  DCHECK(!afterTasks || state_ == JOINING);
+
+  auto const active = activeWorkers_.load();
+  if (value > active) {
+    throw InvalidArgumentException();
+  }
+  // Stop routing new tasks to the workers going away before asking them to
+  // exit, so that they can hand their queues over to the remaining ones.
+  activeWorkers_.store(active - value);
+  for (size_t i = active - value; i < active; ++i) {
+    queues_[i]->stopRequested.store(true);
+  }
+  wakeAll();
+
+  for (size_t n = 0; n < value; ++n) {
+    deadWorkerCond_.wait(lock, [&] { return !deadWorkers_.empty(); });
+    auto thread = std::move(deadWorkers_.front());
+    deadWorkers_.pop_front();
+    thread->join();
+  }
+}
+
+void WorkStealingThreadManager::wakeAll() {
+  // Pairs with the fence in waitOnTask(): a worker that is not counted as
+  // idle here sees the change before it goes to sleep.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (auto const idle = idleCount_.load()) {
+    waitSem_.post(idle);
+  }
+}
+
+void WorkStealingThreadManager::workerStarted(Worker& worker) {
+  InitCallback initCallback;
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    DCHECK_GT(idleCount_.load(), 0);
+    --idleCount_;
+    initCallback = initCallback_;
+    if (!namePrefix_.empty()) {
+      worker.thread()->setName(
+          folly::to<std::string>(namePrefix_, "-", ++namePrefixCounter_));
+    }
+  }
+
+  if (initCallback) {
+    initCallback();
+  }
+}
+
+void WorkStealingThreadManager::workerExiting(Worker& worker) {
+  // Hand whatever is still queued here to the remaining workers. When the
+  // whole manager is stopping there are none, and stopImpl() drops the tasks.
+  auto& queue = *queues_[worker.index()];
+  auto const active = activeWorkers_.load();
+  if (active > 0) {
+    size_t moved = 0;
+    while (auto task = queue.pop()) {
+      queues_[folly::Random::rand32(active)]->push(std::move(task));
+      ++moved;
+    }
+    if (moved > 0) {
+      waitSem_.post(std::min(moved, active));
+    }
+  }
+
+  std::unique_lock<std::mutex> l(mutex_);
+  --workerCount_;
+  deadWorkers_.push_back(worker.thread());
+  deadWorkerCond_.notify_one();
+}
+
+std::unique_ptr<WorkStealingThreadManager::Task>
+WorkStealingThreadManager::waitOnTask(size_t self) {
+  auto& queue = *queues_[self];
+  while (true) {
+    bool const stopping = queue.stopRequested.load();
+    if (stopping && state_ != JOINING) {
+      return nullptr;
+    }
+    if (auto task = findTask(self)) {
+      return task;
+    }
+    if (stopping) {
+      // Joining, and nothing is left to run.
+      return nullptr;
+    }
+
+    ++idleCount_;
+    // Pairs with the fences in add() and wakeAll(): either they see this
+    // worker as idle and post, or the re-checks below see the new task or the
+    // stop request.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (auto task = findTask(self)) {
+      --idleCount_;
+      return task;
+    }
+    if (!queue.stopRequested.load()) {
+      waitSem_.wait();
+    }
+    --idleCount_;
+  }
+}
+
+std::unique_ptr<WorkStealingThreadManager::Task>
+WorkStealingThreadManager::findTask(size_t self) {
+  if (auto task = queues_[self]->pop()) {
+    return task;
+  }
+  return steal(self);
+}
+
+std::unique_ptr<WorkStealingThreadManager::Task>
+WorkStealingThreadManager::steal(size_t self) {
+  auto const n = usedQueues_.load();
+  while (true) {
+    // Pick the queue whose best lane has the highest priority, starting at a
+    // random queue so that thieves spread out.
+    size_t victim = n;
+    size_t bestLane = kNumLanes;
+    size_t idx = n > 1 ? folly::Random::rand32(n) : 0;
+    for (size_t i = 0; i < n; ++i, ++idx) {
+      if (idx == n) {
+        idx = 0;
+      }
+      if (idx == self) {
+        continue;
+      }
+      auto const mask = queues_[idx]->nonEmpty.load(std::memory_order_seq_cst);
+      if (mask == 0) {
+        continue;
+      }
+      size_t const lane = folly::findFirstSet(mask) - 1;
+      if (lane < bestLane) {
+        bestLane = lane;
+        victim = idx;
+        if (lane == 0) {
+          break;
+        }
+      }
+    }
+    if (victim == n) {
+      return nullptr;
+    }
+    // Another worker may have drained the victim since the scan; that worker
+    // made progress, so just scan again.
+    if (auto task = queues_[victim]->pop()) {
+      stolenCount_.fetch_add(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+}
+
+void WorkStealingThreadManager::runTask(Task& task) {
+  auto startTime = std::chrono::steady_clock::now();
+
+  // Codel auto-expire time algorithm
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+      startTime - task.getQueueBeginTime());
+  if (task.canExpire() && codel_.overloaded(delay)) {
+    if (codelCallback_) {
+      codelCallback_(task.getRunnable());
+    }
+    if (codelEnabled_) {
+      FB_LOG_EVERY_MS(WARNING, 10000) << "Queueing delay timeout";
+      onTaskExpired(task);
+      return;
+    }
+  }
+
+  if (observer_) {
+    // Hold lock to ensure that observer_ does not get deleted
+    folly::SharedMutex::ReadHolder g(observerLock_);
+    if (observer_) {
+      observer_->preRun(task.getContext().get());
+    }
+  }
+
+  // Check if the task is expired
+  if (task.canExpire() && task.getExpireTime() <= startTime) {
+    onTaskExpired(task);
+    return;
+  }
+
+  try {
+    task.run();
+  } catch (const std::exception& ex) {
+    LOG(ERROR) << "worker task threw unhandled " << folly::exceptionStr(ex);
+  } catch (...) {
+    LOG(ERROR) << "worker task threw unhandled "
+               << folly::exceptionStr(std::current_exception());
+  }
+
+  reportTaskStats(task, startTime, std::chrono::steady_clock::now());
+}
+
+void WorkStealingThreadManager::reportTaskStats(
+    const Task& task,
+    const std::chrono::steady_clock::time_point& workBegin,
+    const std::chrono::steady_clock::time_point& workEnd) {
+  auto queueBegin = task.getQueueBeginTime();
+  auto waitTime = workBegin - queueBegin;
+  auto runTime = workEnd - workBegin;
+
+  // Same probe as ThreadManager::Impl, see there for the units.
+  FOLLY_SDT(
+      thrift,
+      thread_manager_task_stats,
+      namePrefix_.c_str(),
+      task.getContext() ? task.getContext()->getRootId() : 0,
+      queueBegin.time_since_epoch().count(),
+      waitTime.count(),
+      runTime.count());
+
+  if (enableTaskStats_) {
+    folly::MSLGuard g(statsLock_);
+    waitingTimeUs_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(waitTime);
+    executingTimeUs_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(runTime);
+    ++numTasks_;
+  }
+
+  // Optimistic check lock free
+  if (observer_) {
+    // Hold lock to ensure that observer_ does not get deleted.
+    folly::SharedMutex::ReadHolder g(observerLock_);
+    if (observer_) {
+      observer_->postRun(
+          task.getContext().get(),
+          {seriesNames_[priorityOf(task.lane())],
+           queueBegin,
+           workBegin,
+           workEnd});
+    }
+  }
+}
+
+void WorkStealingThreadManager::onTaskExpired(const Task& task) {
+  ExpireCallback expireCallback;
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    expiredCount_++;
+    expireCallback = expireCallback_;
+  }
+
+  if (expireCallback) {
+    // Expired callback should _not_ be called holding mutex_
+    expireCallback(task.getRunnable());
+  }
+}
+
+size_t WorkStealingThreadManager::idleWorkerCount() const {
+  return idleCount_;
+}
+
+size_t WorkStealingThreadManager::workerCount() const {
+  std::unique_lock<std::mutex> l(mutex_);
+  return workerCount_;
+}
+
+size_t WorkStealingThreadManager::pendingTaskCount() const {
+  size_t count = 0;
+  auto const n = usedQueues_.load();
+  for (size_t i = 0; i < n; ++i) {
+    count += queues_[i]->size.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+size_t WorkStealingThreadManager::pendingUpstreamTaskCount() const {
+  size_t count = 0;
+  auto const n = usedQueues_.load();
+  for (size_t i = 0; i < n; ++i) {
+    count += queues_[i]->upstreamSize();
+  }
+  return count;
+}
+
+size_t WorkStealingThreadManager::totalTaskCount() const {
+  auto const workers = workerCount();
+  auto const idle = std::min(workers, idleWorkerCount());
+  return pendingTaskCount() + (workers - idle);
+}
+
+size_t WorkStealingThreadManager::expiredTaskCount() {
+  std::unique_lock<std::mutex> l(mutex_);
+  return std::exchange(expiredCount_, 0);
+}
+
+size_t WorkStealingThreadManager::stolenTaskCount() const {
+  return stolenCount_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingThreadManager::add(
+    std::shared_ptr<Runnable> task,
+    int64_t timeout,
+    int64_t expiration,
+    Source source) noexcept {
+  add(PRIORITY::NORMAL, std::move(task), timeout, expiration, source);
+}
+
+void WorkStealingThreadManager::add(
+    PRIORITY priority,
+    std::shared_ptr<Runnable> value,
+    int64_t /*timeout*/,
+    int64_t expiration,
+    Source source) noexcept {
+  auto const state = state_.load();
+  CHECK(state != UNINITIALIZED && state != STARTING)
+      << "WorkStealingThreadManager::add ThreadManager not started";
+
+  if (state != STARTED) {
+    LOG(WARNING) << "abort add() that got called after join() or stop()";
+    return;
+  }
+
+  auto task = std::make_unique<Task>(
+      std::move(value),
+      std::chrono::milliseconds{expiration},
+      laneOf(priority, source));
+
+  // Tasks added from a worker stay on that worker, others are spread out.
+  size_t index;
+  if (currentWorker.manager == this) {
+    index = currentWorker.index;
+  } else {
+    auto const active = activeWorkers_.load(std::memory_order_relaxed);
+    index = active > 1 ? folly::Random::rand32(active) : 0;
+  }
+  queues_[index]->push(std::move(task));
+
+  // Pairs with the fence in waitOnTask().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idleCount_.load(std::memory_order_relaxed) > 0) {
+    waitSem_.post();
+  }
+}
+
+void WorkStealingThreadManager::add(folly::Func f) {
+  add(FunctionRunner::create(std::move(f)));
+}
+
+void WorkStealingThreadManager::addWithPriority(
+    folly::Func f,
+    int8_t priority) {
+  add(
+      translatePriority(priority),
+      FunctionRunner::create(std::move(f)),
+      0,
+      0,
+      Source::INTERNAL);
+}
+
+void WorkStealingThreadManager::remove(std::shared_ptr<Runnable> /*task*/) {
+  throw IllegalStateException(
+      "WorkStealingThreadManager::remove() not implemented");
+}
+
+std::shared_ptr<Runnable> WorkStealingThreadManager::removeNextPending() {
+  if (state_ != STARTED) {
+    throw IllegalStateException(
+        "WorkStealingThreadManager::removeNextPending "
+        "ThreadManager not started");
+  }
+
+  auto const n = usedQueues_.load();
+  for (size_t i = 0; i < n; ++i) {
+    if (auto task = queues_[i]->pop()) {
+      return task->getRunnable();
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingThreadManager::clearPending() {
+  while (removeNextPending() != nullptr) {
+  }
+}
+
+void WorkStealingThreadManager::setExpireCallback(
+    ExpireCallback expireCallback) {
+  std::unique_lock<std::mutex> l(mutex_);
+  expireCallback_ = std::move(expireCallback);
+}
+
+void WorkStealingThreadManager::setCodelCallback(
+    ExpireCallback expireCallback) {
+  codelCallback_ = std::move(expireCallback);
+}
+
+void WorkStealingThreadManager::setThreadInitCallback(
+    InitCallback initCallback) {
+  std::unique_lock<std::mutex> l(mutex_);
+  initCallback_ = std::move(initCallback);
+}
+
+void WorkStealingThreadManager::getStats(
+    std::chrono::microseconds& waitTime,
+    std::chrono::microseconds& runTime,
+    int64_t maxItems) {
+  folly::MSLGuard g(statsLock_);
+  if (numTasks_) {
+    if (numTasks_ >= maxItems) {
+      waitingTimeUs_ /= numTasks_;
+      executingTimeUs_ /= numTasks_;
+      numTasks_ = 1;
+    }
+    waitTime = waitingTimeUs_ / numTasks_;
+    runTime = executingTimeUs_ / numTasks_;
+  } else {
+    waitTime = std::chrono::microseconds::zero();
+    runTime = std::chrono::microseconds::zero();
+  }
+}
+
+void WorkStealingThreadManager::enableCodel(bool enabled) {
+  codelEnabled_ = enabled || FLAGS_codel_enabled;
+}
+
+folly::Codel* WorkStealingThreadManager::getCodel() {
+  return &codel_;
+}
+
+folly::Executor::KeepAlive<> WorkStealingThreadManager::getKeepAlive(
+    ExecutionScope es,
+    Source source) const {
+  auto const idx = laneOf(es.getPriority(), source);
+  DCHECK(idx < executors_.size());
+  return getKeepAliveToken(*executors_[idx]);
+}
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
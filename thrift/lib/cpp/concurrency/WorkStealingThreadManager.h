@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/DefaultKeepAliveExecutor.h>
+#include <folly/executors/Codel.h>
+#include <folly/synchronization/LifoSem.h>
+#include <folly/synchronization/SmallLocks.h>
+
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+/**
+ * Work-stealing thread manager
+ * ============================
+ *
+ * ThreadManager::Impl funnels every add() and every dequeue through one
+ * shared set of queues, which becomes the bottleneck on machines with many
+ * cores. Here, each worker instead owns a local queue, split into one FIFO
+ * lane per (PRIORITY, Source) pair:
+ *
+ *   - add() from one of this manager's workers enqueues on that worker's own
+ *     queue; add() from any other thread picks a random worker's queue.
+ *   - A worker runs the oldest task of the highest-priority non-empty lane of
+ *     its own queue. When that is empty, it steals from the queue whose best
+ *     lane has the highest priority, and only then goes to sleep.
+ *
+ * Lanes are ordered like in newPriorityQueueThreadManager(): by PRIORITY, then
+ * INTERNAL before EXISTING_INTERACTION before UPSTREAM. Priorities are strict
+ * within a queue, and idle workers always steal the highest-priority work
+ * first. A busy worker does not look at other queues though, so a task
+ * queued behind a lower-priority task on a busy worker waits for that task
+ * unless an idle worker steals it first.
+ *
+ * Expiration, CoDel (getCodel(), setCodelCallback()), the expire and thread
+ * init callbacks, task stats and ThreadManager::Observer behave as in
+ * ThreadManager::Impl. getKeepAlive() honors both the priority and the source
+ * of the ExecutionScope.
+ *
+ * The number of workers can be changed with addWorker()/removeWorker() up to
+ * the maxWorkers passed to the constructor; tasks queued on a removed worker
+ * are handed to the remaining ones.
+ */
+class WorkStealingThreadManager : public ThreadManager,
+                                  public folly::DefaultKeepAliveExecutor {
+ public:
+  /**
+   * @param numWorkers number of threads started by start()
+   * @param enableTaskStats whether to collect getStats() data
+   * @param maxWorkers upper bound for addWorker(); defaults to numWorkers
+   */
+  explicit WorkStealingThreadManager(
+      size_t numWorkers = sysconf(_SC_NPROCESSORS_ONLN),
+      bool enableTaskStats = false,
+      size_t maxWorkers = 0);
+  ~WorkStealingThreadManager() override;
+
+  void start() override;
+  void stop() override;
+  void join() override;
+  STATE state() const override;
+  std::shared_ptr<ThreadFactory> threadFactory() const override;
+  void threadFactory(std::shared_ptr<ThreadFactory> value) override;
+  std::string getNamePrefix() const override;
+  void setNamePrefix(const std::string& name) override;
+  void addWorker(size_t value = 1) override;
+  void removeWorker(size_t value = 1) override;
+  size_t idleWorkerCount() const override;
+  size_t workerCount() const override;
+  size_t pendingTaskCount() const override;
+  size_t pendingUpstreamTaskCount() const override;
+  size_t totalTaskCount() const override;
+  size_t expiredTaskCount() override;
+
+  using ThreadManager::add;
+  void add(
+      std::shared_ptr<Runnable> task,
+      int64_t timeout,
+      int64_t expiration,
+      Source source) noexcept override;
+  void add(
+      PRIORITY priority,
+      std::shared_ptr<Runnable> task,
+      int64_t timeout,
+      int64_t expiration,
+      Source source) noexcept;
+
+  /**
+   * Implements folly::Executor::add()
+   */
+  void add(folly::Func f) override;
+
+  /**
+   * Implements folly::Executor::addWithPriority(), mapping executor
+   * priorities the same way PriorityThreadManager does.
+   */
+  void addWithPriority(folly::Func f, int8_t priority) override;
+
+  uint8_t getNumPriorities() const override {
+    return N_PRIORITIES;
+  }
+
+  void remove(std::shared_ptr<Runnable> task) override;
+  std::shared_ptr<Runnable> removeNextPending() override;
+  void clearPending() override;
+
+  void setExpireCallback(ExpireCallback expireCallback) override;
+  void setCodelCallback(ExpireCallback expireCallback) override;
+  void setThreadInitCallback(InitCallback initCallback) override;
+
+  void getStats(
+      std::chrono::microseconds& waitTime,
+      std::chrono::microseconds& runTime,
+      int64_t maxItems) override;
+
+  void enableCodel(bool) override;
+  folly::Codel* getCodel() override;
+
+  [[nodiscard]] KeepAlive<> getKeepAlive(ExecutionScope es, Source source)
+      const override;
+
+  /**
+   * Number of tasks that were run by another worker than the one whose queue
+   * they were added to.
+   */
+  size_t stolenTaskCount() const;
+
+ private:
+  class Task;
+  class Worker;
+  class LaneExecutor;
+  struct WorkerQueue;
+
+  void addWorkerImpl(std::unique_lock<std::mutex>& lock, size_t value);
+  void removeWorkerImpl(
+      std::unique_lock<std::mutex>& lock,
+      size_t value,
+      bool afterTasks);
+  void stopImpl(bool joinArg);
+  void joinKeepAliveOnce();
+
+  // Methods invoked by workers
+  void workerStarted(Worker& worker);
+  void workerExiting(Worker& worker);
+  std::unique_ptr<Task> waitOnTask(size_t self);
+  std::unique_ptr<Task> findTask(size_t self);
+  std::unique_ptr<Task> steal(size_t self);
+  void runTask(Task& task);
+  void reportTaskStats(
+      const Task& task,
+      const std::chrono::steady_clock::time_point& workBegin,
+      const std::chrono::steady_clock::time_point& workEnd);
+  void onTaskExpired(const Task& task);
+  void wakeAll();
+  void setSeriesNames();
+
+  const size_t numWorkers_;
+  const bool enableTaskStats_;
+
+  // One per possible worker, allocated up front so that thieves can scan them
+  // without synchronizing with addWorker().
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  // Workers [0, activeWorkers_) are running and receive new tasks. Queues up
+  // to usedQueues_ may still hold tasks and are scanned by thieves.
+  std::atomic<size_t> activeWorkers_{0};
+  std::atomic<size_t> usedQueues_{0};
+
+  std::atomic<size_t> idleCount_{0};
+  std::atomic<size_t> stolenCount_{0};
+  folly::LifoSem waitSem_;
+
+  folly::Codel codel_;
+  std::atomic<bool> codelEnabled_;
+
+  folly::MicroSpinLock statsLock_{0};
+  std::chrono::microseconds waitingTimeUs_{0};
+  std::chrono::microseconds executingTimeUs_{0};
+  int64_t numTasks_{0};
+
+  ExpireCallback expireCallback_;
+  ExpireCallback codelCallback_;
+  InitCallback initCallback_;
+
+  // Guards everything below, and expireCallback_ and initCallback_.
+  mutable std::mutex mutex_;
+  std::mutex stateUpdateMutex_;
+  std::atomic<STATE> state_{UNINITIALIZED};
+  std::shared_ptr<ThreadFactory> threadFactory_;
+  std::string namePrefix_;
+  uint32_t namePrefixCounter_{0};
+  // Observer series per priority, named like newPriorityQueueThreadManager()'s.
+  std::array<std::string, N_PRIORITIES> seriesNames_;
+  size_t expiredCount_{0};
+  size_t workerCount_{0};
+  // Signaled whenever a worker thread exits.
+  std::condition_variable deadWorkerCond_;
+  std::deque<std::shared_ptr<Thread>> deadWorkers_;
+
+  std::vector<std::unique_ptr<Executor>> executors_;
+  bool keepAliveJoined_{false};
+};
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
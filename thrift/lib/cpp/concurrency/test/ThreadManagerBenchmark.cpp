@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/portability/GFlags.h>
+#include <folly/synchronization/Baton.h>
+
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+#include <thrift/lib/cpp/concurrency/WorkStealingThreadManager.h>
+
+DEFINE_int32(num_workers, 16, "Number of worker threads per ThreadManager");
+DEFINE_int32(
+    num_producers,
+    16,
+    "Number of threads concurrently adding tasks from outside the pool");
+DEFINE_int32(fan_out, 16, "Number of subtasks added by each task in fan_out");
+
+using namespace apache::thrift::concurrency;
+
+namespace {
+
+using Factory = std::function<std::shared_ptr<ThreadManager>()>;
+
+std::shared_ptr<ThreadManager> simple() {
+  return ThreadManager::newSimpleThreadManager(FLAGS_num_workers);
+}
+
+std::shared_ptr<ThreadManager> priorityQueue() {
+  return ThreadManager::newPriorityQueueThreadManager(FLAGS_num_workers);
+}
+
+std::shared_ptr<ThreadManager> priority() {
+  // All the benchmarked tasks are NORMAL.
+  return PriorityThreadManager::newPriorityThreadManager(FLAGS_num_workers);
+}
+
+std::shared_ptr<ThreadManager> workStealing() {
+  return std::make_shared<WorkStealingThreadManager>(FLAGS_num_workers);
+}
+
+// Producers outside the pool add iters empty tasks in total; measures the
+// contention on the shared queue(s) between producers and workers.
+void addFromProducers(const Factory& factory, size_t iters) {
+  std::shared_ptr<ThreadManager> tm;
+  std::atomic<size_t> remaining{iters};
+  folly::Baton<> done;
+  std::vector<std::thread> producers;
+  BENCHMARK_SUSPEND {
+    tm = factory();
+    tm->start();
+    if (iters == 0) {
+      done.post();
+    }
+  }
+
+  size_t const numProducers = FLAGS_num_producers;
+  for (size_t p = 0; p < numProducers; ++p) {
+    size_t const n = iters / numProducers + (p < iters % numProducers ? 1 : 0);
+    producers.emplace_back([&, n] {
+      for (size_t i = 0; i < n; ++i) {
+        tm->add([&] {
+          if (--remaining == 0) {
+            done.post();
+          }
+        });
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  done.wait();
+
+  BENCHMARK_SUSPEND {
+    tm->join();
+  }
+}
+
+// Each task added from outside adds FLAGS_fan_out subtasks from the worker
+// running it, as a handler does when it splits up a request.
+void addFromWorkers(const Factory& factory, size_t iters) {
+  std::shared_ptr<ThreadManager> tm;
+  size_t const fanOut = FLAGS_fan_out;
+  size_t const roots = (iters + fanOut - 1) / fanOut;
+  std::atomic<size_t> remaining{roots * fanOut};
+  folly::Baton<> done;
+  BENCHMARK_SUSPEND {
+    tm = factory();
+    tm->start();
+    if (roots == 0) {
+      done.post();
+    }
+  }
+
+  for (size_t r = 0; r < roots; ++r) {
+    tm->add([&] {
+      for (size_t i = 0; i < fanOut; ++i) {
+        tm->add([&] {
+          if (--remaining == 0) {
+            done.post();
+          }
+        });
+      }
+    });
+  }
+  done.wait();
+
+  BENCHMARK_SUSPEND {
+    tm->join();
+  }
+}
+
+} // namespace
+
+BENCHMARK(simple_producers, iters) {
+  addFromProducers(simple, iters);
+}
+
+BENCHMARK_RELATIVE(priority_queue_producers, iters) {
+  addFromProducers(priorityQueue, iters);
+}
+
+BENCHMARK_RELATIVE(priority_producers, iters) {
+  addFromProducers(priority, iters);
+}
+
+BENCHMARK_RELATIVE(work_stealing_producers, iters) {
+  addFromProducers(workStealing, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(simple_fan_out, iters) {
+  addFromWorkers(simple, iters);
+}
+
+BENCHMARK_RELATIVE(priority_queue_fan_out, iters) {
+  addFromWorkers(priorityQueue, iters);
+}
+
+BENCHMARK_RELATIVE(priority_fan_out, iters) {
+  addFromWorkers(priority, iters);
+}
+
+BENCHMARK_RELATIVE(work_stealing_fan_out, iters) {
+  addFromWorkers(workStealing, iters);
+}
+
+int main(int argc, char* argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+#include <folly/synchronization/Baton.h>
+#include <thrift/lib/cpp/concurrency/FunctionRunner.h>
+#include <thrift/lib/cpp/concurrency/WorkStealingThreadManager.h>
+
+using namespace apache::thrift::concurrency;
+
+// Verify tasks are executed at all, through every entry point.
+TEST(WorkStealingThreadManagerTest, RunsAllTasks) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(4);
+  tm->start();
+
+  constexpr int kTasks = 10000;
+  std::atomic<int> count{0};
+  for (int i = 0; i < kTasks; ++i) {
+    switch (i % 3) {
+      case 0:
+        tm->add(FunctionRunner::create([&] { ++count; }));
+        break;
+      case 1:
+        tm->add([&] { ++count; });
+        break;
+      default:
+        tm->getKeepAlive(
+              ThreadManager::ExecutionScope(PRIORITY::HIGH),
+              ThreadManager::Source::UPSTREAM)
+            ->add([&] { ++count; });
+    }
+  }
+  tm->join();
+
+  EXPECT_EQ(kTasks, count.load());
+  EXPECT_EQ(0, tm->pendingTaskCount());
+  EXPECT_EQ(0, tm->workerCount());
+}
+
+// With a single worker, queued tasks run by priority, then source, then FIFO.
+TEST(WorkStealingThreadManagerTest, PriorityOrder) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(1);
+  tm->start();
+
+  folly::Baton<> blocked, unblock;
+  tm->add([&] {
+    blocked.post();
+    unblock.wait();
+  });
+  blocked.wait();
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int i) {
+    return FunctionRunner::create([&, i] {
+      std::lock_guard<std::mutex> g(mutex);
+      order.push_back(i);
+    });
+  };
+  using Source = ThreadManager::Source;
+  tm->add(PRIORITY::BEST_EFFORT, record(5), 0, 0, Source::UPSTREAM);
+  tm->add(PRIORITY::NORMAL, record(3), 0, 0, Source::UPSTREAM);
+  tm->add(PRIORITY::NORMAL, record(4), 0, 0, Source::UPSTREAM);
+  tm->add(PRIORITY::NORMAL, record(2), 0, 0, Source::INTERNAL);
+  tm->add(PRIORITY::HIGH_IMPORTANT, record(1), 0, 0, Source::UPSTREAM);
+  EXPECT_EQ(5, tm->pendingTaskCount());
+  EXPECT_EQ(4, tm->pendingUpstreamTaskCount());
+
+  unblock.post();
+  tm->join();
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4, 5}), order);
+}
+
+// Tasks queued on a busy worker get picked up by the idle one.
+TEST(WorkStealingThreadManagerTest, IdleWorkerSteals) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(2);
+  tm->start();
+
+  folly::Baton<> blocked, unblock, done;
+  std::atomic<int> count{0};
+  tm->add([&] {
+    // Tasks added from a worker are queued on that worker.
+    for (int i = 0; i < 100; ++i) {
+      tm->add([&] {
+        if (++count == 100) {
+          done.post();
+        }
+      });
+    }
+    blocked.post();
+    unblock.wait();
+  });
+  blocked.wait();
+
+  // Only the other worker can run them. The outer task may have been stolen
+  // as well.
+  EXPECT_TRUE(done.try_wait_for(std::chrono::seconds(10)));
+  EXPECT_GE(tm->stolenTaskCount(), 100);
+
+  unblock.post();
+  tm->join();
+}
+
+TEST(WorkStealingThreadManagerTest, Expiration) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(1);
+  std::atomic<int> expired{0};
+  tm->setExpireCallback([&](std::shared_ptr<Runnable>) { ++expired; });
+  tm->start();
+
+  folly::Baton<> blocked, unblock;
+  tm->add([&] {
+    blocked.post();
+    unblock.wait();
+  });
+  blocked.wait();
+
+  bool ran = false;
+  tm->add(FunctionRunner::create([&] { ran = true; }), 0, 1);
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  unblock.post();
+  tm->join();
+
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(1, expired.load());
+  EXPECT_EQ(1, tm->expiredTaskCount());
+}
+
+// Unlike join(), stop() drops the tasks that are still queued.
+TEST(WorkStealingThreadManagerTest, StopDropsPendingTasks) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(1);
+  tm->start();
+
+  folly::Baton<> blocked;
+  std::atomic<bool> unblock{false};
+  tm->add([&] {
+    blocked.post();
+    while (!unblock) {
+      std::this_thread::yield();
+    }
+  });
+  blocked.wait();
+
+  bool ran = false;
+  tm->add([&] { ran = true; });
+  std::thread stopper([&] { tm->stop(); });
+  while (tm->state() != ThreadManager::STOPPING) {
+    std::this_thread::yield();
+  }
+  unblock = true;
+  stopper.join();
+
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(ThreadManager::STOPPED, tm->state());
+}
+
+// Tasks left on a removed worker's queue are run by the remaining workers.
+TEST(WorkStealingThreadManagerTest, AddRemoveWorkers) {
+  auto tm = std::make_shared<WorkStealingThreadManager>(1, false, 4);
+  tm->start();
+  tm->addWorker(3);
+  EXPECT_EQ(4, tm->workerCount());
+  EXPECT_THROW(tm->addWorker(), InvalidArgumentException);
+
+  std::atomic<int> count{0};
+  for (int i = 0; i < 1000; ++i) {
+    tm->add([&] { ++count; });
+  }
+  tm->removeWorker(3);
+  EXPECT_EQ(1, tm->workerCount());
+  tm->join();
+  EXPECT_EQ(1000, count.load());
+}
+
+TEST(WorkStealingThreadManagerTest, Observer) {
+  class TestObserver : public ThreadManager::Observer {
+   public:
+    void preRun(folly::RequestContext*) override {
+      ++preRuns;
+    }
+    void postRun(folly::RequestContext*, const RunStats& stats) override {
+      ++postRuns;
+      EXPECT_EQ("tm-pri3", stats.threadPoolName);
+    }
+
+    std::atomic<int> preRuns{0};
+    std::atomic<int> postRuns{0};
+  };
+
+  auto observer = std::make_shared<TestObserver>();
+  ThreadManager::setObserver(observer);
+
+  auto tm = std::make_shared<WorkStealingThreadManager>(2);
+  tm->setNamePrefix("tm");
+  tm->start();
+  for (int i = 0; i < 10; ++i) {
+    tm->add([] {});
+  }
+  tm->join();
+  ThreadManager::setObserver(nullptr);
+
+  EXPECT_EQ(10, observer->preRuns.load());
+  EXPECT_EQ(10, observer->postRuns.load());
+}
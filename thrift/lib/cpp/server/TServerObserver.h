@@ -39,11 +39,16 @@ class TServerObserver {
     SamplingStatus() noexcept : SamplingStatus(false, false) {}
     SamplingStatus(
         bool isServerSamplingEnabled,
-        bool isClientSamplingEnabled) noexcept
+        bool isClientSamplingEnabled,
+        bool isLatencyStatsSamplingEnabled = false,
+        bool isTracingEnabled = false) noexcept
         : isServerSamplingEnabled_(isServerSamplingEnabled),
-          isClientSamplingEnabled_(isClientSamplingEnabled) {}
+          isClientSamplingEnabled_(isClientSamplingEnabled),
+          isLatencyStatsSamplingEnabled_(isLatencyStatsSamplingEnabled),
+          isTracingEnabled_(isTracingEnabled) {}
     bool isEnabled() const {
-      return isServerSamplingEnabled_ || isClientSamplingEnabled_;
+      return isServerSamplingEnabled_ || isClientSamplingEnabled_ ||
+          isLatencyStatsSamplingEnabled_ || isTracingEnabled_;
     }
     bool isEnabledByServer() const {
       return isServerSamplingEnabled_;
@@ -51,10 +56,20 @@ class TServerObserver {
     bool isEnabledByClient() const {
       return isClientSamplingEnabled_;
     }
+    // Sampled for the server's MethodLatencyStats.
+    bool isEnabledByLatencyStats() const {
+      return isLatencyStatsSamplingEnabled_;
+    }
+    // Sampled for the server's RequestTracer.
+    bool isEnabledByTracer() const {
+      return isTracingEnabled_;
+    }
 
    private:
     bool isServerSamplingEnabled_;
     bool isClientSamplingEnabled_;
+    bool isLatencyStatsSamplingEnabled_;
+    bool isTracingEnabled_;
   };
 
   class PreHandlerTimestamps {
@@ -71,6 +86,9 @@ class TServerObserver {
     }
 
     clock::time_point readEnd;
+    // Set when the request was queued on the thread manager, in which case
+    // processBegin is when it was dequeued.
+    clock::time_point queueBegin;
     clock::time_point processBegin;
 
     folly::Optional<uint64_t> processDelayLatencyUsec() const {
@@ -94,6 +112,9 @@ class TServerObserver {
 
   class CallTimestamps : public PreHandlerTimestamps {
    public:
+    // Serialization of the response by the handler callback.
+    std::chrono::steady_clock::time_point serializeBegin;
+    std::chrono::steady_clock::time_point serializeEnd;
     std::chrono::steady_clock::time_point processEnd;
     std::chrono::steady_clock::time_point writeBegin;
     std::chrono::steady_clock::time_point writeEnd;
@@ -155,6 +176,20 @@ class TServerObserver {
 
   virtual void sentReply() {}
 
+  // A batch of numWrites writes totalling numBytes was flushed to a
+  // connection, the oldest of which waited `delay` to be batched.
+  virtual void writeBatchFlushed(
+      uint32_t /*numWrites*/,
+      uint64_t /*numBytes*/,
+      std::chrono::microseconds /*delay*/) {}
+
+  // A write of numBytes selected for zerocopy (see
+  // ThriftServer::setZeroCopyEnableFunc) was sent with MSG_ZEROCOPY, or was
+  // copied because the transport does not support zerocopy (e.g. TLS).
+  virtual void zeroCopyWrite(uint64_t /*numBytes*/) {}
+
+  virtual void zeroCopyFallback(uint64_t /*numBytes*/) {}
+
   virtual void activeRequests(int32_t /*numRequests*/) {}
 
   virtual void callCompleted(const CallTimestamps& /*runtimes*/) {}
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <cstddef>
+#include <type_traits>
+
 #include <folly/io/Cursor.h>
 
 namespace apache {
@@ -130,6 +133,62 @@ T readVarint(CursorT& c) {
 
 namespace detail {
 
+/**
+ * Decode up to n varints from the contiguous range [p, end) into out, and
+ * advance p past the bytes consumed. This loads 8 bytes at a time and packs
+ * the 7-bit groups of each varint in one step (with PEXT on CPUs where it is
+ * fast), so it stops early, without consuming anything, once fewer
+ * than 8 bytes remain or when a varint is longer than 8 bytes. The caller is
+ * expected to finish such values with the scalar path.
+ * Returns the number of values decoded.
+ */
+size_t readVarintRun(
+    const uint8_t*& p,
+    const uint8_t* end,
+    uint32_t* out,
+    size_t n);
+size_t readVarintRun(
+    const uint8_t*& p,
+    const uint8_t* end,
+    uint64_t* out,
+    size_t n);
+
+} // namespace detail
+
+/**
+ * Read n consecutive varints into out. Equivalent to calling readVarint() n
+ * times, but decodes whole runs of values per buffer in the chain.
+ */
+template <
+    class T,
+    class CursorT,
+    typename std::enable_if<
+        std::is_constructible<folly::io::Cursor, const CursorT&>::value,
+        bool>::type = false>
+void readVarintRange(CursorT& c, T* out, size_t n) {
+  static_assert(
+      std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+      "readVarintRange supports 32 and 64 bit integers only");
+  using U = typename std::make_unsigned<T>::type;
+  while (n > 0) {
+    const uint8_t* start = c.data();
+    const uint8_t* p = start;
+    size_t decoded = apache::thrift::util::detail::readVarintRun(
+        p, start + c.length(), reinterpret_cast<U*>(out), n);
+    c.skipNoAdvance(p - start);
+    out += decoded;
+    n -= decoded;
+    if (n > 0) {
+      // Tail of the current buffer, a value straddling two buffers, or an
+      // over-long varint.
+      readVarint<T, CursorT>(c, *out++);
+      --n;
+    }
+  }
+}
+
+namespace detail {
+
 template <typename T>
 class has_ensure_and_append {
   template <typename U>
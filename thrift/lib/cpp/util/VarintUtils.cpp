@@ -20,6 +20,20 @@
 
 #include <stdint.h>
 
+#include <folly/CpuId.h>
+#include <folly/Portability.h>
+#include <folly/lang/Bits.h>
+
+// PEXT is emitted through inline asm rather than the _pext_u64 intrinsic so
+// this file does not need to be built with -mbmi2; it is only ever executed
+// after a runtime CPUID check.
+#if FOLLY_X64 && defined(__GNUC__)
+#define THRIFT_UTIL_VARINT_HAS_PEXT 1
+#include <cpuid.h>
+#else
+#define THRIFT_UTIL_VARINT_HAS_PEXT 0
+#endif
+
 namespace apache {
 namespace thrift {
 namespace util {
@@ -109,6 +123,130 @@ namespace detail {
 [[noreturn]] void throwInvalidVarint() {
   throw std::out_of_range("invalid varint read");
 }
+
+namespace {
+
+constexpr uint64_t kVarintContinuationBits = 0x8080808080808080ULL;
+constexpr uint64_t kVarintPayloadBits = 0x7f7f7f7f7f7f7f7fULL;
+
+// Packs the 7-bit groups of an (at most 8 byte) little-endian varint, with
+// the continuation bits already cleared, into a contiguous value.
+template <bool kUsePext>
+inline uint64_t packVarintPayload(uint64_t x);
+
+template <>
+inline uint64_t packVarintPayload<false>(uint64_t x) {
+  x = ((x & 0x7f007f007f007f00ULL) >> 1) | (x & 0x007f007f007f007fULL);
+  x = ((x & 0x3fff00003fff0000ULL) >> 2) | (x & 0x00003fff00003fffULL);
+  x = ((x & 0x0fffffff00000000ULL) >> 4) | (x & 0x000000000fffffffULL);
+  return x;
+}
+
+#if THRIFT_UTIL_VARINT_HAS_PEXT
+template <>
+inline uint64_t packVarintPayload<true>(uint64_t x) {
+  uint64_t result;
+  asm("pextq %2, %1, %0" : "=r"(result) : "r"(x), "r"(kVarintPayloadBits));
+  return result;
+}
+#endif
+
+template <typename U, bool kUsePext>
+size_t readVarintRunImpl(
+    const uint8_t*& p,
+    const uint8_t* end,
+    U* out,
+    size_t n) {
+  enum { maxSize = (8 * sizeof(U) + 6) / 7 };
+  if (!folly::kIsLittleEndian) {
+    return 0;
+  }
+
+  const uint8_t* cur = p;
+  size_t i = 0;
+  for (; i < n && end - cur >= 8; ++i) {
+    uint64_t word = folly::loadUnaligned<uint64_t>(cur);
+    uint64_t stops = ~word & kVarintContinuationBits;
+    if (stops == 0) {
+      // Longer than 8 bytes, let the scalar path deal with it.
+      break;
+    }
+    size_t size = folly::findFirstSet(stops) / 8;
+    if (size > maxSize) {
+      throwInvalidVarint();
+    }
+    // stops ^ (stops - 1) selects every byte up to and including the last
+    // byte of this varint.
+    word &= kVarintPayloadBits & (stops ^ (stops - 1));
+    out[i] = static_cast<U>(packVarintPayload<kUsePext>(word));
+    cur += size;
+  }
+  p = cur;
+  return i;
+}
+
+template <typename U>
+using ReadVarintRunFn = size_t (*)(const uint8_t*&, const uint8_t*, U*, size_t);
+
+#if THRIFT_UTIL_VARINT_HAS_PEXT
+// AMD CPUs before Zen 3 (family 0x19) implement PEXT in microcode, where it
+// is much slower than the SWAR fallback. Other vendors get SWAR as well.
+bool hasFastPext() {
+  if (!folly::CpuId().bmi2()) {
+    return false;
+  }
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  // "GenuineIntel"
+  if (ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e) {
+    return true;
+  }
+  // "AuthenticAMD"
+  if (ebx == 0x68747541 && edx == 0x69746e65 && ecx == 0x444d4163 &&
+      __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    unsigned family = (eax >> 8) & 0xf;
+    if (family == 0xf) {
+      family += (eax >> 20) & 0xff;
+    }
+    return family >= 0x19;
+  }
+  return false;
+}
+#endif
+
+template <typename U>
+ReadVarintRunFn<U> selectReadVarintRun() {
+#if THRIFT_UTIL_VARINT_HAS_PEXT
+  if (hasFastPext()) {
+    return &readVarintRunImpl<U, true>;
+  }
+#endif
+  return &readVarintRunImpl<U, false>;
+}
+
+} // namespace
+
+size_t readVarintRun(
+    const uint8_t*& p,
+    const uint8_t* end,
+    uint32_t* out,
+    size_t n) {
+  static const ReadVarintRunFn<uint32_t> impl =
+      selectReadVarintRun<uint32_t>();
+  return impl(p, end, out, n);
+}
+
+size_t readVarintRun(
+    const uint8_t*& p,
+    const uint8_t* end,
+    uint64_t* out,
+    size_t n) {
+  static const ReadVarintRunFn<uint64_t> impl =
+      selectReadVarintRun<uint64_t>();
+  return impl(p, end, out, n);
+}
 } // namespace detail
 
 } // namespace util
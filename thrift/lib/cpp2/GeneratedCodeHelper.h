@@ -23,6 +23,7 @@
 
 #include <fmt/core.h>
 #include <folly/Traits.h>
+#include <folly/Optional.h>
 #include <folly/Utility.h>
 #include <folly/futures/Future.h>
 #include <folly/io/Cursor.h>
@@ -498,50 +499,62 @@ folly::exception_wrapper recv_wrapped_helper(
   int32_t protoSeqId = 0;
   MessageType mtype;
   ctx->preRead();
-  try {
-    if (state.header() && state.header()->getCrc32c().has_value() &&
-        checksum::crc32c(*state.buf()) != *state.header()->getCrc32c()) {
-      return folly::make_exception_wrapper<TApplicationException>(
-          TApplicationException::TApplicationExceptionType::CHECKSUM_MISMATCH,
-          "corrupted response");
-    }
-    prot->readMessageBegin(fname, mtype, protoSeqId);
-    if (mtype == T_EXCEPTION) {
-      TApplicationException x;
-      apache::thrift::detail::deserializeExceptionBody(prot, &x);
-      prot->readMessageEnd();
-      return folly::exception_wrapper(std::move(x));
-    }
-    if (mtype != T_REPLY) {
-      prot->skip(protocol::T_STRUCT);
-      prot->readMessageEnd();
-      return folly::make_exception_wrapper<TApplicationException>(
-          TApplicationException::TApplicationExceptionType::
-              INVALID_MESSAGE_TYPE);
-    }
-    if (fname.compare(method) != 0) {
-      prot->skip(protocol::T_STRUCT);
+  // Large values are checksummed as they are parsed, and the rest once
+  // parsing is done, instead of the whole response being read once more
+  // before parsing. The result is discarded on mismatch.
+  folly::Optional<checksum::ChainChecksum> checksum;
+  if (state.header() && state.header()->getCrc32c().has_value()) {
+    checksum.emplace(*state.buf());
+    prot->setInputChecksum(&*checksum);
+  }
+  auto guard = folly::makeGuard([&] { prot->setInputChecksum(nullptr); });
+  auto ew = [&]() -> folly::exception_wrapper {
+    try {
+      prot->readMessageBegin(fname, mtype, protoSeqId);
+      if (mtype == T_EXCEPTION) {
+        TApplicationException x;
+        apache::thrift::detail::deserializeExceptionBody(prot, &x);
+        prot->readMessageEnd();
+        return folly::exception_wrapper(std::move(x));
+      }
+      if (mtype != T_REPLY) {
+        prot->skip(protocol::T_STRUCT);
+        prot->readMessageEnd();
+        return folly::make_exception_wrapper<TApplicationException>(
+            TApplicationException::TApplicationExceptionType::
+                INVALID_MESSAGE_TYPE);
+      }
+      if (fname.compare(method) != 0) {
+        prot->skip(protocol::T_STRUCT);
+        prot->readMessageEnd();
+        return folly::make_exception_wrapper<TApplicationException>(
+            TApplicationException::TApplicationExceptionType::
+                WRONG_METHOD_NAME,
+            folly::to<std::string>(
+                "expected method: ", method, ", actual method: ", fname));
+      }
+      SerializedMessage smsg;
+      smsg.protocolType = prot->protocolType();
+      smsg.buffer = state.buf();
+      ctx->onReadData(smsg);
+      apache::thrift::detail::deserializeRequestBody(prot, &result);
       prot->readMessageEnd();
-      return folly::make_exception_wrapper<TApplicationException>(
-          TApplicationException::TApplicationExceptionType::WRONG_METHOD_NAME,
-          folly::to<std::string>(
-              "expected method: ", method, ", actual method: ", fname));
+      ctx->postRead(
+          state.header(),
+          folly::to_narrow(state.buf()->computeChainDataLength()));
+      return folly::exception_wrapper();
+    } catch (std::exception const& e) {
+      return folly::exception_wrapper(std::current_exception(), e);
+    } catch (...) {
+      return folly::exception_wrapper(std::current_exception());
     }
-    SerializedMessage smsg;
-    smsg.protocolType = prot->protocolType();
-    smsg.buffer = state.buf();
-    ctx->onReadData(smsg);
-    apache::thrift::detail::deserializeRequestBody(prot, &result);
-    prot->readMessageEnd();
-    ctx->postRead(
-        state.header(),
-        folly::to_narrow(state.buf()->computeChainDataLength()));
-    return folly::exception_wrapper();
-  } catch (std::exception const& e) {
-    return folly::exception_wrapper(std::current_exception(), e);
-  } catch (...) {
-    return folly::exception_wrapper(std::current_exception());
+  }();
+  if (checksum && checksum->value() != *state.header()->getCrc32c()) {
+    return folly::make_exception_wrapper<TApplicationException>(
+        TApplicationException::TApplicationExceptionType::CHECKSUM_MISMATCH,
+        "corrupted response");
   }
+  return ew;
 }
 
 template <typename PResult, typename Protocol, typename... ReturnTs>
@@ -16,6 +16,8 @@
 
 #include <thrift/lib/cpp2/async/AsyncProcessor.h>
 
+#include <thrift/lib/cpp2/server/ServerConfigs.h>
+
 namespace apache {
 namespace thrift {
 
@@ -317,6 +319,13 @@ bool GeneratedAsyncProcessor::setUpRequestProcessing(
   return true;
 }
 
+AdaptiveInlinePolicy* GeneratedAsyncProcessor::getAdaptiveInlinePolicy(
+    const Cpp2RequestContext* ctx) {
+  auto connCtx = ctx->getConnectionContext();
+  auto serverConfigs = connCtx ? connCtx->getServerConfigs() : nullptr;
+  return serverConfigs ? serverConfigs->getAdaptiveInlinePolicy() : nullptr;
+}
+
 concurrency::PRIORITY ServerInterface::getRequestPriority(
     Cpp2RequestContext* ctx,
     concurrency::PRIORITY prio) {
@@ -512,6 +521,26 @@ void HandlerCallbackBase::sendReply(
 #endif
 }
 
+void HandlerCallbackBase::markSerializeBegin() {
+  if (reqCtx_) {
+    auto& timestamps = static_cast<server::TServerObserver::CallTimestamps&>(
+        reqCtx_->getTimestamps());
+    if (UNLIKELY(timestamps.getSamplingStatus().isEnabled())) {
+      timestamps.serializeBegin = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+void HandlerCallbackBase::markSerializeEnd() {
+  if (reqCtx_) {
+    auto& timestamps = static_cast<server::TServerObserver::CallTimestamps&>(
+        reqCtx_->getTimestamps());
+    if (UNLIKELY(timestamps.getSamplingStatus().isEnabled())) {
+      timestamps.serializeEnd = std::chrono::steady_clock::now();
+    }
+  }
+}
+
 void HandlerCallbackBase::releaseInteraction(
     Tile* interaction,
     folly::EventBase* eb) {
@@ -555,7 +584,9 @@ void HandlerCallback<void>::complete(folly::Try<folly::Unit>&& r) {
 
 void HandlerCallback<void>::doDone() {
   assert(cp_ != nullptr);
+  markSerializeBegin();
   auto queue = cp_(this->protoSeqId_, this->ctx_.get());
+  markSerializeEnd();
   this->ctx_.reset();
   sendReply(std::move(queue));
 }
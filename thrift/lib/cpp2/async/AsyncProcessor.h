@@ -37,8 +37,10 @@
 #include <thrift/lib/cpp2/async/ServerStream.h>
 #include <thrift/lib/cpp2/async/Sink.h>
 #include <thrift/lib/cpp2/protocol/Protocol.h>
+#include <thrift/lib/cpp2/server/AdaptiveInlinePolicy.h>
 #include <thrift/lib/cpp2/server/Cpp2ConnContext.h>
 #include <thrift/lib/cpp2/util/Checksum.h>
+#include <thrift/lib/cpp2/util/PerfectHashMap.h>
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
 #include <thrift/lib/thrift/gen-cpp2/metadata_types.h>
 
@@ -155,8 +157,11 @@ class GeneratedAsyncProcessor : public AsyncProcessor {
       Cpp2RequestContext* context,
       folly::EventBase* eb,
       concurrency::ThreadManager* tm);
+  // Perfect hash from method name to handler. Generated processors also list
+  // the methods of the services they extend, so a method is found with a
+  // single lookup whatever the depth of the inheritance.
   template <typename ProcessFunc>
-  using ProcessMap = folly::F14ValueMap<std::string, ProcessFunc>;
+  using ProcessMap = PerfectHashMap<ProcessFunc>;
 
   template <typename Derived>
   using InteractionConstructor = std::unique_ptr<Tile> (Derived::*)();
@@ -221,6 +226,10 @@ class GeneratedAsyncProcessor : public AsyncProcessor {
       ChildType* childClass,
       Tile* tile);
 
+  // The policy of the server that received the request, if any.
+  static AdaptiveInlinePolicy* getAdaptiveInlinePolicy(
+      const Cpp2RequestContext* ctx);
+
   // Returns false if interaction id is duplicated.
   bool createInteraction(
       ResponseChannelRequest::UniquePtr& req,
@@ -498,6 +507,10 @@ class HandlerCallbackBase {
   void sendReply(folly::IOBufQueue queue);
   void sendReply(ResponseAndServerStreamFactory&& responseAndStream);
 
+  // Timestamp serialization of the response if the request is sampled.
+  void markSerializeBegin();
+  void markSerializeEnd();
+
   // Must be called from IO thread
   static void releaseInteraction(Tile* interaction, folly::EventBase* eb);
   void releaseInteractionInstance();
@@ -668,10 +681,12 @@ std::shared_ptr<EventTask> GeneratedAsyncProcessor::makeEventTaskForRequest(
     Tile* tile) {
   auto taskFn = [=, serializedRequest = std::move(serializedRequest)](
                     ResponseChannelRequest::UniquePtr rq) mutable {
-    if (ctx->getTimestamps().getSamplingStatus().isEnabled()) {
+    auto& timestamps = ctx->getTimestamps();
+    if (timestamps.getSamplingStatus().isEnabled()) {
       // Since this request was queued, reset the processBegin
       // time to the actual start time, and not the queue time.
-      ctx->getTimestamps().processBegin = std::chrono::steady_clock::now();
+      timestamps.queueBegin = timestamps.processBegin;
+      timestamps.processBegin = std::chrono::steady_clock::now();
     }
     // Oneway request won't be canceled if expired. see
     // D1006482 for furhter details.  TODO: fix this
@@ -756,7 +771,29 @@ void GeneratedAsyncProcessor::processInThread(
   auto source = tile && !ctx->getInteractionCreate()
       ? Source::EXISTING_INTERACTION
       : Source::UPSTREAM;
-  tm->getKeepAlive(pri, source)->add([task = std::move(task)] { task->run(); });
+
+  auto policy = tile ? nullptr : getAdaptiveInlinePolicy(ctx);
+  if (!policy) {
+    tm->getKeepAlive(pri, source)->add(
+        [task = std::move(task)] { task->run(); });
+    return;
+  }
+
+  auto& method = policy->getMethod(ctx->getMethodName());
+  auto start = std::chrono::steady_clock::now();
+  if (policy->shouldRunInline(method, start)) {
+    task->run();
+    policy->onProcessed(
+        method, true, std::chrono::steady_clock::now() - start);
+    return;
+  }
+  tm->getKeepAlive(pri, source)->add(
+      [task = std::move(task), policy, &method] {
+        auto begin = std::chrono::steady_clock::now();
+        task->run();
+        policy->onProcessed(
+            method, false, std::chrono::steady_clock::now() - begin);
+      });
 }
 
 template <class F>
@@ -840,12 +877,14 @@ void HandlerCallback<T>::complete(folly::Try<T>&& r) {
 template <typename T>
 void HandlerCallback<T>::doResult(InputType r) {
   assert(cp_ != nullptr);
+  this->markSerializeBegin();
   auto reply = Helper::call(
       cp_,
       this->protoSeqId_,
       this->ctx_.get(),
       std::move(this->streamEx_),
       std::forward<InputType>(r));
+  this->markSerializeEnd();
   this->ctx_.reset();
   sendReply(std::move(reply));
 }
@@ -21,6 +21,7 @@
 #include <folly/futures/Future.h>
 #include <folly/synchronization/Baton.h>
 #include <thrift/lib/cpp2/async/ClientStreamBridge.h>
+#include <thrift/lib/cpp2/async/StreamCreditWindow.h>
 #if FOLLY_HAS_COROUTINES
 #include <folly/experimental/coro/AsyncGenerator.h>
 #include <folly/experimental/coro/Baton.h>
@@ -58,8 +59,8 @@ class ClientBufferedStream {
       ++bufferOptions_.chunkSize;
     }
 
-    int32_t outstanding = bufferOptions_.chunkSize;
-    size_t payloadDataSize = 0;
+    apache::thrift::detail::StreamCreditWindow window(bufferOptions_);
+    bool waited = false;
 
     apache::thrift::detail::ClientStreamBridge::ClientQueue queue;
     class ReadyCallback : public apache::thrift::detail::ClientStreamConsumer {
@@ -85,10 +86,12 @@ class ClientBufferedStream {
         ReadyCallback callback;
         if (streamBridge->wait(&callback)) {
           callback.wait();
+          waited = true;
         }
         queue = streamBridge->getMessages();
       }
 
+      size_t payloadSize = 0;
       {
         auto& payload = queue.front();
         if (payload.hasValue()) {
@@ -98,7 +101,7 @@ class ClientBufferedStream {
             queue.pop();
             continue;
           }
-          payloadDataSize += payload->payload->computeChainDataLength();
+          payloadSize = payload->payload->computeChainDataLength();
         }
         auto value = decode_(std::move(payload));
         queue.pop();
@@ -116,11 +119,9 @@ class ClientBufferedStream {
         }
       }
 
-      if ((--outstanding <= bufferOptions_.chunkSize / 2) ||
-          (payloadDataSize >= kRequestCreditPayloadSize)) {
-        streamBridge->requestN(bufferOptions_.chunkSize - outstanding);
-        outstanding = bufferOptions_.chunkSize;
-        payloadDataSize = 0;
+      if (auto credits =
+              window.onPayload(payloadSize, std::exchange(waited, false))) {
+        streamBridge->requestN(credits);
       }
     }
   }
@@ -134,7 +135,7 @@ class ClientBufferedStream {
               decode_,
               bufferOptions_.memSize)
         : toAsyncGeneratorImpl<false>(
-              std::move(streamBridge_), bufferOptions_.chunkSize, decode_);
+              std::move(streamBridge_), bufferOptions_, decode_);
   }
 
   struct PayloadAndHeader {
@@ -150,7 +151,7 @@ class ClientBufferedStream {
               decode_,
               bufferOptions_.memSize)
         : toAsyncGeneratorImpl<true>(
-              std::move(streamBridge_), bufferOptions_.chunkSize, decode_);
+              std::move(streamBridge_), bufferOptions_, decode_);
   }
 #endif // FOLLY_HAS_COROUTINES
 
@@ -168,7 +169,7 @@ class ClientBufferedStream {
         std::forward<Callback>(onNextTry),
         std::move(streamBridge_),
         decode_,
-        bufferOptions_.chunkSize);
+        bufferOptions_);
     Subscription sub(c->state_);
     e->add([c]() { (*c)(); });
     return sub;
@@ -181,15 +182,15 @@ class ClientBufferedStream {
       std::conditional_t<WithHeader, PayloadAndHeader, T>&&>
   toAsyncGeneratorImpl(
       apache::thrift::detail::ClientStreamBridge::ClientPtr streamBridge,
-      int32_t chunkBufferSize,
+      BufferOptions bufferOptions,
       folly::Try<T> (*decode)(folly::Try<StreamPayload>&&)) {
-    if (chunkBufferSize == 0) {
+    if (bufferOptions.chunkSize == 0) {
       streamBridge->requestN(1);
-      ++chunkBufferSize;
+      ++bufferOptions.chunkSize;
     }
 
-    int32_t outstanding = chunkBufferSize;
-    size_t payloadDataSize = 0;
+    apache::thrift::detail::StreamCreditWindow window(bufferOptions);
+    bool waited = false;
 
     apache::thrift::detail::ClientStreamBridge::ClientQueue queue;
     class ReadyCallback : public apache::thrift::detail::ClientStreamConsumer {
@@ -217,6 +218,7 @@ class ClientBufferedStream {
               co_await folly::coro::co_current_cancellation_token,
               [&] { streamBridge->cancel(); }};
           co_await callback.baton;
+          waited = true;
         }
         queue = streamBridge->getMessages();
         if (queue.empty()) {
@@ -228,6 +230,7 @@ class ClientBufferedStream {
       }
 
       {
+        size_t payloadSize = 0;
         auto& payload = queue.front();
         if (!payload.hasValue() && !payload.hasException()) {
           break;
@@ -241,7 +244,7 @@ class ClientBufferedStream {
               continue;
             }
           } else {
-            payloadDataSize += payload->payload->computeChainDataLength();
+            payloadSize = payload->payload->computeChainDataLength();
           }
         }
         if constexpr (WithHeader) {
@@ -268,11 +271,9 @@ class ClientBufferedStream {
           co_yield folly::coro::co_result(std::move(value));
         }
 
-        if ((--outstanding <= chunkBufferSize / 2) ||
-            (payloadDataSize >= kRequestCreditPayloadSize)) {
-          streamBridge->requestN(chunkBufferSize - outstanding);
-          outstanding = chunkBufferSize;
-          payloadDataSize = 0;
+        if (auto credits =
+                window.onPayload(payloadSize, std::exchange(waited, false))) {
+          streamBridge->requestN(credits);
         }
       }
     }
@@ -477,14 +478,12 @@ class ClientBufferedStream {
         OnNextTry onNextTry,
         apache::thrift::detail::ClientStreamBridge::ClientPtr streamBridge,
         folly::Try<T> (*decode)(folly::Try<StreamPayload>&&),
-        int32_t chunkBufferSize)
+        const BufferOptions& bufferOptions)
         : e_(e),
           onNextTry_(std::move(onNextTry)),
           decode_(decode),
-          chunkBufferSize_(chunkBufferSize),
-          state_(std::make_shared<SharedState>(std::move(streamBridge))) {
-      outstanding_ = chunkBufferSize_;
-    }
+          window_(bufferOptions),
+          state_(std::make_shared<SharedState>(std::move(streamBridge))) {}
 
     ~Continuation() {
       state_->promise.setValue();
@@ -500,6 +499,7 @@ class ClientBufferedStream {
     }
 
     void consume() override {
+      waited_ = true;
       e_->add([this]() { (*this)(); });
     }
 
@@ -526,6 +526,7 @@ class ClientBufferedStream {
           }
         }
 
+        size_t payloadSize = 0;
         {
           auto& payload = queue.front();
           if (!payload.hasValue() && !payload.hasException()) {
@@ -539,7 +540,7 @@ class ClientBufferedStream {
               queue.pop();
               continue;
             }
-            payloadDataSize_ += payload->payload->computeChainDataLength();
+            payloadSize = payload->payload->computeChainDataLength();
           }
           auto value = decode_(std::move(payload));
           queue.pop();
@@ -550,11 +551,9 @@ class ClientBufferedStream {
           }
         }
 
-        if ((--outstanding_ <= chunkBufferSize_ / 2) ||
-            (payloadDataSize_ >= kRequestCreditPayloadSize)) {
-          state_->streamBridge->requestN(chunkBufferSize_ - outstanding_);
-          outstanding_ = chunkBufferSize_;
-          payloadDataSize_ = 0;
+        if (auto credits = window_.onPayload(
+                payloadSize, std::exchange(waited_, false))) {
+          state_->streamBridge->requestN(credits);
         }
       }
     }
@@ -563,9 +562,9 @@ class ClientBufferedStream {
     folly::Executor::KeepAlive<> e_;
     OnNextTry onNextTry_;
     folly::Try<T> (*decode_)(folly::Try<StreamPayload>&&);
-    int32_t chunkBufferSize_;
-    int32_t outstanding_;
-    size_t payloadDataSize_{0};
+    apache::thrift::detail::StreamCreditWindow window_;
+    // Whether the consumer had to wait for the next payload.
+    bool waited_{false};
     std::shared_ptr<SharedState> state_;
     friend class ClientBufferedStream;
   };
@@ -573,7 +572,8 @@ class ClientBufferedStream {
   apache::thrift::detail::ClientStreamBridge::ClientPtr streamBridge_;
   folly::Try<T> (*decode_)(folly::Try<StreamPayload>&&) = nullptr;
   BufferOptions bufferOptions_;
-  static constexpr size_t kRequestCreditPayloadSize = 16384;
+  static constexpr size_t kRequestCreditPayloadSize =
+      apache::thrift::detail::StreamCreditWindow::kRequestCreditPayloadSize;
 
   friend class yarpl::flowable::ThriftStreamShim;
 };
@@ -27,6 +27,10 @@ namespace thrift {
 struct BufferOptions {
   int32_t chunkSize{100};
   size_t memSize{0};
+  // If set, chunkSize is only the initial number of credits, which is then
+  // tuned to the stream's throughput, see detail::StreamCreditWindow.
+  int32_t maxChunkSize{0};
+  size_t maxMemSize{0};
 };
 
 namespace detail {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <folly/Executor.h>
+
+#include <thrift/lib/cpp2/async/RequestCallback.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+// Forwards the results of a request to cb on the given executor.
+template <bool oneWay>
+class ExecutorRequestCallback final : public RequestClientCallback {
+ public:
+  ExecutorRequestCallback(
+      RequestClientCallback::Ptr cb,
+      folly::Executor::KeepAlive<> executorKeepAlive)
+      : executorKeepAlive_(std::move(executorKeepAlive)), cb_(std::move(cb)) {
+    CHECK(executorKeepAlive_);
+  }
+
+  void onRequestSent() noexcept override {
+    if (oneWay) {
+      executorKeepAlive_.get()->add(
+          [cb = std::move(cb_)]() mutable { cb.release()->onRequestSent(); });
+      delete this;
+    } else {
+      requestSent_ = true;
+    }
+  }
+  void onResponse(ClientReceiveState&& rs) noexcept override {
+    executorKeepAlive_.get()->add([requestSent = requestSent_,
+                                   cb = std::move(cb_),
+                                   rs = std::move(rs)]() mutable {
+      if (requestSent) {
+        cb->onRequestSent();
+      }
+      cb.release()->onResponse(std::move(rs));
+    });
+    delete this;
+  }
+  void onResponseError(folly::exception_wrapper ex) noexcept override {
+    executorKeepAlive_.get()->add([requestSent = requestSent_,
+                                   cb = std::move(cb_),
+                                   ex = std::move(ex)]() mutable {
+      if (requestSent) {
+        cb->onRequestSent();
+      }
+      cb.release()->onResponseError(std::move(ex));
+    });
+    delete this;
+  }
+
+ private:
+  bool requestSent_{false};
+  folly::Executor::KeepAlive<> executorKeepAlive_;
+  RequestClientCallback::Ptr cb_;
+};
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
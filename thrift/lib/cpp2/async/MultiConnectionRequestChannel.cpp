@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/MultiConnectionRequestChannel.h>
+
+#include <algorithm>
+
+#include <folly/Random.h>
+
+#include <thrift/lib/cpp2/async/ExecutorRequestCallback.h>
+
+namespace apache {
+namespace thrift {
+
+struct MultiConnectionRequestChannel::Connection {
+  explicit Connection(folly::Executor::KeepAlive<folly::EventBase> eventBase)
+      : evb(std::move(eventBase)) {}
+
+  ~Connection();
+
+  const folly::Executor::KeepAlive<folly::EventBase> evb;
+  std::atomic<size_t> outstanding{0};
+  // Created lazily, only accessed on evb.
+  ImplPtr channel;
+};
+
+namespace {
+using Connection = MultiConnectionRequestChannel::Connection;
+
+struct InteractionState {
+  std::shared_ptr<Connection> connection;
+  apache::thrift::ManagedStringView name;
+  InteractionId id;
+};
+
+void maybeCreateInteraction(
+    const RpcOptions& options,
+    MultiConnectionRequestChannel::Impl& channel) {
+  if (auto id = options.getInteractionId()) {
+    auto* state = reinterpret_cast<InteractionState*>(id);
+    if (!state->id) {
+      state->id = channel.registerInteraction(std::move(state->name), id);
+    }
+  }
+}
+
+// Drops the channel once nothing uses it anymore. Runs on its IO thread.
+void closeWhenDetachable(MultiConnectionRequestChannel::ImplPtr channel) {
+  if (channel->isDetachable()) {
+    return;
+  }
+  auto* raw = channel.get();
+  raw->setOnDetachable([channel = std::move(channel)]() mutable {
+    if (!channel) {
+      return;
+    }
+    // The channel can't be destroyed from its own callback.
+    auto* evb = channel->getEventBase();
+    evb->runInLoop([channel = std::move(channel)] {
+      channel->unsetOnDetachable();
+    });
+  });
+}
+
+// Keeps track of the requests outstanding on a connection.
+template <bool oneWay>
+class OutstandingRequestCallback final : public RequestClientCallback {
+ public:
+  OutstandingRequestCallback(
+      std::shared_ptr<Connection> connection,
+      RequestClientCallback::Ptr cb)
+      : connection_(std::move(connection)), cb_(std::move(cb)) {
+    connection_->outstanding.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void onRequestSent() noexcept override {
+    if (oneWay) {
+      done();
+      cb_.release()->onRequestSent();
+      delete this;
+    } else {
+      cb_->onRequestSent();
+    }
+  }
+  void onResponse(ClientReceiveState&& rs) noexcept override {
+    done();
+    cb_.release()->onResponse(std::move(rs));
+    delete this;
+  }
+  void onResponseError(folly::exception_wrapper ex) noexcept override {
+    done();
+    cb_.release()->onResponseError(std::move(ex));
+    delete this;
+  }
+
+  bool isSync() const override {
+    return cb_->isSync();
+  }
+  bool isInlineSafe() const override {
+    return cb_->isInlineSafe();
+  }
+
+ private:
+  void done() {
+    connection_->outstanding.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::shared_ptr<Connection> connection_;
+  RequestClientCallback::Ptr cb_;
+};
+} // namespace
+
+MultiConnectionRequestChannel::Connection::~Connection() {
+  if (channel) {
+    evb.copy().add([channel = std::move(channel)](auto&&) mutable {
+      closeWhenDetachable(std::move(channel));
+    });
+  }
+}
+
+MultiConnectionRequestChannel::MultiConnectionRequestChannel(
+    folly::Executor* callbackExecutor,
+    std::weak_ptr<folly::IOExecutor> executor,
+    ImplCreator implCreator,
+    Options options)
+    : implCreator_(std::move(implCreator)),
+      options_(options),
+      callbackExecutor_(callbackExecutor),
+      executor_(std::move(executor)) {
+  CHECK_GE(options_.minConnections, 1);
+  CHECK_LE(options_.minConnections, options_.maxConnections);
+  auto connections = connections_.wlock();
+  for (size_t i = 0; i < options_.minConnections; ++i) {
+    connections->push_back(newConnection());
+  }
+}
+
+std::shared_ptr<MultiConnectionRequestChannel::Connection>
+MultiConnectionRequestChannel::newConnection() {
+  auto executor = executor_.lock();
+  if (!executor) {
+    throw std::logic_error("IO executor already destroyed.");
+  }
+  // IOExecutors hand out their event bases in turn.
+  return std::make_shared<Connection>(
+      folly::getKeepAliveToken(executor->getEventBase()));
+}
+
+std::shared_ptr<MultiConnectionRequestChannel::Connection>
+MultiConnectionRequestChannel::pickConnection() {
+  std::shared_ptr<Connection> picked;
+  size_t numConnections;
+  {
+    auto connections = connections_.rlock();
+    numConnections = connections->size();
+    auto load = [&](size_t i) {
+      return (*connections)[i]->outstanding.load(std::memory_order_relaxed);
+    };
+    size_t best = 0;
+    if (numConnections > 1 &&
+        options_.balancing == Balancing::LEAST_OUTSTANDING) {
+      for (size_t i = 1; i < numConnections; ++i) {
+        if (load(i) < load(best)) {
+          best = i;
+        }
+      }
+    } else if (numConnections > 1) {
+      size_t first = folly::Random::rand32(numConnections);
+      size_t second = folly::Random::rand32(numConnections - 1);
+      if (second >= first) {
+        ++second;
+      }
+      best = load(second) < load(first) ? second : first;
+    }
+    picked = (*connections)[best];
+  }
+
+  maybeResize(numConnections);
+  return picked;
+}
+
+void MultiConnectionRequestChannel::maybeResize(size_t numConnections) {
+  if (options_.minConnections == options_.maxConnections) {
+    return;
+  }
+  auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count();
+  auto last = lastResizeCheck_.load(std::memory_order_relaxed);
+  if (now - last <
+          std::chrono::nanoseconds(options_.resizeInterval).count() ||
+      !lastResizeCheck_.compare_exchange_strong(last, now)) {
+    return;
+  }
+
+  auto outstanding = getOutstandingRequestCount();
+  if (outstanding > options_.growAbove * numConnections &&
+      numConnections < options_.maxConnections) {
+    auto connection = newConnection();
+    auto connections = connections_.wlock();
+    if (connections->size() < options_.maxConnections) {
+      connections->push_back(std::move(connection));
+    }
+  } else if (
+      outstanding < options_.shrinkBelow * numConnections &&
+      numConnections > options_.minConnections) {
+    std::shared_ptr<Connection> retired;
+    auto connections = connections_.wlock();
+    if (connections->size() > options_.minConnections) {
+      auto it = std::min_element(
+          connections->begin(),
+          connections->end(),
+          [](const auto& a, const auto& b) {
+            return a->outstanding.load(std::memory_order_relaxed) <
+                b->outstanding.load(std::memory_order_relaxed);
+          });
+      // In flight requests keep the connection alive.
+      retired = std::move(*it);
+      *it = std::move(connections->back());
+      connections->pop_back();
+    }
+  }
+}
+
+std::shared_ptr<MultiConnectionRequestChannel::Connection>
+MultiConnectionRequestChannel::getConnection(const RpcOptions& options) {
+  if (options.getInteractionId()) {
+    return reinterpret_cast<InteractionState*>(options.getInteractionId())
+        ->connection;
+  }
+  return pickConnection();
+}
+
+MultiConnectionRequestChannel::Impl& MultiConnectionRequestChannel::impl(
+    Connection& connection) {
+  DCHECK(connection.evb->inRunningEventBaseThread());
+
+  if (connection.channel && !connection.channel->good()) {
+    closeWhenDetachable(std::move(connection.channel));
+    connection.channel = nullptr;
+  }
+  if (!connection.channel) {
+    connection.channel = implCreator_(*connection.evb);
+  }
+  return *connection.channel;
+}
+
+template <typename SendFunc>
+void MultiConnectionRequestChannel::sendRequestImpl(
+    std::shared_ptr<Connection> connection,
+    SendFunc&& sendFunc) {
+  auto& evb = *connection->evb;
+  evb.runInEventBaseThread(
+      [this,
+       connection = std::move(connection),
+       sendFunc = std::forward<SendFunc>(sendFunc)]() mutable {
+        sendFunc(impl(*connection));
+      });
+}
+
+uint16_t MultiConnectionRequestChannel::getProtocolId() {
+  folly::call_once(protocolIdInitFlag_, [&] {
+    auto connection = pickConnection();
+    connection->evb->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [&] { protocolId_ = impl(*connection).getProtocolId(); });
+  });
+
+  return protocolId_;
+}
+
+void MultiConnectionRequestChannel::sendRequestResponse(
+    const RpcOptions& options,
+    apache::thrift::ManagedStringView&& methodName,
+    SerializedRequest&& request,
+    std::shared_ptr<transport::THeader> header,
+    RequestClientCallback::Ptr cob) {
+  if (!cob->isInlineSafe()) {
+    cob = RequestClientCallback::Ptr(new detail::ExecutorRequestCallback<false>(
+        std::move(cob), getKeepAliveToken(callbackExecutor_)));
+  }
+  auto connection = getConnection(options);
+  cob = RequestClientCallback::Ptr(
+      new OutstandingRequestCallback<false>(connection, std::move(cob)));
+  sendRequestImpl(
+      std::move(connection),
+      [options,
+       methodName = std::move(methodName),
+       request = std::move(request),
+       header = std::move(header),
+       cob = std::move(cob)](Impl& channel) mutable {
+        maybeCreateInteraction(options, channel);
+        channel.sendRequestResponse(
+            options,
+            std::move(methodName),
+            std::move(request),
+            std::move(header),
+            std::move(cob));
+      });
+}
+
+void MultiConnectionRequestChannel::sendRequestNoResponse(
+    const RpcOptions& options,
+    apache::thrift::ManagedStringView&& methodName,
+    SerializedRequest&& request,
+    std::shared_ptr<transport::THeader> header,
+    RequestClientCallback::Ptr cob) {
+  if (!cob->isInlineSafe()) {
+    cob = RequestClientCallback::Ptr(new detail::ExecutorRequestCallback<true>(
+        std::move(cob), getKeepAliveToken(callbackExecutor_)));
+  }
+  auto connection = getConnection(options);
+  cob = RequestClientCallback::Ptr(
+      new OutstandingRequestCallback<true>(connection, std::move(cob)));
+  sendRequestImpl(
+      std::move(connection),
+      [options,
+       methodName = std::move(methodName),
+       request = std::move(request),
+       header = std::move(header),
+       cob = std::move(cob)](Impl& channel) mutable {
+        maybeCreateInteraction(options, channel);
+        channel.sendRequestNoResponse(
+            options,
+            std::move(methodName),
+            std::move(request),
+            std::move(header),
+            std::move(cob));
+      });
+}
+
+void MultiConnectionRequestChannel::sendRequestStream(
+    const RpcOptions& options,
+    apache::thrift::ManagedStringView&& methodName,
+    SerializedRequest&& request,
+    std::shared_ptr<transport::THeader> header,
+    StreamClientCallback* cob) {
+  sendRequestImpl(
+      getConnection(options),
+      [options,
+       methodName = std::move(methodName),
+       request = std::move(request),
+       header = std::move(header),
+       cob](Impl& channel) mutable {
+        maybeCreateInteraction(options, channel);
+        channel.sendRequestStream(
+            options,
+            std::move(methodName),
+            std::move(request),
+            std::move(header),
+            cob);
+      });
+}
+
+void MultiConnectionRequestChannel::sendRequestSink(
+    const RpcOptions& options,
+    apache::thrift::ManagedStringView&& methodName,
+    SerializedRequest&& request,
+    std::shared_ptr<transport::THeader> header,
+    SinkClientCallback* cob) {
+  sendRequestImpl(
+      getConnection(options),
+      [options,
+       methodName = std::move(methodName),
+       request = std::move(request),
+       header = std::move(header),
+       cob](Impl& channel) mutable {
+        maybeCreateInteraction(options, channel);
+        channel.sendRequestSink(
+            options,
+            std::move(methodName),
+            std::move(request),
+            std::move(header),
+            cob);
+      });
+}
+
+InteractionId MultiConnectionRequestChannel::createInteraction(
+    ManagedStringView&& name) {
+  CHECK(!name.view().empty());
+  return createInteractionId(reinterpret_cast<int64_t>(
+      new InteractionState{pickConnection(), std::move(name), {}}));
+}
+
+void MultiConnectionRequestChannel::terminateInteraction(
+    InteractionId idWrapper) {
+  int64_t id = idWrapper;
+  releaseInteractionId(std::move(idWrapper));
+  std::unique_ptr<InteractionState> state(
+      reinterpret_cast<InteractionState*>(id));
+  auto& evb = *state->connection->evb;
+  evb.runInEventBaseThread([connection = std::move(state->connection),
+                            id = std::move(state->id)]() mutable {
+    if (connection->channel) {
+      connection->channel->terminateInteraction(std::move(id));
+    } else {
+      // channel is only null if nothing was ever sent on that connection,
+      // in which case server doesn't know about this interaction
+      DCHECK(!id);
+    }
+  });
+}
+
+size_t MultiConnectionRequestChannel::getConnectionCount() const {
+  return connections_.rlock()->size();
+}
+
+size_t MultiConnectionRequestChannel::getOutstandingRequestCount() const {
+  size_t outstanding = 0;
+  auto connections = connections_.rlock();
+  for (const auto& connection : *connections) {
+    outstanding += connection->outstanding.load(std::memory_order_relaxed);
+  }
+  return outstanding;
+}
+
+} // namespace thrift
+} // namespace apache
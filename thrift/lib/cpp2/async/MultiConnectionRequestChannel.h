@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/executors/IOExecutor.h>
+
+#include <thrift/lib/cpp2/async/ClientChannel.h>
+#include <thrift/lib/cpp2/async/RequestChannel.h>
+
+namespace apache {
+namespace thrift {
+
+// RequestChannel that spreads requests to one endpoint over several
+// connections (e.g. RocketClientChannels), each living on an IO thread of
+// the given executor, so that a single busy client is not limited to one
+// core and one TCP connection.
+//
+// Like PooledRequestChannel, it may be used from any thread, and runs
+// callbacks that are not inline-safe on callbackExecutor. Each request goes to
+// the connection with the fewest outstanding requests, either out of all of
+// them or out of two picked at random. Every Options::resizeInterval the
+// average number of outstanding requests per connection is checked, and a
+// connection is added above Options::growAbove or retired below
+// Options::shrinkBelow. A retired connection is closed once its last request
+// or stream completes. Connections that went bad are re-created on the next
+// request sent over them.
+//
+// Outstanding streams and sinks keep their connection open, but are not
+// counted when balancing. All requests of an interaction go over the
+// connection it was created on.
+class MultiConnectionRequestChannel : public RequestChannel {
+ public:
+  using Impl = ClientChannel;
+  using ImplPtr = std::shared_ptr<Impl>;
+  // Called on the IO thread the connection will live on. Must return a new
+  // connection to the same endpoint every time.
+  using ImplCreator = folly::Function<ImplPtr(folly::EventBase&)>;
+
+  enum class Balancing {
+    LEAST_OUTSTANDING,
+    POWER_OF_TWO_CHOICES,
+  };
+
+  struct Options {
+    size_t minConnections{1};
+    size_t maxConnections{8};
+    Balancing balancing{Balancing::POWER_OF_TWO_CHOICES};
+    // Average outstanding requests per connection.
+    size_t growAbove{32};
+    size_t shrinkBelow{4};
+    std::chrono::milliseconds resizeInterval{1000};
+  };
+
+  static std::unique_ptr<
+      MultiConnectionRequestChannel,
+      folly::DelayedDestruction::Destructor>
+  newSyncChannel(
+      std::weak_ptr<folly::IOExecutor> executor,
+      ImplCreator implCreator,
+      Options options = Options()) {
+    return {
+        new MultiConnectionRequestChannel(
+            nullptr, std::move(executor), std::move(implCreator), options),
+        {}};
+  }
+
+  static std::unique_ptr<
+      MultiConnectionRequestChannel,
+      folly::DelayedDestruction::Destructor>
+  newChannel(
+      folly::Executor* callbackExecutor,
+      std::weak_ptr<folly::IOExecutor> executor,
+      ImplCreator implCreator,
+      Options options = Options()) {
+    return {
+        new MultiConnectionRequestChannel(
+            callbackExecutor,
+            std::move(executor),
+            std::move(implCreator),
+            options),
+        {}};
+  }
+
+  void sendRequestResponse(
+      const RpcOptions& options,
+      ManagedStringView&& methodName,
+      SerializedRequest&&,
+      std::shared_ptr<transport::THeader> header,
+      RequestClientCallback::Ptr cob) override;
+
+  void sendRequestNoResponse(
+      const RpcOptions& options,
+      ManagedStringView&& methodName,
+      SerializedRequest&&,
+      std::shared_ptr<transport::THeader> header,
+      RequestClientCallback::Ptr cob) override;
+
+  void sendRequestStream(
+      const RpcOptions& options,
+      ManagedStringView&& methodName,
+      SerializedRequest&&,
+      std::shared_ptr<transport::THeader> header,
+      StreamClientCallback* cob) override;
+
+  void sendRequestSink(
+      const RpcOptions& options,
+      ManagedStringView&& methodName,
+      SerializedRequest&&,
+      std::shared_ptr<transport::THeader> header,
+      SinkClientCallback* cob) override;
+
+  using RequestChannel::sendRequestNoResponse;
+  using RequestChannel::sendRequestResponse;
+  using RequestChannel::sendRequestSink;
+  using RequestChannel::sendRequestStream;
+
+  void setCloseCallback(CloseCallback*) override {
+    LOG(FATAL) << "Not supported";
+  }
+
+  folly::EventBase* getEventBase() const override {
+    return nullptr;
+  }
+
+  uint16_t getProtocolId() override;
+
+  // may be called from any thread
+  void terminateInteraction(InteractionId id) override;
+
+  // may be called from any thread
+  InteractionId createInteraction(ManagedStringView&& name) override;
+
+  size_t getConnectionCount() const;
+
+  // Requests sent but not answered yet, over all connections.
+  size_t getOutstandingRequestCount() const;
+
+  struct Connection;
+
+ private:
+  MultiConnectionRequestChannel(
+      folly::Executor* callbackExecutor,
+      std::weak_ptr<folly::IOExecutor> executor,
+      ImplCreator implCreator,
+      Options options);
+
+  template <typename SendFunc>
+  void sendRequestImpl(
+      std::shared_ptr<Connection> connection,
+      SendFunc&& sendFunc);
+
+  std::shared_ptr<Connection> newConnection();
+
+  // Picks the connection for a request outside of an interaction.
+  std::shared_ptr<Connection> pickConnection();
+  std::shared_ptr<Connection> getConnection(const RpcOptions& options);
+
+  void maybeResize(size_t numConnections);
+
+  // Must be called on the connection's IO thread.
+  Impl& impl(Connection& connection);
+
+  ImplCreator implCreator_;
+  const Options options_;
+
+  folly::Executor* callbackExecutor_{nullptr};
+  std::weak_ptr<folly::IOExecutor> executor_;
+
+  folly::Synchronized<
+      std::vector<std::shared_ptr<Connection>>,
+      folly::SharedMutex>
+      connections_;
+  // steady_clock time of the last resize check, in nanoseconds.
+  std::atomic<int64_t> lastResizeCheck_{0};
+
+  folly::once_flag protocolIdInitFlag_;
+  uint16_t protocolId_;
+};
+
+} // namespace thrift
+} // namespace apache
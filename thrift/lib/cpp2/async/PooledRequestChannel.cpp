@@ -16,6 +16,7 @@
 
 #include <thrift/lib/cpp2/async/PooledRequestChannel.h>
 
+#include <thrift/lib/cpp2/async/ExecutorRequestCallback.h>
 #include <thrift/lib/cpp2/async/FutureRequest.h>
 
 #include <folly/futures/Future.h>
@@ -76,56 +77,6 @@ void PooledRequestChannel::sendRequestImpl(
       });
 }
 
-namespace {
-template <bool oneWay>
-class ExecutorRequestCallback final : public RequestClientCallback {
- public:
-  ExecutorRequestCallback(
-      RequestClientCallback::Ptr cb,
-      folly::Executor::KeepAlive<> executorKeepAlive)
-      : executorKeepAlive_(std::move(executorKeepAlive)), cb_(std::move(cb)) {
-    CHECK(executorKeepAlive_);
-  }
-
-  void onRequestSent() noexcept override {
-    if (oneWay) {
-      executorKeepAlive_.get()->add(
-          [cb = std::move(cb_)]() mutable { cb.release()->onRequestSent(); });
-      delete this;
-    } else {
-      requestSent_ = true;
-    }
-  }
-  void onResponse(ClientReceiveState&& rs) noexcept override {
-    executorKeepAlive_.get()->add([requestSent = requestSent_,
-                                   cb = std::move(cb_),
-                                   rs = std::move(rs)]() mutable {
-      if (requestSent) {
-        cb->onRequestSent();
-      }
-      cb.release()->onResponse(std::move(rs));
-    });
-    delete this;
-  }
-  void onResponseError(folly::exception_wrapper ex) noexcept override {
-    executorKeepAlive_.get()->add([requestSent = requestSent_,
-                                   cb = std::move(cb_),
-                                   ex = std::move(ex)]() mutable {
-      if (requestSent) {
-        cb->onRequestSent();
-      }
-      cb.release()->onResponseError(std::move(ex));
-    });
-    delete this;
-  }
-
- private:
-  bool requestSent_{false};
-  folly::Executor::KeepAlive<> executorKeepAlive_;
-  RequestClientCallback::Ptr cb_;
-};
-} // namespace
-
 void PooledRequestChannel::sendRequestResponse(
     const RpcOptions& options,
     apache::thrift::ManagedStringView&& methodName,
@@ -133,7 +84,7 @@ void PooledRequestChannel::sendRequestResponse(
     std::shared_ptr<transport::THeader> header,
     RequestClientCallback::Ptr cob) {
   if (!cob->isInlineSafe()) {
-    cob = RequestClientCallback::Ptr(new ExecutorRequestCallback<false>(
+    cob = RequestClientCallback::Ptr(new detail::ExecutorRequestCallback<false>(
         std::move(cob), getKeepAliveToken(callbackExecutor_)));
   }
   sendRequestImpl(
@@ -160,7 +111,7 @@ void PooledRequestChannel::sendRequestNoResponse(
     std::shared_ptr<transport::THeader> header,
     RequestClientCallback::Ptr cob) {
   if (!cob->isInlineSafe()) {
-    cob = RequestClientCallback::Ptr(new ExecutorRequestCallback<true>(
+    cob = RequestClientCallback::Ptr(new detail::ExecutorRequestCallback<true>(
         std::move(cob), getKeepAliveToken(callbackExecutor_)));
   }
   sendRequestImpl(
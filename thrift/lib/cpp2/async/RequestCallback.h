@@ -480,10 +480,17 @@ class RpcOptions {
     return chunkTimeout_;
   }
 
+  /**
+   * Sets a fixed credit window. Overrides an earlier
+   * setAdaptiveChunkBufferSize(); to set the initial window of an adaptive
+   * stream call this first.
+   */
   RpcOptions& setChunkBufferSize(int32_t chunkBufferSize) {
     CHECK_EQ(bufferOptions_.memSize, 0)
         << "Only one of setMemoryBufferSize and setChunkBufferSize should be called";
     bufferOptions_.chunkSize = chunkBufferSize;
+    bufferOptions_.maxChunkSize = 0;
+    bufferOptions_.maxMemSize = 0;
     return *this;
   }
 
@@ -491,9 +498,26 @@ class RpcOptions {
     return bufferOptions_.chunkSize;
   }
 
+  /**
+   * Lets the stream grow or shrink its credit window, starting at
+   * getChunkBufferSize(), to keep the producer busy over the observed round
+   * trip time. The window stays within maxChunks credits and maxBytes of
+   * buffered payloads (if non-zero).
+   */
+  RpcOptions& setAdaptiveChunkBufferSize(int32_t maxChunks, size_t maxBytes) {
+    CHECK_EQ(bufferOptions_.memSize, 0)
+        << "setAdaptiveChunkBufferSize and setMemoryBufferSize are exclusive";
+    CHECK_GE(maxChunks, bufferOptions_.chunkSize);
+    bufferOptions_.maxChunkSize = maxChunks;
+    bufferOptions_.maxMemSize = maxBytes;
+    return *this;
+  }
+
   RpcOptions& setMemoryBufferSize(size_t targetBytes, int32_t initialChunks) {
     CHECK_EQ(bufferOptions_.chunkSize, 100)
         << "Only one of setMemoryBufferSize and setChunkBufferSize should be called";
+    CHECK_EQ(bufferOptions_.maxChunkSize, 0)
+        << "setAdaptiveChunkBufferSize and setMemoryBufferSize are exclusive";
     CHECK_GT(targetBytes, 0);
     bufferOptions_.memSize = targetBytes;
     bufferOptions_.chunkSize = initialChunks;
@@ -504,6 +528,21 @@ class RpcOptions {
     return bufferOptions_;
   }
 
+  /**
+   * Lets the server pack several stream items into one frame, which cuts the
+   * per-item overhead of streams with many small items. Items arrive as
+   * usual. Only supported by Rocket; servers that do not support it ignore
+   * it.
+   */
+  RpcOptions& setStreamBatchingConfig(StreamBatchingConfig config) {
+    streamBatchingConfig_ = std::move(config);
+    return *this;
+  }
+
+  const std::optional<StreamBatchingConfig>& getStreamBatchingConfig() const {
+    return streamBatchingConfig_;
+  }
+
   RpcOptions& setQueueTimeout(std::chrono::milliseconds queueTimeout) {
     queueTimeout_ = queueTimeout;
     return *this;
@@ -624,6 +663,7 @@ class RpcOptions {
   bool enableChecksum_{false};
   bool enablePageAlignment_{false};
   BufferOptions bufferOptions_;
+  std::optional<StreamBatchingConfig> streamBatchingConfig_;
   int64_t interactionId_{0};
 
   std::string routingKey_;
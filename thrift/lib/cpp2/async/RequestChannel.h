@@ -25,6 +25,7 @@
 
 #include <folly/ExceptionWrapper.h>
 #include <folly/Function.h>
+#include <folly/Optional.h>
 #include <folly/String.h>
 #include <folly/Utility.h>
 #include <folly/fibers/FiberManager.h>
@@ -312,7 +313,16 @@ SerializedRequest preprocessSendT(
     queue.append(std::move(buf));
 
     prot->setOutput(&queue, bufSize);
-    auto guard = folly::makeGuard([&] { prot->setOutput(nullptr); });
+    // Large values are checksummed as they are written.
+    folly::Optional<apache::thrift::checksum::QueueChecksum> checksum;
+    if (rpcOptions.getEnableChecksum()) {
+      checksum.emplace(queue);
+      prot->setOutputChecksum(&*checksum);
+    }
+    auto guard = folly::makeGuard([&] {
+      prot->setOutput(nullptr);
+      prot->setOutputChecksum(nullptr);
+    });
     try {
       ctx.preWrite();
       writefunc(prot);
@@ -328,8 +338,8 @@ SerializedRequest preprocessSendT(
       throw;
     }
 
-    if (rpcOptions.getEnableChecksum()) {
-      header.setCrc32c(apache::thrift::checksum::crc32c(*queue.front()));
+    if (checksum) {
+      header.setCrc32c(checksum->value());
     }
 
     return SerializedRequest(queue.move());
@@ -16,11 +16,122 @@
 
 #include <thrift/lib/cpp2/async/RetryingRequestChannel.h>
 
+#include <algorithm>
+#include <vector>
+
+#include <folly/container/F14Map.h>
 #include <folly/io/async/AsyncSocketException.h>
+#include <folly/io/async/HHWheelTimer.h>
 
 namespace apache {
 namespace thrift {
 
+namespace {
+// Latencies kept per method to compute the hedging delay from.
+constexpr size_t kLatencyWindow = 128;
+// Latencies to observe before the percentile is used.
+constexpr size_t kMinLatencySamples = 32;
+// The percentile is recomputed after this many new latencies.
+constexpr size_t kLatencyRecomputeInterval = 16;
+// Unused hedging budget accumulates up to this many hedges.
+constexpr double kMaxBudgetTokens = 10;
+} // namespace
+
+// Hedging configuration and state. Apart from the counters, only accessed on
+// the channel's EventBase.
+class RetryingRequestChannel::HedgingState {
+ public:
+  struct Method {
+    std::vector<std::chrono::microseconds> latencies;
+    size_t next{0};
+    size_t samples{0};
+    size_t sinceRecompute{0};
+    std::chrono::milliseconds percentileDelay{0};
+  };
+
+  explicit HedgingState(HedgingOptions options)
+      : options_(std::move(options)) {
+    for (const auto& name : options_.methods) {
+      methods_[name];
+    }
+  }
+
+  // Returns nullptr if the method may not be hedged.
+  Method* getMethod(folly::StringPiece name) {
+    auto it = methods_.find(name);
+    return it == methods_.end() ? nullptr : &it->second;
+  }
+
+  std::chrono::milliseconds getDelay(const Method& method) const {
+    if (options_.delayPercentile > 0 && method.samples >= kMinLatencySamples) {
+      return method.percentileDelay;
+    }
+    return options_.delay;
+  }
+
+  void addLatency(Method& method, std::chrono::microseconds latency) {
+    if (options_.delayPercentile <= 0) {
+      return;
+    }
+    if (method.latencies.size() < kLatencyWindow) {
+      method.latencies.push_back(latency);
+    } else {
+      method.latencies[method.next] = latency;
+      method.next = (method.next + 1) % kLatencyWindow;
+    }
+    if (++method.samples < kMinLatencySamples ||
+        (method.samples > kMinLatencySamples &&
+         ++method.sinceRecompute < kLatencyRecomputeInterval)) {
+      return;
+    }
+    method.sinceRecompute = 0;
+    auto latencies = method.latencies;
+    // Clamp in floating point first: converting a negative or out of range
+    // double to size_t is undefined.
+    auto percentile = std::clamp(options_.delayPercentile, 0.0, 1.0);
+    auto rank = std::min(
+        latencies.size() - 1,
+        static_cast<size_t>(percentile * latencies.size()));
+    auto nth = latencies.begin() + rank;
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    method.percentileDelay =
+        std::chrono::ceil<std::chrono::milliseconds>(*nth);
+  }
+
+  void onRequest() {
+    budgetTokens_ = std::min(budgetTokens_ + options_.budget, kMaxBudgetTokens);
+  }
+
+  bool tryFireHedge() {
+    if (budgetTokens_ < 1) {
+      return false;
+    }
+    budgetTokens_ -= 1;
+    hedgesFired_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void onHedgeWon() {
+    hedgesWon_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  size_t getHedgesFired() const {
+    return hedgesFired_.load(std::memory_order_relaxed);
+  }
+
+  size_t getHedgesWon() const {
+    return hedgesWon_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const HedgingOptions options_;
+  // Never modified after construction, so Method references stay valid.
+  folly::F14NodeMap<std::string, Method> methods_;
+  double budgetTokens_{0};
+  std::atomic<size_t> hedgesFired_{0};
+  std::atomic<size_t> hedgesWon_{0};
+};
+
 class RetryingRequestChannel::RequestCallbackBase {
  protected:
   RequestCallbackBase(
@@ -198,6 +309,168 @@ class RetryingRequestChannel::StreamCallback
   StreamClientCallback& clientCallback_;
 };
 
+// A request of a hedged method. Sends the request, and a hedge if it has not
+// completed after the hedging delay. The first response is passed on and the
+// other one dropped. Transport errors are retried once no other attempt is in
+// flight. Deletes itself once all attempts have completed.
+class RetryingRequestChannel::HedgedRequest
+    : public folly::HHWheelTimer::Callback {
+ public:
+  HedgedRequest(
+      folly::Executor::KeepAlive<> ka,
+      RetryingRequestChannel::ImplPtr impl,
+      std::shared_ptr<HedgingState> hedging,
+      HedgingState::Method& method,
+      int retries,
+      const apache::thrift::RpcOptions& options,
+      apache::thrift::RequestClientCallback::Ptr cob,
+      folly::StringPiece methodName,
+      SerializedRequest&& request,
+      std::shared_ptr<apache::thrift::transport::THeader> header)
+      : ka_(std::move(ka)),
+        impl_(std::move(impl)),
+        hedging_(std::move(hedging)),
+        method_(method),
+        retriesLeft_(retries),
+        options_(options),
+        cob_(std::move(cob)),
+        methodName_(methodName.str()),
+        request_(std::move(request)),
+        header_(std::move(header)) {}
+
+  void start(folly::EventBase& evb) {
+    // Sending may fail inline, so schedule the hedge first.
+    evb.timer().scheduleTimeout(this, hedging_->getDelay(method_));
+    send(false);
+  }
+
+  void timeoutExpired() noexcept override {
+    if (hedging_->tryFireHedge()) {
+      send(true);
+    }
+  }
+
+  void callbackCanceled() noexcept override {}
+
+ private:
+  class Attempt final : public apache::thrift::RequestClientCallback {
+   public:
+    Attempt(HedgedRequest& request, bool hedge)
+        : request_(request),
+          hedge_(hedge),
+          start_(std::chrono::steady_clock::now()) {}
+
+    void onRequestSent() noexcept override {}
+
+    void onResponse(
+        apache::thrift::ClientReceiveState&& state) noexcept override {
+      request_.onResponse(*this, std::move(state));
+      delete this;
+    }
+
+    void onResponseError(folly::exception_wrapper ex) noexcept override {
+      request_.onResponseError(std::move(ex));
+      delete this;
+    }
+
+    bool isHedge() const {
+      return hedge_;
+    }
+
+    std::chrono::steady_clock::time_point start() const {
+      return start_;
+    }
+
+   private:
+    HedgedRequest& request_;
+    const bool hedge_;
+    const std::chrono::steady_clock::time_point start_;
+  };
+
+  void send(bool hedge) {
+    ++outstanding_;
+    impl_->sendRequestResponse(
+        options_,
+        methodName_,
+        SerializedRequest(request_.buffer->clone()),
+        header_,
+        RequestClientCallback::Ptr(new Attempt(*this, hedge)));
+  }
+
+  void onResponse(
+      const Attempt& attempt,
+      apache::thrift::ClientReceiveState&& state) {
+    hedging_->addLatency(
+        method_,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - attempt.start()));
+    if (cob_) {
+      cancelTimeout();
+      if (attempt.isHedge()) {
+        hedging_->onHedgeWon();
+      }
+      cob_->onRequestSent();
+      cob_.release()->onResponse(std::move(state));
+    }
+    attemptDone();
+  }
+
+  void onResponseError(folly::exception_wrapper ex) {
+    // Errors are only reported if no other attempt may still succeed.
+    if (cob_ && outstanding_ == 1) {
+      if (ex.is_compatible_with<
+              apache::thrift::transport::TTransportException>() &&
+          retriesLeft_ > 0) {
+        --retriesLeft_;
+        --outstanding_;
+        send(false);
+        return;
+      }
+      cancelTimeout();
+      cob_.release()->onResponseError(std::move(ex));
+    }
+    attemptDone();
+  }
+
+  void attemptDone() {
+    if (--outstanding_ == 0) {
+      DCHECK(!cob_);
+      DCHECK(!isScheduled());
+      delete this;
+    }
+  }
+
+  folly::Executor::KeepAlive<> ka_;
+  RetryingRequestChannel::ImplPtr impl_;
+  std::shared_ptr<HedgingState> hedging_;
+  HedgingState::Method& method_;
+  int retriesLeft_;
+  size_t outstanding_{0};
+  apache::thrift::RpcOptions options_;
+  apache::thrift::RequestClientCallback::Ptr cob_;
+  std::string methodName_;
+  SerializedRequest request_;
+  std::shared_ptr<apache::thrift::transport::THeader> header_;
+};
+
+RetryingRequestChannel::RetryingRequestChannel(
+    folly::EventBase& evb,
+    int numRetries,
+    ImplPtr impl,
+    HedgingOptions hedgingOptions)
+    : impl_(std::move(impl)),
+      numRetries_(numRetries),
+      evb_(evb),
+      hedging_(std::make_shared<HedgingState>(std::move(hedgingOptions))) {}
+
+size_t RetryingRequestChannel::getHedgesFired() const {
+  return hedging_ ? hedging_->getHedgesFired() : 0;
+}
+
+size_t RetryingRequestChannel::getHedgesWon() const {
+  return hedging_ ? hedging_->getHedgesWon() : 0;
+}
+
 void RetryingRequestChannel::sendRequestStream(
     const apache::thrift::RpcOptions& rpcOptions,
     ManagedStringView&& methodName,
@@ -228,6 +501,27 @@ void RetryingRequestChannel::sendRequestResponse(
     SerializedRequest&& request,
     std::shared_ptr<apache::thrift::transport::THeader> header,
     RequestClientCallback::Ptr cob) {
+  // Requests of an interaction are tied to its state on the connection, so
+  // they are not hedged.
+  if (hedging_ && !options.getInteractionId()) {
+    if (auto method = hedging_->getMethod(methodName.view())) {
+      hedging_->onRequest();
+      auto hedgedRequest = new HedgedRequest(
+          folly::getKeepAliveToken(evb_),
+          impl_,
+          hedging_,
+          *method,
+          numRetries_,
+          options,
+          std::move(cob),
+          methodName.view(),
+          std::move(request),
+          std::move(header));
+      hedgedRequest->start(evb_);
+      return;
+    }
+  }
+
   cob = RequestClientCallback::Ptr(new RequestCallback(
       folly::getKeepAliveToken(evb_),
       impl_,
@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <future>
+#include <string>
+
+#include <folly/container/F14Set.h>
 
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 
@@ -25,6 +30,11 @@ namespace thrift {
 
 // Simple RequestChannel wrapper, which automatically retries requests if they
 // fail with a TTransportException.
+//
+// It can also hedge requests: if a request of an opted-in method has not
+// completed after a delay, a duplicate is sent and whichever response arrives
+// first is returned. The response of the other one is dropped when it
+// arrives. Only idempotent methods may be hedged.
 class RetryingRequestChannel : public apache::thrift::RequestChannel {
  public:
   using Impl = apache::thrift::RequestChannel;
@@ -32,11 +42,35 @@ class RetryingRequestChannel : public apache::thrift::RequestChannel {
   using UniquePtr = std::
       unique_ptr<RetryingRequestChannel, folly::DelayedDestruction::Destructor>;
 
+  struct HedgingOptions {
+    // Methods whose requests may be hedged.
+    folly::F14FastSet<std::string> methods;
+    // How long to wait for the response before sending the hedge.
+    std::chrono::milliseconds delay{10};
+    // If set (e.g. 0.95), the hedge is sent once the request has been
+    // outstanding for longer than this percentile of the method's recent
+    // latencies instead. delay is used until enough latencies were observed.
+    double delayPercentile{0};
+    // Hedges may add at most this fraction of extra requests.
+    double budget{0.05};
+  };
+
   static UniquePtr
   newChannel(folly::EventBase& evb, int numRetries, ImplPtr impl) {
     return {new RetryingRequestChannel(evb, numRetries, std::move(impl)), {}};
   }
 
+  static UniquePtr newChannel(
+      folly::EventBase& evb,
+      int numRetries,
+      ImplPtr impl,
+      HedgingOptions hedgingOptions) {
+    return {
+        new RetryingRequestChannel(
+            evb, numRetries, std::move(impl), std::move(hedgingOptions)),
+        {}};
+  }
+
   void sendRequestStream(
       const apache::thrift::RpcOptions& rpcOptions,
       ManagedStringView&& methodName,
@@ -72,19 +106,34 @@ class RetryingRequestChannel : public apache::thrift::RequestChannel {
     return impl_->getProtocolId();
   }
 
+  // Number of hedges sent.
+  size_t getHedgesFired() const;
+  // Number of requests answered by their hedge.
+  size_t getHedgesWon() const;
+
  protected:
   ~RetryingRequestChannel() override = default;
 
   RetryingRequestChannel(folly::EventBase& evb, int numRetries, ImplPtr impl)
       : impl_(std::move(impl)), numRetries_(numRetries), evb_(evb) {}
 
+  RetryingRequestChannel(
+      folly::EventBase& evb,
+      int numRetries,
+      ImplPtr impl,
+      HedgingOptions hedgingOptions);
+
   class RequestCallbackBase;
   class RequestCallback;
   class StreamCallback;
+  class HedgingState;
+  class HedgedRequest;
 
   ImplPtr impl_;
   int numRetries_;
   folly::EventBase& evb_;
+  // Shared with outstanding hedged requests, which may outlive the channel.
+  std::shared_ptr<HedgingState> hedging_;
 };
 } // namespace thrift
 } // namespace apache
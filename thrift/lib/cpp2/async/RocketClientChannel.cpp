@@ -17,7 +17,9 @@
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <fmt/core.h>
 #include <folly/ExceptionString.h>
@@ -45,13 +47,18 @@
 #include <thrift/lib/cpp2/transport/core/RpcMetadataUtil.h>
 #include <thrift/lib/cpp2/transport/core/ThriftClientCallback.h>
 #include <thrift/lib/cpp2/transport/core/TryUtil.h>
+#include <thrift/lib/cpp2/transport/rocket/MetadataInterning.h>
 #include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
 #include <thrift/lib/cpp2/transport/rocket/RocketException.h>
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
 #include <thrift/lib/cpp2/transport/rocket/client/RocketClient.h>
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_constants.h>
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
 
 THRIFT_FLAG_DEFINE_bool(rocket_client_new_protocol_key, false);
+// Size of the metadata interning table to offer in the setup frame, 0 to not
+// intern metadata.
+THRIFT_FLAG_DEFINE_int64(rocket_client_interned_metadata_entries, 0);
 
 using namespace apache::thrift::transport;
 
@@ -449,9 +456,35 @@ class FirstRequestProcessorSink : public SinkClientCallback,
   folly::EventBase* evb_;
 };
 
-void setCompression(RequestRpcMetadata& metadata, ssize_t payloadSize) {
+constexpr uint64_t compressionAlgoBit(CompressionAlgorithm algorithm) {
+  return 1ull << (static_cast<int>(algorithm) - 1);
+}
+
+// Codecs responses can be compressed with, encoded as in
+// NegotiationParameters.compressionAlgos.
+constexpr uint64_t kAcceptedCompressionAlgos =
+    compressionAlgoBit(CompressionAlgorithm::ZLIB) |
+    compressionAlgoBit(CompressionAlgorithm::ZSTD) |
+    compressionAlgoBit(CompressionAlgorithm::LZ4);
+
+void setCompression(
+    RequestRpcMetadata& metadata,
+    ssize_t payloadSize,
+    const folly::Optional<int32_t>& zstdDictionaryId) {
   if (auto compressionConfig = metadata.compressionConfig_ref()) {
     if (auto codecRef = compressionConfig->codecConfig_ref()) {
+      // Lets the server pick a cheaper codec for responses.
+      if (!compressionConfig->acceptedAlgos_ref()) {
+        compressionConfig->acceptedAlgos_ref() = kAcceptedCompressionAlgos;
+      }
+      // Also tells the server which dictionary to compress responses with.
+      if (codecRef->getType() == CodecConfig::zstdConfig) {
+        if (zstdDictionaryId) {
+          codecRef->mutable_zstdConfig().dictionaryId_ref() = *zstdDictionaryId;
+        } else {
+          codecRef->mutable_zstdConfig().dictionaryId_ref().reset();
+        }
+      }
       if (payloadSize >
           compressionConfig->compressionSizeLimit_ref().value_or(0)) {
         switch (codecRef->getType()) {
@@ -460,6 +493,12 @@ void setCompression(RequestRpcMetadata& metadata, ssize_t payloadSize) {
             break;
           case CodecConfig::zstdConfig:
             metadata.compression_ref() = CompressionAlgorithm::ZSTD;
+            if (zstdDictionaryId) {
+              metadata.compressionDictionaryId_ref() = *zstdDictionaryId;
+            }
+            break;
+          case CodecConfig::lz4Config:
+            metadata.compression_ref() = CompressionAlgorithm::LZ4;
             break;
           default:
             break;
@@ -482,13 +521,17 @@ class RocketClientChannel::SingleRequestSingleResponseCallback final
       uint16_t protocolId,
       std::string methodName,
       size_t requestSerializedSize,
-      size_t requestWireSize)
+      size_t requestWireSize,
+      std::shared_ptr<rocket::MetadataInterningEncoder> metadataEncoder,
+      std::vector<int32_t> internedIds)
       : cb_(std::move(cb)),
         g_(std::move(g)),
         protocolId_(protocolId),
         methodName_(std::move(methodName)),
         requestSerializedSize_(requestSerializedSize),
-        requestWireSize_(requestWireSize) {}
+        requestWireSize_(requestWireSize),
+        metadataEncoder_(std::move(metadataEncoder)),
+        internedIds_(std::move(internedIds)) {}
 
   void onWriteSuccess() noexcept override {
     cb_->onRequestSent();
@@ -496,6 +539,10 @@ class RocketClientChannel::SingleRequestSingleResponseCallback final
 
   void onResponsePayload(
       folly::Try<rocket::Payload>&& payload) noexcept override {
+    if (!internedIds_.empty()) {
+      metadataEncoder_->onResponse(internedIds_, payload.hasValue());
+    }
+
     folly::Try<FirstResponsePayload> response;
     RpcSizeStats stats;
     stats.requestSerializedSizeBytes = requestSerializedSize_;
@@ -555,6 +602,9 @@ class RocketClientChannel::SingleRequestSingleResponseCallback final
   std::string methodName_;
   const size_t requestSerializedSize_;
   const size_t requestWireSize_;
+  // Interning table entries defined by the request.
+  const std::shared_ptr<rocket::MetadataInterningEncoder> metadataEncoder_;
+  const std::vector<int32_t> internedIds_;
 };
 
 class RocketClientChannel::SingleRequestNoResponseCallback final
@@ -585,6 +635,14 @@ class RocketClientChannel::SingleRequestNoResponseCallback final
 rocket::SetupFrame RocketClientChannel::makeSetupFrame(
     RequestSetupMetadata meta) {
   meta.maxVersion_ref() = 6;
+  if (auto entries = THRIFT_FLAG(rocket_client_interned_metadata_entries)) {
+    meta.maxInternedEntries_ref() = static_cast<int32_t>(entries);
+  }
+  if (!meta.zstdDictionaryIds_ref()) {
+    if (auto ids = rocket::ZstdDictionaryRegistry::getIds(); !ids.empty()) {
+      meta.zstdDictionaryIds_ref() = std::move(ids);
+    }
+  }
   if (const auto& hostMetadata = ClientChannel::getHostMetadata()) {
     meta.clientMetadata_ref().ensure().hostname_ref().from_optional(
         hostMetadata->hostname);
@@ -630,6 +688,19 @@ void RocketClientChannel::handleMetadataPush(
         if (auto version = metadata.setupResponse_ref()->version_ref()) {
           serverVersion_ = *version;
         }
+        if (auto dictionaryId =
+                metadata.setupResponse_ref()->zstdDictionaryId_ref()) {
+          if (rocket::ZstdDictionaryRegistry::get(*dictionaryId)) {
+            zstdDictionaryId_ = *dictionaryId;
+          }
+        }
+        if (auto entries =
+                metadata.setupResponse_ref()->maxInternedEntries_ref()) {
+          if (*entries > 0) {
+            metadataEncoder_ =
+                std::make_shared<rocket::MetadataInterningEncoder>(*entries);
+          }
+        }
         break;
       }
       default:
@@ -747,8 +818,16 @@ void RocketClientChannel::sendRequestStream(
     return;
   }
 
+  if (auto& batchingConfig = rpcOptions.getStreamBatchingConfig()) {
+    metadata.streamBatchingConfig_ref() = *batchingConfig;
+  }
+
   auto buf = std::move(request.buffer);
-  setCompression(metadata, buf->computeChainDataLength());
+  setCompression(metadata, buf->computeChainDataLength(), zstdDictionaryId_);
+  if (metadataEncoder_) {
+    // Only requests with a single response define entries.
+    metadataEncoder_->encode(metadata, false /* define */);
+  }
 
   return rclient_->sendRequestStream(
       rocket::pack(metadata, std::move(buf)),
@@ -784,7 +863,10 @@ void RocketClientChannel::sendRequestSink(
   }
 
   auto buf = std::move(request.buffer);
-  setCompression(metadata, buf->computeChainDataLength());
+  setCompression(metadata, buf->computeChainDataLength(), zstdDictionaryId_);
+  if (metadataEncoder_) {
+    metadataEncoder_->encode(metadata, false /* define */);
+  }
 
   return rclient_->sendRequestSink(
       rocket::pack(metadata, std::move(buf)),
@@ -820,7 +902,7 @@ void RocketClientChannel::sendThriftRequest(
   }
 
   auto buf = std::move(request.buffer);
-  setCompression(metadata, buf->computeChainDataLength());
+  setCompression(metadata, buf->computeChainDataLength(), zstdDictionaryId_);
 
   switch (kind) {
     case RpcKind::SINGLE_REQUEST_NO_RESPONSE:
@@ -843,9 +925,12 @@ void RocketClientChannel::sendThriftRequest(
 }
 
 void RocketClientChannel::sendSingleRequestNoResponse(
-    const RequestRpcMetadata& metadata,
+    RequestRpcMetadata& metadata,
     std::unique_ptr<folly::IOBuf> buf,
     RequestClientCallback::Ptr cb) {
+  if (metadataEncoder_) {
+    metadataEncoder_->encode(metadata, false /* define */);
+  }
   auto requestPayload = rocket::pack(metadata, std::move(buf));
   const bool isSync = cb->isSync();
   SingleRequestNoResponseCallback callback(std::move(cb), inflightGuard());
@@ -860,11 +945,16 @@ void RocketClientChannel::sendSingleRequestNoResponse(
 }
 
 void RocketClientChannel::sendSingleRequestSingleResponse(
-    const RequestRpcMetadata& metadata,
+    RequestRpcMetadata& metadata,
     std::chrono::milliseconds timeout,
     std::unique_ptr<folly::IOBuf> buf,
     RequestClientCallback::Ptr cb) {
   const auto requestSerializedSize = buf->computeChainDataLength();
+  std::string methodName = metadata.name_ref().value_or({});
+  std::vector<int32_t> internedIds;
+  if (metadataEncoder_) {
+    internedIds = metadataEncoder_->encode(metadata, true /* define */);
+  }
   auto requestPayload = rocket::pack(metadata, std::move(buf));
   const auto requestWireSize = requestPayload.dataSize();
   const bool isSync = cb->isSync();
@@ -872,9 +962,11 @@ void RocketClientChannel::sendSingleRequestSingleResponse(
       std::move(cb),
       inflightGuard(),
       static_cast<uint16_t>(metadata.protocol_ref().value_unchecked()),
-      metadata.name_ref().value_or({}),
+      std::move(methodName),
       requestSerializedSize,
-      requestWireSize);
+      requestWireSize,
+      metadataEncoder_,
+      std::move(internedIds));
 
   if (isSync && folly::fibers::onFiber()) {
     callback.onResponsePayload(rclient_->sendRequestResponseSync(
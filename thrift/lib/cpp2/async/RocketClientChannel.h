@@ -44,6 +44,7 @@ class StreamClientCallback;
 class ThriftClientCallback;
 
 namespace rocket {
+class MetadataInterningEncoder;
 class Payload;
 class RocketClient;
 } // namespace rocket
@@ -171,6 +172,11 @@ class RocketClientChannel final : public ClientChannel {
 
   folly::F14FastMap<int64_t, ManagedStringView> pendingInteractions_;
   folly::Optional<int32_t> serverVersion_;
+  // Pre-shared ZSTD dictionary accepted by the server in the setup response.
+  folly::Optional<int32_t> zstdDictionaryId_;
+  // Set once the server accepted metadata interning in the setup response.
+  // Shared with the callbacks of in-flight requests.
+  std::shared_ptr<rocket::MetadataInterningEncoder> metadataEncoder_;
 
   RocketClientChannel(
       folly::AsyncTransport::UniquePtr socket,
@@ -190,12 +196,12 @@ class RocketClientChannel final : public ClientChannel {
       RequestClientCallback::Ptr cb);
 
   void sendSingleRequestNoResponse(
-      const RequestRpcMetadata& metadata,
+      RequestRpcMetadata& metadata,
       std::unique_ptr<folly::IOBuf> buf,
       RequestClientCallback::Ptr cb);
 
   void sendSingleRequestSingleResponse(
-      const RequestRpcMetadata& metadata,
+      RequestRpcMetadata& metadata,
       std::chrono::milliseconds timeout,
       std::unique_ptr<folly::IOBuf> buf,
       RequestClientCallback::Ptr cb);
@@ -51,6 +51,8 @@ struct HeadersPayload {
   explicit HeadersPayload(StreamPayloadMetadata&& sp) {
     payload.otherMetadata_ref().copy_from(sp.otherMetadata_ref());
     metadata.compression_ref().copy_from(sp.compression_ref());
+    metadata.compressionDictionaryId_ref().copy_from(
+        sp.compressionDictionaryId_ref());
   }
 
   HeadersPayloadContent payload;
@@ -60,6 +62,8 @@ struct HeadersPayload {
     StreamPayloadMetadata md;
     md.otherMetadata_ref().copy_from(payload.otherMetadata_ref());
     md.compression_ref().copy_from(metadata.compression_ref());
+    md.compressionDictionaryId_ref().copy_from(
+        metadata.compressionDictionaryId_ref());
     return StreamPayload(nullptr, std::move(md));
   }
 };
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/StreamCreditWindow.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/util/Ewma.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+namespace {
+// Keeps at least one credit outstanding after requesting at half window.
+constexpr int32_t kMinSize = 2;
+} // namespace
+
+constexpr size_t StreamCreditWindow::kRequestCreditPayloadSize;
+
+StreamCreditWindow::StreamCreditWindow(
+    const BufferOptions& options,
+    Clock::time_point now)
+    : maxSize_(options.maxChunkSize),
+      maxMemSize_(options.maxMemSize),
+      size_(options.chunkSize),
+      outstanding_(options.chunkSize),
+      granted_(options.chunkSize),
+      rateSince_(now) {
+  CHECK_GT(size_, 0);
+  if (maxSize_) {
+    CHECK_GE(maxSize_, size_);
+  }
+}
+
+int32_t StreamCreditWindow::onPayload(
+    size_t payloadSize,
+    bool waited,
+    Clock::time_point now) {
+  --outstanding_;
+  payloadDataSize_ += payloadSize;
+
+  if (maxSize_) {
+    ++received_;
+    avgPayloadSize_ =
+        sampleEwma<double>(avgPayloadSize_, payloadSize, received_ == 1);
+    if (measuring_ && received_ > grantedBefore_) {
+      // Payloads that were already queued say nothing about the round trip.
+      if (waited) {
+        rtt_ = sampleEwma<std::chrono::nanoseconds>(
+            rtt_, now - requestedAt_, rtt_.count() == 0);
+      }
+      measuring_ = false;
+    }
+  }
+
+  if (outstanding_ > size_ / 2 &&
+      payloadDataSize_ < kRequestCreditPayloadSize) {
+    return 0;
+  }
+  payloadDataSize_ = 0;
+
+  if (maxSize_) {
+    resize(now);
+  }
+  auto credits = size_ - outstanding_;
+  if (credits <= 0) {
+    return 0;
+  }
+  outstanding_ = size_;
+
+  if (maxSize_) {
+    if (!measuring_) {
+      measuring_ = true;
+      requestedAt_ = now;
+      grantedBefore_ = granted_;
+    }
+    granted_ += credits;
+  }
+  return credits;
+}
+
+void StreamCreditWindow::resize(Clock::time_point now) {
+  auto elapsed = now - rateSince_;
+  if (rtt_.count() == 0 || elapsed < rtt_) {
+    return;
+  }
+  auto sample = (received_ - receivedSince_) /
+      std::chrono::duration<double>(elapsed).count();
+  // Follow increases immediately so a window that is too small doubles on
+  // every round trip.
+  rate_ = sample > rate_ ? sample : sampleEwma(rate_, sample, false);
+  rateSince_ = now;
+  receivedSince_ = received_;
+
+  auto target = 2 * rate_ * std::chrono::duration<double>(rtt_).count();
+  if (maxMemSize_ && avgPayloadSize_ > 0) {
+    target = std::min(target, maxMemSize_ / avgPayloadSize_);
+  }
+  size_ = static_cast<int32_t>(std::clamp<double>(
+      std::ceil(target), std::min(kMinSize, maxSize_), maxSize_));
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <thrift/lib/cpp2/async/ClientStreamBridge.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+/**
+ * Decides when a stream consumer requests more credits, and how many.
+ *
+ * Credits are requested once half of the window has been consumed, or every
+ * kRequestCreditPayloadSize bytes, topping the outstanding credits back up to
+ * the window size.
+ *
+ * With BufferOptions::maxChunkSize set, BufferOptions::chunkSize is only the
+ * initial window. The window is then resized to twice the bandwidth-delay
+ * product of the stream: the number of payloads consumed per round trip,
+ * where a round trip is the time from requesting credits to the consumer
+ * receiving the first payload they allowed. Only round trips the consumer
+ * had to wait for are measured, so a slow consumer never grows the window.
+ * The window stays within maxChunkSize credits and, going by the average
+ * payload size, BufferOptions::maxMemSize bytes.
+ */
+class StreamCreditWindow {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t kRequestCreditPayloadSize = 16384;
+
+  // options.chunkSize credits are assumed to have been requested already.
+  explicit StreamCreditWindow(
+      const BufferOptions& options,
+      Clock::time_point now = Clock::now());
+
+  /**
+   * Called for each payload handed to the consumer; waited tells whether the
+   * consumer had to wait for it. Returns the number of credits to request, if
+   * any.
+   */
+  int32_t onPayload(
+      size_t payloadSize,
+      bool waited,
+      Clock::time_point now = Clock::now());
+
+  int32_t size() const {
+    return size_;
+  }
+
+  std::chrono::nanoseconds roundTripTime() const {
+    return rtt_;
+  }
+
+ private:
+  void resize(Clock::time_point now);
+
+  const int32_t maxSize_;
+  const size_t maxMemSize_;
+  int32_t size_;
+  int32_t outstanding_;
+  size_t payloadDataSize_{0};
+
+  // Auto-tuning state, only maintained if maxSize_ is set.
+  uint64_t granted_;
+  uint64_t received_{0};
+  double avgPayloadSize_{0};
+  // Round trip being measured: when credits were requested and how many
+  // had been granted before.
+  bool measuring_{false};
+  Clock::time_point requestedAt_;
+  uint64_t grantedBefore_{0};
+  std::chrono::nanoseconds rtt_{0};
+  // Payloads consumed per second, measured over at least a round trip.
+  Clock::time_point rateSince_;
+  uint64_t receivedSince_{0};
+  double rate_{0};
+};
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
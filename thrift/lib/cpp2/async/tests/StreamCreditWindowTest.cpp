@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/StreamCreditWindow.h>
+
+#include <algorithm>
+#include <deque>
+
+#include <folly/portability/GTest.h>
+#include <thrift/lib/cpp2/async/RequestCallback.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::detail;
+using namespace std::chrono;
+
+namespace {
+
+using TimePoint = StreamCreditWindow::Clock::time_point;
+
+// Simulates a producer that sends a payload for each credit one round trip
+// after it was requested, and a consumer that takes consumeTime per payload.
+class Simulation {
+ public:
+  Simulation(const BufferOptions& options, nanoseconds rtt)
+      : window_(options, now_), rtt_(rtt) {
+    arrivals_.assign(options.chunkSize, now_ + rtt_);
+  }
+
+  void run(int payloads, nanoseconds consumeTime) {
+    for (int i = 0; i < payloads; ++i) {
+      auto arrival = arrivals_.front();
+      arrivals_.pop_front();
+      bool waited = arrival > now_;
+      now_ = std::max(now_, arrival);
+      auto credits = window_.onPayload(100, waited, now_);
+      arrivals_.insert(arrivals_.end(), credits, now_ + rtt_);
+      now_ += consumeTime;
+    }
+  }
+
+  const StreamCreditWindow& window() const {
+    return window_;
+  }
+
+ private:
+  TimePoint now_;
+  StreamCreditWindow window_;
+  nanoseconds rtt_;
+  std::deque<TimePoint> arrivals_;
+};
+
+} // namespace
+
+TEST(StreamCreditWindowTest, fixed) {
+  BufferOptions options;
+  options.chunkSize = 10;
+  StreamCreditWindow window(options);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(0, window.onPayload(100, false));
+  }
+  EXPECT_EQ(5, window.onPayload(100, false));
+
+  // Large payloads request credits sooner.
+  EXPECT_EQ(
+      1,
+      window.onPayload(StreamCreditWindow::kRequestCreditPayloadSize, false));
+  EXPECT_EQ(10, window.size());
+}
+
+TEST(StreamCreditWindowTest, chunkBufferSizeOverridesAdaptive) {
+  RpcOptions rpcOptions;
+  rpcOptions.setChunkBufferSize(10);
+  rpcOptions.setAdaptiveChunkBufferSize(100, 0);
+  EXPECT_EQ(10, rpcOptions.getBufferOptions().chunkSize);
+  EXPECT_EQ(100, rpcOptions.getBufferOptions().maxChunkSize);
+
+  // A window larger than the adaptive limit is fine once fixed.
+  rpcOptions.setChunkBufferSize(200);
+  EXPECT_EQ(0, rpcOptions.getBufferOptions().maxChunkSize);
+  Simulation simulation(rpcOptions.getBufferOptions(), milliseconds(10));
+  simulation.run(2000, nanoseconds(0));
+  EXPECT_EQ(200, simulation.window().size());
+}
+
+TEST(StreamCreditWindowTest, growToBandwidthDelayProduct) {
+  BufferOptions options;
+  options.chunkSize = 10;
+  options.maxChunkSize = 1000;
+  Simulation simulation(options, milliseconds(10));
+
+  // A consumer that keeps up is only limited by the window.
+  simulation.run(20000, nanoseconds(0));
+  EXPECT_EQ(milliseconds(10), simulation.window().roundTripTime());
+  EXPECT_EQ(1000, simulation.window().size());
+}
+
+TEST(StreamCreditWindowTest, memoryBudget) {
+  BufferOptions options;
+  options.chunkSize = 10;
+  options.maxChunkSize = 1000;
+  options.maxMemSize = 20000;
+  Simulation simulation(options, milliseconds(10));
+
+  simulation.run(20000, nanoseconds(0));
+  EXPECT_EQ(200, simulation.window().size());
+
+  // 1000 payloads per second over a 10ms round trip.
+  simulation.run(5000, milliseconds(1));
+  EXPECT_NEAR(20, simulation.window().size(), 2);
+}
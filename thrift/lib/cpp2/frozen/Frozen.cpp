@@ -16,6 +16,13 @@
 
 #include <thrift/lib/cpp2/frozen/Frozen.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 
@@ -96,6 +103,223 @@ void ByteRangeFreezer::doAppendBytes(
   distance = range.begin() - origin;
 }
 
+namespace {
+
+/**
+ * Runs f(0) .. f(n - 1) on up to 'threads' threads, the calling one included,
+ * and rethrows the first exception any of them threw.
+ */
+void parallelFor(
+    size_t n,
+    size_t threads,
+    folly::FunctionRef<void(size_t)> f) {
+  std::atomic<size_t> next{0};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto work = [&] {
+    for (size_t i; (i = next++) < n;) {
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = n;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < std::min(threads, n); ++t) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * Counts the bytes appended by freezing items as if the appends started at
+ * 'start', without keeping them. Freezing never reads back what it wrote, so
+ * every append is given the same scratch buffer.
+ */
+class SizingFreezer final : public FreezeRoot {
+ public:
+  SizingFreezer(size_t start, size_t itemBytes)
+      : item_(std::make_unique<byte[]>(
+            itemBytes + LayoutRoot::kPaddingBytes)),
+        start_(start),
+        end_(start) {}
+
+  FreezePosition item() const {
+    return {item_.get(), 0};
+  }
+
+  size_t size() const {
+    return end_ - start_;
+  }
+
+  size_t alignment() const {
+    return alignment_;
+  }
+
+  bool registeredPositions() const {
+    return !positions_.empty();
+  }
+
+ private:
+  void doAppendBytes(
+      byte* /* origin */,
+      size_t n,
+      folly::MutableByteRange& range,
+      size_t& distance,
+      size_t alignment) override {
+    distance = 0;
+    if (!n) {
+      range.reset(nullptr, 0);
+      return;
+    }
+    alignment_ = std::max(alignment_, alignment);
+    end_ = alignBy(end_, alignment) + n;
+    // Setting bit fields writes whole words, past the end of the range.
+    size_t size = n + LayoutRoot::kPaddingBytes;
+    if (size > scratchSize_) {
+      // Earlier ranges may still be written to, so are kept around.
+      scratchSize_ = std::max(size, 2 * scratchSize_);
+      scratch_.push_back(std::make_unique<byte[]>(scratchSize_));
+    }
+    range.reset(scratch_.back().get(), n);
+  }
+
+  std::unique_ptr<byte[]> item_;
+  std::vector<std::unique_ptr<byte[]>> scratch_;
+  size_t scratchSize_{0};
+  size_t start_;
+  size_t end_;
+  size_t alignment_{1};
+};
+
+} // namespace
+
+bool ParallelFreezer::freezesInParallel(size_t n, FieldPosition writeStep)
+    const {
+  // Items packed into bits share bytes with their neighbours, and shared
+  // references frozen so far could not be found from the tasks.
+  return options_.threads > 1 && n >= options_.minItems &&
+      n >= 2 * options_.itemsPerTask && writeStep.offset > 0 &&
+      positions_.empty();
+}
+
+void ParallelFreezer::freezeItems(
+    size_t n,
+    FreezePosition write,
+    FieldPosition writeStep,
+    ItemFreezer freezeItem) {
+  struct Task {
+    size_t begin;
+    size_t end;
+    size_t size;
+    size_t alignment;
+    byte* data;
+  };
+  // Every task holds itemsPerTask items but the last, which holds the rest.
+  size_t perTask = std::max<size_t>(options_.itemsPerTask, 8);
+  std::vector<Task> tasks(std::max<size_t>(n / perTask, 1));
+  for (size_t t = 0; t < tasks.size(); ++t) {
+    tasks[t].begin = t * perTask;
+    tasks[t].end = t + 1 == tasks.size() ? n : (t + 1) * perTask;
+  }
+
+  auto sizeTask = [&](Task& task, size_t start) {
+    SizingFreezer sizer(start, writeStep.offset);
+    for (size_t i = task.begin; i < task.end; ++i) {
+      freezeItem(sizer, i, sizer.item());
+    }
+    task.size = sizer.size();
+    task.alignment = sizer.alignment();
+    return !sizer.registeredPositions();
+  };
+  std::atomic<bool> sharesRefs{false};
+  parallelFor(tasks.size(), options_.threads, [&](size_t t) {
+    if (!sizeTask(tasks[t], 0)) {
+      sharesRefs = true;
+    }
+  });
+  if (sharesRefs) {
+    FreezeRoot::freezeItems(n, write, writeStep, freezeItem);
+    return;
+  }
+
+  // The padding a task appends only depends on where its bytes start modulo
+  // the largest alignment it uses, so few tasks need to be sized again.
+  auto start = reinterpret_cast<uintptr_t>(write_.begin());
+  auto end = start;
+  std::vector<Task> placed;
+  for (auto& task : tasks) {
+    if (end % task.alignment) {
+      sizeTask(task, end);
+    }
+    task.data = write_.begin() + (end - start);
+    end += task.size;
+    // Setting bit fields rewrites whole words, so a task may write up to 7
+    // bytes past its own. Tasks appending fewer bytes are merged into the
+    // next one, so only neighbouring tasks overlap.
+    if (!placed.empty() && placed.back().size < LayoutRoot::kPaddingBytes) {
+      placed.back().end = task.end;
+      placed.back().size += task.size;
+    } else {
+      placed.push_back(task);
+    }
+  }
+  if (placed.size() > 1 && placed.back().size < LayoutRoot::kPaddingBytes) {
+    placed[placed.size() - 2].end = placed.back().end;
+    placed[placed.size() - 2].size += placed.back().size;
+    placed.pop_back();
+  }
+  if (end - start > write_.size()) {
+    throw std::length_error("Insufficient buffer allocated");
+  }
+
+  auto freezeTask = [&](size_t t) {
+    auto& task = placed[t];
+    folly::MutableByteRange range(task.data, task.size);
+    ByteRangeFreezer freezer(range);
+    for (size_t i = task.begin; i < task.end; ++i) {
+      freezeItem(
+          freezer,
+          i,
+          {write.start + i * writeStep.offset, write.bitOffset});
+    }
+    CHECK(range.empty()) << "Task appended " << task.size - range.size()
+                         << " bytes, sized " << task.size;
+  };
+  // Neighbouring tasks never run together: even ones first, then odd ones.
+  // The items of the last task are followed by the bytes of the first, so it
+  // runs alone.
+  size_t last = placed.size() - 1;
+  parallelFor((last + 1) / 2, options_.threads, [&](size_t k) {
+    freezeTask(2 * k);
+  });
+  parallelFor(last / 2, options_.threads, [&](size_t k) {
+    freezeTask(2 * k + 1);
+  });
+  freezeTask(last);
+  write_.advance(end - start);
+}
+
+void ParallelFreezer::doAppendBytes(
+    byte* origin,
+    size_t n,
+    folly::MutableByteRange& range,
+    size_t& distance,
+    size_t alignment) {
+  serial_.appendBytes(origin, n, range, distance, alignment);
+}
+
 namespace detail {
 
 FieldPosition BlockLayout::maximize() {
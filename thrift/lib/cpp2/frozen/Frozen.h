@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <iosfwd>
 #include <iterator>
 #include <map>
@@ -31,6 +32,7 @@
 
 #include <folly/Demangle.h>
 #include <folly/FBVector.h>
+#include <folly/Function.h>
 #include <folly/MapUtil.h>
 #include <folly/Memory.h>
 #include <folly/Optional.h>
@@ -906,6 +908,37 @@ class FreezeRoot {
     doAppendBytes(origin, n, range, distance, align);
   }
 
+  /**
+   * Freezes the i'th item of a container through 'root' at 'pos'.
+   */
+  using ItemFreezer =
+      folly::FunctionRef<void(FreezeRoot& root, size_t i, FreezePosition pos)>;
+
+  /**
+   * Whether the n items of a container, 'writeStep' apart, should be frozen
+   * with freezeItems(). Containers freeze their items one by one otherwise.
+   */
+  virtual bool freezesInParallel(size_t /* n */, FieldPosition /* writeStep */)
+      const {
+    return false;
+  }
+
+  /**
+   * Freezes the n items of a container, starting at 'write' and 'writeStep'
+   * apart, possibly concurrently. Bytes appended for the items must come out
+   * in the same order as if they were frozen one by one.
+   */
+  virtual void freezeItems(
+      size_t n,
+      FreezePosition write,
+      FieldPosition writeStep,
+      ItemFreezer freezeItem) {
+    for (size_t i = 0; i < n; ++i) {
+      freezeItem(*this, i, write);
+      write = write(writeStep);
+    }
+  }
+
  private:
   virtual void doAppendBytes(
       byte* origin,
@@ -923,6 +956,8 @@ inline size_t alignBy(size_t start, size_t alignment) {
  * A FreezeRoot that writes to a given ByteRange
  */
 class ByteRangeFreezer final : public FreezeRoot {
+  friend class ParallelFreezer;
+
  protected:
   explicit ByteRangeFreezer(folly::MutableByteRange& write) : write_(write) {}
 
@@ -948,6 +983,70 @@ class ByteRangeFreezer final : public FreezeRoot {
   folly::MutableByteRange& write_;
 };
 
+/**
+ * Options for ParallelFreezer.
+ */
+struct ParallelFreezeOptions {
+  // Threads freezing the items of a container, including the calling one.
+  size_t threads{4};
+  // Containers with fewer items are frozen by the calling thread alone.
+  size_t minItems{1 << 14};
+  // Items frozen by each task, at least 8.
+  size_t itemsPerTask{1 << 10};
+};
+
+/**
+ * A FreezeRoot that writes to a given ByteRange like ByteRangeFreezer, and
+ * produces the same bytes, but freezes the items of large containers on
+ * several threads. The items are split into tasks, each of which is first
+ * frozen into scratch memory to size the bytes it appends, then frozen again
+ * at its final offset, so it pays off for items with out of line data, like
+ * strings, nested containers or structs holding them.
+ *
+ * Values behind references are recorded as they are frozen, so that shared
+ * ones are frozen once. Tasks cannot see each other's, so containers whose
+ * items hold references are frozen one by one.
+ */
+class ParallelFreezer final : public FreezeRoot {
+ protected:
+  ParallelFreezer(
+      folly::MutableByteRange& write,
+      const ParallelFreezeOptions& options)
+      : write_(write), serial_(write), options_(options) {}
+
+ public:
+  template <class T>
+  static typename Layout<T>::View freeze(
+      const Layout<T>& layout,
+      const T& root,
+      folly::MutableByteRange& write,
+      const ParallelFreezeOptions& options) {
+    ParallelFreezer freezer(write, options);
+    return freezer.doFreeze(layout, root);
+  }
+
+  bool freezesInParallel(size_t n, FieldPosition writeStep) const override;
+
+  void freezeItems(
+      size_t n,
+      FreezePosition write,
+      FieldPosition writeStep,
+      ItemFreezer freezeItem) override;
+
+ private:
+  void doAppendBytes(
+      byte* origin,
+      size_t n,
+      folly::MutableByteRange& range,
+      size_t& distance,
+      size_t alignment) override;
+
+  folly::MutableByteRange& write_;
+  // Appends bytes outside of parallel containers.
+  ByteRangeFreezer serial_;
+  ParallelFreezeOptions options_;
+};
+
 /**
  * The root that manage the referred fields at load time
  */
@@ -1117,6 +1216,7 @@ using View = typename Layout<T>::View;
 #include <thrift/lib/cpp2/frozen/FrozenString-inl.h> // @nolint
 // depends on Range
 #include <thrift/lib/cpp2/frozen/FrozenHashTable-inl.h> // @nolint
+#include <thrift/lib/cpp2/frozen/FrozenSwissTable-inl.h> // @nolint
 #include <thrift/lib/cpp2/frozen/FrozenOrderedTable-inl.h> // @nolint
 // depends on Associative
 #include <thrift/lib/cpp2/frozen/FrozenAssociative-inl.h> // @nolint
@@ -168,6 +168,21 @@ struct Layout<T, typename std::enable_if<IsHashSet<T>::value>::type>
           T,
           typename T::value_type,
           apache::thrift::frozen::detail::HashTableLayout> {};
+
+template <class T>
+struct Layout<T, typename std::enable_if<IsSwissHashMap<T>::value>::type>
+    : public apache::thrift::frozen::detail::MapTableLayout<
+          T,
+          typename T::key_type,
+          typename T::mapped_type,
+          apache::thrift::frozen::detail::SwissTableLayout> {};
+
+template <class T>
+struct Layout<T, typename std::enable_if<IsSwissHashSet<T>::value>::type>
+    : public apache::thrift::frozen::detail::SetTableLayout<
+          T,
+          typename T::value_type,
+          apache::thrift::frozen::detail::SwissTableLayout> {};
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
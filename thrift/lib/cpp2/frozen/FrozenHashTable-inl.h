@@ -205,6 +205,13 @@ struct HashTableLayout : public ArrayLayout<T, Item> {
     assert(index.empty() == sparseTable.empty());
     root.freezeField(self, this->sparseTableField, sparseTable);
 
+    if (root.freezesInParallel(coll.size(), writeStep)) {
+      index.erase(
+          std::remove(index.begin(), index.end(), nullptr), index.end());
+      this->freezeItemsInParallel(root, index, write, writeStep);
+      return;
+    }
+
     FieldPosition noField; // not really used
     for (auto& it : index) {
       if (it) {
@@ -254,6 +261,13 @@ struct HashTableLayout : public ArrayLayout<T, Item> {
 
     void operator[](size_t) = delete;
 
+    /**
+     * The bytes of the sparse table find() probes before the items.
+     */
+    std::array<folly::ByteRange, 1> indexBytes() const {
+      return {{table_.itemBytes()}};
+    }
+
     std::pair<iterator, iterator> equal_range(const KeyView& key) const {
       auto found = find(key);
       if (found != this->end()) {
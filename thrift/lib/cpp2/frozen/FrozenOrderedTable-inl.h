@@ -112,6 +112,17 @@ struct SortedTableLayout : public ArrayLayout<T, Item> {
     std::vector<const Item*> index;
     maybeIndex(coll, index);
 
+    if (root.freezesInParallel(coll.size(), writeStep)) {
+      if (index.empty()) {
+        index.reserve(coll.size());
+        for (auto& item : coll) {
+          index.push_back(KeyExtractor::getPointer(item));
+        }
+      }
+      this->freezeItemsInParallel(root, index, write, writeStep);
+      return;
+    }
+
     FieldPosition noField; // not really used
     if (index.empty()) {
       // either the collection was already sorted or it's empty
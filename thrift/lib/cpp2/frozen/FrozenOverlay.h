@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include <folly/File.h>
+#include <folly/Optional.h>
+#include <thrift/lib/cpp2/frozen/FrozenUtil.h>
+
+namespace apache {
+namespace thrift {
+namespace frozen {
+
+/**
+ * Changes to a frozen map since its base image was frozen: records added or
+ * changed (first), and keys removed (second). Being a plain pair, a delta is
+ * frozen and mapped like any other value:
+ *
+ *   freezeToFile(delta, std::move(deltaFile));
+ *   MapOverlay<Index> index(
+ *       mapFrozen<Index>(std::move(baseFile)),
+ *       mapFrozen<MapDelta<Index>>(std::move(deltaFile)));
+ *
+ * A refresh freezes only the records changed since the base, so it costs a
+ * few percent of re-freezing the whole map while the delta stays small.
+ */
+template <class Map>
+using MapDelta = std::pair<Map, std::unordered_set<typename Map::key_type>>;
+
+/**
+ * Returns the delta turning base into updated.
+ */
+template <class Map>
+MapDelta<Map> makeDelta(const Map& base, const Map& updated) {
+  MapDelta<Map> delta;
+  for (auto& entry : updated) {
+    auto found = base.find(entry.first);
+    if (found == base.end() || !(found->second == entry.second)) {
+      delta.first.insert(entry);
+    }
+  }
+  for (auto& entry : base) {
+    if (updated.find(entry.first) == updated.end()) {
+      delta.second.insert(entry.first);
+    }
+  }
+  return delta;
+}
+
+/**
+ * A frozen map viewed through a frozen delta: records of the delta shadow
+ * those of the base, and tombstoned keys are hidden. Lookups have the same
+ * signatures as those of a frozen map view, and cost one extra lookup in the
+ * (small) delta. Both images are immutable, so an overlay may be read from
+ * any number of threads, including while it is compacted.
+ */
+template <class Map>
+class MapOverlay {
+ public:
+  using BaseView = typename Layout<Map>::View;
+  using DeltaView = typename Layout<MapDelta<Map>>::View;
+  using key_type = typename BaseView::key_type;
+  using mapped_type = typename BaseView::mapped_type;
+
+  explicit MapOverlay(MappedFrozen<Map> base) : base_(std::move(base)) {
+    size_ = base_.size();
+  }
+
+  MapOverlay(MappedFrozen<Map> base, MappedFrozen<MapDelta<Map>> delta)
+      : base_(std::move(base)), delta_(std::move(delta)) {
+    // Only the delta is walked: its keys either replace or add a record,
+    // and its tombstones remove one if the base has it.
+    size_ = base_.size() + delta_->first().size();
+    for (auto&& entry : delta_->first()) {
+      size_ -= base_.count(entry.first());
+    }
+    for (auto&& key : delta_->second()) {
+      size_ -= base_.count(key);
+    }
+  }
+
+  MapOverlay(MapOverlay&&) = default;
+  MapOverlay& operator=(MapOverlay&&) = default;
+
+  folly::Optional<mapped_type> getOptional(const key_type& key) const {
+    if (delta_) {
+      if (auto found = delta_->first().getOptional(key)) {
+        return found;
+      }
+      if (delta_->second().count(key)) {
+        return folly::none;
+      }
+    }
+    return base_.getOptional(key);
+  }
+
+  mapped_type getDefault(const key_type& key, mapped_type def = mapped_type())
+      const {
+    if (auto found = getOptional(key)) {
+      return std::move(*found);
+    }
+    return def;
+  }
+
+  mapped_type at(const key_type& key) const {
+    if (auto found = getOptional(key)) {
+      return std::move(*found);
+    }
+    throw std::out_of_range("Key not found");
+  }
+
+  size_t count(const key_type& key) const {
+    return getOptional(key) ? 1 : 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  // Records and tombstones in the delta, to decide when to compact.
+  size_t deltaSize() const {
+    return delta_ ? delta_->first().size() + delta_->second().size() : 0;
+  }
+
+  /**
+   * Calls f(key, value) for every record, those of the delta first, in no
+   * particular order.
+   */
+  template <class F>
+  void forEach(F&& f) const {
+    if (delta_) {
+      for (auto&& entry : delta_->first()) {
+        f(entry.first(), entry.second());
+      }
+    }
+    for (auto&& entry : base_) {
+      auto key = entry.first();
+      if (delta_ &&
+          (delta_->first().count(key) || delta_->second().count(key))) {
+        continue;
+      }
+      f(key, entry.second());
+    }
+  }
+
+  /**
+   * Returns the map with the delta applied, to freeze as a new base.
+   */
+  Map thaw() const {
+    auto ret = base_.thaw();
+    if (delta_) {
+      auto delta = delta_->thaw();
+      for (auto& key : delta.second) {
+        ret.erase(key);
+      }
+      for (auto& entry : delta.first) {
+        ret.erase(entry.first);
+        ret.insert(std::move(entry));
+      }
+    }
+    return ret;
+  }
+
+  const BaseView& base() const {
+    return base_;
+  }
+
+ private:
+  MappedFrozen<Map> base_;
+  folly::Optional<MappedFrozen<MapDelta<Map>>> delta_;
+  size_t size_{0};
+};
+
+/**
+ * Merges the delta of overlay into a new base image frozen to file, and
+ * returns an overlay of that base alone. Meant to run on a background thread
+ * while readers keep using the current overlay, and swap to the new one once
+ * it returns. Thaws the merged map, so it needs memory for one thawed copy of
+ * it on top of the mapped images.
+ */
+template <class Map>
+MapOverlay<Map> compactToFile(
+    const MapOverlay<Map>& overlay,
+    folly::File file) {
+  freezeToFile(overlay.thaw(), file.dup());
+  return MapOverlay<Map>(mapFrozen<Map>(std::move(file)));
+}
+
+} // namespace frozen
+} // namespace thrift
+} // namespace apache
@@ -118,12 +118,39 @@ struct ArrayLayout : public LayoutBase {
       FreezePosition /* self */,
       FreezePosition write,
       FieldPosition writeStep) const {
+    if (root.freezesInParallel(coll.size(), writeStep)) {
+      std::vector<const Item*> items;
+      items.reserve(coll.size());
+      for (const auto& it : coll) {
+        items.push_back(&it);
+      }
+      freezeItemsInParallel(root, items, write, writeStep);
+      return;
+    }
     for (const auto& it : coll) {
       root.freezeField(write, itemField, it);
       write = write(writeStep);
     }
   }
 
+  /**
+   * Freezes the given items in order through FreezeRoot::freezeItems(), for
+   * roots which freeze large containers in parallel.
+   */
+  void freezeItemsInParallel(
+      FreezeRoot& root,
+      const std::vector<const Item*>& items,
+      FreezePosition write,
+      FieldPosition writeStep) const {
+    root.freezeItems(
+        items.size(),
+        write,
+        writeStep,
+        [&](FreezeRoot& itemRoot, size_t i, FreezePosition pos) {
+          itemRoot.freezeField(pos, itemField, *items[i]);
+        });
+  }
+
   void thaw(ViewPosition self, T& out) const {
     out.clear();
     auto outIt = std::back_inserter(out);
@@ -232,6 +259,17 @@ struct ArrayLayout : public LayoutBase {
       return {data, data + count_};
     }
 
+    /**
+     * The bytes holding the items themselves, not including any data the
+     * items refer to.
+     */
+    folly::ByteRange itemBytes() const {
+      const auto& item = itemLayout();
+      size_t bytes =
+          item.size ? item.size * count_ : (item.bits * count_ + 7) / 8;
+      return {data_, bytes};
+    }
+
    private:
     /**
      * Simple iterator on a range, with additional '.thaw()' member for thawing
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// IWYU pragma: private, include "thrift/lib/cpp2/frozen/Frozen.h"
+
+#if FOLLY_SSE >= 2
+#include <emmintrin.h>
+#endif
+
+namespace apache {
+namespace thrift {
+namespace frozen {
+namespace detail {
+
+/**
+ * A group of control bytes of a Swiss table, one per slot. Empty slots hold
+ * kEmpty, full ones hold the low 7 bits of the hash of their key.
+ */
+struct SwissGroup {
+  static constexpr size_t kSize = 16;
+  static constexpr uint8_t kEmpty = 0x80;
+
+  /**
+   * Returns a mask with bit i set if slot i of the group holds 'tag'.
+   */
+  static uint32_t match(const uint8_t* group, uint8_t tag) {
+#if FOLLY_SSE >= 2
+    auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return _mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kSize; ++i) {
+      mask |= uint32_t(group[i] == tag) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * Returns a mask with bit i set if slot i of the group is empty.
+   */
+  static uint32_t matchEmpty(const uint8_t* group) {
+#if FOLLY_SSE >= 2
+    // Only empty slots have the high bit set.
+    return _mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+    return match(group, kEmpty);
+#endif
+  }
+};
+
+/**
+ * Layout specialization for range types which support unique hash lookup,
+ * indexed like a Swiss table: slots are split in groups of 16, and a lookup
+ * compares the 7 bit tags of a whole group with one SSE2 instruction before
+ * comparing any key. Most lookups touch one group and one item.
+ *
+ * Only the items of full slots are stored, in slot order, so items take as
+ * much space as in a plain array. 'groupOffsets' holds the index of the
+ * first item of each group.
+ */
+template <class T, class Item, class KeyExtractor, class Key>
+struct SwissTableLayout : public ArrayLayout<T, Item> {
+  typedef ArrayLayout<T, Item> Base;
+  typedef SwissTableLayout LayoutSelf;
+  typedef Layout<Key> KeyLayout;
+
+  Field<std::string> controlField;
+  Field<std::vector<size_t>> groupOffsetsField;
+
+  SwissTableLayout()
+      // continue field ids from ArrayLayout, not reusing HashTableLayout's
+      : controlField(5, "control"), groupOffsetsField(6, "groupOffsets") {}
+
+  FieldPosition maximize() {
+    FieldPosition pos = ArrayLayout<T, Item>::maximize();
+    FROZEN_MAXIMIZE_FIELD(control);
+    FROZEN_MAXIMIZE_FIELD(groupOffsets);
+    return pos;
+  }
+
+  template <class K>
+  static uint64_t hash(const K& key) {
+    // Tags and group indexes are taken from different bits of the hash, so
+    // it needs to be well mixed. std::hash of integers is the identity.
+    return folly::hash::twang_mix64(KeyLayout::hash(key));
+  }
+
+  static uint8_t tagOf(uint64_t h) {
+    return h & 0x7f;
+  }
+
+  static size_t groupCount(size_t size) {
+    // Keeps the load factor at or below 7/8, so every probe sequence ends in
+    // a group with an empty slot.
+    size_t groups = 1;
+    while (groups * SwissGroup::kSize * 7 / 8 < size) {
+      groups *= 2;
+    }
+    return groups;
+  }
+
+  static void buildIndex(
+      const T& coll,
+      std::vector<const Item*>& index,
+      std::string& control,
+      std::vector<size_t>& groupOffsets) {
+    size_t groups = groupCount(coll.size());
+    size_t mask = groups - 1;
+    index.assign(groups * SwissGroup::kSize, nullptr);
+    control.assign(groups * SwissGroup::kSize, char(SwissGroup::kEmpty));
+    auto ctrl = reinterpret_cast<uint8_t*>(&control[0]);
+    for (auto& item : coll) {
+      const typename KeyExtractor::KeyType* itemKey =
+          &KeyExtractor::getKey(item);
+      auto h = hash(*itemKey);
+      auto tag = tagOf(h);
+      size_t group = (h >> 7) & mask;
+      for (size_t p = 0;; group = (group + ++p) & mask) { // triangular probing
+        auto groupCtrl = ctrl + group * SwissGroup::kSize;
+        for (auto matches = SwissGroup::match(groupCtrl, tag); matches;
+             matches &= matches - 1) {
+          size_t slot = folly::findFirstSet(matches) - 1;
+          auto other = index[group * SwissGroup::kSize + slot];
+          if (*itemKey == KeyExtractor::getKey(*other)) {
+            throw std::domain_error("Input collection is not distinct");
+          }
+        }
+        if (auto empty = SwissGroup::matchEmpty(groupCtrl)) {
+          size_t slot = folly::findFirstSet(empty) - 1;
+          groupCtrl[slot] = tag;
+          index[group * SwissGroup::kSize + slot] =
+              KeyExtractor::getPointer(item);
+          break;
+        }
+      }
+    }
+    groupOffsets.resize(groups);
+    size_t count = 0;
+    for (size_t group = 0; group < groups; ++group) {
+      groupOffsets[group] = count;
+      auto empty = SwissGroup::matchEmpty(ctrl + group * SwissGroup::kSize);
+      count += SwissGroup::kSize - folly::popcount(empty);
+    }
+  }
+
+  FieldPosition layoutItems(
+      LayoutRoot& root,
+      const T& coll,
+      LayoutPosition self,
+      FieldPosition pos,
+      LayoutPosition write,
+      FieldPosition writeStep) final {
+    std::vector<const Item*> index;
+    std::string control;
+    std::vector<size_t> groupOffsets;
+    buildIndex(coll, index, control, groupOffsets);
+
+    pos = root.layoutField(self, pos, this->controlField, control);
+    pos = root.layoutField(self, pos, this->groupOffsetsField, groupOffsets);
+
+    FieldPosition noField; // not really used
+    for (auto& it : index) {
+      if (it) {
+        root.layoutField(write, noField, this->itemField, *it);
+        write = write(writeStep);
+      }
+    }
+
+    return pos;
+  }
+
+  void freezeItems(
+      FreezeRoot& root,
+      const T& coll,
+      FreezePosition self,
+      FreezePosition write,
+      FieldPosition writeStep) const final {
+    std::vector<const Item*> index;
+    std::string control;
+    std::vector<size_t> groupOffsets;
+    buildIndex(coll, index, control, groupOffsets);
+
+    root.freezeField(self, this->controlField, control);
+    root.freezeField(self, this->groupOffsetsField, groupOffsets);
+
+    if (root.freezesInParallel(coll.size(), writeStep)) {
+      index.erase(
+          std::remove(index.begin(), index.end(), nullptr), index.end());
+      this->freezeItemsInParallel(root, index, write, writeStep);
+      return;
+    }
+
+    FieldPosition noField; // not really used
+    for (auto& it : index) {
+      if (it) {
+        root.freezeField(write, this->itemField, *it);
+        write = write(writeStep);
+      }
+    }
+  }
+
+  void thaw(ViewPosition self, T& out) const {
+    out.clear();
+    auto v = view(self);
+    for (auto it = v.begin(); it != v.end(); ++it) {
+      out.insert(it.thaw());
+    }
+  }
+
+  void print(std::ostream& os, int level) const override {
+    Base::print(os, level);
+    controlField.print(os, level + 1);
+    groupOffsetsField.print(os, level + 1);
+  }
+
+  void clear() final {
+    Base::clear();
+    controlField.clear();
+    groupOffsetsField.clear();
+  }
+
+  FROZEN_SAVE_INLINE(
+      FROZEN_SAVE_FIELD(control) FROZEN_SAVE_FIELD(groupOffsets))
+
+  FROZEN_LOAD_INLINE(
+      FROZEN_LOAD_FIELD(control, 5) FROZEN_LOAD_FIELD(groupOffsets, 6))
+
+  class View : public Base::View {
+    typedef typename Layout<Key>::View KeyView;
+    typedef typename Layout<Item>::View ItemView;
+    typedef typename Layout<std::vector<size_t>>::View OffsetsView;
+
+    const uint8_t* control_{nullptr};
+    size_t groups_{0};
+    OffsetsView groupOffsets_;
+
+   public:
+    View() {}
+    View(const LayoutSelf* layout, ViewPosition self)
+        : Base::View(layout, self),
+          groupOffsets_(layout->groupOffsetsField.layout.view(
+              self(layout->groupOffsetsField.pos))) {
+      folly::StringPiece control = layout->controlField.layout.view(
+          self(layout->controlField.pos));
+      control_ = reinterpret_cast<const uint8_t*>(control.data());
+      groups_ = control.size() / SwissGroup::kSize;
+    }
+
+    typedef typename Base::View::iterator iterator;
+
+    void operator[](size_t) = delete;
+
+    /**
+     * The bytes of the control groups and group offsets find() probes before
+     * the items.
+     */
+    std::array<folly::ByteRange, 2> indexBytes() const {
+      return {{folly::ByteRange(control_, groups_ * SwissGroup::kSize),
+               groupOffsets_.itemBytes()}};
+    }
+
+    std::pair<iterator, iterator> equal_range(const KeyView& key) const {
+      auto found = find(key);
+      if (found != this->end()) {
+        auto next = found;
+        return std::make_pair(found, ++next);
+      } else {
+        return std::make_pair(found, found);
+      }
+    }
+
+    iterator find(const KeyView& key) const {
+      if (groups_ == 0) {
+        return this->end();
+      }
+      auto h = hash(key);
+      auto tag = tagOf(h);
+      size_t mask = groups_ - 1;
+      size_t group = (h >> 7) & mask;
+      for (size_t p = 0; p < groups_; group = (group + ++p) & mask) {
+        auto groupCtrl = control_ + group * SwissGroup::kSize;
+        auto matches = SwissGroup::match(groupCtrl, tag);
+        auto empty = SwissGroup::matchEmpty(groupCtrl);
+        if (matches) {
+          size_t offset = groupOffsets_[group];
+          do {
+            size_t slot = folly::findFirstSet(matches) - 1;
+            // Items of the group's full slots before this one come first.
+            size_t full = ~empty & ((1u << slot) - 1);
+            auto found = this->begin() + (offset + folly::popcount(full));
+            if (KeyExtractor::getViewKey(*found) == key) {
+              return found;
+            }
+            matches &= matches - 1;
+          } while (matches);
+        }
+        if (empty) {
+          return this->end();
+        }
+      }
+      return this->end();
+    }
+
+    size_t count(const KeyView& key) const {
+      return find(key) == this->end() ? 0 : 1;
+    }
+
+    T thaw() const {
+      T ret;
+      static_cast<const SwissTableLayout*>(this->layout_)
+          ->thaw(this->position_, ret);
+      return ret;
+    }
+  };
+
+  View view(ViewPosition self) const {
+    return View(this, self);
+  }
+};
+} // namespace detail
+} // namespace frozen
+} // namespace thrift
+} // namespace apache
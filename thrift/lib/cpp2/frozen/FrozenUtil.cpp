@@ -16,9 +16,13 @@
 
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 
 #include <folly/Conv.h>
+#include <folly/portability/SysMman.h>
+#include <folly/portability/Unistd.h>
 
 // clang-format off
 DEFINE_bool(thrift_frozen_util_disable_mlock, false,
@@ -40,6 +44,74 @@ FrozenFileForwardIncompatible::FrozenFileForwardIncompatible(int fileVersion)
           " are supported.")),
       fileVersion_(fileVersion) {}
 
+namespace {
+int toMadvise(MapFrozenOptions::Advice advice) {
+  switch (advice) {
+    case MapFrozenOptions::Advice::NORMAL:
+      return MADV_NORMAL;
+    case MapFrozenOptions::Advice::RANDOM:
+      return MADV_RANDOM;
+    case MapFrozenOptions::Advice::SEQUENTIAL:
+      return MADV_SEQUENTIAL;
+    case MapFrozenOptions::Advice::WILLNEED:
+      return MADV_WILLNEED;
+  }
+  return MADV_NORMAL;
+}
+
+folly::MemoryMapping copyToHugePages(const folly::MemoryMapping& file) {
+  auto source = file.range();
+  folly::MemoryMapping copy(
+      folly::MemoryMapping::kAnonymous,
+      source.size(),
+      folly::MemoryMapping::Options().setWritable(true).setShared(false));
+#ifdef MADV_HUGEPAGE
+  // Must come before the pages are touched to get huge pages right away.
+  copy.advise(MADV_HUGEPAGE);
+#endif
+  file.advise(MADV_SEQUENTIAL);
+  std::memcpy(copy.writableRange().begin(), source.begin(), source.size());
+  return copy;
+}
+} // namespace
+
+namespace detail {
+folly::MemoryMapping mapFrozenFile(
+    folly::File file,
+    const MapFrozenOptions& options) {
+  folly::MemoryMapping::Options mapOptions;
+  mapOptions.setPrefault(options.prefault && !options.hugePages);
+  folly::MemoryMapping mapping(std::move(file), 0, -1, mapOptions);
+  if (options.hugePages) {
+    mapping = copyToHugePages(mapping);
+  }
+  if (options.advice != MapFrozenOptions::Advice::NORMAL) {
+    mapping.advise(toMadvise(options.advice));
+  }
+  if (options.lockMode) {
+    folly::MemoryMapping::LockFlags flags{};
+    flags.lockOnFault = FLAGS_thrift_frozen_util_mlock_on_fault;
+    mapping.mlock(*options.lockMode, flags);
+  }
+  return mapping;
+}
+} // namespace detail
+
+void prefault(folly::ByteRange range) {
+  if (range.empty()) {
+    return;
+  }
+  static const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  auto begin = reinterpret_cast<uintptr_t>(range.begin()) & ~(pageSize - 1);
+  auto end = reinterpret_cast<uintptr_t>(range.end());
+  // Lets the kernel read all the pages at once, then waits for each of them.
+  madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+  for (auto page = begin; page < end; page += pageSize) {
+    auto addr = std::max(page, reinterpret_cast<uintptr_t>(range.begin()));
+    (void)*reinterpret_cast<const volatile byte*>(addr);
+  }
+}
+
 MallocFreezer::Segment::Segment(size_t _size)
     : size(_size),
       // NB: All allocations rounded up to next multiple of 8 due to packed
@@ -19,6 +19,7 @@
 #include <stdexcept>
 
 #include <folly/File.h>
+#include <folly/Optional.h>
 #include <folly/portability/GFlags.h>
 #include <folly/system/MemoryMapping.h>
 #include <thrift/lib/cpp2/frozen/Frozen.h>
@@ -152,8 +153,12 @@ void deserializeRootLayout(folly::ByteRange& range, Layout<T>& layoutOut) {
   range.advance(schemaSize);
 }
 
+namespace detail {
 template <class T>
-void freezeToFile(const T& x, folly::File file) {
+void freezeToFile(
+    const T& x,
+    folly::File file,
+    const ParallelFreezeOptions* options) {
   std::string schemaStr;
   auto layout = std::make_unique<Layout<T>>();
   auto contentSize = LayoutRoot::layout(x, *layout);
@@ -167,13 +172,20 @@ void freezeToFile(const T& x, folly::File file) {
   auto writeRange = mapping.writableRange();
   std::copy(schemaStr.begin(), schemaStr.end(), writeRange.begin());
   writeRange.advance(schemaStr.size());
-  ByteRangeFreezer::freeze(*layout, x, writeRange);
+  if (options) {
+    ParallelFreezer::freeze(*layout, x, writeRange, *options);
+  } else {
+    ByteRangeFreezer::freeze(*layout, x, writeRange);
+  }
   size_t finalBufferSize = writeRange.begin() - mappingRange.begin();
   ftruncate(file.fd(), finalBufferSize);
 }
 
 template <class T>
-void freezeToString(const T& x, std::string& out) {
+void freezeToString(
+    const T& x,
+    std::string& out,
+    const ParallelFreezeOptions* options) {
   out.clear();
   Layout<T> layout;
   size_t contentSize = LayoutRoot::layout(x, layout);
@@ -184,9 +196,44 @@ void freezeToString(const T& x, std::string& out) {
   out.resize(bufferSize, 0);
   folly::MutableByteRange writeRange(
       reinterpret_cast<byte*>(&out[schemaSize]), contentSize);
-  ByteRangeFreezer::freeze(layout, x, writeRange);
+  if (options) {
+    ParallelFreezer::freeze(layout, x, writeRange, *options);
+  } else {
+    ByteRangeFreezer::freeze(layout, x, writeRange);
+  }
   out.resize(out.size() - writeRange.size());
 }
+} // namespace detail
+
+template <class T>
+void freezeToFile(const T& x, folly::File file) {
+  detail::freezeToFile(x, std::move(file), nullptr);
+}
+
+/**
+ * Freezes the items of large containers on several threads, see
+ * ParallelFreezer. The file is the same as with freezeToFile(x, file).
+ */
+template <class T>
+void freezeToFile(
+    const T& x,
+    folly::File file,
+    const ParallelFreezeOptions& options) {
+  detail::freezeToFile(x, std::move(file), &options);
+}
+
+template <class T>
+void freezeToString(const T& x, std::string& out) {
+  detail::freezeToString(x, out, nullptr);
+}
+
+template <class T>
+void freezeToString(
+    const T& x,
+    std::string& out,
+    const ParallelFreezeOptions& options) {
+  detail::freezeToString(x, out, &options);
+}
 
 template <class T>
 std::string freezeToString(const T& x) {
@@ -304,6 +351,78 @@ MappedFrozen<T> mapFrozen(folly::File file) {
       std::move(file), folly::MemoryMapping::LockMode::TRY_LOCK);
 }
 
+/**
+ * Options for mapFrozen<T>(File, MapFrozenOptions). The defaults map the file
+ * lazily: pages are read in when first touched and nothing is locked, which
+ * keeps startup fast for large files at the cost of page faults on first use.
+ */
+struct MapFrozenOptions {
+  // madvise() advice for the whole mapping.
+  enum class Advice {
+    NORMAL,
+    // Point lookups into large tables; disables readahead.
+    RANDOM,
+    SEQUENTIAL,
+    // Starts reading the whole file in the background.
+    WILLNEED,
+  };
+  Advice advice{Advice::NORMAL};
+  // Fault in the whole file before returning.
+  bool prefault{false};
+  // Copy the file into private memory backed by transparent huge pages
+  // instead of mapping the page cache, to save TLB misses on random lookups.
+  // Reads the whole file and holds a second copy of it while mapped.
+  bool hugePages{false};
+  // Lock the mapping in memory if set.
+  folly::Optional<folly::MemoryMapping::LockMode> lockMode;
+};
+
+namespace detail {
+folly::MemoryMapping mapFrozenFile(
+    folly::File file,
+    const MapFrozenOptions& options);
+} // namespace detail
+
+template <class T>
+MappedFrozen<T> mapFrozen(folly::File file, const MapFrozenOptions& options) {
+  return mapFrozen<T>(detail::mapFrozenFile(std::move(file), options));
+}
+
+/**
+ * Faults in the pages holding the given bytes of a mapped frozen object,
+ * e.g. a frozen string, and waits for them to be read.
+ */
+void prefault(folly::ByteRange range);
+
+namespace detail {
+template <class View>
+auto prefaultIndex(const View& view, int)
+    -> decltype(view.indexBytes(), void()) {
+  for (auto range : view.indexBytes()) {
+    prefault(range);
+  }
+}
+
+template <class View>
+void prefaultIndex(const View&, long) {}
+} // namespace detail
+
+/**
+ * Faults in the pages holding the items of a frozen list, set or map, so a
+ * file mapped lazily can be warmed up for just the tables that are hot:
+ *
+ *   auto index = mapFrozen<Index>(std::move(file), MapFrozenOptions());
+ *   prefault(index.byId());
+ *
+ * For hash maps and sets this includes the index probed by find(). Data the
+ * items point to, like the bytes of string items, is not included.
+ */
+template <class View>
+auto prefault(const View& view) -> decltype(view.itemBytes(), void()) {
+  prefault(view.itemBytes());
+  detail::prefaultIndex(view, 0);
+}
+
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
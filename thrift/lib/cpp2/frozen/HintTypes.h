@@ -17,6 +17,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -80,7 +82,44 @@ class FixedSizeString : public std::string {
   }
 };
 
+/*
+ * For representing hash maps and sets frozen with a Swiss table style index
+ * instead of the default sparse index. Lookups compare a byte of the hash of
+ * 16 slots at a time with SSE2, which is faster for large tables at the cost
+ * of one byte per slot plus an offset per 16 slots. Views have the same API
+ * as those of other frozen hash maps and sets.
+ *
+ * Use this in Thrift IDL like:
+ *
+ *   cpp_include "thrift/lib/cpp2/frozen/HintTypes.h"
+ *
+ *   struct MyStruct {
+ *     1: map<i64, string>
+ *        (cpp.template = "apache::thrift::frozen::SwissHashMap")
+ *        names,
+ *   }
+ *
+ * Data frozen this way must be mapped with the same hint type.
+ */
+template <class K, class V>
+class SwissHashMap : public std::unordered_map<K, V> {
+ public:
+  using std::unordered_map<K, V>::unordered_map;
+};
+
+template <class V>
+class SwissHashSet : public std::unordered_set<V> {
+ public:
+  using std::unordered_set<V>::unordered_set;
+};
+
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
 THRIFT_DECLARE_TRAIT_TEMPLATE(IsString, apache::thrift::frozen::VectorUnpacked)
+THRIFT_DECLARE_TRAIT_TEMPLATE(
+    IsSwissHashMap,
+    apache::thrift::frozen::SwissHashMap)
+THRIFT_DECLARE_TRAIT_TEMPLATE(
+    IsSwissHashSet,
+    apache::thrift::frozen::SwissHashSet)
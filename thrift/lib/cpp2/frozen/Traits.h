@@ -27,6 +27,10 @@ struct IsHashMap : std::false_type {};
 template <class>
 struct IsHashSet : std::false_type {};
 template <class>
+struct IsSwissHashMap : std::false_type {};
+template <class>
+struct IsSwissHashSet : std::false_type {};
+template <class>
 struct IsOrderedMap : std::false_type {};
 template <class>
 struct IsOrderedSet : std::false_type {};
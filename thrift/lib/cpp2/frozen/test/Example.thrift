@@ -173,3 +173,10 @@ struct TestFixedSizeString {
 
 struct Empty {
 }
+
+struct HotCold {
+  1: string coldName;
+  2: list<i64> coldHistory;
+  3: i64 hotId (cpp.frozen_hot);
+  4: map<i64, i64> hotIndex (cpp.frozen_hot);
+}
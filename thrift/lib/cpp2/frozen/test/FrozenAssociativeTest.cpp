@@ -22,6 +22,7 @@
 #include <folly/container/F14Set.h>
 #include <thrift/lib/cpp2/frozen/Frozen.h>
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
+#include <thrift/lib/cpp2/frozen/HintTypes.h>
 #include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_layouts.h>
 #include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_types.h>
 #include <thrift/lib/cpp2/protocol/DebugProtocol.h>
@@ -339,6 +340,61 @@ TEST(Frozen, StringHashMapBig) {
   }
 }
 
+TEST(FrozenSwissHashMap, Basic) {
+  testFrozenHashMapBasic<SwissHashMap<int, int>>();
+  auto fmap = freeze(SwissHashMap<int, int>{});
+  EXPECT_FALSE(fmap.count(1));
+  EXPECT_TRUE(fmap.find(1) == fmap.end());
+}
+
+TEST(FrozenSwissHashMap, Big) {
+  // Large enough to need probing past full groups.
+  SwissHashMap<int64_t, std::string> map;
+  for (int64_t i = 0; i < 10000; ++i) {
+    map[i * 100] = folly::to<std::string>(i);
+  }
+  auto fmap = freeze(map);
+  EXPECT_EQ(map.size(), fmap.size());
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_EQ(folly::to<std::string>(i), fmap.at(i * 100));
+    EXPECT_EQ(0, fmap.count(i * 100 + 1));
+  }
+  EXPECT_EQ(map, fmap.thaw());
+
+  // Mapped through a serialized schema.
+  auto mapped =
+      mapFrozen<SwissHashMap<int64_t, std::string>>(freezeToString(map));
+  EXPECT_EQ("42", mapped.at(4200));
+  EXPECT_FALSE(mapped.count(4201));
+}
+
+TEST(FrozenSwissHashMap, Strings) {
+  SwissHashMap<std::string, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[folly::to<std::string>(i)] = i;
+  }
+  auto fmap = freeze(map);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, fmap.at(folly::to<std::string>(i)));
+  }
+  EXPECT_FALSE(fmap.count("z"));
+  auto eq = fmap.equal_range("42");
+  EXPECT_EQ(1, eq.second - eq.first);
+  EXPECT_EQ(42, eq.first->second());
+}
+
+TEST(FrozenSwissHashSet, Basic) {
+  SwissHashSet<uint32_t> set;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    set.insert(i * 3);
+  }
+  auto fset = freeze(set);
+  for (uint32_t i = 0; i < 3000; ++i) {
+    EXPECT_EQ(i % 3 == 0 ? 1 : 0, fset.count(i)) << i;
+  }
+  EXPECT_EQ(set, fset.thaw());
+}
+
 template <class T>
 size_t distance(const std::pair<T, T>& pair) {
   return pair.second - pair.first;
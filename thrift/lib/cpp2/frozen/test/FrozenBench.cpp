@@ -16,6 +16,9 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Random.h>
+#include <folly/portability/Fcntl.h>
+#include <folly/portability/Unistd.h>
+#include <thrift/lib/cpp2/frozen/FrozenTestUtil.h>
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
 #include <thrift/lib/cpp2/frozen/HintTypes.h>
 #include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_layouts.h>
@@ -183,15 +186,27 @@ auto frozenHashMap_f32 = freeze(hashMap_f32);
 auto frozenHashMap_i32 = freeze(hashMap_i32);
 auto frozenHashMap_i64 = freeze(hashMap_i64);
 auto frozenHashMap_str = freeze(hashMap_str);
+auto frozenSwissHashMap_f32 = freeze(
+    SwissHashMap<float, int>(hashMap_f32.begin(), hashMap_f32.end()));
+auto frozenSwissHashMap_i32 = freeze(
+    SwissHashMap<int32_t, int>(hashMap_i32.begin(), hashMap_i32.end()));
+auto frozenSwissHashMap_i64 = freeze(
+    SwissHashMap<int64_t, int>(hashMap_i64.begin(), hashMap_i64.end()));
+auto frozenSwissHashMap_str = freeze(
+    SwissHashMap<std::string, int>(hashMap_str.begin(), hashMap_str.end()));
 
 BENCHMARK_PARAM(benchmarkLookup, hashMap_f32)
 BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenHashMap_f32)
+BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenSwissHashMap_f32)
 BENCHMARK_PARAM(benchmarkLookup, hashMap_i32)
 BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenHashMap_i32)
+BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenSwissHashMap_i32)
 BENCHMARK_PARAM(benchmarkLookup, hashMap_i64)
 BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenHashMap_i64)
+BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenSwissHashMap_i64)
 BENCHMARK_PARAM(benchmarkLookup, hashMap_str)
 BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenHashMap_str)
+BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenSwissHashMap_str)
 
 BENCHMARK_DRAW_LINE();
 
@@ -211,6 +226,106 @@ BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenMap_i64)
 
 BENCHMARK_DRAW_LINE();
 
+enum class MapMode {
+  // Mapped lazily after dropping the file from the page cache, so first
+  // touches of a page read it from disk.
+  COLD,
+  // Prefaulted at map time.
+  WARM,
+  // Copied into huge pages at map time.
+  HUGE_PAGES,
+};
+
+template <class Map>
+struct FrozenMapFile {
+  explicit FrozenMapFile(const Map& map) : file(freezeToTempFile(map)) {}
+
+  MappedFrozen<Map> map(MapMode mode) const {
+    MapFrozenOptions options;
+    if (mode == MapMode::COLD) {
+      fdatasync(file.fd());
+      posix_fadvise(file.fd(), 0, 0, POSIX_FADV_DONTNEED);
+      options.advice = MapFrozenOptions::Advice::RANDOM;
+    } else {
+      options.prefault = true;
+      options.hugePages = mode == MapMode::HUGE_PAGES;
+    }
+    return mapFrozen<Map>(folly::File(file.fd()), options);
+  }
+
+  folly::test::TemporaryFile file;
+};
+
+template <class Map>
+void benchmarkMappedLookup(
+    size_t iters,
+    const FrozenMapFile<Map>& file,
+    MapMode mode) {
+  using K = typename Map::key_type;
+  int s = 0;
+  MappedFrozen<Map> map;
+  while (iters) {
+    folly::BenchmarkSuspender setup;
+    if (mode == MapMode::COLD || !map) {
+      // Each chunk of lookups starts from a cold mapping.
+      map = MappedFrozen<Map>();
+      map = file.map(mode);
+    }
+    auto& keys = makeKeys<K>();
+    setup.dismiss();
+
+    for (auto& key : keys) {
+      if (iters == 0) {
+        break;
+      }
+      --iters;
+      auto found = map.find(key);
+      if (found != map.end()) {
+        ++s;
+      }
+    }
+  }
+  folly::BenchmarkSuspender teardown;
+  map = MappedFrozen<Map>();
+  folly::doNotOptimizeAway(s);
+}
+
+auto hashMapFile_i64 = FrozenMapFile<decltype(hashMap_i64)>(hashMap_i64);
+auto hashMapFile_str = FrozenMapFile<decltype(hashMap_str)>(hashMap_str);
+
+BENCHMARK_NAMED_PARAM(
+    benchmarkMappedLookup,
+    cold_i64,
+    hashMapFile_i64,
+    MapMode::COLD)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMappedLookup,
+    warm_i64,
+    hashMapFile_i64,
+    MapMode::WARM)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMappedLookup,
+    hugePages_i64,
+    hashMapFile_i64,
+    MapMode::HUGE_PAGES)
+BENCHMARK_NAMED_PARAM(
+    benchmarkMappedLookup,
+    cold_str,
+    hashMapFile_str,
+    MapMode::COLD)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMappedLookup,
+    warm_str,
+    hashMapFile_str,
+    MapMode::WARM)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMappedLookup,
+    hugePages_str,
+    hashMapFile_str,
+    MapMode::HUGE_PAGES)
+
+BENCHMARK_DRAW_LINE();
+
 template <class T>
 void benchmarkOldFreezeDataToString(size_t iters, const T& data) {
   const auto layout = maximumLayout<T>();
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <folly/portability/GTest.h>
+
+#include <thrift/lib/cpp2/frozen/FrozenOverlay.h>
+#include <thrift/lib/cpp2/frozen/FrozenTestUtil.h>
+
+using namespace apache::thrift;
+using namespace frozen;
+
+namespace {
+
+using Index = std::unordered_map<std::string, std::string>;
+
+Index makeBase() {
+  Index base;
+  for (int i = 0; i < 100; ++i) {
+    base["key" + std::to_string(i)] = "value" + std::to_string(i);
+  }
+  return base;
+}
+
+Index makeUpdated() {
+  auto updated = makeBase();
+  updated["key1"] = "changed";
+  updated.erase("key2");
+  updated.erase("key3");
+  updated["new"] = "added";
+  return updated;
+}
+
+MapOverlay<Index> makeOverlay(const Index& base, const Index& updated) {
+  return MapOverlay<Index>(
+      mapFrozen<Index>(freezeToString(base)),
+      mapFrozen<MapDelta<Index>>(freezeToString(makeDelta(base, updated))));
+}
+
+} // namespace
+
+TEST(FrozenOverlay, MakeDelta) {
+  auto delta = makeDelta(makeBase(), makeUpdated());
+  EXPECT_EQ(2, delta.first.size());
+  EXPECT_EQ("changed", delta.first.at("key1"));
+  EXPECT_EQ("added", delta.first.at("new"));
+  EXPECT_EQ(2, delta.second.size());
+  EXPECT_EQ(1, delta.second.count("key2"));
+  EXPECT_EQ(1, delta.second.count("key3"));
+}
+
+TEST(FrozenOverlay, Lookups) {
+  auto updated = makeUpdated();
+  auto overlay = makeOverlay(makeBase(), updated);
+
+  EXPECT_EQ(updated.size(), overlay.size());
+  EXPECT_EQ(4, overlay.deltaSize());
+  EXPECT_EQ("changed", overlay.at("key1"));
+  EXPECT_EQ("added", overlay.at("new"));
+  EXPECT_EQ("value0", overlay.at("key0"));
+  EXPECT_FALSE(overlay.getOptional("key2"));
+  EXPECT_EQ(0, overlay.count("key3"));
+  EXPECT_EQ(0, overlay.count("missing"));
+  EXPECT_EQ("default", overlay.getDefault("key2", "default"));
+  EXPECT_THROW(overlay.at("key2"), std::out_of_range);
+  // The base is unchanged.
+  EXPECT_EQ("value2", overlay.base().at("key2"));
+
+  Index seen;
+  overlay.forEach([&](folly::StringPiece key, folly::StringPiece value) {
+    EXPECT_TRUE(seen.emplace(key.str(), value.str()).second);
+  });
+  EXPECT_EQ(updated, seen);
+  EXPECT_EQ(updated, overlay.thaw());
+}
+
+TEST(FrozenOverlay, NoDelta) {
+  auto base = makeBase();
+  MapOverlay<Index> overlay(mapFrozen<Index>(freezeToString(base)));
+  EXPECT_EQ(base.size(), overlay.size());
+  EXPECT_EQ(0, overlay.deltaSize());
+  EXPECT_EQ("value5", overlay.at("key5"));
+  EXPECT_EQ(base, overlay.thaw());
+}
+
+TEST(FrozenOverlay, OrderedMap) {
+  std::map<int64_t, std::string> base{{1, "one"}, {2, "two"}, {3, "three"}};
+  auto updated = base;
+  updated.erase(2);
+  updated[4] = "four";
+  using Map = decltype(base);
+  MapOverlay<Map> overlay(
+      mapFrozen<Map>(freezeToString(base)),
+      mapFrozen<MapDelta<Map>>(freezeToString(makeDelta(base, updated))));
+  EXPECT_EQ(3, overlay.size());
+  EXPECT_EQ(0, overlay.count(2));
+  EXPECT_EQ("four", overlay.at(4));
+  EXPECT_EQ(updated, overlay.thaw());
+}
+
+TEST(FrozenOverlay, Compact) {
+  auto updated = makeUpdated();
+  auto overlay = makeOverlay(makeBase(), updated);
+
+  folly::test::TemporaryFile tmp;
+  auto compacted = compactToFile(overlay, folly::File(tmp.fd()));
+  EXPECT_EQ(0, compacted.deltaSize());
+  EXPECT_EQ(updated.size(), compacted.size());
+  EXPECT_EQ("changed", compacted.at("key1"));
+  EXPECT_FALSE(compacted.getOptional("key2"));
+  EXPECT_EQ(updated, compacted.thaw());
+  // The old overlay is still usable.
+  EXPECT_EQ("changed", overlay.at("key1"));
+}
@@ -110,6 +110,55 @@ BENCHMARK_RELATIVE(FrozenThaw, iters) {
   folly::doNotOptimizeAway(s);
 }
 
+BENCHMARK_DRAW_LINE();
+
+// A table large enough to freeze in parallel: each place has a name and a
+// small map frozen out of line.
+const PlaceTest& largeValue() {
+  static const PlaceTest places = [] {
+    PlaceTest x;
+    for (int64_t i = 0; i < 200000; ++i) {
+      auto& place = (*x.places_ref())[i * 7919];
+      *place.name_ref() = "place" + std::to_string(i);
+      for (int32_t h = 0; h < i % 12; ++h) {
+        (*place.popularityByHour_ref())[h] = i + h;
+      }
+    }
+    return x;
+  }();
+  return places;
+}
+
+BENCHMARK(FrozenFreezeLarge, iters) {
+  folly::BenchmarkSuspender setup;
+  const auto& value = largeValue();
+  setup.dismiss();
+  while (iters--) {
+    std::string out;
+    freezeToString(value, out);
+    folly::doNotOptimizeAway(out.size());
+  }
+}
+
+void frozenFreezeLargeParallel(size_t iters, size_t threads) {
+  folly::BenchmarkSuspender setup;
+  const auto& value = largeValue();
+  ParallelFreezeOptions options;
+  options.threads = threads;
+  setup.dismiss();
+  while (iters--) {
+    std::string out;
+    freezeToString(value, out, options);
+    folly::doNotOptimizeAway(out.size());
+  }
+}
+
+BENCHMARK_RELATIVE_PARAM(frozenFreezeLargeParallel, 1)
+BENCHMARK_RELATIVE_PARAM(frozenFreezeLargeParallel, 2)
+BENCHMARK_RELATIVE_PARAM(frozenFreezeLargeParallel, 4)
+BENCHMARK_RELATIVE_PARAM(frozenFreezeLargeParallel, 8)
+BENCHMARK_RELATIVE_PARAM(frozenFreezeLargeParallel, 16)
+
 #if 0
 ============================================================================
                                                 relative  time/iter  iters/s
@@ -18,6 +18,8 @@
 
 #include <thrift/lib/cpp2/frozen/FrozenTestUtil.h>
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
+#include <thrift/lib/cpp2/frozen/HintTypes.h>
+#include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_layouts.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 using namespace apache::thrift;
@@ -48,6 +50,68 @@ TEST(FrozenUtil, FreezeAndMap) {
   EXPECT_NE(original, thawed);
 }
 
+TEST(FrozenUtil, MapWithOptions) {
+  auto original = std::vector<std::string>{"hello", "world"};
+  auto tmp = freezeToTempFile(original);
+
+  MapFrozenOptions options;
+  options.advice = MapFrozenOptions::Advice::RANDOM;
+  auto lazy = mapFrozen<std::vector<std::string>>(
+      folly::File(tmp.fd()), options);
+  prefault(lazy);
+  prefault(lazy[1]);
+  EXPECT_EQ(original, lazy.thaw());
+
+  options.prefault = true;
+  options.hugePages = true;
+  auto copied = mapFrozen<std::vector<std::string>>(
+      folly::File(tmp.fd()), options);
+  EXPECT_EQ(original, copied.thaw());
+}
+
+TEST(FrozenUtil, PrefaultHashIndex) {
+  std::unordered_map<int, int> hash;
+  SwissHashMap<int, int> swiss;
+  for (int i = 0; i < 1000; ++i) {
+    hash[i] = i * 10;
+    swiss[i] = i * 10;
+  }
+  auto hashFile = freezeToTempFile(hash);
+  auto swissFile = freezeToTempFile(swiss);
+
+  auto mappedHash = mapFrozen<std::unordered_map<int, int>>(
+      folly::File(hashFile.fd()), MapFrozenOptions());
+  EXPECT_FALSE(mappedHash.indexBytes()[0].empty());
+  prefault(mappedHash);
+  EXPECT_EQ(1, mappedHash.count(5));
+
+  auto mappedSwiss = mapFrozen<SwissHashMap<int, int>>(
+      folly::File(swissFile.fd()), MapFrozenOptions());
+  auto index = mappedSwiss.indexBytes();
+  EXPECT_GE(index[0].size(), swiss.size());
+  EXPECT_FALSE(index[1].empty());
+  prefault(mappedSwiss);
+  EXPECT_EQ(1, mappedSwiss.count(5));
+}
+
+TEST(FrozenUtil, HotFieldsFirst) {
+  apache::thrift::test::HotCold value;
+  *value.coldName_ref() = "cold";
+  *value.coldHistory_ref() = {1, 2, 3};
+  *value.hotId_ref() = 42;
+  *value.hotIndex_ref() = {{1, 10}, {2, 20}};
+
+  auto view = mapFrozen<apache::thrift::test::HotCold>(freezeToString(value));
+  EXPECT_EQ(42, view.hotId());
+  EXPECT_EQ(20, view.hotIndex().at(2));
+  // Data of fields annotated cpp.frozen_hot is frozen before the others.
+  auto hotIndex = view.hotIndex().itemBytes();
+  auto coldName = folly::ByteRange(view.coldName());
+  EXPECT_LE(hotIndex.end(), coldName.begin());
+  EXPECT_LT(coldName.begin(), view.coldHistory().itemBytes().begin());
+  EXPECT_EQ(value, view.thaw());
+}
+
 TEST(FrozenUtil, FutureVersion) {
   folly::test::TemporaryFile tmp;
 
@@ -190,3 +254,63 @@ TEST(Frozen, FreezeDataToString) {
   EXPECT_EQ(view[1], "123");
   EXPECT_EQ(view[2], "xyz");
 }
+
+namespace {
+// Small tasks, to exercise splitting and merging them.
+ParallelFreezeOptions parallelOptions() {
+  ParallelFreezeOptions options;
+  options.threads = 4;
+  options.minItems = 1;
+  options.itemsPerTask = 8;
+  return options;
+}
+
+template <class T>
+void expectSameFrozen(const T& value) {
+  std::string serial, parallel;
+  freezeToString(value, serial);
+  freezeToString(value, parallel, parallelOptions());
+  EXPECT_EQ(serial, parallel);
+  EXPECT_EQ(value, mapFrozen<T>(std::move(parallel)).thaw());
+}
+} // namespace
+
+TEST(FrozenUtil, ParallelFreeze) {
+  std::vector<std::string> strings;
+  std::unordered_map<int64_t, std::string> hashMap;
+  std::map<int32_t, std::vector<double>> aligned;
+  std::vector<std::vector<int32_t>> nested;
+  for (int i = 0; i < 1000; ++i) {
+    // Mostly empty strings, so many tasks append under 8 bytes.
+    strings.push_back(i % 7 ? "" : std::to_string(i));
+    hashMap[i * 31] = std::string(i % 13, 'x');
+    aligned[i] = std::vector<double>(i % 3, i);
+    nested.push_back(std::vector<int32_t>(i % 5, i));
+  }
+  expectSameFrozen(strings);
+  expectSameFrozen(hashMap);
+  expectSameFrozen(aligned);
+  expectSameFrozen(nested);
+  expectSameFrozen(std::set<std::string>(strings.begin(), strings.end()));
+
+  apache::thrift::test::PlaceTest places;
+  for (int i = 0; i < 200; ++i) {
+    auto& place = (*places.places_ref())[i];
+    *place.name_ref() = "place" + std::to_string(i);
+    for (int h = 0; h < i % 24; ++h) {
+      (*place.popularityByHour_ref())[h] = i * h;
+    }
+  }
+  expectSameFrozen(places);
+}
+
+TEST(FrozenUtil, ParallelFreezeToFile) {
+  std::vector<std::string> original;
+  for (int i = 0; i < 1000; ++i) {
+    original.push_back("item" + std::to_string(i));
+  }
+  folly::test::TemporaryFile tmp;
+  freezeToFile(original, folly::File(tmp.fd()), parallelOptions());
+  auto mapped = mapFrozen<std::vector<std::string>>(folly::File(tmp.fd()));
+  EXPECT_EQ(original, mapped.thaw());
+}
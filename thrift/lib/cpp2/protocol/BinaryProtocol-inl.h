@@ -148,6 +148,56 @@ uint32_t BinaryProtocolWriter::writeFloat(float flt) {
   return sizeof(bits);
 }
 
+namespace detail {
+namespace binary {
+
+// Converts n elements between host and big-endian byte order. Goes through
+// the unsigned integer of the same width so floating point values are not
+// reinterpreted in place, and is written so the compiler can vectorize it.
+template <typename T>
+FOLLY_ALWAYS_INLINE void copyBigEndian(void* dst, const T* src, size_t n) {
+  using U = std::conditional_t<
+      sizeof(T) == 1,
+      uint8_t,
+      std::conditional_t<
+          sizeof(T) == 2,
+          uint16_t,
+          std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+  static_assert(sizeof(U) == sizeof(T), "");
+  if (sizeof(T) == 1 || !folly::kIsLittleEndian) {
+    if (dst != src) {
+      std::memcpy(dst, src, n * sizeof(T));
+    }
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    U bits;
+    std::memcpy(&bits, src + i, sizeof(U));
+    bits = folly::Endian::swap(bits);
+    std::memcpy(static_cast<uint8_t*>(dst) + i * sizeof(U), &bits, sizeof(U));
+  }
+}
+
+} // namespace binary
+} // namespace detail
+
+template <typename T>
+std::enable_if_t<detail::binary::is_fixed_width_v<T>, uint32_t>
+BinaryProtocolWriter::writeArithmeticVector(const T* in, size_t n) {
+  size_t remaining = n;
+  while (remaining > 0) {
+    // Fill whatever tailroom is left and let the appender grow the queue by
+    // its usual increment, instead of asking for one huge buffer.
+    out_.ensure(sizeof(T));
+    size_t count = std::min(remaining, out_.length() / sizeof(T));
+    detail::binary::copyBigEndian(out_.writableData(), in, count);
+    out_.append(count * sizeof(T));
+    in += count;
+    remaining -= count;
+  }
+  return folly::to_narrow(n * sizeof(T));
+}
+
 uint32_t BinaryProtocolWriter::writeString(folly::StringPiece str) {
   return writeBinary(str);
 }
@@ -159,7 +209,12 @@ uint32_t BinaryProtocolWriter::writeBinary(folly::StringPiece str) {
 uint32_t BinaryProtocolWriter::writeBinary(folly::ByteRange v) {
   uint32_t size = folly::to_narrow(v.size());
   uint32_t result = writeI32((int32_t)size);
-  out_.push(v.data(), size);
+  if (UNLIKELY(checksum_ != nullptr) &&
+      size >= checksum::QueueChecksum::kMinValueSize) {
+    checksum_->push(out_, v);
+  } else {
+    out_.push(v.data(), size);
+  }
   return result + size;
 }
 
@@ -493,6 +548,13 @@ void BinaryProtocolReader::readFloat(float& flt) {
   flt = folly::bit_cast<float>(bits);
 }
 
+template <typename T>
+std::enable_if_t<detail::binary::is_fixed_width_v<T>>
+BinaryProtocolReader::readArithmeticVector(T* out, size_t n) {
+  in_.pull(out, n * sizeof(T));
+  detail::binary::copyBigEndian(out, out, n);
+}
+
 void BinaryProtocolReader::checkStringSize(int32_t size) {
   // Catch error cases
   if (size < 0) {
@@ -565,6 +627,12 @@ void BinaryProtocolReader::readStringBody(StrType& str, int32_t size) {
     if (data.empty()) {
       TProtocolException::throwExceededSizeLimit();
     }
+    if (UNLIKELY(checksum_ != nullptr) &&
+        static_cast<size_t>(size) >= checksum::ChainChecksum::kMinValueSize) {
+      // Checksum each chunk right before copying it.
+      data_avail = std::min(data_avail, checksum::ChainChecksum::kChunkSize);
+      checksum_->update(in_.getCurrentPosition() + data_avail);
+    }
 
     str.append((const char*)data.data(), data_avail);
     size_left -= data_avail;
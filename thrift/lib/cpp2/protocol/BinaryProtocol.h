@@ -17,6 +17,9 @@
 #ifndef CPP2_PROTOCOL_TBINARYPROTOCOL_H_
 #define CPP2_PROTOCOL_TBINARYPROTOCOL_H_ 1
 
+#include <cstring>
+#include <type_traits>
+
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include <folly/io/IOBufQueue.h>
@@ -24,6 +27,7 @@
 #include <folly/portability/GFlags.h>
 #include <thrift/lib/cpp/protocol/TProtocol.h>
 #include <thrift/lib/cpp2/protocol/Protocol.h>
+#include <thrift/lib/cpp2/util/Checksum.h>
 
 DECLARE_int32(thrift_cpp2_protocol_reader_string_limit);
 DECLARE_int32(thrift_cpp2_protocol_reader_container_limit);
@@ -38,6 +42,21 @@ typedef folly::io::RWPrivateCursor RWCursor;
 using folly::io::Cursor;
 using folly::io::QueueAppender;
 
+namespace detail {
+namespace binary {
+
+// Element types whose wire representation is the big-endian image of their
+// in-memory representation, so whole lists of them can be byteswapped and
+// copied in one go.
+template <typename T>
+constexpr bool is_fixed_width_v = std::is_same<T, int8_t>::value ||
+    std::is_same<T, int16_t>::value || std::is_same<T, int32_t>::value ||
+    std::is_same<T, int64_t>::value || std::is_same<T, float>::value ||
+    std::is_same<T, double>::value;
+
+} // namespace binary
+} // namespace detail
+
 class BinaryProtocolReader;
 
 /**
@@ -82,6 +101,14 @@ class BinaryProtocolWriter {
     out_ = std::move(output);
   }
 
+  /**
+   * Checksums the output as it is written, see checksum::QueueChecksum. It
+   * must be for the queue passed to setOutput().
+   */
+  void setOutputChecksum(checksum::QueueChecksum* checksum) {
+    checksum_ = checksum;
+  }
+
   inline uint32_t writeMessageBegin(
       folly::StringPiece name,
       MessageType messageType,
@@ -114,6 +141,15 @@ class BinaryProtocolWriter {
   inline uint32_t writeSerializedData(
       const std::unique_ptr<folly::IOBuf>& data);
 
+  /**
+   * Writes n consecutive list elements of a fixed-width type, byteswapping
+   * them straight into the output buffer. Used by protocol_methods for
+   * contiguous list<byte/i16/i32/i64/float/double> containers.
+   */
+  template <typename T>
+  inline std::enable_if_t<detail::binary::is_fixed_width_v<T>, uint32_t>
+  writeArithmeticVector(const T* in, size_t n);
+
   /**
    * Functions that return the [estimated] serialized size
    * Notes:
@@ -164,6 +200,7 @@ class BinaryProtocolWriter {
    */
   QueueAppender out_;
   ExternalBufferSharing sharing_;
+  checksum::QueueChecksum* checksum_{nullptr};
 };
 
 class BinaryProtocolReader {
@@ -228,6 +265,14 @@ class BinaryProtocolReader {
     in_.reset(buf);
   }
 
+  /**
+   * Checksums the input as it is read, see checksum::ChainChecksum. It must
+   * be for the IOBuf passed to setInput().
+   */
+  void setInputChecksum(checksum::ChainChecksum* checksum) {
+    checksum_ = checksum;
+  }
+
   /**
    * Reading functions
    */
@@ -259,6 +304,15 @@ class BinaryProtocolReader {
   inline void readBinary(StrType& str);
   inline void readBinary(std::unique_ptr<folly::IOBuf>& str);
   inline void readBinary(folly::IOBuf& str);
+
+  /**
+   * Bulk counterpart of writeArithmeticVector: copies n elements out of the
+   * input and byteswaps them in place.
+   */
+  template <typename T>
+  inline std::enable_if_t<detail::binary::is_fixed_width_v<T>>
+  readArithmeticVector(T* out, size_t n);
+
   bool peekMap() {
     return false;
   }
@@ -377,6 +431,7 @@ class BinaryProtocolReader {
    * there is not enough data to read the whole struct.
    */
   Cursor in_;
+  checksum::ChainChecksum* checksum_{nullptr};
 
   template <typename T>
   friend class ProtocolReaderWithRefill;
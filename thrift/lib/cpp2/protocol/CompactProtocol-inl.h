@@ -298,7 +298,12 @@ uint32_t CompactProtocolWriter::writeBinary(folly::StringPiece str) {
 uint32_t CompactProtocolWriter::writeBinary(folly::ByteRange str) {
   uint32_t size = folly::to_narrow(str.size());
   uint32_t result = apache::thrift::util::writeVarint(out_, (int32_t)size);
-  out_.push(str.data(), size);
+  if (UNLIKELY(checksum_ != nullptr) &&
+      size >= checksum::QueueChecksum::kMinValueSize) {
+    checksum_->push(out_, str);
+  } else {
+    out_.push(str.data(), size);
+  }
   return result + size;
 }
 
@@ -645,6 +650,19 @@ void CompactProtocolReader::readI64(int64_t& i64) {
   i64 = apache::thrift::util::zigzagToI64(value);
 }
 
+template <typename T>
+std::enable_if_t<
+    std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value>
+CompactProtocolReader::readArithmeticVector(T* out, size_t n) {
+  using U = std::make_unsigned_t<T>;
+  apache::thrift::util::readVarintRange(in_, out, n);
+  // Branch-free zigzag decoding so the loop vectorizes.
+  for (size_t i = 0; i < n; ++i) {
+    U value = static_cast<U>(out[i]);
+    out[i] = static_cast<T>((value >> 1) ^ (U(0) - (value & 1)));
+  }
+}
+
 void CompactProtocolReader::readDouble(double& dub) {
   static_assert(sizeof(double) == sizeof(uint64_t), "");
   static_assert(std::numeric_limits<double>::is_iec559, "");
@@ -689,6 +707,12 @@ void CompactProtocolReader::readStringBody(StrType& str, int32_t size) {
     if (data.empty()) {
       TProtocolException::throwExceededSizeLimit();
     }
+    if (UNLIKELY(checksum_ != nullptr) &&
+        static_cast<size_t>(size) >= checksum::ChainChecksum::kMinValueSize) {
+      // Checksum each chunk right before copying it.
+      data_avail = std::min(data_avail, checksum::ChainChecksum::kChunkSize);
+      checksum_->update(in_.getCurrentPosition() + data_avail);
+    }
 
     str.append((const char*)data.data(), data_avail);
     size_left -= data_avail;
@@ -725,6 +749,32 @@ void CompactProtocolReader::readBinary(folly::IOBuf& str) {
   }
 }
 
+uint32_t CompactProtocolReader::readFromPositionAndAppend(
+    Cursor& snapshot,
+    std::unique_ptr<IOBuf>& ser) {
+  int32_t size =
+      folly::to_narrow(folly::to_signed(folly::io::Cursor(in_) - snapshot));
+
+  if (ser) {
+    std::unique_ptr<IOBuf> newBuf;
+    snapshot.clone(newBuf, size);
+    if (sharing_ != SHARE_EXTERNAL_BUFFER) {
+      newBuf->makeManaged();
+    }
+    // IOBuf are circular, so prependChain called on head is the same as
+    // appending the whole chain at the tail.
+    ser->prependChain(std::move(newBuf));
+  } else {
+    // cut a chunk of things directly
+    snapshot.clone(ser, size);
+    if (sharing_ != SHARE_EXTERNAL_BUFFER) {
+      ser->makeManaged();
+    }
+  }
+
+  return (uint32_t)size;
+}
+
 TType CompactProtocolReader::getType(int8_t type) {
   using apache::thrift::detail::compact::CTypeToTType;
   if (LIKELY(
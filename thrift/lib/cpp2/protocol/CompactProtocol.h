@@ -18,6 +18,7 @@
 #define CPP2_PROTOCOL_COMPACTPROTOCOL_H_ 1
 
 #include <stack>
+#include <type_traits>
 
 #include <folly/FBVector.h>
 #include <folly/io/Cursor.h>
@@ -26,6 +27,7 @@
 #include <folly/portability/GFlags.h>
 #include <thrift/lib/cpp/protocol/TProtocol.h>
 #include <thrift/lib/cpp2/protocol/Protocol.h>
+#include <thrift/lib/cpp2/util/Checksum.h>
 
 DECLARE_int32(thrift_cpp2_protocol_reader_string_limit);
 DECLARE_int32(thrift_cpp2_protocol_reader_container_limit);
@@ -132,6 +134,14 @@ class CompactProtocolWriter {
     out_ = std::move(output);
   }
 
+  /**
+   * Checksums the output as it is written, see checksum::QueueChecksum. It
+   * must be for the queue passed to setOutput().
+   */
+  void setOutputChecksum(checksum::QueueChecksum* checksum) {
+    checksum_ = checksum;
+  }
+
   inline uint32_t writeMessageBegin(
       folly::StringPiece name,
       MessageType messageType,
@@ -231,6 +241,7 @@ class CompactProtocolWriter {
    */
   QueueAppender out_;
   ExternalBufferSharing sharing_;
+  checksum::QueueChecksum* checksum_{nullptr};
 
   struct {
     const char* name;
@@ -299,6 +310,14 @@ class CompactProtocolReader {
     in_.reset(buf);
   }
 
+  /**
+   * Checksums the input as it is read, see checksum::ChainChecksum. It must
+   * be for the IOBuf passed to setInput().
+   */
+  void setInputChecksum(checksum::ChainChecksum* checksum) {
+    checksum_ = checksum;
+  }
+
   /**
    * Reading functions
    */
@@ -330,6 +349,17 @@ class CompactProtocolReader {
   inline void readBinary(StrType& str);
   inline void readBinary(std::unique_ptr<IOBuf>& str);
   inline void readBinary(IOBuf& str);
+
+  /**
+   * Reads n consecutive i32 or i64 list elements into out in one go. Used by
+   * protocol_methods for contiguous list<i32>/list<i64> containers, where it
+   * is much cheaper than going through readI32/readI64 per element.
+   */
+  template <typename T>
+  inline std::enable_if_t<
+      std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value>
+  readArithmeticVector(T* out, size_t n);
+
   void skip(TType type) {
     apache::thrift::skip(*this, type);
   }
@@ -352,11 +382,8 @@ class CompactProtocolReader {
   }
 
   inline uint32_t readFromPositionAndAppend(
-      Cursor& /*cursor*/,
-      std::unique_ptr<folly::IOBuf>& /*ser*/) {
-    // TODO
-    return 0;
-  }
+      Cursor& cursor,
+      std::unique_ptr<folly::IOBuf>& ser);
 
   struct StructReadState {
     int16_t fieldId;
@@ -465,6 +492,7 @@ class CompactProtocolReader {
    * there is not enough data tor ead the whole struct.
    */
   Cursor in_;
+  checksum::ChainChecksum* checksum_{nullptr};
 
   apache::thrift::detail::compact::SimpleStack<int16_t, 10> lastField_;
   int16_t lastFieldId_{-1};
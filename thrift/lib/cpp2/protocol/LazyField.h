@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <folly/Likely.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/lang/Assume.h>
+#include <folly/synchronization/AtomicNotification.h>
+#include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/protocol/Traits.h>
+#include <thrift/lib/cpp2/protocol/detail/protocol_methods.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+/**
+ * Deserialization state of a struct field marked `cpp.experimental.lazy` and
+ * generated with the `lazy_fields` option.
+ *
+ * When the enclosing struct is read with BinaryProtocolReader or
+ * CompactProtocolReader, the field is skipped and its serialized bytes are
+ * kept (sharing the input IOBuf) instead of being decoded. The first access
+ * through the generated accessors decodes them. Until the field is accessed
+ * mutably, writing the struct with the same protocol copies the bytes through
+ * verbatim. Other protocols decode eagerly, as for regular fields.
+ *
+ * Malformed field contents that skip() accepts are reported on first access
+ * rather than by deserialize().
+ *
+ * The value itself is a member of the generated struct and is passed in by
+ * reference; every call on a given LazyField must be given the same value.
+ * Decoding from const accessors is thread-safe: the first caller decodes,
+ * concurrent callers wait on the same atomic state word, so a lazy field adds
+ * no mutex to its struct.
+ */
+template <typename TypeClass>
+class LazyField {
+ public:
+  LazyField() = default;
+
+  LazyField(LazyField&& other) noexcept
+      : serialized_(std::move(other.serialized_)),
+        protocol_(other.protocol_),
+        state_(other.state_.load(std::memory_order_relaxed)) {
+    other.state_.store(kDecoded, std::memory_order_relaxed);
+  }
+
+  LazyField& operator=(LazyField&& other) noexcept {
+    serialized_ = std::move(other.serialized_);
+    protocol_ = other.protocol_;
+    state_.store(
+        other.state_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    other.state_.store(kDecoded, std::memory_order_relaxed);
+    return *this;
+  }
+
+  // The value has to be copied together with the state, see copy().
+  LazyField(const LazyField&) = delete;
+  LazyField& operator=(const LazyField&) = delete;
+
+  template <typename Protocol, typename T, typename ReadState>
+  void read(Protocol& iprot, T& value, ReadState& readState) {
+    readImpl(
+        iprot,
+        value,
+        readState,
+        std::integral_constant<bool, kCanDefer<Protocol>>{});
+  }
+
+  /**
+   * Decodes the pending bytes, if any, into value.
+   */
+  template <typename T>
+  void load(T& value) const {
+    if (FOLLY_LIKELY(state_.load(std::memory_order_acquire) == kDecoded) ||
+        !claimPending()) {
+      return;
+    }
+    try {
+      decode(value);
+    } catch (...) {
+      releasePending(kPending);
+      throw;
+    }
+    releasePending(kDecoded);
+  }
+
+  /**
+   * Like load(), for accessors that hand out a mutable reference: the
+   * serialized bytes can no longer be trusted to match the value.
+   */
+  template <typename T>
+  void loadForWrite(T& value) {
+    load(value);
+    serialized_.reset();
+  }
+
+  /**
+   * The value was overwritten (setter, __clear()).
+   */
+  void reset() noexcept {
+    serialized_.reset();
+    state_.store(kDecoded, std::memory_order_relaxed);
+  }
+
+  template <typename T>
+  void copy(T& value, const LazyField& src, const T& srcValue) {
+    // Holding the pending state keeps a concurrent load() of src from
+    // writing srcValue while it is copied.
+    bool pending = src.claimPending();
+    value = srcValue;
+    serialized_ = src.serialized_ ? src.serialized_->clone() : nullptr;
+    protocol_ = src.protocol_;
+    state_.store(pending ? kPending : kDecoded, std::memory_order_relaxed);
+    if (pending) {
+      src.releasePending(kPending);
+    }
+  }
+
+  template <typename Protocol, typename T>
+  uint32_t write(Protocol& prot, T& value) const {
+    if (canPassThrough<Protocol>()) {
+      return prot.writeSerializedData(serialized_);
+    }
+    load(value);
+    return protocol_methods<T>::write(prot, value);
+  }
+
+  template <bool ZeroCopy, typename Protocol, typename T>
+  uint32_t serializedSize(const Protocol& prot, T& value) const {
+    if (canPassThrough<Protocol>()) {
+      return prot.serializedSizeSerializedData(serialized_);
+    }
+    load(value);
+    return protocol_methods<T>::template serializedSize<ZeroCopy>(prot, value);
+  }
+
+  friend void swap(LazyField& a, LazyField& b) noexcept {
+    using std::swap;
+    swap(a.serialized_, b.serialized_);
+    swap(a.protocol_, b.protocol_);
+    auto state = a.state_.load(std::memory_order_relaxed);
+    a.state_.store(
+        b.state_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    b.state_.store(state, std::memory_order_relaxed);
+  }
+
+ private:
+  // serialized_ holds no bytes that still have to be decoded.
+  static constexpr uint32_t kDecoded = 0;
+  // serialized_ holds bytes that have not been decoded yet.
+  static constexpr uint32_t kPending = 1;
+  // A thread holds the pending bytes, to decode or copy them.
+  static constexpr uint32_t kBusy = 2;
+
+  // Returns true, with the state set to kBusy, if the bytes are pending.
+  // Waits for another thread holding them.
+  bool claimPending() const {
+    auto state = state_.load(std::memory_order_acquire);
+    while (true) {
+      if (state == kDecoded) {
+        return false;
+      }
+      if (state == kPending) {
+        if (state_.compare_exchange_weak(
+                state, kBusy, std::memory_order_acquire)) {
+          return true;
+        }
+        continue;
+      }
+      folly::atomic_wait(&state_, kBusy);
+      state = state_.load(std::memory_order_acquire);
+    }
+  }
+
+  void releasePending(uint32_t state) const {
+    state_.store(state, std::memory_order_release);
+    folly::atomic_notify_all(&state_);
+  }
+
+  template <typename T>
+  using protocol_methods = pm::protocol_methods<TypeClass, T>;
+
+  template <typename Protocol>
+  static constexpr bool kCanDefer =
+      std::is_same<Protocol, BinaryProtocolReader>::value ||
+      std::is_same<Protocol, CompactProtocolReader>::value;
+
+  template <typename Protocol, typename T, typename ReadState>
+  void readImpl(Protocol& iprot, T&, ReadState&, std::true_type) {
+    folly::io::Cursor start = iprot.getCursor();
+    iprot.skip(protocol_type_v<TypeClass, T>);
+    std::unique_ptr<folly::IOBuf> serialized;
+    iprot.readFromPositionAndAppend(start, serialized);
+    serialized_ = std::move(serialized);
+    protocol_ = Protocol::protocolType();
+    state_.store(kPending, std::memory_order_relaxed);
+  }
+
+  template <typename Protocol, typename T, typename ReadState>
+  void readImpl(
+      Protocol& iprot,
+      T& value,
+      ReadState& readState,
+      std::false_type) {
+    reset();
+    protocol_methods<T>::readWithContext(iprot, value, readState);
+  }
+
+  template <typename Protocol>
+  bool canPassThrough() const {
+    return (std::is_same<Protocol, BinaryProtocolWriter>::value ||
+            std::is_same<Protocol, CompactProtocolWriter>::value) &&
+        serialized_ && protocol_ == Protocol::protocolType();
+  }
+
+  template <typename T>
+  void decode(T& value) const {
+    value = T();
+    switch (protocol_) {
+      case ProtocolType::T_BINARY_PROTOCOL:
+        decodeWith<BinaryProtocolReader>(value);
+        return;
+      case ProtocolType::T_COMPACT_PROTOCOL:
+        decodeWith<CompactProtocolReader>(value);
+        return;
+      default:
+        folly::assume_unreachable();
+    }
+  }
+
+  template <typename Reader, typename T>
+  void decodeWith(T& value) const {
+    Reader reader;
+    reader.setInput(serialized_.get());
+    protocol_methods<T>::read(reader, value);
+  }
+
+  std::unique_ptr<folly::IOBuf> serialized_;
+  ProtocolType protocol_{ProtocolType::T_BINARY_PROTOCOL};
+  mutable std::atomic<uint32_t> state_{kDecoded};
+};
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
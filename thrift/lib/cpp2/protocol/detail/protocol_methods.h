@@ -152,6 +152,42 @@ template <typename T>
 constexpr bool sorted_unique_constructible_v =
     sorted_unique_constructible_<void, T>;
 
+// Contiguous containers whose elements the protocol can read in bulk (see
+// readArithmeticVector) skip the per-element protocol_methods dispatch.
+template <typename Void, typename Protocol, typename T>
+constexpr bool protocol_reads_arithmetic_vector_ = false;
+template <typename Protocol, typename T>
+constexpr bool protocol_reads_arithmetic_vector_<
+    folly::void_t<
+        decltype(std::declval<Protocol&>().readArithmeticVector(
+            std::declval<T&>().data(),
+            std::size_t())),
+        decltype(std::declval<T&>().resize(std::size_t()))>,
+    Protocol,
+    T> = std::is_same<
+    decltype(std::declval<T&>().data()),
+    typename T::value_type*>::value;
+template <typename Protocol, typename T>
+constexpr bool protocol_reads_arithmetic_vector_v =
+    protocol_reads_arithmetic_vector_<void, Protocol, T>;
+
+// Write-side counterpart of protocol_reads_arithmetic_vector_v, see
+// writeArithmeticVector.
+template <typename Void, typename Protocol, typename T>
+constexpr bool protocol_writes_arithmetic_vector_ = false;
+template <typename Protocol, typename T>
+constexpr bool protocol_writes_arithmetic_vector_<
+    folly::void_t<decltype(std::declval<Protocol&>().writeArithmeticVector(
+        std::declval<T const&>().data(),
+        std::size_t()))>,
+    Protocol,
+    T> = std::is_same<
+    decltype(std::declval<T const&>().data()),
+    typename T::value_type const*>::value;
+template <typename Protocol, typename T>
+constexpr bool protocol_writes_arithmetic_vector_v =
+    protocol_writes_arithmetic_vector_<void, Protocol, T>;
+
 FOLLY_CREATE_MEMBER_INVOKER(emplace_hint_invoker, emplace_hint);
 
 template <typename T>
@@ -512,21 +548,13 @@ struct protocol_methods<type_class::list<ElemClass>, Type> {
           protocol::TProtocolException::throwTruncatedData();
         }
 
-        using traits = std::iterator_traits<typename Type::iterator>;
-        using cat = typename traits::iterator_category;
-        if (reserve_if_possible(&out, list_size) ||
-            // use bidi as a hint for doubly linked list containers like
-            // std::list
-            std::is_same<cat, std::bidirectional_iterator_tag>::value) {
-          while (list_size--) {
-            elem_methods::read(protocol, emplace_back_default(out));
-          }
-        } else {
-          out.resize(list_size);
-          for (auto&& elem : out) {
-            elem_methods::read(protocol, elem);
-          }
-        }
+        read_elements(
+            protocol,
+            out,
+            list_size,
+            std::integral_constant<
+                bool,
+                protocol_reads_arithmetic_vector_v<Protocol, Type>>{});
       }
     }
     protocol.readListEnd();
@@ -543,9 +571,12 @@ struct protocol_methods<type_class::list<ElemClass>, Type> {
 
     xfer += protocol.writeListBegin(
         elem_ttype::value, folly::to_narrow(folly::to_unsigned(out.size())));
-    for (auto const& elem : out) {
-      xfer += elem_methods::write(protocol, elem);
-    }
+    xfer += write_elements(
+        protocol,
+        out,
+        std::integral_constant<
+            bool,
+            protocol_writes_arithmetic_vector_v<Protocol, Type>>{});
     xfer += protocol.writeListEnd();
     return xfer;
   }
@@ -562,6 +593,57 @@ struct protocol_methods<type_class::list<ElemClass>, Type> {
     xfer += protocol.serializedSizeListEnd();
     return xfer;
   }
+
+ private:
+  template <typename Protocol>
+  static void read_elements(
+      Protocol& protocol,
+      Type& out,
+      std::uint32_t list_size,
+      std::true_type) {
+    auto offset = out.size();
+    out.resize(offset + list_size);
+    protocol.readArithmeticVector(out.data() + offset, list_size);
+  }
+
+  template <typename Protocol>
+  static void read_elements(
+      Protocol& protocol,
+      Type& out,
+      std::uint32_t list_size,
+      std::false_type) {
+    using traits = std::iterator_traits<typename Type::iterator>;
+    using cat = typename traits::iterator_category;
+    if (reserve_if_possible(&out, list_size) ||
+        // use bidi as a hint for doubly linked list containers like
+        // std::list
+        std::is_same<cat, std::bidirectional_iterator_tag>::value) {
+      while (list_size--) {
+        elem_methods::read(protocol, emplace_back_default(out));
+      }
+    } else {
+      out.resize(list_size);
+      for (auto&& elem : out) {
+        elem_methods::read(protocol, elem);
+      }
+    }
+  }
+
+  template <typename Protocol>
+  static std::size_t
+  write_elements(Protocol& protocol, Type const& out, std::true_type) {
+    return protocol.writeArithmeticVector(out.data(), out.size());
+  }
+
+  template <typename Protocol>
+  static std::size_t
+  write_elements(Protocol& protocol, Type const& out, std::false_type) {
+    std::size_t xfer = 0;
+    for (auto const& elem : out) {
+      xfer += elem_methods::write(protocol, elem);
+    }
+    return xfer;
+  }
 };
 
 /*
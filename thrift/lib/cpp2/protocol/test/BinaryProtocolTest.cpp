@@ -14,9 +14,15 @@
  * limitations under the License.
  */
 
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <folly/io/IOBufQueue.h>
 #include <folly/portability/GTest.h>
 
 #include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
+#include <thrift/lib/cpp2/protocol/detail/protocol_methods.h>
 
 using namespace apache::thrift;
 using namespace apache::thrift::protocol;
@@ -39,4 +45,112 @@ TEST_F(BinaryProtocolTest, readInvalidBool) {
   EXPECT_THROW(inprot.readBool(value), TProtocolException);
 }
 
+template <typename TypeClass, typename T>
+void testBulkListRoundTrip(const std::vector<T>& values) {
+  using methods = apache::thrift::detail::pm::
+      protocol_methods<type_class::list<TypeClass>, std::vector<T>>;
+
+  folly::IOBufQueue queue;
+  BinaryProtocolWriter writer;
+  writer.setOutput(&queue);
+  methods::write(writer, values);
+  auto buf = queue.move();
+
+  // Same bytes as writing element by element.
+  folly::IOBufQueue expectedQueue;
+  BinaryProtocolWriter expectedWriter;
+  expectedWriter.setOutput(&expectedQueue);
+  expectedWriter.writeListBegin(
+      apache::thrift::protocol_type_v<TypeClass, T>,
+      values.size());
+  for (auto value : values) {
+    methods::elem_methods::write(expectedWriter, value);
+  }
+  auto expected = expectedQueue.move();
+  EXPECT_EQ(expected->coalesce(), buf->coalesce());
+
+  // Split the input so that elements straddle buffer boundaries.
+  auto data = buf->coalesce();
+  auto chain = folly::IOBuf::create(0);
+  for (size_t i = 0; i < data.size(); i += 3) {
+    chain->prependChain(folly::IOBuf::copyBuffer(
+        data.data() + i, std::min<size_t>(3, data.size() - i)));
+  }
+
+  for (const folly::IOBuf* input : {buf.get(), chain.get()}) {
+    BinaryProtocolReader reader;
+    reader.setInput(input);
+    std::vector<T> result;
+    methods::read(reader, result);
+    EXPECT_EQ(values, result);
+  }
+}
+
+TEST_F(BinaryProtocolTest, bulkListRoundTrip) {
+  testBulkListRoundTrip<type_class::integral, int8_t>(
+      {0, 1, -1, std::numeric_limits<int8_t>::min()});
+  testBulkListRoundTrip<type_class::integral, int16_t>(
+      {0, 1, -1, 0x1234, std::numeric_limits<int16_t>::min()});
+  testBulkListRoundTrip<type_class::integral, int32_t>(
+      {0, 1, -1, 0x12345678, std::numeric_limits<int32_t>::min()});
+  testBulkListRoundTrip<type_class::integral, int64_t>(
+      {0, 1, -1, 0x123456789abcdef0, std::numeric_limits<int64_t>::min()});
+  testBulkListRoundTrip<type_class::floating_point, float>(
+      {0.0f, -1.5f, std::numeric_limits<float>::max()});
+  testBulkListRoundTrip<type_class::floating_point, double>(
+      {0.0, -1.5, std::numeric_limits<double>::denorm_min()});
+}
+
+TEST_F(BinaryProtocolTest, bulkListDetection) {
+  using apache::thrift::detail::pm::protocol_writes_arithmetic_vector_v;
+  enum class Enum { A };
+  EXPECT_TRUE((protocol_writes_arithmetic_vector_v<
+               BinaryProtocolWriter,
+               std::vector<int32_t>>));
+  EXPECT_FALSE((protocol_writes_arithmetic_vector_v<
+                BinaryProtocolWriter,
+                std::deque<int32_t>>));
+  EXPECT_FALSE((protocol_writes_arithmetic_vector_v<
+                BinaryProtocolWriter,
+                std::vector<bool>>));
+  EXPECT_FALSE((protocol_writes_arithmetic_vector_v<
+                BinaryProtocolWriter,
+                std::vector<Enum>>));
+}
+
+TEST_F(BinaryProtocolTest, nonContiguousListRoundTrip) {
+  using methods = apache::thrift::detail::pm::protocol_methods<
+      type_class::list<type_class::integral>,
+      std::deque<int32_t>>;
+  std::deque<int32_t> values{0, 1, -1, 0x12345678};
+  folly::IOBufQueue queue;
+  BinaryProtocolWriter writer;
+  writer.setOutput(&queue);
+  methods::write(writer, values);
+  auto buf = queue.move();
+
+  BinaryProtocolReader reader;
+  reader.setInput(buf.get());
+  std::deque<int32_t> result;
+  methods::read(reader, result);
+  EXPECT_EQ(values, result);
+}
+
+TEST_F(BinaryProtocolTest, bulkListTruncated) {
+  std::vector<int64_t> values(16, 42);
+  folly::IOBufQueue queue;
+  BinaryProtocolWriter writer;
+  writer.setOutput(&queue);
+  writer.writeArithmeticVector(values.data(), values.size());
+  auto buf = queue.move();
+  buf->trimEnd(1);
+
+  BinaryProtocolReader reader;
+  reader.setInput(buf.get());
+  std::vector<int64_t> result(values.size());
+  EXPECT_THROW(
+      reader.readArithmeticVector(result.data(), result.size()),
+      std::out_of_range);
+}
+
 } // namespace
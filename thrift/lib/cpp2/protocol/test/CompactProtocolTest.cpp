@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <folly/io/IOBufQueue.h>
+#include <folly/portability/GTest.h>
+
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/protocol/detail/protocol_methods.h>
+
+using namespace apache::thrift;
+
+namespace {
+
+class CompactProtocolTest : public testing::Test {};
+
+template <typename T>
+std::vector<T> makeValues() {
+  std::mt19937_64 rng(1234);
+  std::vector<T> values = {
+      0,
+      1,
+      -1,
+      std::numeric_limits<T>::min(),
+      std::numeric_limits<T>::max()};
+  // Mix of every varint length.
+  for (int shift = 0; shift < 8 * int(sizeof(T)); ++shift) {
+    for (int i = 0; i < 16; ++i) {
+      auto bits = static_cast<T>(rng() >> (64 - 8 * sizeof(T)));
+      values.push_back(static_cast<T>(bits >> shift));
+    }
+  }
+  return values;
+}
+
+template <typename T>
+std::unique_ptr<folly::IOBuf> writeList(const std::vector<T>& values) {
+  using methods = detail::pm::protocol_methods<
+      type_class::list<type_class::integral>,
+      std::vector<T>>;
+  folly::IOBufQueue queue;
+  CompactProtocolWriter writer;
+  writer.setOutput(&queue);
+  methods::write(writer, values);
+  return queue.move();
+}
+
+template <typename T>
+std::vector<T> readList(const folly::IOBuf& buf) {
+  using methods = detail::pm::protocol_methods<
+      type_class::list<type_class::integral>,
+      std::vector<T>>;
+  CompactProtocolReader reader;
+  reader.setInput(&buf);
+  std::vector<T> values;
+  methods::read(reader, values);
+  return values;
+}
+
+// Splits buf into a chain of pieces of at most chunkSize bytes so that
+// varints straddle buffer boundaries.
+std::unique_ptr<folly::IOBuf> fragment(
+    const folly::IOBuf& buf,
+    size_t chunkSize) {
+  auto flat = buf.cloneCoalescedAsValue();
+  folly::ByteRange data(flat.data(), flat.length());
+  std::unique_ptr<folly::IOBuf> head;
+  for (size_t i = 0; i < data.size(); i += chunkSize) {
+    auto piece = folly::IOBuf::copyBuffer(
+        data.data() + i, std::min(chunkSize, data.size() - i));
+    if (head) {
+      head->prependChain(std::move(piece));
+    } else {
+      head = std::move(piece);
+    }
+  }
+  return head;
+}
+
+TEST_F(CompactProtocolTest, bulkReadI32List) {
+  auto values = makeValues<int32_t>();
+  auto buf = writeList(values);
+  EXPECT_EQ(values, readList<int32_t>(*buf));
+  for (size_t chunkSize : {1, 3, 7, 8, 9, 64}) {
+    EXPECT_EQ(values, readList<int32_t>(*fragment(*buf, chunkSize)))
+        << chunkSize;
+  }
+}
+
+TEST_F(CompactProtocolTest, bulkReadI64List) {
+  auto values = makeValues<int64_t>();
+  auto buf = writeList(values);
+  EXPECT_EQ(values, readList<int64_t>(*buf));
+  for (size_t chunkSize : {1, 3, 7, 8, 9, 64}) {
+    EXPECT_EQ(values, readList<int64_t>(*fragment(*buf, chunkSize)))
+        << chunkSize;
+  }
+}
+
+TEST_F(CompactProtocolTest, bulkReadInvalidVarint) {
+  // A 6 byte varint does not fit into an i32.
+  uint8_t data[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0, 0, 0, 0};
+  auto buf = folly::IOBuf::wrapBufferAsValue(folly::range(data));
+
+  CompactProtocolReader reader;
+  reader.setInput(&buf);
+  int32_t value;
+  EXPECT_THROW(reader.readArithmeticVector(&value, 1), std::out_of_range);
+}
+
+} // namespace
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/AdaptiveCompressionPolicy.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <folly/portability/SysResource.h>
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/util/Ewma.h>
+
+namespace apache {
+namespace thrift {
+
+namespace {
+bool accepts(const CompressionConfig& config, CompressionAlgorithm algorithm) {
+  auto algos = config.acceptedAlgos_ref().value_or(0);
+  return algos & (1ull << (static_cast<int>(algorithm) - 1));
+}
+
+CompressionAlgorithm requestedAlgorithm(const CompressionConfig& config) {
+  if (auto codecRef = config.codecConfig_ref()) {
+    switch (codecRef->getType()) {
+      case CodecConfig::zlibConfig:
+        return CompressionAlgorithm::ZLIB;
+      case CodecConfig::zstdConfig:
+        return CompressionAlgorithm::ZSTD;
+      case CodecConfig::lz4Config:
+        return CompressionAlgorithm::LZ4;
+      default:
+        break;
+    }
+  }
+  return CompressionAlgorithm::NONE;
+}
+
+int64_t processCpuTimeNs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto toNs = [](const timeval& tv) {
+    return int64_t(tv.tv_sec) * 1000000000 + int64_t(tv.tv_usec) * 1000;
+  };
+  return toNs(usage.ru_utime) + toNs(usage.ru_stime);
+}
+} // namespace
+
+AdaptiveCompressionPolicy::AdaptiveCompressionPolicy(Options options)
+    : options_(std::move(options)) {
+  CHECK(options_.highCpuLoad <= options_.maxCpuLoad);
+  CHECK_GT(options_.sampleRate, 0);
+}
+
+AdaptiveCompressionPolicy::Method& AdaptiveCompressionPolicy::getMethod(
+    const std::string& name) {
+  return methods_.get(name).second;
+}
+
+AdaptiveCompressionPolicy::Decision AdaptiveCompressionPolicy::decide(
+    Method& method,
+    const CompressionConfig& config,
+    size_t payloadSize) {
+  Decision decision;
+  auto requested = requestedAlgorithm(config);
+  if (requested == CompressionAlgorithm::NONE ||
+      payloadSize <= static_cast<size_t>(
+                         config.compressionSizeLimit_ref().value_or(0))) {
+    return decision;
+  }
+
+  auto skip = [&] {
+    method.skippedCount_.fetch_add(1, std::memory_order_relaxed);
+    return decision;
+  };
+  if (payloadSize < options_.minPayloadSize) {
+    return skip();
+  }
+  if (method.samples_.load(std::memory_order_relaxed) >=
+          options_.minSamples &&
+      method.compressedRatio() > options_.maxCompressedRatio &&
+      method.poorRatioCount_.fetch_add(1, std::memory_order_relaxed) %
+              options_.sampleRate !=
+          0) {
+    return skip();
+  }
+  auto cpuLoad = getCpuLoad();
+  if (cpuLoad >= options_.maxCpuLoad) {
+    return skip();
+  }
+
+  decision.algorithm = requested;
+  if (cpuLoad >= options_.highCpuLoad) {
+    if (accepts(config, CompressionAlgorithm::LZ4)) {
+      decision.algorithm = CompressionAlgorithm::LZ4;
+    } else {
+      decision.level = folly::io::COMPRESSION_LEVEL_FASTEST;
+    }
+  }
+  return decision;
+}
+
+void AdaptiveCompressionPolicy::onCompressed(
+    Method& method,
+    size_t uncompressedSize,
+    size_t compressedSize,
+    std::chrono::nanoseconds cpuTime) {
+  method.compressedCount_.fetch_add(1, std::memory_order_relaxed);
+  if (compressedSize < uncompressedSize) {
+    method.bytesSaved_.fetch_add(
+        uncompressedSize - compressedSize, std::memory_order_relaxed);
+  }
+  method.cpuNs_.fetch_add(cpuTime.count(), std::memory_order_relaxed);
+
+  auto const sample = static_cast<double>(compressedSize) /
+      std::max<size_t>(uncompressedSize, 1);
+  auto const samples = method.samples_.fetch_add(1, std::memory_order_relaxed);
+  auto ratio = method.ratio_.load(std::memory_order_relaxed);
+  ratio = sampleEwma(ratio, sample, samples == 0);
+  method.ratio_.store(ratio, std::memory_order_relaxed);
+}
+
+double AdaptiveCompressionPolicy::getCpuLoad() {
+  if (options_.cpuLoad) {
+    return options_.cpuLoad();
+  }
+
+  auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count();
+  auto last = lastCpuSampleNs_.load(std::memory_order_relaxed);
+  if (now - last <
+          std::chrono::nanoseconds(options_.cpuLoadInterval).count() ||
+      !lastCpuSampleNs_.compare_exchange_strong(last, now)) {
+    return cpuLoad_.load(std::memory_order_relaxed);
+  }
+
+  auto cpuTime = processCpuTimeNs();
+  auto lastCpuTime = lastCpuTimeNs_.exchange(cpuTime);
+  if (last != 0) {
+    auto cores = std::max(1u, std::thread::hardware_concurrency());
+    cpuLoad_.store(
+        std::min(1.0, double(cpuTime - lastCpuTime) / (now - last) / cores),
+        std::memory_order_relaxed);
+  }
+  return cpuLoad_.load(std::memory_order_relaxed);
+}
+
+void AdaptiveCompressionPolicy::reportMetrics(
+    const MetricReportFn& report,
+    const std::string& prefix) const {
+  methods_.forEach([&](const std::string& name, const Method& method) {
+    report(prefix + name + ".compressed", method.compressedCount());
+    report(prefix + name + ".skipped", method.skippedCount());
+    report(prefix + name + ".bytes_saved", method.bytesSaved());
+    report(prefix + name + ".cpu_ns", method.cpuTime().count());
+    report(prefix + name + ".compressed_ratio", method.compressedRatio());
+  });
+}
+
+} // namespace thrift
+} // namespace apache
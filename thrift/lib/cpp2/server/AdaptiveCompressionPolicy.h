@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <folly/Function.h>
+#include <folly/compression/Compression.h>
+
+#include <thrift/lib/cpp2/server/MethodStateMap.h>
+#include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Decides for each Rocket response of a client that asked for compression
+ * whether it is worth compressing, and with which codec and level.
+ *
+ * Without a policy every response above CompressionConfig's size limit is
+ * compressed with the codec the client asked for. With one:
+ *
+ *   - responses smaller than Options::minPayloadSize are not compressed;
+ *   - the policy keeps a moving average of how well each method's responses
+ *     compress. Once that is above Options::maxCompressedRatio, only one in
+ *     Options::sampleRate responses is compressed, to notice if it changes;
+ *   - above Options::highCpuLoad, the cheapest codec the client accepts (LZ4
+ *     if it does, the requested codec at its fastest level otherwise) is
+ *     used, and above Options::maxCpuLoad nothing is compressed.
+ *
+ * Install with BaseThriftServer::setAdaptiveCompressionPolicy().
+ */
+class AdaptiveCompressionPolicy {
+ public:
+  using MetricReportFn =
+      folly::Function<void(const std::string&, double) const>;
+
+  struct Options {
+    size_t minPayloadSize{1024};
+    // Compressed size / uncompressed size.
+    double maxCompressedRatio{0.9};
+    uint32_t sampleRate{64};
+    // Samples needed before a method's ratio is trusted.
+    uint32_t minSamples{16};
+    // CPU load between 0 and 1.
+    double highCpuLoad{0.7};
+    double maxCpuLoad{0.9};
+    // Returns the current CPU load between 0 and 1. Defaults to the CPU
+    // usage of this process over all cores, sampled every cpuLoadInterval.
+    std::function<double()> cpuLoad;
+    std::chrono::milliseconds cpuLoadInterval{100};
+  };
+
+  struct Decision {
+    CompressionAlgorithm algorithm{CompressionAlgorithm::NONE};
+    int level{folly::io::COMPRESSION_LEVEL_DEFAULT};
+  };
+
+  class Method {
+   public:
+    double compressedRatio() const {
+      return ratio_.load(std::memory_order_relaxed);
+    }
+    uint64_t compressedCount() const {
+      return compressedCount_.load(std::memory_order_relaxed);
+    }
+    uint64_t skippedCount() const {
+      return skippedCount_.load(std::memory_order_relaxed);
+    }
+    uint64_t bytesSaved() const {
+      return bytesSaved_.load(std::memory_order_relaxed);
+    }
+    std::chrono::nanoseconds cpuTime() const {
+      return std::chrono::nanoseconds(cpuNs_.load(std::memory_order_relaxed));
+    }
+
+   private:
+    friend class AdaptiveCompressionPolicy;
+
+    // Updated without synchronization; concurrent samples may get lost.
+    std::atomic<double> ratio_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> compressedCount_{0};
+    std::atomic<uint64_t> skippedCount_{0};
+    std::atomic<uint64_t> bytesSaved_{0};
+    std::atomic<uint64_t> cpuNs_{0};
+    // Responses that were expected to compress poorly, for sampling.
+    std::atomic<uint64_t> poorRatioCount_{0};
+  };
+
+  AdaptiveCompressionPolicy() : AdaptiveCompressionPolicy(Options()) {}
+  explicit AdaptiveCompressionPolicy(Options options);
+
+  /**
+   * Returns the state of the given method, see MethodStateMap. The reference
+   * stays valid for the lifetime of the policy.
+   */
+  Method& getMethod(const std::string& name);
+
+  /**
+   * Picks the compression for a response of payloadSize bytes, out of the
+   * codecs the client accepts per config.
+   */
+  Decision decide(
+      Method& method,
+      const CompressionConfig& config,
+      size_t payloadSize);
+
+  /**
+   * Records the result of compressing a response as decided.
+   */
+  void onCompressed(
+      Method& method,
+      size_t uncompressedSize,
+      size_t compressedSize,
+      std::chrono::nanoseconds cpuTime);
+
+  /**
+   * Reports "<prefix><method>.compressed" and "<prefix><method>.skipped"
+   * response counts, "<prefix><method>.bytes_saved",
+   * "<prefix><method>.cpu_ns" spent compressing and
+   * "<prefix><method>.compressed_ratio" for every method seen so far.
+   */
+  void reportMetrics(const MetricReportFn& report, const std::string& prefix)
+      const;
+
+  const Options& getOptions() const {
+    return options_;
+  }
+
+ private:
+  double getCpuLoad();
+
+  const Options options_;
+  MethodStateMap<Method> methods_;
+
+  // Default CPU load sampling.
+  std::atomic<int64_t> lastCpuSampleNs_{0};
+  std::atomic<int64_t> lastCpuTimeNs_{0};
+  std::atomic<double> cpuLoad_{0};
+};
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/AdaptiveInlinePolicy.h>
+
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/util/Ewma.h>
+
+namespace apache {
+namespace thrift {
+
+AdaptiveInlinePolicy::AdaptiveInlinePolicy(Options options)
+    : options_(std::move(options)),
+      budgetPerWindow_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          options_.loadWindow * options_.maxIoThreadShare)) {
+  CHECK(options_.promoteBelow <= options_.demoteAbove);
+}
+
+AdaptiveInlinePolicy::Method& AdaptiveInlinePolicy::getMethod(
+    const std::string& name) {
+  return methods_.get(name).second;
+}
+
+bool AdaptiveInlinePolicy::shouldRunInline(
+    Method& method,
+    std::chrono::steady_clock::time_point now) {
+  if (!method.isInline()) {
+    method.offloadedCount_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto& budget = *budget_;
+  if (now - budget.windowStart >= options_.loadWindow) {
+    budget.windowStart = now;
+    budget.used = std::chrono::nanoseconds::zero();
+  }
+  if (budget.used >= budgetPerWindow_) {
+    method.offloadedCount_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  method.inlineCount_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void AdaptiveInlinePolicy::onProcessed(
+    Method& method,
+    bool ranInline,
+    std::chrono::nanoseconds cost) {
+  if (ranInline) {
+    budget_->used += cost;
+  }
+
+  auto const sample = cost.count();
+  auto const samples = method.samples_.fetch_add(1, std::memory_order_relaxed);
+  auto avg = method.avgCostNs_.load(std::memory_order_relaxed);
+  avg = sampleEwma<int64_t>(avg, sample, samples == 0);
+  method.avgCostNs_.store(avg, std::memory_order_relaxed);
+
+  if (samples + 1 < options_.minSamples) {
+    return;
+  }
+  if (method.isInline()) {
+    if (avg > options_.demoteAbove.count()) {
+      method.inline_.store(false, std::memory_order_relaxed);
+    }
+  } else if (avg < options_.promoteBelow.count()) {
+    method.inline_.store(true, std::memory_order_relaxed);
+  }
+}
+
+void AdaptiveInlinePolicy::reportMetrics(
+    const MetricReportFn& report,
+    const std::string& prefix) const {
+  methods_.forEach([&](const std::string& name, const Method& method) {
+    report(prefix + name + ".inline", method.inlineCount());
+    report(prefix + name + ".offloaded", method.offloadedCount());
+    report(prefix + name + ".avg_cost_ns", method.averageCost().count());
+    report(prefix + name + ".is_inline", method.isInline() ? 1 : 0);
+  });
+}
+
+} // namespace thrift
+} // namespace apache
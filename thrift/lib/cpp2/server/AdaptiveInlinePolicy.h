@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <folly/Function.h>
+#include <folly/ThreadLocal.h>
+#include <thrift/lib/cpp2/server/MethodStateMap.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Decides at runtime whether a request for a method that is not annotated
+ * with thread='eb' runs inline on the IO thread that received it, or is
+ * queued on the ThreadManager as usual.
+ *
+ * For very cheap handlers the hop to a CPU thread and back costs more than
+ * the handler itself. The policy keeps a moving average of each method's
+ * processing time (deserialization, the synchronous part of the handler and,
+ * for sync handlers, serialization of the response), wherever it runs:
+ *
+ *   - a method is promoted to inline execution once its average drops below
+ *     Options::promoteBelow, and demoted back to the ThreadManager once it
+ *     goes above Options::demoteAbove;
+ *   - each IO thread may spend at most Options::maxIoThreadShare of its time
+ *     running promoted methods inline. Once that budget is used up for the
+ *     current Options::loadWindow, promoted methods are offloaded again until
+ *     the next window.
+ *
+ * Requests that belong to an interaction are always offloaded. Inline
+ * requests bypass the ThreadManager queue, so its priorities and queue
+ * timeouts do not apply to them.
+ *
+ * Install with BaseThriftServer::setAdaptiveInlinePolicy().
+ */
+class AdaptiveInlinePolicy {
+ public:
+  using MetricReportFn =
+      folly::Function<void(const std::string&, double) const>;
+
+  struct Options {
+    std::chrono::nanoseconds promoteBelow{std::chrono::microseconds(1)};
+    std::chrono::nanoseconds demoteAbove{std::chrono::microseconds(5)};
+    double maxIoThreadShare{0.25};
+    std::chrono::milliseconds loadWindow{100};
+    // Samples needed before a method is promoted or demoted.
+    uint32_t minSamples{128};
+  };
+
+  class Method {
+   public:
+    bool isInline() const {
+      return inline_.load(std::memory_order_relaxed);
+    }
+    std::chrono::nanoseconds averageCost() const {
+      return std::chrono::nanoseconds(
+          avgCostNs_.load(std::memory_order_relaxed));
+    }
+    uint64_t inlineCount() const {
+      return inlineCount_.load(std::memory_order_relaxed);
+    }
+    uint64_t offloadedCount() const {
+      return offloadedCount_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class AdaptiveInlinePolicy;
+
+    std::atomic<bool> inline_{false};
+    // Updated without synchronization; concurrent samples may get lost.
+    std::atomic<int64_t> avgCostNs_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> inlineCount_{0};
+    std::atomic<uint64_t> offloadedCount_{0};
+  };
+
+  AdaptiveInlinePolicy() : AdaptiveInlinePolicy(Options()) {}
+  explicit AdaptiveInlinePolicy(Options options);
+
+  /**
+   * Returns the state of the given method, see MethodStateMap. The reference
+   * stays valid for the lifetime of the policy.
+   */
+  Method& getMethod(const std::string& name);
+
+  /**
+   * Called on the IO thread for each request; returns true if it should run
+   * inline there.
+   */
+  bool shouldRunInline(
+      Method& method,
+      std::chrono::steady_clock::time_point now =
+          std::chrono::steady_clock::now());
+
+  /**
+   * Records the processing time of a request, inline or not.
+   */
+  void
+  onProcessed(Method& method, bool ranInline, std::chrono::nanoseconds cost);
+
+  /**
+   * Reports "<prefix><method>.inline" and "<prefix><method>.offloaded"
+   * execution counts, "<prefix><method>.avg_cost_ns" and
+   * "<prefix><method>.is_inline" for every method seen so far.
+   */
+  void reportMetrics(const MetricReportFn& report, const std::string& prefix)
+      const;
+
+  const Options& getOptions() const {
+    return options_;
+  }
+
+ private:
+  // Inline execution budget of the current IO thread.
+  struct IoThreadBudget {
+    std::chrono::steady_clock::time_point windowStart;
+    std::chrono::nanoseconds used{0};
+  };
+
+  const Options options_;
+  const std::chrono::nanoseconds budgetPerWindow_;
+  MethodStateMap<Method> methods_;
+  folly::ThreadLocal<IoThreadBudget> budget_;
+};
+
+} // namespace thrift
+} // namespace apache
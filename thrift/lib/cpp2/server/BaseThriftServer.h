@@ -39,7 +39,11 @@
 #include <thrift/lib/cpp2/Flags.h>
 #include <thrift/lib/cpp2/Thrift.h>
 #include <thrift/lib/cpp2/async/AsyncProcessor.h>
+#include <thrift/lib/cpp2/server/AdaptiveCompressionPolicy.h>
+#include <thrift/lib/cpp2/server/AdaptiveInlinePolicy.h>
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
 #include <thrift/lib/cpp2/server/MonitoringServerInterface.h>
+#include <thrift/lib/cpp2/server/RequestTracer.h>
 #include <thrift/lib/cpp2/server/ServerAttribute.h>
 #include <thrift/lib/cpp2/server/ServerConfigs.h>
 
@@ -274,6 +278,13 @@ class BaseThriftServer : public apache::thrift::concurrency::Runnable,
    */
   ServerAttribute<size_t> writeBatchingSize_{0};
 
+  /**
+   * Trigger early flush when this many bytes are queued.
+   * Ignored if write batching interval is not set.
+   * (0 == disabled)
+   */
+  ServerAttribute<size_t> writeBatchingByteSize_{0};
+
   ServerAttributeThreadLocal<folly::sorted_vector_set<std::string>>
       methodsBypassMaxRequestsLimit_{{}};
 
@@ -301,6 +312,14 @@ class BaseThriftServer : public apache::thrift::concurrency::Runnable,
 
   std::shared_ptr<server::TServerEventHandler> eventHandler_;
 
+  std::shared_ptr<AdaptiveInlinePolicy> adaptiveInlinePolicy_;
+
+  std::shared_ptr<AdaptiveCompressionPolicy> adaptiveCompressionPolicy_;
+
+  std::shared_ptr<MethodLatencyStats> methodLatencyStats_;
+
+  std::shared_ptr<RequestTracer> requestTracer_;
+
   // Notification of various server events. Note that once observer_ has been
   // set, it cannot be set again and will remain alive for (at least) the
   // lifetime of *this.
@@ -466,6 +485,64 @@ class BaseThriftServer : public apache::thrift::concurrency::Runnable,
     return threadManager_;
   }
 
+  /**
+   * Lets the server run cheap methods inline on the IO threads instead of
+   * queueing them on the thread manager, see AdaptiveInlinePolicy. Not set
+   * by default. Must be called before serve().
+   */
+  void setAdaptiveInlinePolicy(std::shared_ptr<AdaptiveInlinePolicy> policy) {
+    CHECK(configMutable());
+    adaptiveInlinePolicy_ = std::move(policy);
+  }
+
+  AdaptiveInlinePolicy* getAdaptiveInlinePolicy() const final {
+    return adaptiveInlinePolicy_.get();
+  }
+
+  /**
+   * Lets the server decide per response whether and how to compress Rocket
+   * responses for clients that asked for compression, see
+   * AdaptiveCompressionPolicy. Not set by default, in which case responses
+   * are compressed as the client asked. Must be called before serve().
+   */
+  void setAdaptiveCompressionPolicy(
+      std::shared_ptr<AdaptiveCompressionPolicy> policy) {
+    CHECK(configMutable());
+    adaptiveCompressionPolicy_ = std::move(policy);
+  }
+
+  AdaptiveCompressionPolicy* getAdaptiveCompressionPolicy() const final {
+    return adaptiveCompressionPolicy_.get();
+  }
+
+  /**
+   * Records per-method latency histograms of the stages requests go through,
+   * see MethodLatencyStats. Not set by default. Must be called before
+   * serve().
+   */
+  void setMethodLatencyStats(std::shared_ptr<MethodLatencyStats> stats) {
+    CHECK(configMutable());
+    methodLatencyStats_ = std::move(stats);
+  }
+
+  MethodLatencyStats* getMethodLatencyStats() const final {
+    return methodLatencyStats_.get();
+  }
+
+  /**
+   * Keeps the timestamps of a sample of requests in per-IO-thread ring
+   * buffers, see RequestTracer. Not set by default. Must be called before
+   * serve().
+   */
+  void setRequestTracer(std::shared_ptr<RequestTracer> tracer) {
+    CHECK(configMutable());
+    requestTracer_ = std::move(tracer);
+  }
+
+  RequestTracer* getRequestTracer() const final {
+    return requestTracer_.get();
+  }
+
   /**
    * Get the maximum # of connections allowed before overload.
    *
@@ -1144,6 +1221,23 @@ class BaseThriftServer : public apache::thrift::concurrency::Runnable,
     return writeBatchingSize_.get();
   }
 
+  /**
+   * Set write batching byte size. Ignored if write batching interval is not
+   * set.
+   */
+  void setWriteBatchingByteSize(
+      size_t batchingByteSize,
+      AttributeSource source = AttributeSource::OVERRIDE) {
+    writeBatchingByteSize_.set(batchingByteSize, source);
+  }
+
+  /**
+   * Get write batching byte size
+   */
+  size_t getWriteBatchingByteSize() const {
+    return writeBatchingByteSize_.get();
+  }
+
   const Metadata& metadata() const {
     return metadata_;
   }
@@ -17,6 +17,7 @@
 #include "thrift/lib/cpp2/server/Cpp2ConnContext.h"
 
 #include <folly/String.h>
+#include <thrift/lib/cpp2/server/Cpp2Worker.h>
 
 #ifdef __APPLE__
 #include <sys/ucred.h> // @manual
@@ -90,6 +91,10 @@ folly::Optional<std::string> Cpp2ConnContext::PeerCred::getError() const {
   }
 }
 
+const server::ServerConfigs* Cpp2ConnContext::getServerConfigs() const {
+  return worker_ ? worker_->getServer() : nullptr;
+}
+
 std::optional<std::string_view> ClientMetadataRef::getAgent() {
   if (!md_.agent_ref()) {
     return {};
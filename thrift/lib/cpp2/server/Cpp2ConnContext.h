@@ -31,6 +31,7 @@
 #include <thrift/lib/cpp/server/TServerObserver.h>
 #include <thrift/lib/cpp/transport/THeader.h>
 #include <thrift/lib/cpp2/async/Interaction.h>
+#include <thrift/lib/cpp2/util/ArenaAllocator.h>
 #include <wangle/ssl/SSLUtil.h>
 
 using apache::thrift::concurrency::PriorityThreadManager;
@@ -42,6 +43,10 @@ namespace rocket {
 class ThriftRocketServerHandler;
 }
 
+namespace server {
+class ServerConfigs;
+}
+
 using ClientIdentityHook = std::function<std::unique_ptr<void, void (*)(void*)>(
     const folly::AsyncTransport* transport,
     X509* cert,
@@ -253,6 +258,12 @@ class Cpp2ConnContext : public apache::thrift::server::TConnectionContext {
     return worker_;
   }
 
+  /**
+   * Configuration of the server that accepted this connection, nullptr if
+   * the connection has no worker.
+   */
+  const server::ServerConfigs* getServerConfigs() const;
+
   std::optional<TransportType> getTransportType() const {
     return transportType_;
   }
@@ -563,6 +574,19 @@ class Cpp2RequestContext : public apache::thrift::server::TConnectionContext {
     return tile_;
   }
 
+  // Memory that lives exactly as long as this request. Created on first use.
+  // See ArenaAllocator for how to build generated structs against it.
+  folly::SysArena& getArena() {
+    if (!arena_) {
+      arena_ = std::make_unique<folly::SysArena>();
+    }
+    return *arena_;
+  }
+
+  ArenaAllocator<char> getArenaAllocator() {
+    return ArenaAllocator<char>(getArena());
+  }
+
  protected:
   static void no_op_destructor(void* /*ptr*/) {}
 
@@ -570,6 +594,9 @@ class Cpp2RequestContext : public apache::thrift::server::TConnectionContext {
 
  private:
   Cpp2ConnContext* ctx_;
+  // Declared before anything that may hold arena memory, so that it is
+  // destroyed last.
+  std::unique_ptr<folly::SysArena> arena_;
   RequestDataPtr requestData_;
   std::chrono::milliseconds requestTimeout_{0};
   std::string methodName_;
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <folly/lang/Bits.h>
+#include <glog/logging.h>
+
+namespace apache {
+namespace thrift {
+
+namespace {
+constexpr uint64_t kSubBuckets = uint64_t(1)
+    << LatencyHistogram::kSubBucketBits;
+
+// Only written by the owning thread, so no read-modify-write is needed.
+template <typename T>
+void increment(std::atomic<T>& value, T delta) {
+  value.store(
+      value.load(std::memory_order_relaxed) + delta,
+      std::memory_order_relaxed);
+}
+} // namespace
+
+constexpr size_t LatencyHistogram::kNumBuckets;
+constexpr size_t MethodLatencyStats::kNumStages;
+
+size_t LatencyHistogram::bucketIndex(std::chrono::nanoseconds latency) {
+  uint64_t units = std::max<int64_t>(latency.count(), 0) >> kUnitShift;
+  if (units < kSubBuckets) {
+    return units;
+  }
+  size_t msb = folly::findLastSet(units) - 1;
+  size_t index = ((msb - kSubBucketBits + 1) << kSubBucketBits) +
+      ((units >> (msb - kSubBucketBits)) & (kSubBuckets - 1));
+  return std::min(index, kNumBuckets - 1);
+}
+
+std::chrono::nanoseconds LatencyHistogram::bucketLowerBound(size_t index) {
+  DCHECK_LT(index, kNumBuckets);
+  if (index < kSubBuckets) {
+    return std::chrono::nanoseconds(index << kUnitShift);
+  }
+  size_t msb = (index >> kSubBucketBits) + kSubBucketBits - 1;
+  uint64_t units = (kSubBuckets + (index & (kSubBuckets - 1)))
+      << (msb - kSubBucketBits);
+  return std::chrono::nanoseconds(units << kUnitShift);
+}
+
+void LatencyHistogram::add(std::chrono::nanoseconds latency, uint64_t count) {
+  buckets_[bucketIndex(latency)] += count;
+  sumNs_ += std::max<int64_t>(latency.count(), 0) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  sumNs_ += other.sumNs_;
+}
+
+uint64_t LatencyHistogram::count() const {
+  uint64_t count = 0;
+  for (auto bucket : buckets_) {
+    count += bucket;
+  }
+  return count;
+}
+
+std::chrono::nanoseconds LatencyHistogram::average() const {
+  auto total = count();
+  return std::chrono::nanoseconds(total ? sumNs_ / int64_t(total) : 0);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double quantile) const {
+  auto total = count();
+  if (total == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(quantile * total)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      auto lower = bucketLowerBound(i);
+      if (i + 1 == kNumBuckets) {
+        return lower;
+      }
+      return lower + (bucketLowerBound(i + 1) - lower) / 2;
+    }
+  }
+  return bucketLowerBound(kNumBuckets - 1);
+}
+
+MethodLatencyStats::Method::Shard::~Shard() {
+  auto retired = method_.retired_.wlock();
+  mergeInto(*retired);
+}
+
+void MethodLatencyStats::Method::Shard::mergeInto(
+    Histograms& histograms) const {
+  for (size_t stage = 0; stage < kNumStages; ++stage) {
+    auto& histogram = histograms[stage];
+    for (size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+      histogram.addToBucket(
+          i, buckets_[stage][i].load(std::memory_order_relaxed));
+    }
+    histogram.addToSum(std::chrono::nanoseconds(
+        sumNs_[stage].load(std::memory_order_relaxed)));
+  }
+}
+
+MethodLatencyStats::Method::Method()
+    : shards_([this] { return new Shard(*this); }) {}
+
+void MethodLatencyStats::Method::record(
+    Stage stage,
+    std::chrono::nanoseconds latency) {
+  auto& shard = *shards_;
+  auto index = static_cast<size_t>(stage);
+  increment<uint64_t>(
+      shard.buckets_[index][LatencyHistogram::bucketIndex(latency)], 1);
+  increment<int64_t>(
+      shard.sumNs_[index], std::max<int64_t>(latency.count(), 0));
+}
+
+MethodLatencyStats::Histograms MethodLatencyStats::Method::getHistograms()
+    const {
+  // Holding the accessor keeps threads from exiting, so no shard is counted
+  // both live and retired.
+  auto accessor = shards_.accessAllThreads();
+  auto histograms = *retired_.rlock();
+  for (const auto& shard : accessor) {
+    shard.mergeInto(histograms);
+  }
+  return histograms;
+}
+
+MethodLatencyStats::MethodLatencyStats(Options options)
+    : options_(std::move(options)) {
+  CHECK_GT(options_.sampleRate, 0u);
+}
+
+MethodLatencyStats::Method& MethodLatencyStats::getMethod(
+    const std::string& name) {
+  return methods_.get(name).second;
+}
+
+void MethodLatencyStats::record(
+    Method& method,
+    const server::TServerObserver::CallTimestamps& timestamps) {
+  const std::chrono::steady_clock::time_point unset;
+  if (timestamps.readEnd == unset || timestamps.processBegin == unset) {
+    return;
+  }
+  // queueBegin is only set if the request went through the thread manager.
+  const bool queued = timestamps.queueBegin != unset;
+  method.record(
+      Stage::READ_TO_DISPATCH,
+      (queued ? timestamps.queueBegin : timestamps.processBegin) -
+          timestamps.readEnd);
+  method.record(
+      Stage::QUEUE,
+      queued ? timestamps.processBegin - timestamps.queueBegin
+             : std::chrono::nanoseconds(0));
+  if (timestamps.serializeBegin != unset) {
+    method.record(
+        Stage::HANDLER, timestamps.serializeBegin - timestamps.processBegin);
+    method.record(
+        Stage::SERIALIZE, timestamps.serializeEnd - timestamps.serializeBegin);
+  } else if (timestamps.processEnd != unset) {
+    // Errors are not serialized by the handler callback.
+    method.record(
+        Stage::HANDLER, timestamps.processEnd - timestamps.processBegin);
+  }
+  if (timestamps.writeBegin != unset) {
+    method.record(Stage::WRITE, timestamps.writeEnd - timestamps.writeBegin);
+  }
+}
+
+std::map<std::string, MethodLatencyStats::Histograms>
+MethodLatencyStats::getHistograms() const {
+  std::map<std::string, Histograms> histograms;
+  methods_.forEach([&](const std::string& name, const Method& method) {
+    histograms.emplace(name, method.getHistograms());
+  });
+  return histograms;
+}
+
+void MethodLatencyStats::reportMetrics(
+    const MetricReportFn& report,
+    const std::string& prefix) const {
+  reportHistograms(getHistograms(), report, prefix);
+}
+
+void MethodLatencyStats::reportHistograms(
+    const std::map<std::string, Histograms>& histograms,
+    const MetricReportFn& report,
+    const std::string& prefix) {
+  for (const auto& [name, stages] : histograms) {
+    for (size_t stage = 0; stage < kNumStages; ++stage) {
+      const auto& histogram = stages[stage];
+      auto key = prefix + name + "." + stageName(static_cast<Stage>(stage));
+      report(key + ".count", histogram.count());
+      report(key + ".avg_ns", histogram.average().count());
+      report(key + ".p50_ns", histogram.percentile(0.5).count());
+      report(key + ".p90_ns", histogram.percentile(0.9).count());
+      report(key + ".p99_ns", histogram.percentile(0.99).count());
+      report(key + ".p999_ns", histogram.percentile(0.999).count());
+    }
+  }
+}
+
+const char* MethodLatencyStats::stageName(Stage stage) {
+  switch (stage) {
+    case Stage::READ_TO_DISPATCH:
+      return "read_to_dispatch";
+    case Stage::QUEUE:
+      return "queue";
+    case Stage::HANDLER:
+      return "handler";
+    case Stage::SERIALIZE:
+      return "serialize";
+    case Stage::WRITE:
+      return "write";
+  }
+  return "unknown";
+}
+
+} // namespace thrift
+} // namespace apache
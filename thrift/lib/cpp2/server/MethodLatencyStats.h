@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <folly/Function.h>
+#include <folly/Synchronized.h>
+#include <folly/ThreadLocal.h>
+
+#include <thrift/lib/cpp/server/TServerObserver.h>
+#include <thrift/lib/cpp2/server/MethodStateMap.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * A log-linear latency histogram in the style of HdrHistogram. Latencies are
+ * counted in units of 2^kUnitShift ns, and every power of two above
+ * 2^kSubBucketBits units is split into 2^kSubBucketBits buckets, so a bucket
+ * is at most 1/8th as wide as its lower bound. Latencies of 2^kMaxValueBits
+ * ns (about 68s) and above all go to the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kUnitShift = 6;
+  static constexpr size_t kSubBucketBits = 3;
+  static constexpr size_t kMaxValueBits = 36;
+  static constexpr size_t kNumBuckets =
+      (kMaxValueBits - kUnitShift - kSubBucketBits + 1) << kSubBucketBits;
+
+  static size_t bucketIndex(std::chrono::nanoseconds latency);
+  // Smallest latency counted in the given bucket.
+  static std::chrono::nanoseconds bucketLowerBound(size_t index);
+
+  void add(std::chrono::nanoseconds latency, uint64_t count = 1);
+  void addToBucket(size_t index, uint64_t count) {
+    buckets_[index] += count;
+  }
+  void addToSum(std::chrono::nanoseconds sum) {
+    sumNs_ += sum.count();
+  }
+  void merge(const LatencyHistogram& other);
+
+  uint64_t count() const;
+  uint64_t bucketCount(size_t index) const {
+    return buckets_[index];
+  }
+  std::chrono::nanoseconds sum() const {
+    return std::chrono::nanoseconds(sumNs_);
+  }
+  std::chrono::nanoseconds average() const;
+  // Middle of the bucket holding the given quantile, 0 if empty.
+  std::chrono::nanoseconds percentile(double quantile) const;
+
+ private:
+  std::array<uint64_t, kNumBuckets> buckets_{};
+  int64_t sumNs_{0};
+};
+
+/**
+ * Per-method latency histograms of the stages a request goes through on the
+ * server:
+ *
+ *   - READ_TO_DISPATCH: from the request being read off the connection to it
+ *     being handed to the thread manager (or run on the IO thread);
+ *   - QUEUE: waiting in the thread manager queue;
+ *   - HANDLER: running the handler, up to serialization of its response;
+ *   - SERIALIZE: serializing the response;
+ *   - WRITE: from the response being queued on the connection to it being
+ *     written to the socket.
+ *
+ * Only one in Options::sampleRate requests is timed. Histograms are sharded
+ * per thread and only written by their own thread, so recording takes no
+ * locks and no read-modify-write atomics; shards are merged when read.
+ * Each shard takes about 9KB per method and recording thread.
+ *
+ * Only Rocket request-response calls are recorded. Install with
+ * BaseThriftServer::setMethodLatencyStats(), and read through
+ * getHistograms() and reportMetrics(), or across all servers through
+ * ServerInstrumentation::getMethodLatencyHistograms().
+ */
+class MethodLatencyStats {
+ public:
+  using MetricReportFn =
+      folly::Function<void(const std::string&, double) const>;
+
+  enum class Stage {
+    READ_TO_DISPATCH,
+    QUEUE,
+    HANDLER,
+    SERIALIZE,
+    WRITE,
+  };
+  static constexpr size_t kNumStages = 5;
+
+  using Histograms = std::array<LatencyHistogram, kNumStages>;
+
+  struct Options {
+    uint32_t sampleRate{1};
+  };
+
+  class Method {
+   public:
+    Method();
+
+    // Lock-free; may be called from any thread.
+    void record(Stage stage, std::chrono::nanoseconds latency);
+
+    // Merges the shards of all threads.
+    Histograms getHistograms() const;
+
+   private:
+    struct Shard {
+      explicit Shard(Method& method) : method_(method) {}
+      // Keeps the counts of threads that exit.
+      ~Shard();
+      void mergeInto(Histograms& histograms) const;
+
+      Method& method_;
+      std::array<
+          std::array<std::atomic<uint64_t>, LatencyHistogram::kNumBuckets>,
+          kNumStages>
+          buckets_{};
+      std::array<std::atomic<int64_t>, kNumStages> sumNs_{};
+    };
+    struct ShardTag {};
+
+    folly::Synchronized<Histograms> retired_;
+    folly::ThreadLocal<Shard, ShardTag, folly::AccessModeStrict> shards_;
+  };
+
+  MethodLatencyStats() : MethodLatencyStats(Options()) {}
+  explicit MethodLatencyStats(Options options);
+
+  /**
+   * Returns the state of the given method, see MethodStateMap. The reference
+   * stays valid for the lifetime of the stats.
+   */
+  Method& getMethod(const std::string& name);
+
+  /**
+   * Records every stage of a completed request whose timestamps are known.
+   */
+  void record(
+      Method& method,
+      const server::TServerObserver::CallTimestamps& timestamps);
+
+  std::map<std::string, Histograms> getHistograms() const;
+
+  /**
+   * Reports "<prefix><method>.<stage>.count", ".avg_ns", ".p50_ns",
+   * ".p90_ns", ".p99_ns" and ".p999_ns" for every method seen so far.
+   */
+  void reportMetrics(const MetricReportFn& report, const std::string& prefix)
+      const;
+
+  static void reportHistograms(
+      const std::map<std::string, Histograms>& histograms,
+      const MetricReportFn& report,
+      const std::string& prefix);
+
+  static const char* stageName(Stage stage);
+
+  const Options& getOptions() const {
+    return options_;
+  }
+
+ private:
+  const Options options_;
+  MethodStateMap<Method> methods_;
+};
+
+} // namespace thrift
+} // namespace apache
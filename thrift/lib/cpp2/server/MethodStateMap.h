@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/ThreadLocal.h>
+#include <folly/container/F14Map.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Per-method state of a server-wide policy or statistic, keyed by method
+ * name.
+ *
+ * Method names come from the client, so at most maxMethods names get their
+ * own entry. Once that many are tracked, any other name shares the entry of
+ * kOverflowName.
+ *
+ * Lookups are served from a per-thread cache of the entries, so the common
+ * case takes no lock. Entries are never removed and their addresses are
+ * stable for the lifetime of the map.
+ */
+template <typename T>
+class MethodStateMap {
+ public:
+  using Entry = std::pair<const std::string, T>;
+
+  static constexpr size_t kDefaultMaxMethods = 4096;
+  static constexpr const char* kOverflowName = "__other__";
+
+  explicit MethodStateMap(size_t maxMethods = kDefaultMaxMethods)
+      : maxMethods_(maxMethods) {}
+
+  Entry& get(const std::string& name) {
+    auto& cache = *cache_;
+    auto cached = cache.find(name);
+    if (cached != cache.end()) {
+      return *cached->second;
+    }
+    auto& entry = lookup(name);
+    // Names folded into the overflow entry are not cached, so the cache
+    // stays bounded too.
+    if (entry.first == name) {
+      cache.emplace(name, &entry);
+    }
+    return entry;
+  }
+
+  /**
+   * Calls fn(name, state) for every entry.
+   */
+  template <typename F>
+  void forEach(F&& fn) const {
+    auto entries = entries_.rlock();
+    for (const auto& [name, state] : *entries) {
+      fn(name, state);
+    }
+  }
+
+ private:
+  Entry& lookup(const std::string& name) {
+    {
+      auto entries = entries_.rlock();
+      auto it = entries->find(name);
+      if (it != entries->end()) {
+        // Values of a node map never move.
+        return const_cast<Entry&>(*it);
+      }
+    }
+    auto entries = entries_.wlock();
+    auto it = entries->find(name);
+    if (it == entries->end()) {
+      it = entries->size() < maxMethods_
+          ? entries->try_emplace(name).first
+          : entries->try_emplace(kOverflowName).first;
+    }
+    return *it;
+  }
+
+  const size_t maxMethods_;
+  folly::Synchronized<folly::F14NodeMap<std::string, T>, folly::SharedMutex>
+      entries_;
+  folly::ThreadLocal<folly::F14FastMap<std::string, Entry*>> cache_;
+};
+
+} // namespace thrift
+} // namespace apache
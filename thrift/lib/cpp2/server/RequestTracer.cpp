@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/RequestTracer.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <fmt/core.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <folly/portability/Unistd.h>
+#include <folly/system/ThreadId.h>
+#include <glog/logging.h>
+
+namespace apache {
+namespace thrift {
+
+namespace {
+using CallTimestamps = server::TServerObserver::CallTimestamps;
+using TimePoint = std::chrono::steady_clock::time_point;
+
+// The timestamps kept in a slot, in order.
+constexpr std::array<TimePoint CallTimestamps::*, 8> kTimestamps = {{
+    &CallTimestamps::readEnd,
+    &CallTimestamps::queueBegin,
+    &CallTimestamps::processBegin,
+    &CallTimestamps::serializeBegin,
+    &CallTimestamps::serializeEnd,
+    &CallTimestamps::processEnd,
+    &CallTimestamps::writeBegin,
+    &CallTimestamps::writeEnd,
+}};
+
+double toMicros(TimePoint timestamp) {
+  return std::chrono::duration<double, std::micro>(
+             timestamp.time_since_epoch())
+      .count();
+}
+} // namespace
+
+constexpr size_t RequestTracer::kNumTimestamps;
+
+RequestTracer::Buffer::Buffer(size_t size, uint64_t threadId)
+    : size_(size), threadId_(threadId), slots_(new Slot[size]()) {}
+
+RequestTracer::RequestTracer(Options options)
+    : options_(std::move(options)), buffers_([this] {
+        return new Buffer(options_.recordsPerThread, folly::getOSThreadID());
+      }) {
+  static_assert(kTimestamps.size() == kNumTimestamps, "");
+  CHECK_GT(options_.sampleRate, 0u);
+  CHECK_GT(options_.recordsPerThread, 0u);
+}
+
+const std::string& RequestTracer::internMethod(const std::string& name) {
+  return methods_.get(name).first;
+}
+
+void RequestTracer::record(
+    const std::string& method,
+    const CallTimestamps& timestamps) {
+  auto& buffer = *buffers_;
+  auto sequence = ++buffer.written_;
+  auto& slot = buffer.slots_[(sequence - 1) % buffer.size_];
+
+  slot.version.store(2 * sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.method.store(&method, std::memory_order_relaxed);
+  for (size_t i = 0; i < kNumTimestamps; ++i) {
+    slot.timestampsNs[i].store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            (timestamps.*kTimestamps[i]).time_since_epoch())
+            .count(),
+        std::memory_order_relaxed);
+  }
+  slot.version.store(2 * sequence, std::memory_order_release);
+}
+
+std::vector<RequestTracer::Record> RequestTracer::getRecords() const {
+  std::vector<Record> records;
+  {
+    auto accessor = buffers_.accessAllThreads();
+    for (const auto& buffer : accessor) {
+      for (size_t i = 0; i < buffer.size_; ++i) {
+        const auto& slot = buffer.slots_[i];
+        auto version = slot.version.load(std::memory_order_acquire);
+        if (version == 0 || version % 2 != 0) {
+          continue;
+        }
+        Record record;
+        auto method = slot.method.load(std::memory_order_relaxed);
+        for (size_t j = 0; j < kNumTimestamps; ++j) {
+          record.timestamps.*kTimestamps[j] =
+              TimePoint(std::chrono::nanoseconds(
+                  slot.timestampsNs[j].load(std::memory_order_relaxed)));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != version) {
+          // Overwritten while being read.
+          continue;
+        }
+        record.method = *method;
+        record.threadId = buffer.threadId_;
+        record.sequence = version / 2;
+        records.push_back(std::move(record));
+      }
+    }
+  }
+  std::stable_sort(
+      records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.timestamps.readEnd < b.timestamps.readEnd;
+      });
+  return records;
+}
+
+std::string RequestTracer::dumpChromeTrace() const {
+  const TimePoint unset;
+  const auto pid = getpid();
+  folly::dynamic events = folly::dynamic::array;
+  for (const auto& record : getRecords()) {
+    const auto& ts = record.timestamps;
+    auto id = fmt::format("{}:{}", record.threadId, record.sequence);
+    auto addEvent = [&](const std::string& name, bool begin, TimePoint at) {
+      events.push_back(folly::dynamic::object("name", name)("cat", "thrift")(
+          "ph", begin ? "b" : "e")("id", id)("pid", pid)(
+          "tid", record.threadId)("ts", toMicros(at)));
+    };
+    auto addSpan = [&](const std::string& name, TimePoint from, TimePoint to) {
+      if (from != unset && to != unset) {
+        addEvent(name, true, from);
+        addEvent(name, false, to);
+      }
+    };
+
+    const bool queued = ts.queueBegin != unset;
+    const bool serialized = ts.serializeBegin != unset;
+    const auto end = ts.writeEnd != unset ? ts.writeEnd : ts.processEnd;
+    if (ts.readEnd == unset || end == unset) {
+      continue;
+    }
+    // Spans on the same track must nest, so the request span encloses the
+    // stage spans.
+    addEvent(record.method, true, ts.readEnd);
+    addSpan(
+        "read_to_dispatch",
+        ts.readEnd,
+        queued ? ts.queueBegin : ts.processBegin);
+    if (queued) {
+      addSpan("queue", ts.queueBegin, ts.processBegin);
+    }
+    addSpan(
+        "handler",
+        ts.processBegin,
+        serialized ? ts.serializeBegin : ts.processEnd);
+    if (serialized) {
+      addSpan("serialize", ts.serializeBegin, ts.serializeEnd);
+    }
+    addSpan("write", ts.writeBegin, ts.writeEnd);
+    addEvent(record.method, false, end);
+  }
+  return folly::toJson(folly::dynamic::object("traceEvents", std::move(events))(
+      "displayTimeUnit", "ns"));
+}
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/ThreadLocal.h>
+#include <folly/Unit.h>
+
+#include <thrift/lib/cpp/server/TServerObserver.h>
+#include <thrift/lib/cpp2/server/MethodStateMap.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Keeps the timestamps of a sample of requests for diagnosing tail latency:
+ * when the request was parsed, queued on and dequeued from the thread
+ * manager, when the handler started and finished, when the response was
+ * serialized and when it was written to the socket.
+ *
+ * One in Options::sampleRate requests is traced. Records are written by the
+ * IO thread that sent the response into its own ring buffer of
+ * Options::recordsPerThread records, overwriting the oldest ones. Writing a
+ * record takes no locks; readers detect records overwritten while being read
+ * and skip them. Records of IO threads that exit are dropped.
+ *
+ * Only Rocket request-response calls are traced. Install with
+ * BaseThriftServer::setRequestTracer(), and dump with dumpChromeTrace() for
+ * chrome://tracing or Perfetto.
+ */
+class RequestTracer {
+ public:
+  struct Options {
+    uint32_t sampleRate{1000};
+    size_t recordsPerThread{4096};
+  };
+
+  struct Record {
+    std::string method;
+    // OS id of the IO thread that wrote the record.
+    uint64_t threadId{0};
+    // Position of the record in its thread's buffer, starting from 1.
+    uint64_t sequence{0};
+    // Timestamps the request did not go through are left unset.
+    server::TServerObserver::CallTimestamps timestamps;
+  };
+
+  RequestTracer() : RequestTracer(Options()) {}
+  explicit RequestTracer(Options options);
+
+  /**
+   * Returns a copy of the name that stays valid for the lifetime of the
+   * tracer, to pass to record(). Names beyond the limit of MethodStateMap
+   * are all recorded as its kOverflowName.
+   */
+  const std::string& internMethod(const std::string& name);
+
+  /**
+   * Adds a record to the calling thread's buffer. method must have been
+   * returned by internMethod().
+   */
+  void record(
+      const std::string& method,
+      const server::TServerObserver::CallTimestamps& timestamps);
+
+  /**
+   * Records currently held by all threads, ordered by parse time.
+   */
+  std::vector<Record> getRecords() const;
+
+  /**
+   * Renders getRecords() in the Chrome trace event format, one async track
+   * per request with a nested span per stage.
+   */
+  std::string dumpChromeTrace() const;
+
+  const Options& getOptions() const {
+    return options_;
+  }
+
+ private:
+  static constexpr size_t kNumTimestamps = 8;
+
+  // A seqlock: version is odd while the slot is being written, and
+  // 2 * sequence once record number sequence is complete.
+  struct Slot {
+    std::atomic<uint64_t> version{0};
+    std::atomic<const std::string*> method{nullptr};
+    std::array<std::atomic<int64_t>, kNumTimestamps> timestampsNs{};
+  };
+
+  struct Buffer {
+    Buffer(size_t size, uint64_t threadId);
+
+    const size_t size_;
+    const uint64_t threadId_;
+    std::unique_ptr<Slot[]> slots_;
+    // Only accessed by the owning thread.
+    uint64_t written_{0};
+  };
+  struct BufferTag {};
+
+  const Options options_;
+  MethodStateMap<folly::Unit> methods_;
+  folly::ThreadLocal<Buffer, BufferTag, folly::AccessModeStrict> buffers_;
+};
+
+} // namespace thrift
+} // namespace apache
@@ -33,7 +33,11 @@ namespace thrift {
 using PreprocessResult =
     folly::Optional<boost::variant<AppClientException, AppServerException>>;
 
+class AdaptiveCompressionPolicy;
+class AdaptiveInlinePolicy;
 class Cpp2ConnContext;
+class MethodLatencyStats;
+class RequestTracer;
 
 namespace server {
 
@@ -97,6 +101,18 @@ class ServerConfigs {
   // @see ThriftServer::getTosReflect function.
   virtual bool getTosReflect() const = 0;
 
+  // @see BaseThriftServer::getAdaptiveInlinePolicy function.
+  virtual AdaptiveInlinePolicy* getAdaptiveInlinePolicy() const = 0;
+
+  // @see BaseThriftServer::getAdaptiveCompressionPolicy function.
+  virtual AdaptiveCompressionPolicy* getAdaptiveCompressionPolicy() const = 0;
+
+  // @see BaseThriftServer::getMethodLatencyStats function.
+  virtual MethodLatencyStats* getMethodLatencyStats() const = 0;
+
+  // @see BaseThriftServer::getRequestTracer function.
+  virtual RequestTracer* getRequestTracer() const = 0;
+
   /**
    * Disables tracking of number of active requests in the server.
    *
@@ -16,6 +16,8 @@
 
 #include <thrift/lib/cpp2/server/ServerInstrumentation.h>
 
+#include <thrift/lib/cpp2/server/ThriftServer.h>
+
 namespace apache {
 namespace thrift {
 
@@ -30,6 +32,23 @@ ServerInstrumentation::ServerCollection::getServers() const {
   return servers_.rlock();
 }
 
+std::map<std::string, MethodLatencyStats::Histograms>
+ServerInstrumentation::getMethodLatencyHistograms() {
+  std::map<std::string, MethodLatencyStats::Histograms> merged;
+  forEachServer([&](ThriftServer& server) {
+    if (auto* stats = server.getMethodLatencyStats()) {
+      for (const auto& [name, histograms] : stats->getHistograms()) {
+        auto& into = merged[name];
+        for (size_t stage = 0; stage < MethodLatencyStats::kNumStages;
+             ++stage) {
+          into[stage].merge(histograms[stage]);
+        }
+      }
+    }
+  });
+  return merged;
+}
+
 void ServerInstrumentation::ServerCollection::addServer(ThriftServer& server) {
   servers_.wlock()->insert(&server);
 }
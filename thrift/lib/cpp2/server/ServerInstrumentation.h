@@ -18,10 +18,14 @@
 
 #include <folly/Synchronized.h>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
+
 namespace apache {
 namespace thrift {
 
@@ -49,6 +53,14 @@ class ServerInstrumentation {
     }
   }
 
+  /**
+   * Per-method latency histograms of all servers with MethodLatencyStats
+   * installed, merged across servers. See MethodLatencyStats::reportHistograms
+   * to export them.
+   */
+  static std::map<std::string, MethodLatencyStats::Histograms>
+  getMethodLatencyHistograms();
+
  private:
   static void registerServer(ThriftServer& server) {
     ServerCollection::getInstance().addServer(server);
@@ -41,6 +41,17 @@
 #include <wangle/acceptor/FizzConfigUtil.h>
 #include <wangle/acceptor/SharedSSLContextManager.h>
 
+// folly only builds its io_uring backend when liburing is present.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<liburing.h>)
+#define THRIFT_HAS_IO_URING 1
+#include <folly/experimental/io/IoUringBackend.h>
+#endif
+#endif
+#ifndef THRIFT_HAS_IO_URING
+#define THRIFT_HAS_IO_URING 0
+#endif
+
 DEFINE_bool(
     thrift_abort_if_exceeds_shutdown_deadline,
     true,
@@ -180,6 +191,51 @@ int ThriftServer::getListenSocket() const {
   return sockets[0];
 }
 
+bool ThriftServer::isIOUringAvailable() {
+#if THRIFT_HAS_IO_URING
+  return folly::IoUringBackend::isAvailable();
+#else
+  return false;
+#endif
+}
+
+void ThriftServer::setUseIOUring(IOUringOptions options) {
+  CHECK(configMutable());
+  if (!isIOUringAvailable()) {
+    LOG(WARNING) << "io_uring is not available, IO threads will use epoll";
+    return;
+  }
+#if THRIFT_HAS_IO_URING
+  folly::PollIoBackend::Options backendOptions;
+  backendOptions.setCapacity(options.capacity)
+      .setMaxSubmit(options.maxSubmit)
+      .setMaxGet(options.maxGet)
+      .setUseRegisteredFds(options.registerFds);
+
+  folly::EventBase::Options evbOptions;
+  evbOptions.setBackendFactory(
+      [backendOptions]() -> std::unique_ptr<folly::EventBaseBackendBase> {
+        try {
+          return std::make_unique<folly::IoUringBackend>(backendOptions);
+        } catch (const std::exception& ex) {
+          // e.g. ring creation failing due to RLIMIT_MEMLOCK
+          LOG(ERROR) << "Failed to create io_uring backend, falling back to "
+                     << "epoll: " << folly::exceptionStr(ex);
+          return folly::EventBase::getDefaultBackend();
+        }
+      });
+
+  auto eventBaseManager =
+      std::make_unique<folly::EventBaseManager>(std::move(evbOptions));
+  auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(
+      0, ioThreadPool_->getThreadFactory(), eventBaseManager.get());
+  ioThreadPool_ = std::move(ioThreadPool);
+  ioUringEventBaseManager_ = std::move(eventBaseManager);
+#else
+  (void)options;
+#endif
+}
+
 folly::EventBaseManager* ThriftServer::getEventBaseManager() {
   return eventBaseManager_;
 }
@@ -309,6 +365,9 @@ void ThriftServer::setup() {
       }
 
       // Resize the IO pool
+      if (getUseIOUring()) {
+        VLOG(1) << "Using io_uring backend for " << nWorkers << " IO threads";
+      }
       ioThreadPool_->setNumThreads(nWorkers);
       if (!acceptPool_) {
         acceptPool_ = std::make_shared<folly::IOThreadPoolExecutor>(
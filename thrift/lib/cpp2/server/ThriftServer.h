@@ -134,6 +134,10 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
   //! Manager of per-thread EventBase objects.
   folly::EventBaseManager* eventBaseManager_ = folly::EventBaseManager::get();
 
+  //! Manager of the io_uring backed EventBases driving ioThreadPool_, set
+  //! iff setUseIOUring() was called. Must outlive ioThreadPool_.
+  std::unique_ptr<folly::EventBaseManager> ioUringEventBaseManager_;
+
   //! IO thread pool. Drives Cpp2Workers.
   std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_ =
       std::make_shared<folly::IOThreadPoolExecutor>(
@@ -262,6 +266,43 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
     ioThreadPool_->setThreadFactory(threadFactory);
   }
 
+  struct IOUringOptions {
+    // Number of in-flight operations each IO thread's ring can hold. Every
+    // connection keeps at least one poll registered, so this should exceed
+    // the number of connections served by a single IO thread.
+    size_t capacity{64 * 1024};
+    // Max number of submission queue entries handed to the kernel per
+    // io_uring_enter() call.
+    size_t maxSubmit{128};
+    // Max number of completions reaped per event loop iteration.
+    size_t maxGet{128};
+    // Register connection fds with the ring to avoid the per-operation fd
+    // table lookup in the kernel.
+    bool registerFds{true};
+  };
+
+  /**
+   * Returns true if this build and the running kernel support the io_uring
+   * EventBase backend.
+   */
+  static bool isIOUringAvailable();
+
+  /**
+   * Drive the IO worker threads with folly's io_uring EventBase backend
+   * instead of the default libevent (epoll) one. Reads and writevs issued by
+   * all connections of a Cpp2Worker are then batched into a single ring per
+   * IO thread. Falls back to epoll if io_uring is not available.
+   *
+   * This replaces the current IO thread pool, so it must be called before
+   * setIOThreadFactory() and has no effect on a pool installed later via
+   * setIOThreadPool().
+   */
+  void setUseIOUring(IOUringOptions options = IOUringOptions());
+
+  bool getUseIOUring() const {
+    return ioUringEventBaseManager_ != nullptr;
+  }
+
   /**
    * Set the thread pool used to handle TLS handshakes. Note that the pool's
    * thread factory will be overridden - if you'd like to use your own, set it
@@ -335,6 +376,21 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
     return zeroCopyEnableFunc_;
   }
 
+  /**
+   * Send writes of at least `threshold` bytes with MSG_ZEROCOPY. Rocket
+   * connections batch responses before writing, so the threshold applies to
+   * the whole batch. The socket keeps the written IOBufs alive until the
+   * kernel reports the transmission complete. The observer is told about
+   * each such write through zeroCopyWrite(), or zeroCopyFallback() if the
+   * transport had to copy it.
+   */
+  void setZeroCopyThreshold(size_t threshold) {
+    setZeroCopyEnableFunc(
+        [threshold](const std::unique_ptr<folly::IOBuf>& buf) {
+          return buf->computeChainDataLength() >= threshold;
+        });
+  }
+
   void setAcceptExecutor(std::shared_ptr<folly::IOThreadPoolExecutor> pool) {
     acceptPool_ = pool;
   }
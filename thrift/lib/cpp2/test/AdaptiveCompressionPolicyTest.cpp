@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/AdaptiveCompressionPolicy.h>
+
+#include <chrono>
+#include <map>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using namespace std::chrono;
+
+namespace {
+
+CompressionConfig zstdConfig(bool acceptsLz4) {
+  CompressionConfig config;
+  config.codecConfig_ref().ensure().set_zstdConfig();
+  config.compressionSizeLimit_ref() = 10;
+  uint64_t algos = 1ull << (static_cast<int>(CompressionAlgorithm::ZSTD) - 1);
+  if (acceptsLz4) {
+    algos |= 1ull << (static_cast<int>(CompressionAlgorithm::LZ4) - 1);
+  }
+  config.acceptedAlgos_ref() = algos;
+  return config;
+}
+
+class AdaptiveCompressionPolicyTest : public testing::Test {
+ protected:
+  static AdaptiveCompressionPolicy::Options options(const double& cpuLoad) {
+    AdaptiveCompressionPolicy::Options options;
+    options.minPayloadSize = 100;
+    options.maxCompressedRatio = 0.9;
+    options.sampleRate = 4;
+    options.minSamples = 2;
+    options.highCpuLoad = 0.5;
+    options.maxCpuLoad = 0.8;
+    options.cpuLoad = [&cpuLoad] { return cpuLoad; };
+    return options;
+  }
+
+  double cpuLoad_{0};
+  AdaptiveCompressionPolicy policy_{options(cpuLoad_)};
+  AdaptiveCompressionPolicy::Method& method_{policy_.getMethod("foo")};
+};
+
+} // namespace
+
+TEST_F(AdaptiveCompressionPolicyTest, payloadSize) {
+  auto config = zstdConfig(false);
+
+  // Below the client's limit: not compressed, and not counted as skipped.
+  EXPECT_EQ(
+      CompressionAlgorithm::NONE, policy_.decide(method_, config, 5).algorithm);
+  EXPECT_EQ(0, method_.skippedCount());
+
+  EXPECT_EQ(
+      CompressionAlgorithm::NONE,
+      policy_.decide(method_, config, 50).algorithm);
+  EXPECT_EQ(1, method_.skippedCount());
+
+  auto decision = policy_.decide(method_, config, 1000);
+  EXPECT_EQ(CompressionAlgorithm::ZSTD, decision.algorithm);
+  EXPECT_EQ(folly::io::COMPRESSION_LEVEL_DEFAULT, decision.level);
+
+  // Clients that did not ask for compression get none.
+  EXPECT_EQ(
+      CompressionAlgorithm::NONE,
+      policy_.decide(method_, CompressionConfig(), 1000).algorithm);
+}
+
+TEST_F(AdaptiveCompressionPolicyTest, poorRatio) {
+  auto config = zstdConfig(false);
+
+  policy_.onCompressed(method_, 1000, 990, nanoseconds(100));
+  // Not enough samples yet.
+  EXPECT_EQ(
+      CompressionAlgorithm::ZSTD,
+      policy_.decide(method_, config, 1000).algorithm);
+  policy_.onCompressed(method_, 1000, 990, nanoseconds(100));
+
+  // Only one in sampleRate responses is compressed.
+  int compressed = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (policy_.decide(method_, config, 1000).algorithm !=
+        CompressionAlgorithm::NONE) {
+      ++compressed;
+    }
+  }
+  EXPECT_EQ(2, compressed);
+  EXPECT_EQ(6, method_.skippedCount());
+
+  // Samples that compress well bring it back.
+  for (int i = 0; i < 16; ++i) {
+    policy_.onCompressed(method_, 1000, 100, nanoseconds(100));
+  }
+  EXPECT_LT(method_.compressedRatio(), 0.9);
+  EXPECT_EQ(
+      CompressionAlgorithm::ZSTD,
+      policy_.decide(method_, config, 1000).algorithm);
+}
+
+TEST_F(AdaptiveCompressionPolicyTest, compressedRatio) {
+  policy_.onCompressed(method_, 1000, 250, nanoseconds(100));
+  EXPECT_DOUBLE_EQ(0.25, method_.compressedRatio());
+  // Each later response moves the ratio by an eighth of the difference.
+  policy_.onCompressed(method_, 1000, 650, nanoseconds(100));
+  EXPECT_DOUBLE_EQ(0.3, method_.compressedRatio());
+  // Empty responses do not divide by zero.
+  policy_.onCompressed(method_, 0, 0, nanoseconds(100));
+  EXPECT_DOUBLE_EQ(0.2625, method_.compressedRatio());
+}
+
+TEST_F(AdaptiveCompressionPolicyTest, cpuLoad) {
+  cpuLoad_ = 0.6;
+
+  EXPECT_EQ(
+      CompressionAlgorithm::LZ4,
+      policy_.decide(method_, zstdConfig(true), 1000).algorithm);
+  auto decision = policy_.decide(method_, zstdConfig(false), 1000);
+  EXPECT_EQ(CompressionAlgorithm::ZSTD, decision.algorithm);
+  EXPECT_EQ(folly::io::COMPRESSION_LEVEL_FASTEST, decision.level);
+
+  cpuLoad_ = 0.9;
+  EXPECT_EQ(
+      CompressionAlgorithm::NONE,
+      policy_.decide(method_, zstdConfig(true), 1000).algorithm);
+  EXPECT_EQ(1, method_.skippedCount());
+}
+
+TEST_F(AdaptiveCompressionPolicyTest, reportMetrics) {
+  policy_.decide(method_, zstdConfig(false), 50);
+  policy_.onCompressed(method_, 1000, 250, nanoseconds(100));
+  policy_.onCompressed(method_, 1000, 250, nanoseconds(200));
+
+  std::map<std::string, double> metrics;
+  policy_.reportMetrics(
+      [&](const std::string& name, double value) { metrics[name] = value; },
+      "thrift.");
+  EXPECT_EQ(2, metrics.at("thrift.foo.compressed"));
+  EXPECT_EQ(1, metrics.at("thrift.foo.skipped"));
+  EXPECT_EQ(1500, metrics.at("thrift.foo.bytes_saved"));
+  EXPECT_EQ(300, metrics.at("thrift.foo.cpu_ns"));
+  EXPECT_EQ(0.25, metrics.at("thrift.foo.compressed_ratio"));
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/AdaptiveInlinePolicy.h>
+
+#include <chrono>
+#include <map>
+#include <thread>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using namespace std::chrono;
+
+namespace {
+
+// The default thresholds, but decisions after a few samples and a short load
+// window.
+AdaptiveInlinePolicy::Options quickOptions() {
+  AdaptiveInlinePolicy::Options options;
+  options.maxIoThreadShare = 0.1;
+  options.loadWindow = milliseconds(10);
+  options.minSamples = 4;
+  return options;
+}
+
+void feed(
+    AdaptiveInlinePolicy& policy,
+    AdaptiveInlinePolicy::Method& method,
+    nanoseconds cost,
+    int count) {
+  for (int i = 0; i < count; ++i) {
+    policy.onProcessed(method, method.isInline(), cost);
+  }
+}
+
+} // namespace
+
+TEST(AdaptiveInlinePolicyTest, offloadedUntilMeasured) {
+  AdaptiveInlinePolicy policy(quickOptions());
+  auto& method = policy.getMethod("foo");
+
+  EXPECT_FALSE(policy.shouldRunInline(method));
+  EXPECT_FALSE(policy.shouldRunInline(method));
+  EXPECT_EQ(0, method.inlineCount());
+  EXPECT_EQ(2, method.offloadedCount());
+}
+
+TEST(AdaptiveInlinePolicyTest, promoteAndDemote) {
+  AdaptiveInlinePolicy policy(quickOptions());
+  auto& method = policy.getMethod("foo");
+
+  // Not enough samples yet.
+  feed(policy, method, nanoseconds(100), 3);
+  EXPECT_FALSE(method.isInline());
+  feed(policy, method, nanoseconds(100), 1);
+  EXPECT_TRUE(method.isInline());
+  EXPECT_TRUE(policy.shouldRunInline(method));
+
+  // Between the thresholds nothing changes.
+  feed(policy, method, microseconds(3), 100);
+  EXPECT_TRUE(method.isInline());
+
+  feed(policy, method, microseconds(50), 100);
+  EXPECT_FALSE(method.isInline());
+  EXPECT_FALSE(policy.shouldRunInline(method));
+
+  feed(policy, method, microseconds(3), 100);
+  EXPECT_FALSE(method.isInline());
+  feed(policy, method, nanoseconds(100), 100);
+  EXPECT_TRUE(method.isInline());
+}
+
+TEST(AdaptiveInlinePolicyTest, methodsDecideSeparately) {
+  AdaptiveInlinePolicy policy(quickOptions());
+  auto& cheap = policy.getMethod("cheap");
+  auto& expensive = policy.getMethod("expensive");
+
+  feed(policy, cheap, nanoseconds(100), 10);
+  feed(policy, expensive, microseconds(50), 10);
+  EXPECT_TRUE(policy.shouldRunInline(policy.getMethod("cheap")));
+  EXPECT_FALSE(policy.shouldRunInline(policy.getMethod("expensive")));
+  EXPECT_EQ(1, cheap.inlineCount());
+  EXPECT_EQ(1, expensive.offloadedCount());
+}
+
+TEST(AdaptiveInlinePolicyTest, ioThreadBudget) {
+  // The budget is only checked for promoted methods, and the 600us samples
+  // that use it up would demote the method on their own with the default
+  // 5us threshold. Raise the threshold so that only the budget decides.
+  auto options = quickOptions();
+  options.demoteAbove = milliseconds(1);
+  AdaptiveInlinePolicy policy(options);
+  auto& method = policy.getMethod("foo");
+  feed(policy, method, nanoseconds(100), 10);
+  ASSERT_TRUE(method.isInline());
+
+  // 10% of a 10ms window.
+  auto now = steady_clock::now();
+  EXPECT_TRUE(policy.shouldRunInline(method, now));
+  policy.onProcessed(method, true, microseconds(600));
+  EXPECT_TRUE(policy.shouldRunInline(method, now));
+  policy.onProcessed(method, true, microseconds(600));
+  EXPECT_FALSE(policy.shouldRunInline(method, now));
+  EXPECT_TRUE(method.isInline());
+
+  // Other IO threads have budgets of their own.
+  std::thread([&] {
+    EXPECT_TRUE(policy.shouldRunInline(method, now));
+  }).join();
+
+  EXPECT_TRUE(policy.shouldRunInline(method, now + milliseconds(10)));
+  EXPECT_EQ(4, method.inlineCount());
+  EXPECT_EQ(1, method.offloadedCount());
+}
+
+TEST(AdaptiveInlinePolicyTest, reportMetrics) {
+  AdaptiveInlinePolicy policy(quickOptions());
+  auto& method = policy.getMethod("foo");
+  feed(policy, method, nanoseconds(100), 10);
+  policy.shouldRunInline(method);
+  policy.shouldRunInline(method);
+
+  std::map<std::string, double> metrics;
+  policy.reportMetrics(
+      [&](const std::string& name, double value) { metrics[name] = value; },
+      "thrift.");
+  EXPECT_EQ(2, metrics.at("thrift.foo.inline"));
+  EXPECT_EQ(0, metrics.at("thrift.foo.offloaded"));
+  EXPECT_EQ(100, metrics.at("thrift.foo.avg_cost_ns"));
+  EXPECT_EQ(1, metrics.at("thrift.foo.is_inline"));
+}
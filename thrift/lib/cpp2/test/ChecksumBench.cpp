@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures CRC32C throughput on a 10 MB payload, and compares serializing
+// (and parsing) a payload with large values and checksumming it in a separate
+// pass against checksumming it as it is written (and read).
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/util/Checksum.h>
+
+using namespace apache::thrift;
+
+namespace {
+
+constexpr size_t kPayloadSize = 10 * 1000 * 1000;
+constexpr size_t kValueSize = 1000 * 1000;
+
+const std::unique_ptr<folly::IOBuf>& payload() {
+  static auto buf = [] {
+    auto ret = folly::IOBuf::create(kPayloadSize);
+    for (size_t i = 0; i < kPayloadSize; ++i) {
+      ret->writableData()[i] = static_cast<uint8_t>(i * 31);
+    }
+    ret->append(kPayloadSize);
+    return ret;
+  }();
+  return buf;
+}
+
+const std::vector<std::string>& values() {
+  static auto strings = [] {
+    std::vector<std::string> ret;
+    for (size_t i = 0; i < kPayloadSize / kValueSize; ++i) {
+      ret.emplace_back(
+          reinterpret_cast<const char*>(payload()->data()) + i * kValueSize,
+          kValueSize);
+    }
+    return ret;
+  }();
+  return strings;
+}
+
+// Sets crc, if given, to the checksum of the payload as it is written.
+std::unique_ptr<folly::IOBuf> serialize(uint32_t* crc) {
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  checksum::QueueChecksum checksum(queue);
+  CompactProtocolWriter writer;
+  writer.setOutput(&queue);
+  writer.setOutputChecksum(crc ? &checksum : nullptr);
+  for (auto& value : values()) {
+    writer.writeI64(value.size());
+    writer.writeBinary(value);
+  }
+  if (crc) {
+    *crc = checksum.value();
+  }
+  return queue.move();
+}
+
+void parse(const folly::IOBuf& buf, checksum::ChainChecksum* checksum) {
+  CompactProtocolReader reader;
+  reader.setInput(&buf);
+  reader.setInputChecksum(checksum);
+  for (size_t i = 0; i < values().size(); ++i) {
+    int64_t size;
+    reader.readI64(size);
+    std::string value;
+    reader.readBinary(value);
+    folly::doNotOptimizeAway(value);
+  }
+}
+
+void reportThroughput() {
+  constexpr size_t kIters = 100;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kIters; ++i) {
+    folly::doNotOptimizeAway(checksum::crc32c(*payload()));
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  LOG(INFO) << "crc32c: " << kIters * kPayloadSize / elapsed.count() / 1e9
+            << " GB/s";
+}
+
+} // namespace
+
+BENCHMARK(crc32c, iters) {
+  while (iters--) {
+    folly::doNotOptimizeAway(checksum::crc32c(*payload()));
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(serialize_then_checksum, iters) {
+  while (iters--) {
+    auto buf = serialize(nullptr);
+    folly::doNotOptimizeAway(checksum::crc32c(*buf));
+  }
+}
+
+BENCHMARK_RELATIVE(serialize_checksummed, iters) {
+  while (iters--) {
+    uint32_t crc;
+    folly::doNotOptimizeAway(serialize(&crc));
+    folly::doNotOptimizeAway(crc);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(checksum_then_parse, iters) {
+  std::unique_ptr<folly::IOBuf> buf;
+  BENCHMARK_SUSPEND {
+    buf = serialize(nullptr);
+  }
+  while (iters--) {
+    folly::doNotOptimizeAway(checksum::crc32c(*buf));
+    parse(*buf, nullptr);
+  }
+}
+
+BENCHMARK_RELATIVE(parse_checksummed, iters) {
+  std::unique_ptr<folly::IOBuf> buf;
+  BENCHMARK_SUSPEND {
+    buf = serialize(nullptr);
+  }
+  while (iters--) {
+    checksum::ChainChecksum checksum(*buf);
+    parse(*buf, &checksum);
+    folly::doNotOptimizeAway(checksum.value());
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  reportThroughput();
+  folly::runBenchmarks();
+  return 0;
+}
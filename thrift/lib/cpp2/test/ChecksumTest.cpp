@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+
+#include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/util/Checksum.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::checksum;
+
+namespace {
+
+std::string makeString(size_t size, char seed) {
+  std::string str(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    str[i] = static_cast<char>(seed + i * 31);
+  }
+  return str;
+}
+
+// Values both smaller and larger than what is checksummed as written.
+std::vector<std::string> makeValues() {
+  return {
+      makeString(10, 'a'),
+      makeString(QueueChecksum::kMinValueSize, 'b'),
+      makeString(100, 'c'),
+      makeString(3 * QueueChecksum::kChunkSize + 17, 'd'),
+      makeString(QueueChecksum::kMinValueSize - 1, 'e'),
+  };
+}
+
+template <typename Writer, typename Reader>
+void checkProtocol() {
+  auto values = makeValues();
+
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  QueueChecksum written(queue);
+  Writer writer;
+  // Small growth so that values span several buffers.
+  writer.setOutput(&queue, 1000);
+  writer.setOutputChecksum(&written);
+  for (auto& value : values) {
+    writer.writeI32(42);
+    writer.writeString(value);
+  }
+  writer.setOutputChecksum(nullptr);
+
+  auto buf = queue.move();
+  EXPECT_TRUE(buf->isChained());
+  auto expected = crc32c(*buf);
+  EXPECT_EQ(expected, written.value());
+
+  ChainChecksum read(*buf);
+  Reader reader;
+  reader.setInput(buf.get());
+  reader.setInputChecksum(&read);
+  for (auto& value : values) {
+    int32_t i;
+    reader.readI32(i);
+    EXPECT_EQ(42, i);
+    std::string str;
+    reader.readString(str);
+    EXPECT_EQ(value, str);
+  }
+  EXPECT_EQ(expected, read.value());
+}
+
+} // namespace
+
+TEST(ChecksumTest, append) {
+  auto data = makeString(100000, 'x');
+  folly::ByteRange range(folly::StringPiece(data));
+
+  Crc32c whole;
+  whole.update(range);
+
+  Crc32c first, second, third;
+  first.update(range.subpiece(0, 1000));
+  second.update(range.subpiece(1000, 50000));
+  third.update(range.subpiece(51000));
+  Crc32c combined;
+  combined.append(first);
+  second.append(third);
+  combined.append(second);
+
+  EXPECT_EQ(whole.value(), combined.value());
+  EXPECT_EQ(whole.length(), combined.length());
+  EXPECT_EQ(whole.value(), crc32c(*folly::IOBuf::wrapBuffer(range)));
+}
+
+TEST(ChecksumTest, chainChecksum) {
+  auto data = makeString(10000, 'y');
+  auto buf = folly::IOBuf::copyBuffer(data.data(), 3000);
+  buf->prependChain(folly::IOBuf::create(0));
+  buf->prependChain(folly::IOBuf::copyBuffer(data.data() + 3000, 7000));
+
+  ChainChecksum checksum(*buf);
+  checksum.update(1);
+  checksum.update(2999);
+  checksum.update(5000);
+  EXPECT_EQ(crc32c(*buf), checksum.value());
+  // Positions past the end are ignored.
+  checksum.update(20000);
+  EXPECT_EQ(crc32c(*buf), checksum.value());
+}
+
+TEST(ChecksumTest, compactProtocol) {
+  checkProtocol<CompactProtocolWriter, CompactProtocolReader>();
+}
+
+TEST(ChecksumTest, binaryProtocol) {
+  checkProtocol<BinaryProtocolWriter, BinaryProtocolReader>();
+}
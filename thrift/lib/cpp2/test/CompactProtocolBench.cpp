@@ -58,6 +58,21 @@ Deep makeDeep(size_t triplesz) {
   return data;
 }
 
+// Values are spread over all varint lengths, small ids dominate.
+NumericLists makeNumericLists(size_t size) {
+  NumericLists data;
+  data.i32s_ref()->reserve(size);
+  data.i64s_ref()->reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    auto shift = (i * 7) % 64;
+    data.i32s_ref()->push_back(
+        static_cast<int32_t>((i * 2654435761u) >> (shift % 32)));
+    data.i64s_ref()->push_back(
+        static_cast<int64_t>((i * 11400714819323198485ull) >> shift));
+  }
+  return data;
+}
+
 BENCHMARK(CompactProtocolReader_ctor, kiters) {
   BenchmarkSuspender braces;
   size_t iters = kiters << kMultExp;
@@ -198,6 +213,43 @@ BENCHMARK(CompactProtocolWriter_serialize_deep, kiters) {
   braces.rehire();
 }
 
+void benchDeserializeNumericLists(size_t kiters, size_t size) {
+  BenchmarkSuspender braces;
+  size_t iters = kiters << kMultExp;
+  NumericLists data = makeNumericLists(size);
+  CompactSerializer ser;
+  IOBufQueue bufq;
+  ser.serialize(data, &bufq);
+  auto buf = bufq.move();
+  braces.dismiss();
+  while (iters--) {
+    CompactSerializer s;
+    NumericLists lists;
+    s.deserialize(buf.get(), lists);
+  }
+  braces.rehire();
+}
+
+void benchSerializeNumericLists(size_t kiters, size_t size) {
+  BenchmarkSuspender braces;
+  size_t iters = kiters << kMultExp;
+  NumericLists data = makeNumericLists(size);
+  braces.dismiss();
+  while (iters--) {
+    CompactSerializer ser;
+    IOBufQueue bufq;
+    ser.serialize(data, &bufq);
+  }
+  braces.rehire();
+}
+
+BENCHMARK_PARAM(benchDeserializeNumericLists, 16)
+BENCHMARK_PARAM(benchDeserializeNumericLists, 1024)
+BENCHMARK_PARAM(benchDeserializeNumericLists, 65536)
+BENCHMARK_PARAM(benchSerializeNumericLists, 16)
+BENCHMARK_PARAM(benchSerializeNumericLists, 1024)
+BENCHMARK_PARAM(benchSerializeNumericLists, 65536)
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
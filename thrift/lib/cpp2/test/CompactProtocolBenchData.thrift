@@ -33,3 +33,8 @@ struct Deep1 {
 struct Deep {
   1: list<Deep1> deeps;
 }
+
+struct NumericLists {
+  1: list<i32> i32s;
+  2: list<i64> i64s;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares Rocket payload compression on small (1-4 KB) structured payloads:
+// ZLIB, LZ4, ZSTD, and ZSTD with a dictionary trained on similar payloads.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/portability/GFlags.h>
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <thrift/lib/cpp2/test/gen-cpp2/ProtocolBenchData_types.h>
+#include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
+
+using namespace apache::thrift;
+using namespace thrift::benchmark;
+
+DEFINE_int32(training_samples, 2000, "Payloads to train the dictionary on");
+DEFINE_int32(dictionary_size, 16 * 1024, "Maximum dictionary size");
+
+namespace {
+
+constexpr int32_t kDictionaryId = 1;
+
+std::string makePayload(std::mt19937& rng) {
+  static const std::vector<std::string> kWords = {
+      "user",    "profile", "session", "region", "us-east", "eu-west",
+      "active",  "pending", "expired", "mobile", "desktop", "unknown",
+      "premium", "basic",   "trial",   "en_US",  "fr_FR",   "de_DE",
+  };
+  std::uniform_int_distribution<size_t> entries(16, 64);
+  std::uniform_int_distribution<size_t> word(0, kWords.size() - 1);
+  std::uniform_int_distribution<int64_t> id(0, 1 << 20);
+
+  BigListMixed value;
+  value.lst.resize(entries(rng));
+  for (auto& mixed : value.lst) {
+    mixed.int32 = id(rng) % 1000;
+    mixed.int64 = id(rng);
+    mixed.b = id(rng) % 2;
+    mixed.str = kWords[word(rng)] + "/" + kWords[word(rng)] + "/" +
+        std::to_string(id(rng));
+  }
+  return CompactSerializer::serialize<std::string>(value);
+}
+
+std::vector<std::unique_ptr<folly::IOBuf>>& payloads() {
+  static std::vector<std::unique_ptr<folly::IOBuf>> payloads;
+  return payloads;
+}
+
+void run(size_t iters, CompressionAlgorithm algorithm, bool dictionary) {
+  std::optional<int32_t> dictionaryId;
+  if (dictionary) {
+    dictionaryId = kDictionaryId;
+  }
+  size_t i = 0;
+  while (iters--) {
+    auto data = payloads()[i++ % payloads().size()]->clone();
+    rocket::detail::compressPayload(data, algorithm, dictionaryId);
+    auto result = rocket::detail::uncompressPayload(
+        algorithm, std::move(data), dictionaryId);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+void reportSizes(const char* name, CompressionAlgorithm algorithm, bool dict) {
+  size_t uncompressed = 0, compressed = 0;
+  for (const auto& payload : payloads()) {
+    auto data = payload->clone();
+    uncompressed += data->computeChainDataLength();
+    rocket::detail::compressPayload(
+        data,
+        algorithm,
+        dict ? std::optional<int32_t>(kDictionaryId) : std::nullopt);
+    compressed += data->computeChainDataLength();
+  }
+  LOG(INFO) << name << ": " << compressed << " of " << uncompressed
+            << " bytes (" << 100.0 * compressed / uncompressed << "%)";
+}
+
+} // namespace
+
+BENCHMARK(zlib, iters) {
+  run(iters, CompressionAlgorithm::ZLIB, false);
+}
+
+BENCHMARK_RELATIVE(lz4, iters) {
+  run(iters, CompressionAlgorithm::LZ4, false);
+}
+
+BENCHMARK_RELATIVE(zstd, iters) {
+  run(iters, CompressionAlgorithm::ZSTD, false);
+}
+
+BENCHMARK_RELATIVE(zstd_dictionary, iters) {
+  run(iters, CompressionAlgorithm::ZSTD, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  std::mt19937 rng(42);
+  std::vector<std::string> samples;
+  for (int i = 0; i < FLAGS_training_samples; ++i) {
+    samples.push_back(makePayload(rng));
+  }
+  rocket::ZstdDictionaryRegistry::add(
+      kDictionaryId,
+      folly::ByteRange(folly::StringPiece(
+          rocket::trainZstdDictionary(samples, FLAGS_dictionary_size))));
+
+  // Benchmark on payloads the dictionary was not trained on.
+  for (int i = 0; i < 256; ++i) {
+    payloads().push_back(folly::IOBuf::copyBuffer(makePayload(rng)));
+  }
+
+  reportSizes("zlib", CompressionAlgorithm::ZLIB, false);
+  reportSizes("lz4", CompressionAlgorithm::LZ4, false);
+  reportSizes("zstd", CompressionAlgorithm::ZSTD, false);
+  reportSizes("zstd_dictionary", CompressionAlgorithm::ZSTD, true);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include <folly/portability/GTest.h>
+#include <thrift/lib/cpp2/async/RocketClientChannel.h>
+#include <thrift/lib/cpp2/test/gen-cpp2/MyLeaf.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::test;
+
+namespace {
+
+class Handler : public MyLeafSvIf {
+ public:
+  void doRoot(std::string& out) override {
+    out = "root";
+  }
+  void doNode(std::string& out) override {
+    out = "node";
+  }
+  void doLeaf(std::string& out) override {
+    out = "leaf";
+  }
+};
+
+} // namespace
+
+TEST(InheritanceTest, ProcessMapListsInheritedMethods) {
+  for (const auto* map :
+       {&MyLeafAsyncProcessor::getBinaryProtocolProcessMap(),
+        &MyLeafAsyncProcessor::getCompactProtocolProcessMap()}) {
+    EXPECT_EQ(3, map->size());
+    EXPECT_EQ(1, map->count("doLeaf"));
+    EXPECT_EQ(1, map->count("doNode"));
+    EXPECT_EQ(1, map->count("doRoot"));
+  }
+  EXPECT_EQ(2, MyNodeAsyncProcessor::getBinaryProtocolProcessMap().size());
+}
+
+TEST(InheritanceTest, DispatchInheritedMethods) {
+  ScopedServerInterfaceThread runner(std::make_shared<Handler>());
+  for (auto protocol :
+       {protocol::T_BINARY_PROTOCOL, protocol::T_COMPACT_PROTOCOL}) {
+    auto client =
+        runner.newClient<MyLeafAsyncClient>(nullptr, [&](auto socket) {
+          auto channel = RocketClientChannel::newChannel(std::move(socket));
+          channel->setProtocolId(protocol);
+          return channel;
+        });
+    std::string out;
+    client->sync_doLeaf(out);
+    EXPECT_EQ("leaf", out);
+    client->sync_doNode(out);
+    EXPECT_EQ("node", out);
+    client->sync_doRoot(out);
+    EXPECT_EQ("root", out);
+  }
+}
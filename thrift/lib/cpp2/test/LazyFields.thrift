@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace cpp2 apache.thrift.test.lazy
+
+// Generated with the lazy_fields option.
+
+struct Inner {
+  1: required i32 value;
+}
+
+struct LooseInner {
+  1: optional i32 value;
+}
+
+struct Outer {
+  1: i32 id;
+  2: list<i64> values (cpp.experimental.lazy);
+  3: optional map<string, Inner> byName (cpp.experimental.lazy);
+  4: Inner inner (cpp.experimental.lazy);
+}
+
+// Same wire layout as Outer, without the lazy fields and with Inner.value
+// optional, to produce bytes that only fail once the lazy field is decoded.
+struct LooseOuter {
+  1: i32 id;
+  2: list<i64> values;
+  4: LooseInner inner;
+}
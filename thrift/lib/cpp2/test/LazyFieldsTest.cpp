@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+#include <thrift/lib/cpp/protocol/TProtocolException.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <thrift/lib/cpp2/test/gen-cpp2/LazyFields_types.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::test::lazy;
+
+namespace {
+
+template <typename Serializer>
+class LazyFieldsTest : public testing::Test {};
+
+using Serializers = testing::Types<BinarySerializer, CompactSerializer>;
+TYPED_TEST_CASE(LazyFieldsTest, Serializers);
+
+Outer makeOuter() {
+  Outer outer;
+  *outer.id_ref() = 7;
+  *outer.values_ref() = {1, 2, 3};
+  Inner inner;
+  inner.value = 42;
+  outer.byName_ref() = std::map<std::string, Inner>{{"a", inner}};
+  *outer.inner_ref() = inner;
+  return outer;
+}
+
+} // namespace
+
+TYPED_TEST(LazyFieldsTest, RoundTrip) {
+  auto outer = makeOuter();
+  auto out = TypeParam::template deserialize<Outer>(
+      TypeParam::template serialize<std::string>(outer));
+  EXPECT_EQ(outer, out);
+  EXPECT_EQ(42, out.byName_ref()->at("a").value);
+
+  // A copy made before the first access decodes on its own.
+  auto copy = TypeParam::template deserialize<Outer>(
+      TypeParam::template serialize<std::string>(outer));
+  Outer copied(copy);
+  EXPECT_EQ(outer, copied);
+  EXPECT_EQ(outer, copy);
+}
+
+TYPED_TEST(LazyFieldsTest, PassThroughWithoutDecode) {
+  // Inner.value is required, so decoding `inner` from these bytes fails.
+  // Skipping it does not, so reading Outer succeeds as long as `inner` is
+  // not accessed.
+  LooseOuter loose;
+  *loose.id_ref() = 7;
+  *loose.values_ref() = {1, 2, 3};
+  loose.inner_ref() = LooseInner();
+  auto serialized = TypeParam::template serialize<std::string>(loose);
+
+  auto out = TypeParam::template deserialize<Outer>(serialized);
+  EXPECT_EQ(7, *out.id_ref());
+  EXPECT_EQ(serialized, TypeParam::template serialize<std::string>(out));
+
+  EXPECT_EQ(*loose.values_ref(), *out.values_ref());
+  EXPECT_THROW(out.inner_ref(), protocol::TProtocolException);
+  // A failed decode leaves the bytes pending.
+  EXPECT_THROW(out.inner_ref(), protocol::TProtocolException);
+}
+
+TYPED_TEST(LazyFieldsTest, ConcurrentConstAccess) {
+  auto outer = makeOuter();
+  const auto out = TypeParam::template deserialize<Outer>(
+      TypeParam::template serialize<std::string>(outer));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      EXPECT_EQ(*outer.values_ref(), *out.values_ref());
+      EXPECT_EQ(42, out.inner_ref()->value);
+      Outer copied(out);
+      EXPECT_EQ(outer, copied);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TYPED_TEST(LazyFieldsTest, MutableAccessDropsSerializedBytes) {
+  auto out = TypeParam::template deserialize<Outer>(
+      TypeParam::template serialize<std::string>(makeOuter()));
+  out.values_ref()->push_back(4);
+
+  auto reread = TypeParam::template deserialize<Outer>(
+      TypeParam::template serialize<std::string>(out));
+  EXPECT_EQ((std::vector<int64_t>{1, 2, 3, 4}), *reread.values_ref());
+}
+
+TEST(LazyFieldsTest, ConvertBetweenProtocols) {
+  auto outer = makeOuter();
+  auto out = CompactSerializer::deserialize<Outer>(
+      CompactSerializer::serialize<std::string>(outer));
+  auto converted = BinarySerializer::deserialize<Outer>(
+      BinarySerializer::serialize<std::string>(out));
+  EXPECT_EQ(outer, converted);
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares the size and parse CPU of RequestRpcMetadata sent as is and with
+// per-connection interning, for requests with typical metadata: method name,
+// client id, service trace meta and a few headers, one of them unique to the
+// request.
+
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <thrift/lib/cpp2/transport/rocket/MetadataInterning.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::rocket;
+
+namespace {
+
+constexpr size_t kRequests = 256;
+constexpr size_t kMaxEntries = 1024;
+// Requests it takes to intern the strings common to all requests.
+constexpr size_t kWarmupRequests = 8;
+
+RequestRpcMetadata makeMetadata(size_t requestId) {
+  RequestRpcMetadata metadata;
+  metadata.protocol_ref() = ProtocolId::COMPACT;
+  metadata.kind_ref() = RpcKind::SINGLE_REQUEST_SINGLE_RESPONSE;
+  metadata.seqId_ref() = static_cast<int32_t>(requestId);
+  metadata.clientTimeoutMs_ref() = 1000;
+  metadata.name_ref() = requestId % 4 ? "getUserProfile" : "updateSession";
+  metadata.clientId_ref() = "web_frontend.prod.us-east";
+  metadata.serviceTraceMeta_ref() = "caller=web_frontend;tier=prod";
+  auto& headers = metadata.otherMetadata_ref().ensure();
+  headers["client_region"] = "us-east-1";
+  headers["client_version"] = "2021.03.15.1";
+  headers["locale"] = "en_US";
+  headers["auth_scheme"] = "service_identity";
+  headers["experiment"] = "ranking_v2_control";
+  headers["request_id"] = std::to_string(0x5eed0000 + requestId);
+  return metadata;
+}
+
+struct Requests {
+  std::vector<std::string> plain;
+  std::vector<std::string> interned;
+  MetadataInterningDecoder decoder{kMaxEntries};
+};
+
+// Serializes the requests of a connection after the interning table has
+// been filled, and feeds the requests that filled it to the decoder.
+Requests& requests() {
+  static Requests requests = [] {
+    Requests ret;
+    MetadataInterningEncoder encoder(kMaxEntries);
+    for (size_t i = 0; i < kWarmupRequests; ++i) {
+      auto metadata = makeMetadata(i);
+      auto ids = encoder.encode(metadata, true);
+      CHECK(ret.decoder.decode(metadata));
+      encoder.onResponse(ids, true);
+    }
+    for (size_t i = 0; i < kRequests; ++i) {
+      auto metadata = makeMetadata(kWarmupRequests + i);
+      ret.plain.push_back(CompactSerializer::serialize<std::string>(metadata));
+      encoder.encode(metadata, true);
+      ret.interned.push_back(
+          CompactSerializer::serialize<std::string>(metadata));
+    }
+    return ret;
+  }();
+  return requests;
+}
+
+void reportSizes() {
+  size_t plain = 0, interned = 0;
+  for (size_t i = 0; i < kRequests; ++i) {
+    plain += requests().plain[i].size();
+    interned += requests().interned[i].size();
+  }
+  LOG(INFO) << "metadata bytes per request: " << plain / kRequests
+            << " as is, " << interned / kRequests << " interned";
+}
+
+} // namespace
+
+BENCHMARK(parse, iters) {
+  size_t i = 0;
+  while (iters--) {
+    RequestRpcMetadata metadata;
+    CompactSerializer::deserialize(
+        requests().plain[i++ % kRequests], metadata);
+    folly::doNotOptimizeAway(metadata);
+  }
+}
+
+BENCHMARK_RELATIVE(parse_interned, iters) {
+  size_t i = 0;
+  while (iters--) {
+    RequestRpcMetadata metadata;
+    CompactSerializer::deserialize(
+        requests().interned[i++ % kRequests], metadata);
+    CHECK(requests().decoder.decode(metadata));
+    folly::doNotOptimizeAway(metadata);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(serialize, iters) {
+  std::vector<RequestRpcMetadata> metadata;
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < kRequests; ++i) {
+      metadata.push_back(makeMetadata(i));
+    }
+  }
+  size_t i = 0;
+  while (iters--) {
+    auto request = metadata[i++ % kRequests];
+    folly::doNotOptimizeAway(
+        CompactSerializer::serialize<std::string>(request));
+  }
+}
+
+BENCHMARK_RELATIVE(serialize_interned, iters) {
+  std::vector<RequestRpcMetadata> metadata;
+  MetadataInterningEncoder encoder(kMaxEntries);
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < kRequests; ++i) {
+      metadata.push_back(makeMetadata(i));
+    }
+    for (size_t i = 0; i < kWarmupRequests; ++i) {
+      auto warmup = makeMetadata(i);
+      encoder.onResponse(encoder.encode(warmup, true), true);
+    }
+  }
+  size_t i = 0;
+  while (iters--) {
+    auto request = metadata[i++ % kRequests];
+    // Requests repeat, so do not let their ids fill the table.
+    encoder.encode(request, false /* define */);
+    folly::doNotOptimizeAway(
+        CompactSerializer::serialize<std::string>(request));
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  reportSizes();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares finding the handler of a request by method name in an F14 map,
+// as generated processors used to, and in the perfect hash they use now, for
+// services of various sizes. The inherited benchmarks look up methods of the
+// base of a three-level service hierarchy: one map per level tried in turn,
+// against a single map listing the methods of every level.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/Optional.h>
+#include <folly/container/F14Map.h>
+#include <folly/init/Init.h>
+
+#include <thrift/lib/cpp2/util/PerfectHashMap.h>
+
+using namespace apache::thrift;
+
+namespace {
+
+using Handler = void (*)(size_t&);
+using F14Map = folly::F14ValueMap<std::string, Handler>;
+using PerfectMap = PerfectHashMap<Handler>;
+
+void handle(size_t& n) {
+  ++n;
+}
+
+constexpr size_t kLookups = 4096;
+
+std::vector<std::pair<std::string, Handler>> makeMethods(
+    size_t count,
+    const std::string& prefix = "method") {
+  std::vector<std::pair<std::string, Handler>> methods;
+  for (size_t i = 0; i < count; ++i) {
+    methods.emplace_back(prefix + "_" + std::to_string(i) + "_request", handle);
+  }
+  return methods;
+}
+
+// Method names of the requests, in random order.
+std::vector<std::string> makeRequests(
+    const std::vector<std::pair<std::string, Handler>>& methods) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> dist(0, methods.size() - 1);
+  std::vector<std::string> requests;
+  for (size_t i = 0; i < kLookups; ++i) {
+    requests.push_back(methods[dist(rng)].first);
+  }
+  return requests;
+}
+
+void build(
+    folly::Optional<F14Map>& map,
+    std::vector<std::pair<std::string, Handler>> methods) {
+  map.emplace(methods.begin(), methods.end());
+}
+
+void build(
+    folly::Optional<PerfectMap>& map,
+    std::vector<std::pair<std::string, Handler>> methods) {
+  map.emplace(std::move(methods));
+}
+
+template <typename Map>
+void dispatch(size_t iters, size_t methodCount) {
+  std::vector<std::string> requests;
+  folly::Optional<Map> map;
+  BENCHMARK_SUSPEND {
+    auto methods = makeMethods(methodCount);
+    requests = makeRequests(methods);
+    build(map, std::move(methods));
+  }
+  size_t handled = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    auto it = map->find(requests[i % kLookups]);
+    if (it != map->end()) {
+      it->second(handled);
+    }
+  }
+  folly::doNotOptimizeAway(handled);
+}
+
+void f14(size_t iters, size_t methodCount) {
+  dispatch<F14Map>(iters, methodCount);
+}
+
+void perfect(size_t iters, size_t methodCount) {
+  dispatch<PerfectMap>(iters, methodCount);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(f14, 10)
+BENCHMARK_RELATIVE_PARAM(perfect, 10)
+BENCHMARK_PARAM(f14, 100)
+BENCHMARK_RELATIVE_PARAM(perfect, 100)
+BENCHMARK_PARAM(f14, 600)
+BENCHMARK_RELATIVE_PARAM(perfect, 600)
+BENCHMARK_PARAM(f14, 2000)
+BENCHMARK_RELATIVE_PARAM(perfect, 2000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(f14_inherited, iters) {
+  std::vector<std::string> requests;
+  std::vector<F14Map> levels;
+  BENCHMARK_SUSPEND {
+    for (auto prefix : {"child", "parent", "base"}) {
+      auto methods = makeMethods(100, prefix);
+      levels.emplace_back(methods.begin(), methods.end());
+      requests = makeRequests(methods);
+    }
+  }
+  size_t handled = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    const auto& name = requests[i % kLookups];
+    for (const auto& level : levels) {
+      auto it = level.find(name);
+      if (it != level.end()) {
+        it->second(handled);
+        break;
+      }
+    }
+  }
+  folly::doNotOptimizeAway(handled);
+}
+
+BENCHMARK_RELATIVE(perfect_inherited, iters) {
+  std::vector<std::string> requests;
+  folly::Optional<PerfectMap> map;
+  BENCHMARK_SUSPEND {
+    std::vector<std::pair<std::string, Handler>> all;
+    for (auto prefix : {"child", "parent", "base"}) {
+      auto methods = makeMethods(100, prefix);
+      all.insert(all.end(), methods.begin(), methods.end());
+      requests = makeRequests(methods);
+    }
+    build(map, std::move(all));
+  }
+  size_t handled = 0;
+  for (size_t i = 0; i < iters; ++i) {
+    auto it = map->find(requests[i % kLookups]);
+    if (it != map->end()) {
+      it->second(handled);
+    }
+  }
+  folly::doNotOptimizeAway(handled);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
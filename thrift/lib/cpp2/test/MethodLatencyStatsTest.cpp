@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using namespace std::chrono;
+using Stage = MethodLatencyStats::Stage;
+
+namespace {
+const LatencyHistogram& histogram(
+    const MethodLatencyStats::Histograms& histograms,
+    Stage stage) {
+  return histograms[static_cast<size_t>(stage)];
+}
+} // namespace
+
+TEST(LatencyHistogramTest, buckets) {
+  EXPECT_EQ(0, LatencyHistogram::bucketIndex(nanoseconds(0)));
+  EXPECT_EQ(0, LatencyHistogram::bucketIndex(nanoseconds(-5)));
+  EXPECT_EQ(1, LatencyHistogram::bucketIndex(nanoseconds(64)));
+  EXPECT_EQ(
+      LatencyHistogram::kNumBuckets - 1,
+      LatencyHistogram::bucketIndex(hours(1)));
+
+  for (size_t i = 0; i + 1 < LatencyHistogram::kNumBuckets; ++i) {
+    auto lower = LatencyHistogram::bucketLowerBound(i);
+    auto upper = LatencyHistogram::bucketLowerBound(i + 1);
+    ASSERT_LT(lower, upper);
+    EXPECT_EQ(i, LatencyHistogram::bucketIndex(lower));
+    EXPECT_EQ(i, LatencyHistogram::bucketIndex(upper - nanoseconds(1)));
+    if (i >= 8) {
+      // Each bucket is at most 1/8th as wide as its lower bound.
+      EXPECT_LE((upper - lower) * 8, lower);
+    }
+  }
+}
+
+TEST(LatencyHistogramTest, percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(nanoseconds(0), histogram.percentile(0.5));
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.add(microseconds(i));
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(microseconds(500500), histogram.sum());
+  EXPECT_EQ(nanoseconds(500500), histogram.average());
+  for (double quantile : {0.5, 0.9, 0.99}) {
+    auto expected = quantile * 1000000;
+    auto actual = histogram.percentile(quantile).count();
+    EXPECT_NEAR(expected, actual, expected / 8);
+  }
+
+  LatencyHistogram other;
+  other.add(seconds(1), 1000);
+  histogram.merge(other);
+  EXPECT_EQ(2000, histogram.count());
+  EXPECT_NEAR(1e9, histogram.percentile(0.9).count(), 1e9 / 8);
+}
+
+TEST(MethodLatencyStatsTest, record) {
+  MethodLatencyStats stats;
+  auto& method = stats.getMethod("foo");
+
+  server::TServerObserver::CallTimestamps timestamps;
+  auto start = steady_clock::now();
+  timestamps.readEnd = start;
+  timestamps.queueBegin = start + microseconds(10);
+  timestamps.processBegin = start + microseconds(110);
+  timestamps.serializeBegin = start + microseconds(1110);
+  timestamps.serializeEnd = start + microseconds(1130);
+  timestamps.processEnd = start + microseconds(1140);
+  timestamps.writeBegin = start + microseconds(1150);
+  timestamps.writeEnd = start + microseconds(1200);
+  stats.record(method, timestamps);
+
+  auto histograms = stats.getHistograms().at("foo");
+  auto expectSum = [&](Stage stage, nanoseconds sum) {
+    EXPECT_EQ(1, histogram(histograms, stage).count());
+    EXPECT_EQ(sum, histogram(histograms, stage).sum());
+  };
+  expectSum(Stage::READ_TO_DISPATCH, microseconds(10));
+  expectSum(Stage::QUEUE, microseconds(100));
+  expectSum(Stage::HANDLER, microseconds(1000));
+  expectSum(Stage::SERIALIZE, microseconds(20));
+  expectSum(Stage::WRITE, microseconds(50));
+
+  // Not queued, not serialized by the handler callback, not written.
+  timestamps.queueBegin = {};
+  timestamps.serializeBegin = {};
+  timestamps.writeBegin = {};
+  stats.record(method, timestamps);
+  histograms = stats.getHistograms().at("foo");
+  EXPECT_EQ(2, histogram(histograms, Stage::QUEUE).count());
+  EXPECT_EQ(microseconds(100), histogram(histograms, Stage::QUEUE).sum());
+  EXPECT_EQ(
+      microseconds(1000 + 1030), histogram(histograms, Stage::HANDLER).sum());
+  EXPECT_EQ(1, histogram(histograms, Stage::SERIALIZE).count());
+  EXPECT_EQ(1, histogram(histograms, Stage::WRITE).count());
+}
+
+TEST(MethodLatencyStatsTest, threads) {
+  MethodLatencyStats stats;
+  auto& method = stats.getMethod("foo");
+  method.record(Stage::HANDLER, microseconds(1));
+
+  // Counts of threads that have exited are kept.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1000; ++j) {
+        method.record(Stage::HANDLER, microseconds(1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto histograms = method.getHistograms();
+  EXPECT_EQ(4001, histogram(histograms, Stage::HANDLER).count());
+  EXPECT_EQ(
+      microseconds(4001), histogram(histograms, Stage::HANDLER).sum());
+  EXPECT_EQ(0, histogram(histograms, Stage::WRITE).count());
+}
+
+TEST(MethodLatencyStatsTest, reportMetrics) {
+  MethodLatencyStats stats;
+  stats.getMethod("foo").record(Stage::WRITE, microseconds(100));
+
+  std::map<std::string, double> metrics;
+  stats.reportMetrics(
+      [&](const std::string& name, double value) { metrics[name] = value; },
+      "thrift.");
+  EXPECT_EQ(1, metrics.at("thrift.foo.write.count"));
+  EXPECT_EQ(100000, metrics.at("thrift.foo.write.avg_ns"));
+  EXPECT_NEAR(100000, metrics.at("thrift.foo.write.p99_ns"), 100000 / 8);
+  EXPECT_EQ(0, metrics.at("thrift.foo.queue.count"));
+  EXPECT_EQ(0, metrics.at("thrift.foo.read_to_dispatch.p50_ns"));
+  EXPECT_EQ(5 * 6, metrics.size());
+}
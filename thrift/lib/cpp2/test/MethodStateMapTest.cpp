@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/MethodStateMap.h>
+
+#include <map>
+#include <thread>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+
+TEST(MethodStateMapTest, entriesAreStable) {
+  MethodStateMap<int> map;
+  auto& foo = map.get("foo");
+  EXPECT_EQ("foo", foo.first);
+  foo.second = 1;
+  map.get("bar").second = 2;
+
+  EXPECT_EQ(&foo, &map.get("foo"));
+  std::thread([&] { EXPECT_EQ(&foo, &map.get("foo")); }).join();
+
+  std::map<std::string, int> entries;
+  map.forEach([&](const std::string& name, int state) {
+    entries[name] = state;
+  });
+  EXPECT_EQ((std::map<std::string, int>{{"bar", 2}, {"foo", 1}}), entries);
+}
+
+TEST(MethodStateMapTest, overflow) {
+  MethodStateMap<int> map(2);
+  ++map.get("foo").second;
+  ++map.get("bar").second;
+
+  auto& other = map.get("baz");
+  EXPECT_EQ(MethodStateMap<int>::kOverflowName, other.first);
+  ++other.second;
+  ++map.get("qux").second;
+  EXPECT_EQ(&other, &map.get("baz"));
+  EXPECT_EQ(2, other.second);
+
+  // Names that already have an entry keep it.
+  EXPECT_EQ("foo", map.get("foo").first);
+  EXPECT_EQ(1, map.get("foo").second);
+
+  size_t count = 0;
+  map.forEach([&](const std::string&, int) { ++count; });
+  EXPECT_EQ(3, count);
+}
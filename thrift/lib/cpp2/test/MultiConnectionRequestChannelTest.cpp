@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/MultiConnectionRequestChannel.h>
+
+#include <atomic>
+#include <vector>
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/io/async/AsyncSocket.h>
+#include <thrift/lib/cpp2/async/RocketClientChannel.h>
+#include <thrift/lib/cpp2/test/gen-cpp2/TestService.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::test;
+
+namespace {
+
+class TestServiceHandler : public TestServiceSvIf {
+ public:
+  int32_t echoInt(int32_t value) override {
+    unblock.getSemiFuture().wait();
+    return value;
+  }
+
+  // Requests block until the test fulfils this. Unlike a Baton, any number
+  // of handler threads can wait on it.
+  folly::SharedPromise<folly::Unit> unblock;
+};
+
+class MultiConnectionRequestChannelTest : public testing::Test {
+ public:
+  std::unique_ptr<TestServiceAsyncClient> makeClient(
+      MultiConnectionRequestChannel::Options options) {
+    auto channel = MultiConnectionRequestChannel::newSyncChannel(
+        ioExecutor,
+        [this](folly::EventBase& evb) {
+          ++connectionsCreated;
+          return MultiConnectionRequestChannel::ImplPtr(
+              RocketClientChannel::newChannel(
+                  folly::AsyncSocket::UniquePtr(
+                      new folly::AsyncSocket(&evb, runner.getAddress()))));
+        },
+        options);
+    channelPtr = channel.get();
+    return std::make_unique<TestServiceAsyncClient>(std::move(channel));
+  }
+
+  std::shared_ptr<TestServiceHandler> handler{
+      std::make_shared<TestServiceHandler>()};
+  ScopedServerInterfaceThread runner{handler};
+  std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor{
+      std::make_shared<folly::IOThreadPoolExecutor>(4)};
+  std::atomic<int> connectionsCreated{0};
+  MultiConnectionRequestChannel* channelPtr{nullptr};
+};
+
+} // namespace
+
+TEST_F(MultiConnectionRequestChannelTest, fixedSize) {
+  handler->unblock.setValue();
+
+  MultiConnectionRequestChannel::Options options;
+  options.minConnections = 3;
+  options.maxConnections = 3;
+  auto client = makeClient(options);
+
+  std::vector<folly::SemiFuture<int32_t>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(client->semifuture_echoInt(i));
+  }
+  auto results = folly::collectAll(std::move(futures)).get();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, results[i].value());
+  }
+  EXPECT_EQ(3, channelPtr->getConnectionCount());
+  EXPECT_EQ(0, channelPtr->getOutstandingRequestCount());
+  EXPECT_LE(connectionsCreated.load(), 3);
+}
+
+TEST_F(MultiConnectionRequestChannelTest, growAndShrink) {
+  MultiConnectionRequestChannel::Options options;
+  options.minConnections = 1;
+  options.maxConnections = 4;
+  options.balancing =
+      MultiConnectionRequestChannel::Balancing::LEAST_OUTSTANDING;
+  options.growAbove = 0;
+  options.shrinkBelow = 1;
+  options.resizeInterval = std::chrono::milliseconds(0);
+  auto client = makeClient(options);
+
+  // Every request finds the others outstanding, so the channel grows.
+  std::vector<folly::SemiFuture<int32_t>> futures;
+  for (int i = 0; i < 20; ++i) {
+    futures.push_back(client->semifuture_echoInt(i));
+  }
+  EXPECT_EQ(4, channelPtr->getConnectionCount());
+  EXPECT_EQ(20, channelPtr->getOutstandingRequestCount());
+
+  handler->unblock.setValue();
+  folly::collectAll(std::move(futures)).wait();
+  EXPECT_EQ(0, channelPtr->getOutstandingRequestCount());
+
+  // Idle again: each request retires a connection.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, client->sync_echoInt(i));
+  }
+  EXPECT_EQ(1, channelPtr->getConnectionCount());
+  EXPECT_EQ(42, client->sync_echoInt(42));
+}
@@ -20,6 +20,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Optional.h>
+#include <folly/memory/Arena.h>
 #include <folly/portability/GFlags.h>
 #include <glog/logging.h>
 
@@ -84,6 +85,34 @@ void readBench(size_t iters, Counter&& counter) {
   counter["serialized_size"] = buf->computeChainDataLength();
 }
 
+// Reads the serialized form of Struct into ArenaStruct, which has the same
+// wire format but allocates from a fresh arena per iteration, as it would from
+// the per-request arena of Cpp2RequestContext. Compare against the readBench
+// of Struct for the default allocator.
+template <
+    typename Serializer,
+    typename Struct,
+    typename ArenaStruct,
+    typename Counter>
+void readArenaBench(size_t iters, Counter&& counter) {
+  BenchmarkSuspender susp;
+  auto strct = create<Struct>();
+  IOBufQueue q;
+  Serializer::serialize(strct, &q);
+  auto buf = q.move();
+  buf->coalesce();
+  susp.dismiss();
+
+  while (iters--) {
+    SysArena arena;
+    ArenaStruct data{
+        typename ArenaStruct::allocator_type(ArenaAllocator<char>(arena))};
+    Serializer::deserialize(buf.get(), data);
+  }
+  susp.rehire();
+  counter["serialized_size"] = buf->computeChainDataLength();
+}
+
 #define X1(proto, rdwr, bench)                                           \
   BENCHMARK_COUNTERS(proto##Protocol_##rdwr##_##bench, counter, iters) { \
     rdwr##Bench<proto##Serializer, bench>(iters, counter);               \
@@ -105,6 +134,7 @@ void readBench(size_t iters, Counter&& counter) {
   X2(proto, MixedInt)        \
   X2(proto, SmallListInt)    \
   X2(proto, BigListInt)      \
+  X2(proto, BigListDouble)   \
   X2(proto, BigListMixed)    \
   X2(proto, BigListMixedInt) \
   X2(proto, LargeListMixed)  \
@@ -112,8 +142,19 @@ void readBench(size_t iters, Counter&& counter) {
   X2(proto, NestedMap)       \
   X2(proto, ComplexStruct)
 
+#define XA(proto, bench)                                      \
+  BENCHMARK_COUNTERS(                                         \
+      proto##Protocol_read_##bench##_arena, counter, iters) { \
+    readArenaBench<proto##Serializer, bench, ArenaListMixed>( \
+        iters, counter);                                      \
+  }
+
 X(Binary)
 X(Compact)
+XA(Binary, BigListMixed)
+XA(Binary, LargeListMixed)
+XA(Compact, BigListMixed)
+XA(Compact, LargeListMixed)
 X(SimpleJSON)
 X(JSON)
 X(Nimble)
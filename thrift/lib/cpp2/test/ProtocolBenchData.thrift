@@ -17,6 +17,7 @@
 namespace cpp2 thrift.benchmark
 
 cpp_include "folly/sorted_vector_types.h"
+cpp_include "thrift/lib/cpp2/util/ArenaAllocator.h"
 
 struct Empty {
 }
@@ -62,6 +63,10 @@ struct BigListInt {
   1: list<i32> lst;
 }
 
+struct BigListDouble {
+  1: list<double> lst;
+}
+
 struct BigListMixed {
   1: list<Mixed> lst;
 }
@@ -70,6 +75,21 @@ struct LargeListMixed {
   1: list<Mixed> lst;
 }
 
+// Same wire format as Mixed / BigListMixed, allocated from a request arena.
+struct ArenaMixed {
+  1: i32 int32;
+  2: i64 int64;
+  3: bool b;
+  4: string (cpp.use_allocator, cpp.type = "::apache::thrift::ArenaString") str;
+} (cpp.allocator = "::apache::thrift::ScopedArenaAllocator")
+
+struct ArenaListMixed {
+  1: list<ArenaMixed> (
+    cpp.use_allocator,
+    cpp.template = "::apache::thrift::ArenaVector",
+  ) lst;
+} (cpp.allocator = "::apache::thrift::ScopedArenaAllocator")
+
 struct LargeMapInt {
   1: map<i32, i32> m;
 }
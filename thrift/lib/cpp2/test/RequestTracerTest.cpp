@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/RequestTracer.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/json.h>
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using namespace std::chrono;
+
+namespace {
+server::TServerObserver::CallTimestamps makeTimestamps(
+    steady_clock::time_point start,
+    bool queued) {
+  server::TServerObserver::CallTimestamps timestamps;
+  timestamps.readEnd = start;
+  if (queued) {
+    timestamps.queueBegin = start + microseconds(10);
+  }
+  timestamps.processBegin = start + microseconds(20);
+  timestamps.serializeBegin = start + microseconds(30);
+  timestamps.serializeEnd = start + microseconds(40);
+  timestamps.processEnd = start + microseconds(50);
+  timestamps.writeBegin = start + microseconds(60);
+  timestamps.writeEnd = start + microseconds(70);
+  return timestamps;
+}
+} // namespace
+
+TEST(RequestTracerTest, ringBuffer) {
+  RequestTracer::Options options;
+  options.recordsPerThread = 4;
+  RequestTracer tracer(options);
+  auto& foo = tracer.internMethod("foo");
+  EXPECT_EQ(&foo, &tracer.internMethod("foo"));
+  EXPECT_TRUE(tracer.getRecords().empty());
+
+  auto start = steady_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    tracer.record(foo, makeTimestamps(start + milliseconds(i), true));
+  }
+
+  // Only the last 4 are kept.
+  auto records = tracer.getRecords();
+  ASSERT_EQ(4, records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ("foo", records[i].method);
+    EXPECT_EQ(7 + i, records[i].sequence);
+    EXPECT_EQ(start + milliseconds(6 + i), records[i].timestamps.readEnd);
+    EXPECT_EQ(
+        start + milliseconds(6 + i) + microseconds(70),
+        records[i].timestamps.writeEnd);
+  }
+}
+
+TEST(RequestTracerTest, threads) {
+  RequestTracer tracer;
+  auto& foo = tracer.internMethod("foo");
+  auto& bar = tracer.internMethod("bar");
+  auto start = steady_clock::now();
+  std::thread([&] {
+    tracer.record(foo, makeTimestamps(start, true));
+    // Records of exited threads are dropped, so check while alive.
+    auto records = tracer.getRecords();
+    ASSERT_EQ(1, records.size());
+    EXPECT_EQ("foo", records[0].method);
+  }).join();
+
+  tracer.record(bar, makeTimestamps(start, false));
+  auto records = tracer.getRecords();
+  ASSERT_EQ(1, records.size());
+  EXPECT_EQ("bar", records[0].method);
+  EXPECT_EQ(steady_clock::time_point(), records[0].timestamps.queueBegin);
+}
+
+TEST(RequestTracerTest, dumpChromeTrace) {
+  RequestTracer tracer;
+  auto start = steady_clock::now();
+  tracer.record(tracer.internMethod("foo"), makeTimestamps(start, true));
+  tracer.record(tracer.internMethod("bar"), makeTimestamps(start, false));
+
+  auto trace = folly::parseJson(tracer.dumpChromeTrace());
+  const auto& events = trace["traceEvents"];
+  // Request, read_to_dispatch, queue, handler, serialize and write spans for
+  // foo, no queue span for bar.
+  ASSERT_EQ(2 * (6 + 5), events.size());
+
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 12; ++i) {
+    EXPECT_EQ("thrift", events[i]["cat"].asString());
+    EXPECT_EQ(events[0]["id"], events[i]["id"]);
+    names.push_back(
+        events[i]["name"].asString() + ":" + events[i]["ph"].asString());
+  }
+  std::vector<std::string> expected{
+      "foo:b",
+      "read_to_dispatch:b",
+      "read_to_dispatch:e",
+      "queue:b",
+      "queue:e",
+      "handler:b",
+      "handler:e",
+      "serialize:b",
+      "serialize:e",
+      "write:b",
+      "write:e",
+      "foo:e",
+  };
+  EXPECT_EQ(expected, names);
+  EXPECT_NEAR(
+      70, events[11]["ts"].asDouble() - events[0]["ts"].asDouble(), 0.01);
+  EXPECT_NE(events[0]["id"], events[12]["id"]);
+}
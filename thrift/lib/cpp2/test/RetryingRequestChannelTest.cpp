@@ -16,6 +16,7 @@
 
 #include <thrift/lib/cpp2/async/RetryingRequestChannel.h>
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
@@ -253,3 +254,93 @@ TEST_F(RetryingRequestChannelTest, shutdownStream) {
   evbThread.reset();
   std::move(sf).get();
 }
+
+namespace {
+RetryingRequestChannel::HedgingOptions hedgeEchoRequest() {
+  RetryingRequestChannel::HedgingOptions options;
+  options.methods = {"echoRequest"};
+  options.delay = std::chrono::milliseconds(10);
+  options.budget = 1;
+  return options;
+}
+} // namespace
+
+TEST_F(RetryingRequestChannelTest, hedgeWins) {
+  std::shared_ptr<RequestChannel> up_chan =
+      HeaderClientChannel::newChannel(AsyncSocket::newSocket(eb, up_addr));
+  auto channel = RetryingRequestChannel::newChannel(
+      *eb, 0, std::move(up_chan), hedgeEchoRequest());
+  auto channelPtr = channel.get();
+
+  TestServiceAsyncClient client(std::move(channel));
+
+  folly::Promise<std::unique_ptr<std::string>> promise;
+  EXPECT_CALL(*handler, semifuture_echoRequest(_))
+      .WillOnce(InvokeWithoutArgs([&] { return promise.getFuture(); }))
+      .WillOnce(InvokeWithoutArgs([] {
+        return folly::makeSemiFuture(std::make_unique<std::string>("Hedge"));
+      }));
+
+  std::string response;
+  client.sync_echoRequest(response, "");
+  EXPECT_EQ("Hedge", response);
+  EXPECT_EQ(1, channelPtr->getHedgesFired());
+  EXPECT_EQ(1, channelPtr->getHedgesWon());
+
+  promise.setValue(std::make_unique<std::string>("Slow"));
+}
+
+TEST_F(RetryingRequestChannelTest, hedgeNotNeeded) {
+  std::shared_ptr<RequestChannel> up_chan =
+      HeaderClientChannel::newChannel(AsyncSocket::newSocket(eb, up_addr));
+  auto options = hedgeEchoRequest();
+  options.delay = std::chrono::seconds(10);
+  auto channel = RetryingRequestChannel::newChannel(
+      *eb, 0, std::move(up_chan), std::move(options));
+  auto channelPtr = channel.get();
+
+  TestServiceAsyncClient client(std::move(channel));
+
+  EXPECT_CALL(*handler, semifuture_echoRequest(_))
+      .WillOnce(InvokeWithoutArgs([] {
+        return folly::makeSemiFuture(std::make_unique<std::string>("Fast"));
+      }));
+  EXPECT_CALL(*handler, echoInt(_)).WillOnce(Return(1));
+
+  std::string response;
+  client.sync_echoRequest(response, "");
+  EXPECT_EQ("Fast", response);
+  // Not opted in.
+  EXPECT_EQ(1, client.sync_echoInt(1));
+  EXPECT_EQ(0, channelPtr->getHedgesFired());
+  EXPECT_EQ(0, channelPtr->getHedgesWon());
+}
+
+TEST_F(RetryingRequestChannelTest, hedgeBudget) {
+  std::shared_ptr<RequestChannel> up_chan =
+      HeaderClientChannel::newChannel(AsyncSocket::newSocket(eb, up_addr));
+  auto options = hedgeEchoRequest();
+  options.budget = 0.5;
+  auto channel = RetryingRequestChannel::newChannel(
+      *eb, 0, std::move(up_chan), std::move(options));
+  auto channelPtr = channel.get();
+
+  TestServiceAsyncClient client(std::move(channel));
+
+  // Only every other request has the budget for a hedge.
+  EXPECT_CALL(*handler, semifuture_echoRequest(_))
+      .Times(6)
+      .WillRepeatedly(InvokeWithoutArgs([] {
+        return folly::futures::sleep(std::chrono::milliseconds(50))
+            .deferValue([](auto&&) {
+              return std::make_unique<std::string>("Slow");
+            });
+      }));
+
+  for (int i = 0; i < 4; ++i) {
+    std::string response;
+    client.sync_echoRequest(response, "");
+    EXPECT_EQ("Slow", response);
+  }
+  EXPECT_EQ(2, channelPtr->getHedgesFired());
+}
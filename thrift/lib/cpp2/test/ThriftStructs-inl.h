@@ -109,6 +109,18 @@ thrift::benchmark::BigListInt create<thrift::benchmark::BigListInt>() {
   return d;
 }
 
+template <>
+thrift::benchmark::BigListDouble create<thrift::benchmark::BigListDouble>() {
+  std::srand(1);
+  std::vector<double> vec;
+  for (int i = 0; i < 10000; i++) {
+    vec.push_back(std::rand() / double(RAND_MAX));
+  }
+  thrift::benchmark::BigListDouble d;
+  *d.lst_ref() = std::move(vec);
+  return d;
+}
+
 template <>
 thrift::benchmark::BigListMixed create<thrift::benchmark::BigListMixed>() {
   std::vector<thrift::benchmark::Mixed> vec(
@@ -41,6 +41,7 @@
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/test/TestSSLServer.h>
 #include <folly/system/ThreadName.h>
+#include <folly/test/TestUtils.h>
 #include <wangle/acceptor/ServerSocketConfig.h>
 
 #include <folly/io/async/AsyncSocket.h>
@@ -2265,6 +2266,133 @@ TEST(ThriftServer, RocketOverSSLNoALPN) {
   EXPECT_EQ(response, "test64");
 }
 
+namespace {
+class ZeroCopyObserver : public server::TServerObserver {
+ public:
+  void zeroCopyWrite(uint64_t numBytes) override {
+    ++writes;
+    bytes += numBytes;
+  }
+  void zeroCopyFallback(uint64_t numBytes) override {
+    ++fallbackWrites;
+    fallbackBytes += numBytes;
+  }
+  std::atomic<uint32_t> writes{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint32_t> fallbackWrites{0};
+  std::atomic<uint64_t> fallbackBytes{0};
+};
+} // namespace
+
+TEST(ThriftServer, RocketZeroCopyThreshold) {
+  auto observer = std::make_shared<ZeroCopyObserver>();
+  auto server = std::static_pointer_cast<ThriftServer>(
+      TestThriftServerFactory<TestInterface>().create());
+  server->setObserver(observer);
+  server->setZeroCopyThreshold(1024);
+  const auto& zeroCopyEnableFunc = server->getZeroCopyEnableFunc();
+  ASSERT_TRUE(zeroCopyEnableFunc);
+  EXPECT_FALSE(
+      zeroCopyEnableFunc(folly::IOBuf::copyBuffer(std::string(1023, 'x'))));
+  EXPECT_TRUE(
+      zeroCopyEnableFunc(folly::IOBuf::copyBuffer(std::string(1024, 'x'))));
+  ScopedServerThread sst(std::move(server));
+
+  folly::EventBase base;
+  folly::AsyncSocket::UniquePtr socket(
+      new folly::AsyncSocket(&base, *sst.getAddress()));
+  // The server enables zerocopy on its sockets the same way, and counts
+  // fallbacks instead where the kernel does not support SO_ZEROCOPY.
+  SKIP_IF(!socket->setZeroCopy(true)) << "SO_ZEROCOPY is not supported";
+  socket->setZeroCopy(false);
+  TestServiceAsyncClient client(
+      RocketClientChannel::newChannel(std::move(socket)));
+
+  // Below the threshold.
+  std::string response;
+  client.sync_sendResponse(response, 64);
+  EXPECT_EQ(response, "test64");
+  EXPECT_EQ(0, observer->writes.load());
+  EXPECT_EQ(0, observer->fallbackWrites.load());
+
+  client.sync_echoRequest(response, std::string(4096, 'x'));
+  EXPECT_EQ(4096 + kEchoSuffix.size(), response.size());
+  EXPECT_EQ(1, observer->writes.load());
+  EXPECT_GT(observer->bytes.load(), response.size());
+  EXPECT_EQ(0, observer->fallbackWrites.load());
+}
+
+TEST(ThriftServer, RocketZeroCopyFallbackOverSSL) {
+  auto observer = std::make_shared<ZeroCopyObserver>();
+  auto server = std::static_pointer_cast<ThriftServer>(
+      TestThriftServerFactory<TestInterface>().create());
+  server->setObserver(observer);
+  server->setZeroCopyThreshold(1024);
+  server->setSSLPolicy(SSLPolicy::REQUIRED);
+  setupServerSSL(*server);
+  ScopedServerThread sst(std::move(server));
+
+  folly::EventBase base;
+  folly::SocketAddress loopback("::1", sst.getAddress()->getPort());
+  folly::AsyncSSLSocket::UniquePtr sslSock(
+      new folly::AsyncSSLSocket(makeClientSslContext(), &base));
+  sslSock->connect(nullptr /* connect callback */, loopback);
+  TestServiceAsyncClient client(
+      RocketClientChannel::newChannel(std::move(sslSock)));
+
+  // TLS encrypts into its own buffers, so nothing can be sent zerocopy.
+  std::string response;
+  client.sync_echoRequest(response, std::string(4096, 'x'));
+  EXPECT_EQ(4096 + kEchoSuffix.size(), response.size());
+  EXPECT_EQ(0, observer->writes.load());
+  EXPECT_EQ(1, observer->fallbackWrites.load());
+  EXPECT_GT(observer->fallbackBytes.load(), response.size());
+}
+
+TEST(ThriftServer, RocketWriteBatchingObserver) {
+  struct Observer : public server::TServerObserver {
+    void writeBatchFlushed(
+        uint32_t numWrites,
+        uint64_t numBytes,
+        std::chrono::microseconds delay) override {
+      writes += numWrites;
+      bytes += numBytes;
+      maxDelay = std::max(maxDelay.load(), delay);
+      ++batches;
+    }
+    std::atomic<uint32_t> batches{0};
+    std::atomic<uint32_t> writes{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<std::chrono::microseconds> maxDelay{
+        std::chrono::microseconds::zero()};
+  };
+  auto observer = std::make_shared<Observer>();
+
+  auto server = std::static_pointer_cast<ThriftServer>(
+      TestThriftServerFactory<TestInterface>().create());
+  server->setObserver(observer);
+  server->setWriteBatchingInterval(std::chrono::milliseconds(10));
+  server->setWriteBatchingSize(100);
+  // A single response exceeds the byte limit, so it is flushed without
+  // waiting for the batching interval to expire.
+  server->setWriteBatchingByteSize(1);
+  ScopedServerThread sst(std::move(server));
+
+  folly::EventBase base;
+  folly::AsyncSocket::UniquePtr socket(
+      new folly::AsyncSocket(&base, *sst.getAddress()));
+  TestServiceAsyncClient client(
+      RocketClientChannel::newChannel(std::move(socket)));
+
+  std::string response;
+  client.sync_sendResponse(response, 64);
+  EXPECT_EQ(response, "test64");
+  EXPECT_GE(observer->batches.load(), 1);
+  EXPECT_GE(observer->writes.load(), observer->batches.load());
+  EXPECT_GT(observer->bytes.load(), response.size());
+  EXPECT_LT(observer->maxDelay.load(), std::chrono::milliseconds(10));
+}
+
 TEST(ThriftServer, SocketQueueTimeout) {
   TestThriftServerFactory<TestServiceSvIf> factory;
   auto baseServer = factory.create();
@@ -82,5 +82,18 @@ TEST_F(EwmaTest, testHalfLife) {
   ASSERT_NEAR(ewma.estimate(), expectedValue, expectedValue * 0.1 / 100);
 }
 
+TEST_F(EwmaTest, testSampleEwma) {
+  auto avg = sampleEwma(0.0, 100.0, true);
+  ASSERT_EQ(avg, 100.0);
+  avg = sampleEwma(avg, 180.0, false);
+  ASSERT_EQ(avg, 110.0);
+
+  ASSERT_EQ(sampleEwma<int64_t>(100, 20, false), 90);
+  ASSERT_EQ(
+      sampleEwma<std::chrono::nanoseconds>(
+          std::chrono::nanoseconds(100), std::chrono::nanoseconds(180), false),
+      std::chrono::nanoseconds(110));
+}
+
 } // namespace thrift
 } // namespace apache
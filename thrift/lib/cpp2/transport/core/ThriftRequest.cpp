@@ -22,11 +22,21 @@ namespace thrift {
 ThriftRequestCore::RequestTimestampSample::RequestTimestampSample(
     server::TServerObserver::CallTimestamps& timestamps,
     server::TServerObserver* observer,
-    MessageChannel::SendCallback* chainedCallback)
+    MessageChannel::SendCallback* chainedCallback,
+    MethodLatencyStats* latencyStats,
+    MethodLatencyStats::Method* latencyStatsMethod,
+    RequestTracer* tracer,
+    const std::string* tracerMethod)
     : timestamps_(timestamps),
       observer_(observer),
-      chainedCallback_(chainedCallback) {
-  DCHECK(observer != nullptr);
+      chainedCallback_(chainedCallback),
+      latencyStats_(latencyStats),
+      latencyStatsMethod_(latencyStatsMethod),
+      tracer_(tracer),
+      tracerMethod_(tracerMethod) {
+  DCHECK(observer != nullptr || latencyStats != nullptr || tracer != nullptr);
+  DCHECK_EQ(latencyStats == nullptr, latencyStatsMethod == nullptr);
+  DCHECK_EQ(tracer == nullptr, tracerMethod == nullptr);
 }
 
 void ThriftRequestCore::RequestTimestampSample::sendQueued() {
@@ -61,6 +71,12 @@ ThriftRequestCore::RequestTimestampSample::~RequestTimestampSample() {
   if (observer_) {
     observer_->callCompleted(timestamps_);
   }
+  if (latencyStats_) {
+    latencyStats_->record(*latencyStatsMethod_, timestamps_);
+  }
+  if (tracer_) {
+    tracer_->record(*tracerMethod_, timestamps_);
+  }
 }
 
 MessageChannel::SendCallbackPtr ThriftRequestCore::prepareSendCallback(
@@ -71,11 +87,28 @@ MessageChannel::SendCallbackPtr ThriftRequestCore::prepareSendCallback(
   // which also implements MessageChannel::SendCallback. Callers of
   // sendReply/sendError are responsible for cleaning up their own callbacks.
   auto& timestamps = getTimestamps();
-  if (timestamps.getSamplingStatus().isEnabledByServer()) {
+  const auto& samplingStatus = timestamps.getSamplingStatus();
+  auto* latencyStats = samplingStatus.isEnabledByLatencyStats()
+      ? serverConfigs_.getMethodLatencyStats()
+      : nullptr;
+  auto* tracer = samplingStatus.isEnabledByTracer()
+      ? serverConfigs_.getRequestTracer()
+      : nullptr;
+  if (!samplingStatus.isEnabledByServer()) {
+    observer = nullptr;
+  }
+  if (observer || latencyStats || tracer) {
     auto chainedCallback = cbPtr.release();
     return MessageChannel::SendCallbackPtr(
         new ThriftRequestCore::RequestTimestampSample(
-            timestamps, observer, chainedCallback));
+            timestamps,
+            observer,
+            chainedCallback,
+            latencyStats,
+            latencyStats ? &latencyStats->getMethod(getMethodName())
+                         : nullptr,
+            tracer,
+            tracer ? &tracer->internMethod(getMethodName()) : nullptr));
   }
   return cbPtr;
 }
@@ -41,6 +41,8 @@
 #endif
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <thrift/lib/cpp2/server/Cpp2ConnContext.h>
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
+#include <thrift/lib/cpp2/server/RequestTracer.h>
 #include <thrift/lib/cpp2/server/ServerConfigs.h>
 #include <thrift/lib/cpp2/transport/core/ThriftChannelIf.h>
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
@@ -160,13 +162,18 @@ class ThriftRequestCore : public ResponseChannelRequest {
     return compressionConfig_;
   }
 
-  // RequestTimestampSample is a wrapper for sampled requests
+  // RequestTimestampSample is a wrapper for sampled requests. Reports to the
+  // observer, latency stats and/or tracer, whichever are not null.
   class RequestTimestampSample : public MessageChannel::SendCallback {
    public:
     RequestTimestampSample(
         server::TServerObserver::CallTimestamps& timestamps,
         server::TServerObserver* observer,
-        MessageChannel::SendCallback* chainedCallback = nullptr);
+        MessageChannel::SendCallback* chainedCallback = nullptr,
+        MethodLatencyStats* latencyStats = nullptr,
+        MethodLatencyStats::Method* latencyStatsMethod = nullptr,
+        RequestTracer* tracer = nullptr,
+        const std::string* tracerMethod = nullptr);
 
     void sendQueued() override;
     void messageSent() override;
@@ -177,6 +184,10 @@ class ThriftRequestCore : public ResponseChannelRequest {
     server::TServerObserver::CallTimestamps timestamps_;
     server::TServerObserver* observer_;
     MessageChannel::SendCallback* chainedCallback_;
+    MethodLatencyStats* latencyStats_;
+    MethodLatencyStats::Method* latencyStatsMethod_;
+    RequestTracer* tracer_;
+    const std::string* tracerMethod_;
   };
 
   void sendReply(
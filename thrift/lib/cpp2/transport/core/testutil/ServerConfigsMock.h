@@ -79,6 +79,22 @@ class ServerConfigsMock : public ServerConfigs {
     return false;
   }
 
+  AdaptiveInlinePolicy* getAdaptiveInlinePolicy() const override {
+    return nullptr;
+  }
+
+  AdaptiveCompressionPolicy* getAdaptiveCompressionPolicy() const override {
+    return nullptr;
+  }
+
+  MethodLatencyStats* getMethodLatencyStats() const override {
+    return nullptr;
+  }
+
+  RequestTracer* getRequestTracer() const override {
+    return nullptr;
+  }
+
  public:
   uint64_t maxResponseSize_{0};
   std::chrono::milliseconds queueTimeout_{std::chrono::milliseconds(500)};
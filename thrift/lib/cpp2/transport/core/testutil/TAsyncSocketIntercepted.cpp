@@ -57,6 +57,11 @@ folly::AsyncSocket::ReadResult TAsyncSocketIntercepted::performRead(
     size_t* offset) {
   ReadResult res = folly::AsyncSocket::performRead(buf, buflen, offset);
 
+  if (readCallback_ && !res.exception && res.readReturn > 0) {
+    readCallback_(folly::ByteRange(
+        static_cast<const uint8_t*>(*buf), size_t(res.readReturn)));
+  }
+
   if (params_.get() && params_->corruptLastReadByte_ && !res.exception &&
       res.readReturn > 0 &&
       res.readReturn >= params_->corruptLastReadByteMinSize_) {
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Function.h>
+#include <folly/Range.h>
 #include <folly/io/IOBuf.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <sys/types.h>
@@ -51,6 +53,11 @@ class TAsyncSocketIntercepted : public folly::AsyncSocket {
     params_ = params;
   }
 
+  // Called on the event base with the bytes of every read.
+  void setReadCallback(folly::Function<void(folly::ByteRange)> callback) {
+    readCallback_ = std::move(callback);
+  }
+
   int32_t getTotalBytesRead() {
     return totalBytesRead_;
   }
@@ -70,6 +77,7 @@ class TAsyncSocketIntercepted : public folly::AsyncSocket {
 
  private:
   std::shared_ptr<Params> params_;
+  folly::Function<void(folly::ByteRange)> readCallback_;
   int32_t totalBytesRead_{0};
   int32_t totalBytesWritten_{0};
 };
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/transport/rocket/MetadataInterning.h>
+
+#include <utility>
+
+#include <folly/lang/Assume.h>
+#include <glog/logging.h>
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+constexpr size_t MetadataInterningEncoder::kMaxEntryLength;
+
+MetadataInterningEncoder::MetadataInterningEncoder(size_t maxEntries)
+    : maxEntries_(maxEntries) {}
+
+folly::Optional<int32_t> MetadataInterningEncoder::intern(
+    const std::string& str,
+    bool define,
+    InternedRequestMetadata& interned,
+    std::vector<int32_t>& defined) {
+  if (str.empty() || str.size() > kMaxEntryLength) {
+    return folly::none;
+  }
+  auto it = ids_.find(str);
+  if (it == ids_.end()) {
+    if (!define || states_.size() >= maxEntries_) {
+      return folly::none;
+    }
+    if (seenOnce_.insert(str).second) {
+      if (seenOnce_.size() > maxEntries_) {
+        seenOnce_.clear();
+      }
+      return folly::none;
+    }
+    seenOnce_.erase(str);
+    it = ids_.emplace(str, static_cast<int32_t>(states_.size())).first;
+    states_.push_back(State::UNDEFINED);
+  }
+
+  auto id = it->second;
+  switch (states_[id]) {
+    case State::DEFINED:
+      return id;
+    case State::PENDING:
+      return folly::none;
+    case State::UNDEFINED:
+      if (!define) {
+        return folly::none;
+      }
+      states_[id] = State::PENDING;
+      interned.newEntries_ref().ensure().emplace(id, str);
+      defined.push_back(id);
+      return id;
+  }
+  folly::assume_unreachable();
+}
+
+std::vector<int32_t> MetadataInterningEncoder::encode(
+    RequestRpcMetadata& metadata,
+    bool define) {
+  InternedRequestMetadata interned;
+  std::vector<int32_t> defined;
+  bool used = false;
+
+  auto internField = [&](auto&& field, auto&& internedField) {
+    if (field) {
+      if (auto id = intern(*field, define, interned, defined)) {
+        internedField = *id;
+        field.reset();
+        used = true;
+      }
+    }
+  };
+  internField(metadata.name_ref(), interned.name_ref());
+  internField(metadata.clientId_ref(), interned.clientId_ref());
+  internField(
+      metadata.serviceTraceMeta_ref(), interned.serviceTraceMeta_ref());
+
+  if (auto headers = metadata.otherMetadata_ref()) {
+    for (auto it = headers->begin(); it != headers->end();) {
+      auto key = intern(it->first, define, interned, defined);
+      auto value = key ? intern(it->second, define, interned, defined)
+                       : folly::none;
+      if (key && value) {
+        auto& ids = interned.otherMetadata_ref().ensure();
+        ids.push_back(*key);
+        ids.push_back(*value);
+        it = headers->erase(it);
+        used = true;
+      } else {
+        ++it;
+      }
+    }
+    if (headers->empty()) {
+      headers.reset();
+    }
+  }
+
+  if (used || interned.newEntries_ref()) {
+    metadata.interned_ref() = std::move(interned);
+  }
+  return defined;
+}
+
+void MetadataInterningEncoder::onResponse(
+    const std::vector<int32_t>& ids,
+    bool received) {
+  for (auto id : ids) {
+    DCHECK(states_[id] == State::PENDING);
+    states_[id] = received ? State::DEFINED : State::UNDEFINED;
+  }
+}
+
+MetadataInterningDecoder::MetadataInterningDecoder(size_t maxEntries)
+    : maxEntries_(maxEntries) {}
+
+const std::string* MetadataInterningDecoder::lookup(int32_t id) const {
+  if (id < 0 || static_cast<size_t>(id) >= entries_.size() ||
+      entries_[id].empty()) {
+    return nullptr;
+  }
+  return &entries_[id];
+}
+
+bool MetadataInterningDecoder::decode(RequestRpcMetadata& metadata) {
+  auto interned = std::move(*metadata.interned_ref());
+  metadata.interned_ref().reset();
+
+  if (auto newEntries = interned.newEntries_ref()) {
+    for (auto& entry : *newEntries) {
+      if (entry.first < 0 || static_cast<size_t>(entry.first) >= maxEntries_ ||
+          entry.second.empty() ||
+          entry.second.size() > MetadataInterningEncoder::kMaxEntryLength) {
+        return false;
+      }
+      if (static_cast<size_t>(entry.first) >= entries_.size()) {
+        entries_.resize(entry.first + 1);
+      }
+      entries_[entry.first] = std::move(entry.second);
+    }
+  }
+
+  auto restoreField = [&](auto&& internedField, auto&& field) {
+    if (internedField) {
+      auto str = lookup(*internedField);
+      if (!str) {
+        return false;
+      }
+      field = *str;
+    }
+    return true;
+  };
+  if (!restoreField(interned.name_ref(), metadata.name_ref()) ||
+      !restoreField(interned.clientId_ref(), metadata.clientId_ref()) ||
+      !restoreField(
+          interned.serviceTraceMeta_ref(), metadata.serviceTraceMeta_ref())) {
+    return false;
+  }
+
+  if (auto ids = interned.otherMetadata_ref()) {
+    if (ids->size() % 2 != 0) {
+      return false;
+    }
+    auto& headers = metadata.otherMetadata_ref().ensure();
+    for (size_t i = 0; i < ids->size(); i += 2) {
+      auto key = lookup((*ids)[i]);
+      auto value = lookup((*ids)[i + 1]);
+      if (!key || !value) {
+        return false;
+      }
+      headers.emplace(*key, *value);
+    }
+  }
+  return true;
+}
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
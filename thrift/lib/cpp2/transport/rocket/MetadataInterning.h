@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <folly/Optional.h>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+/**
+ * Client half of per-connection metadata interning. The method name, client
+ * id, service trace meta and headers of a request are mostly the same as
+ * those of the previous requests on the connection, so once a string has
+ * been seen twice it is added to a table the server keeps for the connection,
+ * and later requests send its id instead (see InternedRequestMetadata).
+ *
+ * Requests may be lost before reaching the server (e.g. on timeout before
+ * being written), so an entry is only referred to by other requests once a
+ * response to the request that defined it has been received. Until then the
+ * string is sent as is. Entries are never evicted: once the table is full,
+ * new strings are sent as is.
+ *
+ * Not thread-safe, only used from the channel's event base.
+ */
+class MetadataInterningEncoder {
+ public:
+  // Longer strings are not worth interning, and are unlikely to repeat.
+  static constexpr size_t kMaxEntryLength = 256;
+
+  explicit MetadataInterningEncoder(size_t maxEntries);
+
+  /**
+   * Replaces the strings of metadata by ids of the table where possible. If
+   * define is set, strings not in the server's table yet are added to it by
+   * this request; their ids are returned, and must be passed to onResponse()
+   * once the request completes. Requests without responses must not define
+   * entries.
+   */
+  std::vector<int32_t> encode(RequestRpcMetadata& metadata, bool define);
+
+  /**
+   * If received is not set, the request that defined the entries might not
+   * have reached the server, and they are defined again by a later request.
+   */
+  void onResponse(const std::vector<int32_t>& ids, bool received);
+
+  size_t size() const {
+    return states_.size();
+  }
+
+ private:
+  enum class State : uint8_t {
+    UNDEFINED,
+    PENDING,
+    DEFINED,
+  };
+
+  folly::Optional<int32_t> intern(
+      const std::string& str,
+      bool define,
+      InternedRequestMetadata& interned,
+      std::vector<int32_t>& defined);
+
+  const size_t maxEntries_;
+  folly::F14FastMap<std::string, int32_t> ids_;
+  std::vector<State> states_;
+  // Strings seen once, so that values unique to a request (e.g. request ids
+  // in headers) do not fill the table.
+  folly::F14FastSet<std::string> seenOnce_;
+};
+
+/**
+ * Server half of per-connection metadata interning.
+ */
+class MetadataInterningDecoder {
+ public:
+  explicit MetadataInterningDecoder(size_t maxEntries);
+
+  /**
+   * Adds the entries metadata.interned defines to the table and restores the
+   * fields it replaced. Returns false if it refers to entries that are not in
+   * the table, defines entries past the size negotiated at setup or defines
+   * entries longer than MetadataInterningEncoder::kMaxEntryLength.
+   */
+  bool decode(RequestRpcMetadata& metadata);
+
+ private:
+  const std::string* lookup(int32_t id) const;
+
+  const size_t maxEntries_;
+  // Undefined entries are empty, empty strings are never interned.
+  std::vector<std::string> entries_;
+};
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
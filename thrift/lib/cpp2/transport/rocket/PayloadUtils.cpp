@@ -16,6 +16,8 @@
 
 #include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
 
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
+
 namespace apache {
 namespace thrift {
 namespace rocket {
@@ -94,6 +96,14 @@ void setCompressionCodec(
           break;
         case CodecConfig::zstdConfig:
           metadata.compression_ref() = CompressionAlgorithm::ZSTD;
+          // Only use a dictionary that was negotiated with the peer.
+          if (auto dictionaryId = codecRef->get_zstdConfig().dictionaryId_ref();
+              dictionaryId && ZstdDictionaryRegistry::get(*dictionaryId)) {
+            metadata.compressionDictionaryId_ref() = *dictionaryId;
+          }
+          break;
+        case CodecConfig::lz4Config:
+          metadata.compression_ref() = CompressionAlgorithm::LZ4;
           break;
         default:
           break;
@@ -115,28 +125,50 @@ template void setCompressionCodec<>(
     StreamPayloadMetadata& metadata,
     size_t payloadSize);
 
+namespace {
+std::shared_ptr<const ZstdDictionary> getZstdDictionary(int32_t id) {
+  auto dictionary = ZstdDictionaryRegistry::get(id);
+  if (!dictionary) {
+    folly::throw_exception<std::runtime_error>(
+        fmt::format("Unknown ZSTD dictionary {}", id));
+  }
+  return dictionary;
+}
+} // namespace
+
 void compressPayload(
     std::unique_ptr<folly::IOBuf>& data,
-    CompressionAlgorithm compression) {
+    CompressionAlgorithm compression,
+    std::optional<int32_t> dictionaryId,
+    int level) {
   folly::io::CodecType codec;
   switch (compression) {
     case CompressionAlgorithm::ZSTD:
+      if (dictionaryId) {
+        data = getZstdDictionary(*dictionaryId)->compress(*data);
+        return;
+      }
       codec = folly::io::CodecType::ZSTD;
       break;
     case CompressionAlgorithm::ZLIB:
       codec = folly::io::CodecType::ZLIB;
       break;
+    case CompressionAlgorithm::LZ4:
+      codec = folly::io::CodecType::LZ4_VARINT_SIZE;
+      break;
     case CompressionAlgorithm::NONE:
       codec = folly::io::CodecType::NO_COMPRESSION;
       break;
   }
-  data = folly::io::getCodec(codec)->compress(data.get());
+  data = folly::io::getCodec(codec, level)->compress(data.get());
 }
 
 folly::Expected<std::unique_ptr<folly::IOBuf>, std::string> uncompressPayload(
     CompressionAlgorithm compression,
-    std::unique_ptr<folly::IOBuf> data) {
-  folly::io::CodecType codec;
+    std::unique_ptr<folly::IOBuf> data,
+    std::optional<int32_t> dictionaryId) {
+  // The algorithm comes from the peer and may be out of range.
+  std::optional<folly::io::CodecType> codec;
   switch (compression) {
     case CompressionAlgorithm::ZSTD:
       codec = folly::io::CodecType::ZSTD;
@@ -144,13 +176,27 @@ folly::Expected<std::unique_ptr<folly::IOBuf>, std::string> uncompressPayload(
     case CompressionAlgorithm::ZLIB:
       codec = folly::io::CodecType::ZLIB;
       break;
+    case CompressionAlgorithm::LZ4:
+      codec = folly::io::CodecType::LZ4_VARINT_SIZE;
+      break;
     case CompressionAlgorithm::NONE:
       codec = folly::io::CodecType::NO_COMPRESSION;
       break;
   }
+  if (!codec) {
+    return folly::makeUnexpected(fmt::format(
+        "unknown compression algorithm {}", static_cast<int>(compression)));
+  }
 
   try {
-    return folly::io::getCodec(codec)->uncompress(data.get());
+    if (dictionaryId) {
+      if (compression != CompressionAlgorithm::ZSTD) {
+        return folly::makeUnexpected(
+            std::string("dictionary is only supported for ZSTD"));
+      }
+      return getZstdDictionary(*dictionaryId)->uncompress(*data);
+    }
+    return folly::io::getCodec(*codec)->uncompress(data.get());
   } catch (const std::exception& e) {
     return folly::makeUnexpected(std::string(e.what()));
   }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <fmt/core.h>
 #include <folly/Expected.h>
 #include <folly/Try.h>
@@ -77,17 +79,21 @@ extern template void setCompressionCodec<>(
 
 /**
  * Helper method to compress the payload before sending to the remote endpoint.
+ * ZSTD may use a dictionary from ZstdDictionaryRegistry, which fixes the level.
  */
 void compressPayload(
     std::unique_ptr<folly::IOBuf>& data,
-    CompressionAlgorithm compression);
+    CompressionAlgorithm compression,
+    std::optional<int32_t> dictionaryId = std::nullopt,
+    int level = folly::io::COMPRESSION_LEVEL_DEFAULT);
 
 /**
  * Helper method to uncompress the payload from remote endpoint.
  */
 folly::Expected<std::unique_ptr<folly::IOBuf>, std::string> uncompressPayload(
     CompressionAlgorithm compression,
-    std::unique_ptr<folly::IOBuf> data);
+    std::unique_ptr<folly::IOBuf> data,
+    std::optional<int32_t> dictionaryId = std::nullopt);
 } // namespace detail
 
 template <typename T>
@@ -126,7 +132,9 @@ folly::Try<T> unpack(rocket::Payload&& payload) {
     // uncompress the payload if needed
     if (auto compress = t.metadata.compression_ref()) {
       auto result = apache::thrift::rocket::detail::uncompressPayload(
-          *compress, std::move(data));
+          *compress,
+          std::move(data),
+          t.metadata.compressionDictionaryId_ref().to_optional());
       if (!result) {
         folly::throw_exception<TApplicationException>(
             TApplicationException::INVALID_TRANSFORM,
@@ -162,7 +170,9 @@ rocket::Payload pack(const Metadata& metadata, Payload&& payload) {
   auto serializedPayload = packCompact(std::forward<Payload>(payload));
   if (auto compress = metadata.compression_ref()) {
     apache::thrift::rocket::detail::compressPayload(
-        serializedPayload, *compress);
+        serializedPayload,
+        *compress,
+        metadata.compressionDictionaryId_ref().to_optional());
   }
   return apache::thrift::rocket::detail::makePayload(
       metadata, std::move(serializedPayload));
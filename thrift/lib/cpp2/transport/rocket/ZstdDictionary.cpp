@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <folly/Indestructible.h>
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <zdict.h>
+#include <zstd.h>
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+namespace {
+// The content size in a frame header comes from the peer, so it is only
+// trusted up to this much for the first output buffer.
+constexpr size_t kMaxInitialOutputSize = 1 << 20;
+
+folly::ByteRange coalesced(
+    const folly::IOBuf& data,
+    std::unique_ptr<folly::IOBuf>& storage) {
+  if (!data.isChained()) {
+    return {data.data(), data.length()};
+  }
+  storage = data.cloneCoalesced();
+  return {storage->data(), storage->length()};
+}
+
+ZSTD_CCtx& getCCtx() {
+  static thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> ctx{
+      ZSTD_createCCtx(), ZSTD_freeCCtx};
+  return *ctx;
+}
+
+ZSTD_DCtx& getDCtx() {
+  static thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> ctx{
+      ZSTD_createDCtx(), ZSTD_freeDCtx};
+  return *ctx;
+}
+
+using Dictionaries = folly::Synchronized<
+    folly::F14FastMap<int32_t, std::shared_ptr<const ZstdDictionary>>,
+    folly::SharedMutex>;
+
+Dictionaries& getDictionaries() {
+  static folly::Indestructible<Dictionaries> dictionaries;
+  return *dictionaries;
+}
+} // namespace
+
+ZstdDictionary::ZstdDictionary(
+    int32_t id,
+    folly::ByteRange dictionary,
+    int level)
+    : id_(id),
+      cdict_(ZSTD_createCDict(dictionary.data(), dictionary.size(), level)),
+      ddict_(ZSTD_createDDict(dictionary.data(), dictionary.size())) {
+  if (!cdict_ || !ddict_) {
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+    throw std::runtime_error(
+        fmt::format("Failed to load ZSTD dictionary {}", id));
+  }
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionary::compress(
+    const folly::IOBuf& data) const {
+  std::unique_ptr<folly::IOBuf> storage;
+  auto input = coalesced(data, storage);
+
+  auto output = folly::IOBuf::create(ZSTD_compressBound(input.size()));
+  auto size = ZSTD_compress_usingCDict(
+      &getCCtx(),
+      output->writableTail(),
+      output->tailroom(),
+      input.data(),
+      input.size(),
+      cdict_);
+  if (ZSTD_isError(size)) {
+    throw std::runtime_error(fmt::format(
+        "ZSTD compression with dictionary {} failed: {}",
+        id_,
+        ZSTD_getErrorName(size)));
+  }
+  output->append(size);
+  return output;
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionary::uncompress(
+    const folly::IOBuf& data) const {
+  std::unique_ptr<folly::IOBuf> storage;
+  auto input = coalesced(data, storage);
+
+  auto length = ZSTD_getFrameContentSize(input.data(), input.size());
+  if (length == ZSTD_CONTENTSIZE_ERROR) {
+    throw std::runtime_error("Invalid ZSTD frame");
+  }
+  auto dictId = ZSTD_getDictID_fromFrame(input.data(), input.size());
+  if (dictId != 0 && dictId != ZSTD_getDictID_fromDDict(ddict_)) {
+    throw std::runtime_error(fmt::format(
+        "ZSTD frame was not compressed with dictionary {}", id_));
+  }
+
+  auto& dctx = getDCtx();
+  ZSTD_DCtx_reset(&dctx, ZSTD_reset_session_only);
+  ZSTD_DCtx_refDDict(&dctx, ddict_);
+
+  // Output buffers grow with the data actually produced, at most doubling
+  // the total each time.
+  folly::IOBufQueue output{folly::IOBufQueue::cacheChainLength()};
+  size_t allocation = length == ZSTD_CONTENTSIZE_UNKNOWN
+      ? ZSTD_DStreamOutSize()
+      : std::max<size_t>(std::min<uint64_t>(length, kMaxInitialOutputSize), 1);
+  ZSTD_inBuffer in{input.data(), input.size(), 0};
+  while (true) {
+    auto buffer = output.preallocate(1, allocation);
+    ZSTD_outBuffer out{buffer.first, buffer.second, 0};
+    auto ret = ZSTD_decompressStream(&dctx, &out, &in);
+    if (ZSTD_isError(ret)) {
+      throw std::runtime_error(fmt::format(
+          "ZSTD decompression with dictionary {} failed: {}",
+          id_,
+          ZSTD_getErrorName(ret)));
+    }
+    output.postallocate(out.pos);
+    if (ret == 0) {
+      break;
+    }
+    if (in.pos == in.size && out.pos < out.size) {
+      throw std::runtime_error("Truncated ZSTD frame");
+    }
+    allocation = std::max(ZSTD_DStreamOutSize(), output.chainLength());
+  }
+  if (in.pos != in.size) {
+    throw std::runtime_error("Invalid ZSTD frame");
+  }
+  auto result = output.move();
+  return result ? std::move(result) : folly::IOBuf::create(0);
+}
+
+void ZstdDictionaryRegistry::add(
+    int32_t id,
+    folly::ByteRange dictionary,
+    int level) {
+  auto zstdDictionary = std::make_shared<ZstdDictionary>(id, dictionary, level);
+  getDictionaries().wlock()->insert_or_assign(id, std::move(zstdDictionary));
+}
+
+void ZstdDictionaryRegistry::remove(int32_t id) {
+  getDictionaries().wlock()->erase(id);
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionaryRegistry::get(
+    int32_t id) {
+  auto dictionaries = getDictionaries().rlock();
+  auto it = dictionaries->find(id);
+  return it == dictionaries->end() ? nullptr : it->second;
+}
+
+std::vector<int32_t> ZstdDictionaryRegistry::getIds() {
+  std::vector<int32_t> ids;
+  auto dictionaries = getDictionaries().rlock();
+  ids.reserve(dictionaries->size());
+  for (const auto& entry : *dictionaries) {
+    ids.push_back(entry.first);
+  }
+  std::sort(ids.begin(), ids.end(), std::greater<>());
+  return ids;
+}
+
+std::string trainZstdDictionary(
+    const std::vector<std::string>& samples,
+    size_t maxSize) {
+  std::string samplesBuffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    samplesBuffer += sample;
+    sampleSizes.push_back(sample.size());
+  }
+
+  std::string dictionary(maxSize, '\0');
+  auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      samplesBuffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    throw std::runtime_error(fmt::format(
+        "ZSTD dictionary training failed: {}", ZDICT_getErrorName(size)));
+  }
+  dictionary.resize(size);
+  return dictionary;
+}
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
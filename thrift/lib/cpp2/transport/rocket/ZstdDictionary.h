@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/io/IOBuf.h>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+/**
+ * A pre-shared ZSTD dictionary. Small payloads share most of their structure
+ * (field headers, enum values, common strings) with each other, but too little
+ * with themselves for ZSTD or ZLIB to find it. Compressing them against a
+ * dictionary trained on typical payloads recovers most of that.
+ */
+class ZstdDictionary {
+ public:
+  static constexpr int kDefaultLevel = 3;
+
+  ZstdDictionary(int32_t id, folly::ByteRange dictionary, int level);
+  ~ZstdDictionary();
+
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+  int32_t id() const {
+    return id_;
+  }
+
+  std::unique_ptr<folly::IOBuf> compress(const folly::IOBuf& data) const;
+
+  // Throws std::runtime_error if data was not compressed with this
+  // dictionary.
+  std::unique_ptr<folly::IOBuf> uncompress(const folly::IOBuf& data) const;
+
+ private:
+  const int32_t id_;
+  ZSTD_CDict_s* cdict_;
+  ZSTD_DDict_s* ddict_;
+};
+
+/**
+ * Process-wide set of pre-shared ZSTD dictionaries. Both peers must register
+ * the same dictionary under the same id. The client offers all registered
+ * dictionaries in the setup frame and the server picks the first one it also
+ * has; that dictionary is then used for ZSTD on the connection.
+ */
+class ZstdDictionaryRegistry {
+ public:
+  static void add(
+      int32_t id,
+      folly::ByteRange dictionary,
+      int level = ZstdDictionary::kDefaultLevel);
+
+  // Payloads compressed with the dictionary can no longer be uncompressed.
+  static void remove(int32_t id);
+
+  // Returns nullptr if there is no dictionary with this id.
+  static std::shared_ptr<const ZstdDictionary> get(int32_t id);
+
+  // Highest (i.e. most recently trained) first.
+  static std::vector<int32_t> getIds();
+};
+
+/**
+ * Trains a dictionary of at most maxSize bytes on sample payloads, e.g.
+ * captured from production traffic. Throws std::runtime_error if training
+ * fails, typically because there are too few samples.
+ */
+std::string trainZstdDictionary(
+    const std::vector<std::string>& samples,
+    size_t maxSize);
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
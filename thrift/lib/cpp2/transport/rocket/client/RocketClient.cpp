@@ -296,6 +296,10 @@ StreamChannelStatus RocketClient::handlePayloadFrame(
         return serverCallback.onStreamError(
             std::move(streamPayload.exception()));
       }
+      if (streamPayload->metadata.batchItemSizes_ref()) {
+        return handleBatchedStreamPayload(
+            serverCallback, streamId, std::move(*streamPayload), complete);
+      }
       if (complete) {
         return serverCallback.onStreamFinalPayload(std::move(*streamPayload));
       }
@@ -314,6 +318,50 @@ StreamChannelStatus RocketClient::handlePayloadFrame(
   return StreamChannelStatus::Alive;
 }
 
+template <typename CallbackType>
+StreamChannelStatus RocketClient::handleBatchedStreamPayload(
+    CallbackType& serverCallback,
+    StreamId streamId,
+    StreamPayload&& batch,
+    bool complete) {
+  // The server packed several stream items into one frame; hand them to the
+  // callback one at a time, as if they had arrived in separate frames.
+  const auto itemSizes = std::move(*batch.metadata.batchItemSizes_ref());
+  size_t totalSize = 0;
+  bool valid = batch.payload && !itemSizes.empty();
+  for (auto itemSize : itemSizes) {
+    valid = valid && itemSize >= 0;
+    totalSize += itemSize;
+  }
+  if (!valid || totalSize != batch.payload->computeChainDataLength()) {
+    serverCallback.onStreamError(
+        folly::make_exception_wrapper<transport::TTransportException>(
+            transport::TTransportException::TTransportExceptionType::
+                STREAMING_CONTRACT_VIOLATION,
+            "Malformed stream payload batch"));
+    return StreamChannelStatus::ContractViolation;
+  }
+
+  folly::io::Cursor cursor(batch.payload.get());
+  for (size_t i = 0; i < itemSizes.size(); ++i) {
+    std::unique_ptr<folly::IOBuf> item;
+    cursor.clone(item, itemSizes[i]);
+    StreamPayload payload(std::move(item), {});
+    if (complete && i + 1 == itemSizes.size()) {
+      return serverCallback.onStreamFinalPayload(std::move(payload));
+    }
+    auto status = serverCallback.onStreamPayload(std::move(payload));
+    if (status != StreamChannelStatus::Alive) {
+      return status;
+    }
+    // onStreamPayload could have resulted in canceling the stream.
+    if (streams_.find(streamId) == streams_.end()) {
+      return StreamChannelStatus::Alive;
+    }
+  }
+  return StreamChannelStatus::Alive;
+}
+
 template <typename CallbackType>
 StreamChannelStatus RocketClient::handleErrorFrame(
     CallbackType& serverCallback,
@@ -494,6 +494,13 @@ class RocketClient : public folly::DelayedDestruction,
       CallbackType& serverCallback,
       std::unique_ptr<folly::IOBuf> frame);
 
+  template <typename CallbackType>
+  StreamChannelStatus handleBatchedStreamPayload(
+      CallbackType& serverCallback,
+      StreamId streamId,
+      StreamPayload&& batch,
+      bool complete);
+
   template <typename CallbackType>
   StreamChannelStatus handleErrorFrame(
       CallbackType& serverCallback,
@@ -43,7 +43,11 @@ template <class T>
 void Parser<T>::getReadBuffer(void** bufout, size_t* lenout) {
   DCHECK(!readBuffer_.isChained());
   if (LIKELY(!aligning_)) {
-    if (periodicResizeBufferTimeout_ == 0) {
+    if (poolReadBuffers_ && readBuffer_.capacity() == 0) {
+      readBuffer_ = ReadBufferPool::get().acquire(
+          ReadBufferPool::roundUpToSizeClass(frameSizeEstimate_));
+      bufferSize_ = readBuffer_.capacity();
+    } else if (periodicResizeBufferTimeout_ == 0) {
       const auto now = std::chrono::steady_clock::now();
       if (now - lastResizeTime_ > resizeBufferTimeout_) {
         resizeBuffer();
@@ -129,14 +133,28 @@ void Parser<T>::readDataAvailable(size_t nbytes) noexcept {
       cursor.reset(&readBuffer_);
       readFrameOrMetadataSize(cursor);
       std::unique_ptr<folly::IOBuf> frame;
-      cursor.clone(frame, bytesToClone);
+      if (poolReadBuffers_ && !aligning_ &&
+          bytesToClone <= ReadBufferPool::kMaxCopiedFrameSize) {
+        // The owner usually holds on to the frame after handleFrame()
+        // returns, and a clone would keep the read buffer shared and out of
+        // the pool.
+        frame = folly::IOBuf::copyBuffer(cursor.data(), bytesToClone);
+      } else {
+        cursor.clone(frame, bytesToClone);
+      }
       owner_.decMemoryUsage(currentFrameLength_);
       currentFrameLength_ = 0;
       readBuffer_.trimStart(totalFrameSize);
       aligning_ = false;
+      frameSizeEstimate_ = std::max(
+          totalFrameSize, frameSizeEstimate_ - frameSizeEstimate_ / 8);
       owner_.handleFrame(std::move(frame));
     }
 
+    if (poolReadBuffers_) {
+      maybeReleaseReadBuffer();
+    }
+
     if (periodicResizeBufferTimeout_ != 0 && !isScheduled() &&
         bufferSize_ > kMaxBufferSize) {
       owner_.scheduleTimeout(
@@ -215,9 +233,20 @@ void Parser<T>::readBufferAvailable(
   }
 }
 
+template <class T>
+void Parser<T>::maybeReleaseReadBuffer() {
+  // Connections receiving frames larger than any pooled size class keep their
+  // buffer, which is shrunk by resizeBuffer() once they go idle.
+  if (readBuffer_.empty() &&
+      frameSizeEstimate_ <= ReadBufferPool::kMaxPooledBufferSize) {
+    ReadBufferPool::get().release(std::move(readBuffer_));
+  }
+}
+
 template <class T>
 void Parser<T>::resizeBuffer() {
-  if (bufferSize_ <= kMaxBufferSize || readBuffer_.length() >= kMaxBufferSize) {
+  if (bufferSize_ <= kMaxBufferSize || readBuffer_.length() >= kMaxBufferSize ||
+      readBuffer_.capacity() == 0 /* returned to the pool */) {
     return;
   }
   // resize readBuffer_ to kMaxBufferSize
@@ -19,3 +19,7 @@
 // timeout value for true resizng timer mechanism, if 0 fallback to
 // the old mechanism
 THRIFT_FLAG_DEFINE_int64(rocket_parser_resize_period_seconds, 3);
+
+// Borrow read buffers from a per IO thread pool instead of keeping one per
+// connection
+THRIFT_FLAG_DEFINE_bool(rocket_parser_pool_read_buffers, false);
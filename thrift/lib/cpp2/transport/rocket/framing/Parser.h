@@ -26,8 +26,10 @@
 #include <folly/io/async/AsyncTransport.h>
 
 #include <thrift/lib/cpp2/Flags.h>
+#include <thrift/lib/cpp2/transport/rocket/framing/ReadBufferPool.h>
 
 THRIFT_FLAG_DECLARE_int64(rocket_parser_resize_period_seconds);
+THRIFT_FLAG_DECLARE_bool(rocket_parser_pool_read_buffers);
 
 namespace apache {
 namespace thrift {
@@ -42,6 +44,7 @@ class Parser final : public folly::AsyncTransport::ReadCallback,
       std::chrono::milliseconds resizeBufferTimeout =
           kDefaultBufferResizeInterval)
       : owner_(owner),
+        poolReadBuffers_(THRIFT_FLAG(rocket_parser_pool_read_buffers)),
         resizeBufferTimeout_(resizeBufferTimeout),
         periodicResizeBufferTimeout_(
             THRIFT_FLAG(rocket_parser_resize_period_seconds)) {}
@@ -50,6 +53,9 @@ class Parser final : public folly::AsyncTransport::ReadCallback,
     if (currentFrameLength_) {
       owner_.decMemoryUsage(currentFrameLength_);
     }
+    if (poolReadBuffers_) {
+      ReadBufferPool::get().release(std::move(readBuffer_));
+    }
   }
 
   // AsyncTransport::ReadCallback implementation
@@ -92,9 +98,21 @@ class Parser final : public folly::AsyncTransport::ReadCallback,
   static constexpr std::chrono::milliseconds kDefaultBufferResizeInterval{
       std::chrono::seconds(3)};
 
+  void maybeReleaseReadBuffer();
+
   T& owner_;
+  // If set, readBuffer_ is borrowed from the thread's ReadBufferPool whenever
+  // the socket is readable and returned once it holds no partial frame, so
+  // idle connections hold no read buffer.
+  const bool poolReadBuffers_;
   size_t bufferSize_{kMinBufferSize};
-  folly::IOBuf readBuffer_{folly::IOBuf::CreateOp(), bufferSize_};
+  folly::IOBuf readBuffer_{
+      poolReadBuffers_ ? folly::IOBuf()
+                       : folly::IOBuf(folly::IOBuf::CreateOp(), bufferSize_)};
+  // Decaying max of recent frame sizes, used to pick the size class of pooled
+  // read buffers. Jumps to large frames immediately so connections receiving
+  // them don't reallocate on every read, and decays by 1/8 per frame.
+  size_t frameSizeEstimate_{kMinBufferSize};
   std::chrono::steady_clock::time_point lastResizeTime_{
       std::chrono::steady_clock::now()};
   const std::chrono::milliseconds resizeBufferTimeout_;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/transport/rocket/framing/ReadBufferPool.h>
+
+#include <utility>
+
+#include <folly/SingletonThreadLocal.h>
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+constexpr std::array<size_t, 5> ReadBufferPool::kSizeClasses;
+constexpr size_t ReadBufferPool::kMaxPooledBufferSize;
+constexpr size_t ReadBufferPool::kMaxCachedBytesPerSizeClass;
+constexpr size_t ReadBufferPool::kMaxCopiedFrameSize;
+
+namespace {
+struct ReadBufferPoolTag {};
+} // namespace
+
+ReadBufferPool& ReadBufferPool::get() {
+  return folly::SingletonThreadLocal<ReadBufferPool, ReadBufferPoolTag>::get();
+}
+
+size_t ReadBufferPool::sizeClassIndex(size_t size) {
+  for (size_t i = 0; i < kSizeClasses.size(); ++i) {
+    if (size <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return kSizeClasses.size();
+}
+
+size_t ReadBufferPool::roundUpToSizeClass(size_t size) {
+  const auto idx = sizeClassIndex(size);
+  return idx < kSizeClasses.size() ? kSizeClasses[idx] : size;
+}
+
+folly::IOBuf ReadBufferPool::acquire(size_t minCapacity) {
+  const auto idx = sizeClassIndex(minCapacity);
+  if (idx == kSizeClasses.size()) {
+    return folly::IOBuf(folly::IOBuf::CreateOp(), minCapacity);
+  }
+  auto& freeList = freeLists_[idx];
+  if (freeList.empty()) {
+    return folly::IOBuf(folly::IOBuf::CreateOp(), kSizeClasses[idx]);
+  }
+  auto buf = std::move(freeList.back());
+  freeList.pop_back();
+  cachedBytes_ -= kSizeClasses[idx];
+  return buf;
+}
+
+void ReadBufferPool::release(folly::IOBuf buf) {
+  if (buf.isChained() || buf.isSharedOne()) {
+    // Frames handed to the application still point into this buffer; it is
+    // freed once they are gone.
+    ++sharedReleases_;
+    return;
+  }
+  // IOBuf::create() may round the capacity up to a malloc size class; file the
+  // buffer under the largest size class it can serve.
+  const auto capacity = buf.capacity();
+  size_t idx = kSizeClasses.size();
+  while (idx > 0 && kSizeClasses[idx - 1] > capacity) {
+    --idx;
+  }
+  if (idx == 0) {
+    return;
+  }
+  --idx;
+  if (capacity >= 2 * kSizeClasses[idx]) {
+    // Grown to fit a large frame, not worth caching.
+    return;
+  }
+  auto& freeList = freeLists_[idx];
+  if ((freeList.size() + 1) * kSizeClasses[idx] > kMaxCachedBytesPerSizeClass) {
+    return;
+  }
+  buf.clear();
+  freeList.push_back(std::move(buf));
+  cachedBytes_ += kSizeClasses[idx];
+}
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <folly/io/IOBuf.h>
+
+namespace apache {
+namespace thrift {
+namespace rocket {
+
+/**
+ * Free lists of rocket parser read buffers, bucketed by size class.
+ *
+ * Each IO thread drives a single EventBase, so the pool is thread local and
+ * needs no synchronization. Parsers return their buffer between frames, which
+ * lets mostly idle connections hold no read buffer at all.
+ */
+class ReadBufferPool {
+ public:
+  static constexpr std::array<size_t, 5> kSizeClasses{
+      {256, 1024, 4096, 16 * 1024, 64 * 1024}};
+  static constexpr size_t kMaxPooledBufferSize = kSizeClasses.back();
+  // Upper bound on the memory cached by each size class of a pool.
+  static constexpr size_t kMaxCachedBytesPerSizeClass = 4 * 1024 * 1024;
+  // Frames up to this size are copied out of a pooled read buffer rather than
+  // cloned, so that the buffer is unshared, and can be cached, once the frames
+  // have been handed off.
+  static constexpr size_t kMaxCopiedFrameSize = 4096;
+
+  // Pool of the calling thread.
+  static ReadBufferPool& get();
+
+  // Smallest size class that can hold `size` bytes. Sizes above
+  // kMaxPooledBufferSize are returned unchanged.
+  static size_t roundUpToSizeClass(size_t size);
+
+  // Returns an empty buffer with at least `minCapacity` bytes of tailroom,
+  // reusing a cached one if possible.
+  folly::IOBuf acquire(size_t minCapacity);
+
+  // Caches `buf` for reuse if it is unshared and of a pooled size class,
+  // otherwise frees it (or drops this reference, if it is shared).
+  void release(folly::IOBuf buf);
+
+  size_t getCachedBytes() const {
+    return cachedBytes_;
+  }
+
+  // Number of released buffers that could not be cached because frames still
+  // pointed into them.
+  size_t getSharedReleases() const {
+    return sharedReleases_;
+  }
+
+ private:
+  static size_t sizeClassIndex(size_t size);
+
+  std::array<std::vector<folly::IOBuf>, kSizeClasses.size()> freeLists_;
+  size_t cachedBytes_{0};
+  size_t sharedReleases_{0};
+};
+
+} // namespace rocket
+} // namespace thrift
+} // namespace apache
@@ -16,9 +16,16 @@
 
 #include <folly/portability/GTest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include <folly/ExceptionWrapper.h>
+#include <folly/ScopeGuard.h>
 #include <folly/io/async/DelayedDestruction.h>
 #include <thrift/lib/cpp2/transport/rocket/framing/Parser.h>
+#include <thrift/lib/cpp2/transport/rocket/framing/ReadBufferPool.h>
 
 namespace apache {
 namespace thrift {
@@ -82,6 +89,137 @@ TEST(ParserTest, noResizeBufferReadBufEqMaxTest) {
   EXPECT_EQ(parser.getReadBufferSize(), Parser<FakeOwner>::kMaxBufferSize * 2);
 }
 
+TEST(ParserTest, pooledReadBufferTest) {
+  THRIFT_FLAG_SET_MOCK(rocket_parser_pool_read_buffers, true);
+  SCOPE_EXIT {
+    THRIFT_FLAG_SET_MOCK(rocket_parser_pool_read_buffers, false);
+  };
+  auto& pool = ReadBufferPool::get();
+  FakeOwner owner;
+  Parser<FakeOwner> parser(owner, std::chrono::milliseconds(0));
+  // Nothing is allocated until the socket is readable
+  EXPECT_EQ(parser.getReadBuffer().capacity(), 0);
+
+  // 3 byte frame length, stream id, frame type and flags, then 4 bytes of
+  // payload
+  const uint8_t frame[] = {0, 0, 10, 0, 0, 0, 1, 0x20, 0, 'a', 'b', 'c', 'd'};
+  auto deliver = [&](const uint8_t* data, size_t len) {
+    void* buf;
+    size_t bufLen;
+    parser.getReadBuffer(&buf, &bufLen);
+    ASSERT_GE(bufLen, len);
+    memcpy(buf, data, len);
+    parser.readDataAvailable(len);
+  };
+
+  // A partial frame keeps the buffer
+  deliver(frame, 5);
+  EXPECT_EQ(parser.getReadBuffer().length(), 5);
+  EXPECT_GE(parser.getReadBuffer().capacity(), ReadBufferPool::kSizeClasses[0]);
+
+  // Once the frame is complete the buffer goes back to the pool
+  const auto cachedBytes = pool.getCachedBytes();
+  deliver(frame + 5, sizeof(frame) - 5);
+  EXPECT_EQ(parser.getReadBuffer().capacity(), 0);
+  EXPECT_EQ(
+      pool.getCachedBytes(), cachedBytes + ReadBufferPool::kSizeClasses[0]);
+
+  // and is reused on the next read
+  deliver(frame, sizeof(frame));
+  EXPECT_EQ(parser.getReadBuffer().capacity(), 0);
+  EXPECT_EQ(
+      pool.getCachedBytes(), cachedBytes + ReadBufferPool::kSizeClasses[0]);
+}
+
+// Like the connections, which keep the frames they are handed.
+class HoldingOwner : public FakeOwner {
+ public:
+  void handleFrame(std::unique_ptr<folly::IOBuf> frame) {
+    frames.push_back(std::move(frame));
+  }
+
+  std::vector<std::unique_ptr<folly::IOBuf>> frames;
+};
+
+TEST(ParserTest, pooledReadBufferHeldFramesTest) {
+  THRIFT_FLAG_SET_MOCK(rocket_parser_pool_read_buffers, true);
+  SCOPE_EXIT {
+    THRIFT_FLAG_SET_MOCK(rocket_parser_pool_read_buffers, false);
+  };
+  auto& pool = ReadBufferPool::get();
+  HoldingOwner owner;
+  Parser<HoldingOwner> parser(owner, std::chrono::milliseconds(0));
+
+  auto deliverFrame = [&](size_t payloadSize) {
+    // 3 byte frame length, stream id, frame type and flags, then the payload
+    const size_t frameSize = 6 + payloadSize;
+    std::vector<uint8_t> frame(3 + frameSize, 'x');
+    frame[0] = static_cast<uint8_t>(frameSize >> 16);
+    frame[1] = static_cast<uint8_t>(frameSize >> 8);
+    frame[2] = static_cast<uint8_t>(frameSize);
+    std::fill_n(frame.begin() + 3, 6, 0);
+    frame[6] = 1;
+    frame[7] = 0x20;
+
+    size_t offset = 0;
+    while (offset < frame.size()) {
+      void* buf;
+      size_t bufLen;
+      parser.getReadBuffer(&buf, &bufLen);
+      const auto len = std::min(bufLen, frame.size() - offset);
+      memcpy(buf, frame.data() + offset, len);
+      parser.readDataAvailable(len);
+      offset += len;
+    }
+  };
+
+  // Small frames are copied out, so the buffer can be cached even though the
+  // owner still holds them.
+  const auto sharedReleases = pool.getSharedReleases();
+  deliverFrame(100);
+  ASSERT_EQ(owner.frames.size(), 1);
+  EXPECT_EQ(owner.frames[0]->computeChainDataLength(), 106);
+  EXPECT_FALSE(owner.frames[0]->isShared());
+  EXPECT_EQ(parser.getReadBuffer().capacity(), 0);
+  EXPECT_EQ(pool.getSharedReleases(), sharedReleases);
+
+  // Larger ones are cloned, and the buffer is released to the heap once the
+  // owner drops them.
+  deliverFrame(ReadBufferPool::kMaxCopiedFrameSize);
+  ASSERT_EQ(owner.frames.size(), 2);
+  EXPECT_EQ(
+      owner.frames[1]->computeChainDataLength(),
+      6 + ReadBufferPool::kMaxCopiedFrameSize);
+  EXPECT_TRUE(owner.frames[1]->isShared());
+  EXPECT_EQ(parser.getReadBuffer().capacity(), 0);
+  EXPECT_EQ(pool.getSharedReleases(), sharedReleases + 1);
+}
+
+TEST(ParserTest, readBufferPoolSizeClassTest) {
+  ReadBufferPool pool;
+  EXPECT_EQ(ReadBufferPool::roundUpToSizeClass(1), 256);
+  EXPECT_EQ(ReadBufferPool::roundUpToSizeClass(257), 1024);
+  EXPECT_EQ(ReadBufferPool::roundUpToSizeClass(64 * 1024), 64 * 1024);
+  EXPECT_EQ(ReadBufferPool::roundUpToSizeClass(64 * 1024 + 1), 64 * 1024 + 1);
+
+  auto buf = pool.acquire(1000);
+  EXPECT_GE(buf.capacity(), 1024);
+  pool.release(std::move(buf));
+  EXPECT_EQ(pool.getCachedBytes(), 1024);
+
+  // Shared buffers are still in use by frames and are not cached
+  buf = pool.acquire(1000);
+  EXPECT_EQ(pool.getCachedBytes(), 0);
+  auto clone = buf.cloneOne();
+  pool.release(std::move(buf));
+  EXPECT_EQ(pool.getCachedBytes(), 0);
+  EXPECT_EQ(pool.getSharedReleases(), 1);
+
+  // Nor are buffers too large for any size class
+  pool.release(folly::IOBuf(folly::IOBuf::CreateOp(), 1024 * 1024));
+  EXPECT_EQ(pool.getCachedBytes(), 0);
+}
+
 TEST(ParserTest, AlignmentTest) {
   std::string s = "1234567890";
   auto iobuf = folly::IOBuf::copyBuffer(s);
@@ -138,6 +138,7 @@ void RocketRoutingHandler::handleConnection(
       server->getStreamExpireTime(),
       server->getWriteBatchingInterval(),
       server->getWriteBatchingSize(),
+      server->getWriteBatchingByteSize(),
       std::move(memLimitParams));
   onConnection(*connection);
   // set negotiated compression algorithm on this connection
@@ -147,6 +148,9 @@ void RocketRoutingHandler::handleConnection(
   if (compression != CompressionAlgorithm::NONE) {
     connection->setNegotiatedCompressionAlgorithm(compression);
   }
+  if (const auto& zeroCopyEnableFunc = server->getZeroCopyEnableFunc()) {
+    connection->setZeroCopyEnableFunc(zeroCopyEnableFunc);
+  }
   connectionManager->addConnection(connection);
 
   if (auto* observer = server->getObserver()) {
@@ -63,12 +63,17 @@ RocketServerConnection::RocketServerConnection(
     std::chrono::milliseconds streamStarvationTimeout,
     std::chrono::milliseconds writeBatchingInterval,
     size_t writeBatchingSize,
+    size_t writeBatchingByteSize,
     folly::Optional<IngressMemoryLimitStateRef> ingressMemoryLimitStateRef)
     : evb_(*socket->getEventBase()),
       socket_(std::move(socket)),
       frameHandler_(std::move(frameHandler)),
       streamStarvationTimeout_(streamStarvationTimeout),
-      writeBatcher_(*this, writeBatchingInterval, writeBatchingSize),
+      writeBatcher_(
+          *this,
+          writeBatchingInterval,
+          writeBatchingSize,
+          writeBatchingByteSize),
       socketDrainer_(*this),
       ingressMemoryLimitStateRef_(std::move(ingressMemoryLimitStateRef)) {
   CHECK(socket_);
@@ -109,6 +114,22 @@ void RocketServerConnection::send(
   writeBatcher_.enqueueWrite(std::move(data), std::move(cb));
 }
 
+folly::WriteFlags RocketServerConnection::zeroCopyWriteFlags(
+    const folly::IOBuf& writes) {
+  const auto bytes = writes.computeChainDataLength();
+  const bool zeroCopy = socket_->getZeroCopy();
+  if (zeroCopy) {
+    ++zeroCopyStats_.zeroCopyWrites;
+    zeroCopyStats_.zeroCopyBytes += bytes;
+  } else {
+    ++zeroCopyStats_.fallbackWrites;
+    zeroCopyStats_.fallbackBytes += bytes;
+  }
+  frameHandler_->onZeroCopyWrite(bytes, zeroCopy);
+  return zeroCopy ? folly::WriteFlags::WRITE_MSG_ZEROCOPY
+                  : folly::WriteFlags::NONE;
+}
+
 RocketServerConnection::~RocketServerConnection() {
   DCHECK(inflightRequests_ == 0);
   DCHECK(inflightWritesQueue_.empty());
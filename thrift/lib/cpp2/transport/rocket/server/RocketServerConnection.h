@@ -102,6 +102,7 @@ class RocketServerConnection final
       std::chrono::milliseconds writeBatchingInterval =
           std::chrono::milliseconds::zero(),
       size_t writeBatchingSize = 0,
+      size_t writeBatchingByteSize = 0,
       folly::Optional<IngressMemoryLimitStateRef> ingressMemoryLimitStateRef =
           folly::none);
 
@@ -140,6 +141,30 @@ class RocketServerConnection final
     negotiatedCompressionAlgo_ = compressionAlgo;
   }
 
+  struct ZeroCopyStats {
+    // Writes handed to the transport with MSG_ZEROCOPY, and their size.
+    uint64_t zeroCopyWrites{0};
+    uint64_t zeroCopyBytes{0};
+    // Writes that qualified for zerocopy but were copied into the kernel
+    // because the transport does not support it (e.g. TLS, or the kernel
+    // rejected SO_ZEROCOPY).
+    uint64_t fallbackWrites{0};
+    uint64_t fallbackBytes{0};
+  };
+
+  // Decides which writes are sent with MSG_ZEROCOPY. Takes over from the
+  // ZeroCopyEnableFunc installed on the socket, so that it is evaluated once
+  // per write both to pick the write flags and to account the write in
+  // getZeroCopyStats() and the server observer.
+  void setZeroCopyEnableFunc(folly::AsyncWriter::ZeroCopyEnableFunc func) {
+    zeroCopyEnableFunc_ = std::move(func);
+    socket_->setZeroCopyEnableFunc(folly::AsyncWriter::ZeroCopyEnableFunc());
+  }
+
+  const ZeroCopyStats& getZeroCopyStats() const {
+    return zeroCopyStats_;
+  }
+
   void sendPayload(
       StreamId streamId,
       Payload&& payload,
@@ -286,6 +311,9 @@ class RocketServerConnection final
 
   folly::Optional<CompressionAlgorithm> negotiatedCompressionAlgo_;
 
+  folly::AsyncWriter::ZeroCopyEnableFunc zeroCopyEnableFunc_;
+  ZeroCopyStats zeroCopyStats_;
+
   enum class ConnectionState : uint8_t {
     ALIVE,
     DRAINING, // Rejecting all new requests, waiting for inflight requests to
@@ -311,10 +339,12 @@ class RocketServerConnection final
     WriteBatcher(
         RocketServerConnection& connection,
         std::chrono::milliseconds batchingInterval,
-        size_t batchingSize)
+        size_t batchingSize,
+        size_t batchingByteSize)
         : connection_(connection),
           batchingInterval_(batchingInterval),
-          batchingSize_(batchingSize) {}
+          batchingSize_(batchingSize),
+          batchingByteSize_(batchingByteSize) {}
 
     void enqueueWrite(
         std::unique_ptr<folly::IOBuf> data,
@@ -323,8 +353,10 @@ class RocketServerConnection final
         cb->sendQueued();
         bufferedWritesContext_.sendCallbacks.push_back(std::move(cb));
       }
+      bufferedWritesBytes_ += data->computeChainDataLength();
       if (!bufferedWrites_) {
         bufferedWrites_ = std::move(data);
+        firstBufferedWriteTime_ = std::chrono::steady_clock::now();
         if (batchingInterval_ != std::chrono::milliseconds::zero()) {
           connection_.getEventBase().timer().scheduleTimeout(
               this, batchingInterval_);
@@ -336,7 +368,10 @@ class RocketServerConnection final
       }
       ++bufferedWritesCount_;
       if (batchingInterval_ != std::chrono::milliseconds::zero() &&
-          bufferedWritesCount_ == batchingSize_) {
+          isScheduled() &&
+          (bufferedWritesCount_ == batchingSize_ ||
+           (batchingByteSize_ != 0 &&
+            bufferedWritesBytes_ >= batchingByteSize_))) {
         cancelTimeout();
         connection_.getEventBase().runInLoop(this, true /* thisIteration */);
       }
@@ -370,7 +405,13 @@ class RocketServerConnection final
     }
 
     void flushPendingWrites() noexcept {
+      connection_.frameHandler_->onWriteBatchFlushed(
+          bufferedWritesCount_,
+          bufferedWritesBytes_,
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - firstBufferedWriteTime_));
       bufferedWritesCount_ = 0;
+      bufferedWritesBytes_ = 0;
       connection_.flushWrites(
           std::move(bufferedWrites_),
           std::exchange(bufferedWritesContext_, WriteBatchContext{}));
@@ -379,9 +420,12 @@ class RocketServerConnection final
     RocketServerConnection& connection_;
     std::chrono::milliseconds batchingInterval_;
     size_t batchingSize_;
+    size_t batchingByteSize_;
     // Callback is scheduled iff bufferedWrites_ is not empty.
     std::unique_ptr<folly::IOBuf> bufferedWrites_;
     size_t bufferedWritesCount_{0};
+    size_t bufferedWritesBytes_{0};
+    std::chrono::steady_clock::time_point firstBufferedWriteTime_;
     WriteBatchContext bufferedWritesContext_;
   };
   WriteBatcher writeBatcher_;
@@ -447,8 +491,14 @@ class RocketServerConnection final
       std::unique_ptr<folly::IOBuf> writes,
       WriteBatchContext&& context) {
     inflightWritesQueue_.push(std::move(context));
-    socket_->writeChain(this, std::move(writes));
+    auto flags = folly::WriteFlags::NONE;
+    if (zeroCopyEnableFunc_ && zeroCopyEnableFunc_(writes)) {
+      flags = zeroCopyWriteFlags(*writes);
+    }
+    socket_->writeChain(this, std::move(writes), flags);
   }
+  // Accounts a write that qualified for zerocopy and returns its flags.
+  folly::WriteFlags zeroCopyWriteFlags(const folly::IOBuf& writes);
 
   void timeoutExpired() noexcept final;
   void describe(std::ostream&) const final {}
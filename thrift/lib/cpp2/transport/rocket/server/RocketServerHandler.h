@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 namespace apache {
@@ -62,6 +64,15 @@ class RocketServerHandler {
 
   virtual void requestComplete() {}
 
+  virtual void onWriteBatchFlushed(
+      size_t /*numWrites*/,
+      size_t /*numBytes*/,
+      std::chrono::microseconds /*delay*/) {}
+
+  // A write of numBytes qualified for zerocopy. It was sent with
+  // MSG_ZEROCOPY if zeroCopy is set, and copied otherwise.
+  virtual void onZeroCopyWrite(size_t /*numBytes*/, bool /*zeroCopy*/) {}
+
   virtual void terminateInteraction(int64_t /*id*/) {}
 
   virtual void connectionClosing() = 0;
@@ -26,6 +26,7 @@
 #include <folly/Range.h>
 #include <folly/ScopeGuard.h>
 #include <folly/io/IOBufQueue.h>
+#include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
 
 #include <thrift/lib/cpp/TApplicationException.h>
@@ -56,12 +57,36 @@ class TimeoutCallback : public folly::HHWheelTimer::Callback {
   RocketStreamClientCallback& parent_;
 };
 
+// Flushes a stream's batch at the end of the event loop iteration or after
+// StreamBatchingConfig::maxDelayMs.
+class BatchFlushCallback : public folly::EventBase::LoopCallback,
+                           public folly::AsyncTimeout {
+ public:
+  BatchFlushCallback(RocketStreamClientCallback& parent, folly::EventBase& evb)
+      : folly::AsyncTimeout(&evb), parent_(parent) {}
+  void runLoopCallback() noexcept override {
+    parent_.flushBatch();
+  }
+  void timeoutExpired() noexcept override {
+    parent_.flushBatch();
+  }
+  void cancel() {
+    cancelLoopCallback();
+    cancelTimeout();
+  }
+
+ private:
+  RocketStreamClientCallback& parent_;
+};
+
 RocketStreamClientCallback::RocketStreamClientCallback(
     StreamId streamId,
     RocketServerConnection& connection,
     uint32_t initialRequestN)
     : streamId_(streamId), connection_(connection), tokens_(initialRequestN) {}
 
+RocketStreamClientCallback::~RocketStreamClientCallback() = default;
+
 bool RocketStreamClientCallback::onFirstResponse(
     FirstResponsePayload&& firstResponse,
     folly::EventBase* /* unused */,
@@ -114,10 +139,28 @@ void RocketStreamClientCallback::onFirstResponseError(
 
 bool RocketStreamClientCallback::onStreamNext(StreamPayload&& payload) {
   DCHECK_NE(tokens_, 0u);
-  if (!--tokens_) {
+  const bool outOfTokens = !--tokens_;
+  if (outOfTokens) {
     scheduleTimeout();
   }
 
+  // Items with metadata of their own are sent on their own.
+  if (batchingConfig_ && payload.payload &&
+      payload.metadata == StreamPayloadMetadata()) {
+    addToBatch(std::move(payload.payload));
+    // No more items can come before the client receives these.
+    if (outOfTokens) {
+      flushBatch();
+    }
+    return true;
+  }
+
+  flushBatch();
+  sendStreamPayload(std::move(payload));
+  return true;
+}
+
+void RocketStreamClientCallback::sendStreamPayload(StreamPayload&& payload) {
   // apply compression if client has specified compression codec
   if (compressionConfig_) {
     apache::thrift::rocket::detail::setCompressionCodec(
@@ -128,10 +171,54 @@ bool RocketStreamClientCallback::onStreamNext(StreamPayload&& payload) {
 
   connection_.sendPayload(
       streamId_, pack(std::move(payload)), Flags::none().next(true));
-  return true;
+}
+
+void RocketStreamClientCallback::addToBatch(
+    std::unique_ptr<folly::IOBuf> data) {
+  batchItemSizes_.push_back(
+      static_cast<int32_t>(data->computeChainDataLength()));
+  batch_.append(std::move(data));
+
+  const auto& config = *batchingConfig_;
+  if ((*config.maxItems_ref() > 0 &&
+       batchItemSizes_.size() >= static_cast<size_t>(*config.maxItems_ref())) ||
+      (*config.maxBytes_ref() > 0 &&
+       batch_.chainLength() >= static_cast<size_t>(*config.maxBytes_ref()))) {
+    flushBatch();
+    return;
+  }
+
+  if (batchItemSizes_.size() == 1) {
+    if (!batchFlushCallback_) {
+      batchFlushCallback_ = std::make_unique<BatchFlushCallback>(
+          *this, connection_.getEventBase());
+    }
+    if (auto delayMs = *config.maxDelayMs_ref(); delayMs > 0) {
+      batchFlushCallback_->scheduleTimeout(delayMs);
+    } else {
+      connection_.getEventBase().runInLoop(batchFlushCallback_.get());
+    }
+  }
+}
+
+void RocketStreamClientCallback::flushBatch() {
+  if (batchItemSizes_.empty()) {
+    return;
+  }
+  if (batchFlushCallback_) {
+    batchFlushCallback_->cancel();
+  }
+
+  StreamPayloadMetadata metadata;
+  if (batchItemSizes_.size() > 1) {
+    metadata.batchItemSizes_ref() = std::move(batchItemSizes_);
+  }
+  batchItemSizes_.clear();
+  sendStreamPayload(StreamPayload(batch_.move(), std::move(metadata)));
 }
 
 void RocketStreamClientCallback::onStreamComplete() {
+  flushBatch();
   connection_.sendPayload(
       streamId_,
       Payload::makeFromData(std::unique_ptr<folly::IOBuf>{}),
@@ -140,6 +227,7 @@ void RocketStreamClientCallback::onStreamComplete() {
 }
 
 void RocketStreamClientCallback::onStreamError(folly::exception_wrapper ew) {
+  flushBatch();
   ew.handle(
       [this](RocketException& rex) {
         connection_.sendError(
@@ -161,6 +249,7 @@ void RocketStreamClientCallback::onStreamError(folly::exception_wrapper ew) {
 }
 
 bool RocketStreamClientCallback::onStreamHeaders(HeadersPayload&& payload) {
+  flushBatch();
   connection_.sendExt(
       streamId_,
       pack(payload),
@@ -214,6 +303,12 @@ void RocketStreamClientCallback::setCompressionConfig(
   compressionConfig_ = std::make_unique<CompressionConfig>(compressionConfig);
 }
 
+void RocketStreamClientCallback::setBatchingConfig(
+    StreamBatchingConfig batchingConfig) {
+  batchingConfig_ =
+      std::make_unique<StreamBatchingConfig>(std::move(batchingConfig));
+}
+
 StreamServerCallback& RocketStreamClientCallback::getStreamServerCallback() {
   DCHECK(serverCallbackReady());
   return *serverCallback();
@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <folly/ExceptionWrapper.h>
+#include <folly/io/IOBufQueue.h>
 #include <folly/io/async/HHWheelTimer.h>
 
 #include <thrift/lib/cpp2/async/StreamCallbacks.h>
@@ -30,13 +34,15 @@ namespace apache {
 namespace thrift {
 namespace rocket {
 
+class BatchFlushCallback;
+
 class RocketStreamClientCallback final : public StreamClientCallback {
  public:
   RocketStreamClientCallback(
       StreamId streamId,
       RocketServerConnection& connection,
       uint32_t initialRequestN);
-  ~RocketStreamClientCallback() override = default;
+  ~RocketStreamClientCallback() override;
 
   bool onFirstResponse(
       FirstResponsePayload&& firstResponse,
@@ -59,6 +65,9 @@ class RocketStreamClientCallback final : public StreamClientCallback {
   void timeoutExpired() noexcept;
   void setProtoId(protocol::PROTOCOL_TYPES);
   void setCompressionConfig(CompressionConfig compressionConfig);
+  void setBatchingConfig(StreamBatchingConfig batchingConfig);
+  // Sends the items batched so far, see StreamBatchingConfig.
+  void flushBatch();
   bool serverCallbackReady() const {
     return serverCallbackOrCancelled_ != kCancelledFlag && serverCallback();
   }
@@ -80,7 +89,13 @@ class RocketStreamClientCallback final : public StreamClientCallback {
   std::unique_ptr<folly::HHWheelTimer::Callback> timeoutCallback_;
   protocol::PROTOCOL_TYPES protoId_;
   std::unique_ptr<CompressionConfig> compressionConfig_;
+  std::unique_ptr<StreamBatchingConfig> batchingConfig_;
+  folly::IOBufQueue batch_{folly::IOBufQueue::cacheChainLength()};
+  std::vector<int32_t> batchItemSizes_;
+  std::unique_ptr<BatchFlushCallback> batchFlushCallback_;
 
+  void sendStreamPayload(StreamPayload&& payload);
+  void addToBatch(std::unique_ptr<folly::IOBuf> data);
   void scheduleTimeout();
   void cancelTimeout();
 };
@@ -16,6 +16,7 @@
 
 #include <thrift/lib/cpp2/transport/rocket/server/RocketThriftRequests.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -32,6 +33,7 @@
 #endif
 #include <thrift/lib/cpp2/SerializationSwitch.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/server/AdaptiveCompressionPolicy.h>
 #include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
 #include <thrift/lib/cpp2/transport/rocket/Types.h>
 #include <thrift/lib/cpp2/transport/rocket/framing/Flags.h>
@@ -395,6 +397,41 @@ FOLLY_NODISCARD folly::exception_wrapper processFirstResponse(
     }
   }
 }
+
+Payload packWithPolicy(
+    AdaptiveCompressionPolicy& policy,
+    const std::string& methodName,
+    const CompressionConfig& compressionConfig,
+    ResponseRpcMetadata& metadata,
+    std::unique_ptr<folly::IOBuf> data) {
+  auto& method = policy.getMethod(methodName);
+  auto size = data->computeChainDataLength();
+  auto decision = policy.decide(method, compressionConfig, size);
+  if (decision.algorithm == CompressionAlgorithm::NONE) {
+    return rocket::detail::makePayload(metadata, std::move(data));
+  }
+
+  // Use the codec and dictionary the client asked for unless the policy
+  // picked a different codec.
+  rocket::detail::setCompressionCodec(compressionConfig, metadata, size);
+  if (metadata.compression_ref() != decision.algorithm) {
+    metadata.compression_ref() = decision.algorithm;
+    metadata.compressionDictionaryId_ref().reset();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  rocket::detail::compressPayload(
+      data,
+      decision.algorithm,
+      metadata.compressionDictionaryId_ref().to_optional(),
+      decision.level);
+  policy.onCompressed(
+      method,
+      size,
+      data->computeChainDataLength(),
+      std::chrono::steady_clock::now() - start);
+  return rocket::detail::makePayload(metadata, std::move(data));
+}
 } // namespace
 
 ThriftServerRequestResponse::ThriftServerRequestResponse(
@@ -426,8 +463,16 @@ void ThriftServerRequestResponse::sendThriftResponse(
     ResponseRpcMetadata&& metadata,
     std::unique_ptr<folly::IOBuf> data,
     apache::thrift::MessageChannel::SendCallbackPtr cb) noexcept {
+  const auto& compressionConfig = getCompressionConfig();
+  auto* policy = compressionConfig
+      ? serverConfigs_.getAdaptiveCompressionPolicy()
+      : nullptr;
   if (auto error = processFirstResponse(
-          metadata, data, getProtoId(), version_, getCompressionConfig())) {
+          metadata,
+          data,
+          getProtoId(),
+          version_,
+          policy ? folly::none : compressionConfig)) {
     error.handle(
         [&](RocketException& ex) {
           context_.sendError(std::move(ex), std::move(cb));
@@ -437,7 +482,13 @@ void ThriftServerRequestResponse::sendThriftResponse(
   }
 
   context_.sendPayload(
-      pack(metadata, std::move(data)),
+      policy ? packWithPolicy(
+                   *policy,
+                   getMethodName(),
+                   *compressionConfig,
+                   metadata,
+                   std::move(data))
+             : pack(metadata, std::move(data)),
       Flags::none().next(true).complete(true),
       std::move(cb));
 }
@@ -32,10 +32,14 @@
 #include <thrift/lib/cpp2/server/Cpp2ConnContext.h>
 #include <thrift/lib/cpp2/server/Cpp2Worker.h>
 #include <thrift/lib/cpp2/server/LoggingEvent.h>
+#include <thrift/lib/cpp2/server/MethodLatencyStats.h>
+#include <thrift/lib/cpp2/server/RequestTracer.h>
 #include <thrift/lib/cpp2/server/VisitorHelper.h>
 #include <thrift/lib/cpp2/transport/core/ThriftRequest.h>
+#include <thrift/lib/cpp2/transport/rocket/MetadataInterning.h>
 #include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
 #include <thrift/lib/cpp2/transport/rocket/RocketException.h>
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
 #include <thrift/lib/cpp2/transport/rocket/framing/ErrorCode.h>
 #include <thrift/lib/cpp2/transport/rocket/framing/Frames.h>
 #include <thrift/lib/cpp2/transport/rocket/server/RocketServerConnection.h>
@@ -47,12 +51,16 @@
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_constants.h>
 
 THRIFT_FLAG_DEFINE_bool(rocket_server_legacy_protocol_key, true);
+// Largest metadata interning table a client may use, 0 to not intern metadata.
+THRIFT_FLAG_DEFINE_int64(rocket_server_max_interned_metadata_entries, 4096);
 
 namespace apache {
 namespace thrift {
 namespace rocket {
 
 thread_local uint32_t ThriftRocketServerHandler::sample_{0};
+thread_local uint32_t ThriftRocketServerHandler::latencyStatsSample_{0};
+thread_local uint32_t ThriftRocketServerHandler::tracingSample_{0};
 
 namespace {
 bool isMetadataValid(const RequestRpcMetadata& metadata) {
@@ -93,14 +101,42 @@ ThriftRocketServerHandler::~ThriftRocketServerHandler() {
   }
 }
 
+void ThriftRocketServerHandler::onWriteBatchFlushed(
+    size_t numWrites,
+    size_t numBytes,
+    std::chrono::microseconds delay) {
+  if (auto* observer = worker_->getServer()->getObserver()) {
+    observer->writeBatchFlushed(numWrites, numBytes, delay);
+  }
+}
+
+void ThriftRocketServerHandler::onZeroCopyWrite(
+    size_t numBytes,
+    bool zeroCopy) {
+  if (auto* observer = worker_->getServer()->getObserver()) {
+    if (zeroCopy) {
+      observer->zeroCopyWrite(numBytes);
+    } else {
+      observer->zeroCopyFallback(numBytes);
+    }
+  }
+}
+
 apache::thrift::server::TServerObserver::SamplingStatus
 ThriftRocketServerHandler::shouldSample() {
   bool isServerSamplingEnabled =
       (sampleRate_ > 0) && ((sample_++ % sampleRate_) == 0);
+  bool isLatencyStatsSamplingEnabled = (latencyStatsSampleRate_ > 0) &&
+      ((latencyStatsSample_++ % latencyStatsSampleRate_) == 0);
+  bool isTracingEnabled = (tracingSampleRate_ > 0) &&
+      ((tracingSample_++ % tracingSampleRate_) == 0);
 
   // TODO: determine isClientSamplingEnabled by "client_logging_enabled" header
   return apache::thrift::server::TServerObserver::SamplingStatus(
-      isServerSamplingEnabled, false);
+      isServerSamplingEnabled,
+      false,
+      isLatencyStatsSamplingEnabled,
+      isTracingEnabled);
 }
 
 void ThriftRocketServerHandler::handleSetupFrame(
@@ -179,6 +215,12 @@ void ThriftRocketServerHandler::handleSetupFrame(
       if (auto* observer = serverConfigs_->getObserver()) {
         sampleRate_ = observer->getSampleRate();
       }
+      if (auto* latencyStats = serverConfigs_->getMethodLatencyStats()) {
+        latencyStatsSampleRate_ = latencyStats->getOptions().sampleRate;
+      }
+      if (auto* tracer = serverConfigs_->getRequestTracer()) {
+        tracingSampleRate_ = tracer->getOptions().sampleRate;
+      }
     }
 
     if (meta.dscpToReflect_ref() || meta.markToReflect_ref()) {
@@ -189,6 +231,26 @@ void ThriftRocketServerHandler::handleSetupFrame(
       ServerPushMetadata serverMeta;
       serverMeta.set_setupResponse();
       serverMeta.setupResponse_ref()->version_ref() = version_;
+      if (auto dictionaryIds = meta.zstdDictionaryIds_ref()) {
+        for (auto dictionaryId : *dictionaryIds) {
+          if (ZstdDictionaryRegistry::get(dictionaryId)) {
+            serverMeta.setupResponse_ref()->zstdDictionaryId_ref() =
+                dictionaryId;
+            break;
+          }
+        }
+      }
+      if (auto entries = meta.maxInternedEntries_ref()) {
+        auto maxEntries = std::min<int64_t>(
+            *entries,
+            THRIFT_FLAG(rocket_server_max_interned_metadata_entries));
+        if (maxEntries > 0) {
+          metadataDecoder_ =
+              std::make_unique<MetadataInterningDecoder>(maxEntries);
+          serverMeta.setupResponse_ref()->maxInternedEntries_ref() =
+              static_cast<int32_t>(maxEntries);
+        }
+      }
       CompactProtocolWriter compactProtocolWriter;
       folly::IOBufQueue queue;
       compactProtocolWriter.setOutput(&queue);
@@ -265,6 +327,9 @@ void ThriftRocketServerHandler::handleRequestStreamFrame(
   auto makeRequestStream = [&](RequestRpcMetadata&& md,
                                std::unique_ptr<folly::IOBuf> debugPayload,
                                std::shared_ptr<folly::RequestContext> ctx) {
+    if (auto batchingConfig = md.streamBatchingConfig_ref()) {
+      clientCallback->setBatchingConfig(*batchingConfig);
+    }
     serverConfigs_->incActiveRequests();
     return RequestsRegistry::makeRequest<ThriftServerRequestStream>(
         *eventBase_,
@@ -350,6 +415,14 @@ void ThriftRocketServerHandler::handleRequestCommon(
 
   auto debugPayload = data->clone();
 
+  // Also rejects interned metadata on connections that did not negotiate it.
+  if (metadata.interned_ref() &&
+      !(metadataDecoder_ && metadataDecoder_->decode(metadata))) {
+    handleRequestWithBadMetadata(makeRequest(
+        std::move(metadata), std::move(debugPayload), std::move(reqCtx)));
+    return;
+  }
+
   if (!isMetadataValid(metadata)) {
     handleRequestWithBadMetadata(makeRequest(
         std::move(metadata), std::move(debugPayload), std::move(reqCtx)));
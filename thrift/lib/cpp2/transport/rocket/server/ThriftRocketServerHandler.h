@@ -53,6 +53,7 @@ class ServerConfigs;
 
 namespace rocket {
 
+class MetadataInterningDecoder;
 class Payload;
 class RequestFnfFrame;
 class RequestResponseFrame;
@@ -94,6 +95,13 @@ class ThriftRocketServerHandler : public RocketServerHandler {
 
   void requestComplete() final;
 
+  void onWriteBatchFlushed(
+      size_t numWrites,
+      size_t numBytes,
+      std::chrono::microseconds delay) final;
+
+  void onZeroCopyWrite(size_t numBytes, bool zeroCopy) final;
+
   void terminateInteraction(int64_t id) final;
 
   Cpp2ConnContext* getCpp2ConnContext() final {
@@ -115,9 +123,16 @@ class ThriftRocketServerHandler : public RocketServerHandler {
 
   uint32_t sampleRate_{0};
   static thread_local uint32_t sample_;
+  uint32_t latencyStatsSampleRate_{0};
+  static thread_local uint32_t latencyStatsSample_;
+  uint32_t tracingSampleRate_{0};
+  static thread_local uint32_t tracingSample_;
 
   int32_t version_{6};
 
+  // Only set if metadata interning was negotiated at setup.
+  std::unique_ptr<MetadataInterningDecoder> metadataDecoder_;
+
   folly::once_flag setupLoggingFlag_;
 
   template <class F>
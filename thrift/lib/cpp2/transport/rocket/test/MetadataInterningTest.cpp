@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+
+#include <thrift/lib/cpp2/transport/rocket/MetadataInterning.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::rocket;
+
+namespace {
+
+RequestRpcMetadata makeMetadata(int requestId) {
+  RequestRpcMetadata metadata;
+  metadata.protocol_ref() = ProtocolId::COMPACT;
+  metadata.kind_ref() = RpcKind::SINGLE_REQUEST_SINGLE_RESPONSE;
+  metadata.name_ref() = "getUser";
+  metadata.clientId_ref() = "frontend";
+  auto& headers = metadata.otherMetadata_ref().ensure();
+  headers["region"] = "us-east";
+  headers["request_id"] = std::to_string(requestId);
+  return metadata;
+}
+
+// Sends a request through the encoder and decoder, and checks that the
+// server sees the same metadata.
+void roundTrip(
+    MetadataInterningEncoder& encoder,
+    MetadataInterningDecoder& decoder,
+    int requestId,
+    bool received = true) {
+  auto expected = makeMetadata(requestId);
+  auto metadata = expected;
+  auto ids = encoder.encode(metadata, true);
+  if (received) {
+    ASSERT_TRUE(decoder.decode(metadata));
+    EXPECT_EQ(expected, metadata);
+  }
+  encoder.onResponse(ids, received);
+}
+
+} // namespace
+
+TEST(MetadataInterningTest, internsRepeatedStrings) {
+  MetadataInterningEncoder encoder(100);
+  MetadataInterningDecoder decoder(100);
+
+  // Strings are interned once seen twice, and used once acknowledged.
+  auto metadata = makeMetadata(0);
+  EXPECT_TRUE(encoder.encode(metadata, true).empty());
+  EXPECT_FALSE(metadata.interned_ref());
+  roundTrip(encoder, decoder, 1);
+  roundTrip(encoder, decoder, 2);
+  EXPECT_EQ(5, encoder.size());
+
+  metadata = makeMetadata(3);
+  EXPECT_TRUE(encoder.encode(metadata, true).empty());
+  ASSERT_TRUE(metadata.interned_ref());
+  EXPECT_FALSE(metadata.interned_ref()->newEntries_ref());
+  EXPECT_FALSE(metadata.name_ref());
+  EXPECT_FALSE(metadata.clientId_ref());
+  // Only the unique request id is sent as is.
+  EXPECT_EQ(1, metadata.otherMetadata_ref()->size());
+  EXPECT_EQ(1, metadata.otherMetadata_ref()->count("request_id"));
+  EXPECT_EQ(2, metadata.interned_ref()->otherMetadata_ref()->size());
+
+  ASSERT_TRUE(decoder.decode(metadata));
+  EXPECT_EQ(makeMetadata(3), metadata);
+
+  for (int i = 4; i < 1000; ++i) {
+    roundTrip(encoder, decoder, i);
+  }
+  EXPECT_LE(encoder.size(), 100);
+}
+
+TEST(MetadataInterningTest, lostRequest) {
+  MetadataInterningEncoder encoder(100);
+  MetadataInterningDecoder decoder(100);
+  roundTrip(encoder, decoder, 0);
+  // Defines the entries, but never reaches the server.
+  roundTrip(encoder, decoder, 1, false);
+
+  // They are defined again.
+  auto metadata = makeMetadata(2);
+  EXPECT_FALSE(encoder.encode(metadata, true).empty());
+  ASSERT_TRUE(metadata.interned_ref());
+  EXPECT_TRUE(metadata.interned_ref()->newEntries_ref());
+  ASSERT_TRUE(decoder.decode(metadata));
+  EXPECT_EQ(makeMetadata(2), metadata);
+}
+
+TEST(MetadataInterningTest, pendingEntries) {
+  MetadataInterningEncoder encoder(100);
+  MetadataInterningDecoder decoder(100);
+  roundTrip(encoder, decoder, 0);
+
+  auto first = makeMetadata(1);
+  auto ids = encoder.encode(first, true);
+  EXPECT_FALSE(ids.empty());
+
+  // Entries are not used until the server has them.
+  auto second = makeMetadata(2);
+  EXPECT_TRUE(encoder.encode(second, true).empty());
+  EXPECT_FALSE(second.interned_ref());
+
+  ASSERT_TRUE(decoder.decode(first));
+  encoder.onResponse(ids, true);
+  auto third = makeMetadata(3);
+  encoder.encode(third, true);
+  ASSERT_TRUE(third.interned_ref());
+  EXPECT_FALSE(third.name_ref());
+}
+
+TEST(MetadataInterningTest, noDefinitions) {
+  MetadataInterningEncoder encoder(100);
+  for (int i = 0; i < 10; ++i) {
+    auto metadata = makeMetadata(i);
+    EXPECT_TRUE(encoder.encode(metadata, false).empty());
+    EXPECT_FALSE(metadata.interned_ref());
+  }
+  EXPECT_EQ(0, encoder.size());
+}
+
+TEST(MetadataInterningTest, invalidIds) {
+  MetadataInterningDecoder decoder(10);
+
+  RequestRpcMetadata unknown;
+  unknown.interned_ref().ensure().name_ref() = 0;
+  EXPECT_FALSE(decoder.decode(unknown));
+
+  RequestRpcMetadata tooMany;
+  tooMany.interned_ref().ensure().newEntries_ref().ensure()[10] = "foo";
+  EXPECT_FALSE(decoder.decode(tooMany));
+
+  RequestRpcMetadata empty;
+  empty.interned_ref().ensure().newEntries_ref().ensure()[0] = "";
+  EXPECT_FALSE(decoder.decode(empty));
+
+  RequestRpcMetadata tooLong;
+  tooLong.interned_ref().ensure().newEntries_ref().ensure()[0] =
+      std::string(MetadataInterningEncoder::kMaxEntryLength + 1, 'x');
+  EXPECT_FALSE(decoder.decode(tooLong));
+
+  RequestRpcMetadata odd;
+  auto& interned = odd.interned_ref().ensure();
+  interned.newEntries_ref().ensure()[0] = "foo";
+  interned.otherMetadata_ref() = std::vector<int32_t>{0};
+  EXPECT_FALSE(decoder.decode(odd));
+
+  RequestRpcMetadata valid;
+  valid.interned_ref().ensure().name_ref() = 0;
+  ASSERT_TRUE(decoder.decode(valid));
+  EXPECT_EQ("foo", *valid.name_ref());
+  EXPECT_FALSE(valid.interned_ref());
+}
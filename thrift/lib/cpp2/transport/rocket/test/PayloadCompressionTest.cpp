@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <folly/ScopeGuard.h>
+#include <folly/portability/GTest.h>
+
+#include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::rocket;
+
+namespace {
+
+std::string makeSample(int i) {
+  return "{\"user\": " + std::to_string(i) +
+      ", \"region\": \"us-east\", \"status\": \"active\", \"tier\": " +
+      (i % 2 ? "\"premium\"" : "\"basic\"") + "}";
+}
+
+std::string trainDictionary() {
+  std::vector<std::string> samples;
+  for (int i = 0; i < 1000; ++i) {
+    samples.push_back(makeSample(i));
+  }
+  return trainZstdDictionary(samples, 4096);
+}
+
+std::string roundTrip(
+    const std::string& payload,
+    CompressionAlgorithm algorithm,
+    std::optional<int32_t> dictionaryId = std::nullopt) {
+  auto data = folly::IOBuf::copyBuffer(payload);
+  detail::compressPayload(data, algorithm, dictionaryId);
+  auto result =
+      detail::uncompressPayload(algorithm, std::move(data), dictionaryId);
+  EXPECT_TRUE(result.hasValue()) << result.error();
+  return result.value()->moveToFbString().toStdString();
+}
+
+} // namespace
+
+TEST(PayloadCompressionTest, lz4) {
+  auto payload = makeSample(1) + makeSample(2);
+  EXPECT_EQ(payload, roundTrip(payload, CompressionAlgorithm::LZ4));
+}
+
+TEST(PayloadCompressionTest, zstdDictionary) {
+  auto dictionary = trainDictionary();
+  ZstdDictionaryRegistry::add(
+      7, folly::ByteRange(folly::StringPiece(dictionary)));
+  SCOPE_EXIT {
+    ZstdDictionaryRegistry::remove(7);
+  };
+  EXPECT_EQ(std::vector<int32_t>{7}, ZstdDictionaryRegistry::getIds());
+
+  auto payload = makeSample(12345);
+  EXPECT_EQ(payload, roundTrip(payload, CompressionAlgorithm::ZSTD, 7));
+
+  auto withDictionary = folly::IOBuf::copyBuffer(payload);
+  detail::compressPayload(withDictionary, CompressionAlgorithm::ZSTD, 7);
+  auto withoutDictionary = folly::IOBuf::copyBuffer(payload);
+  detail::compressPayload(withoutDictionary, CompressionAlgorithm::ZSTD);
+  EXPECT_LT(
+      withDictionary->computeChainDataLength(),
+      withoutDictionary->computeChainDataLength());
+
+  auto result = detail::uncompressPayload(
+      CompressionAlgorithm::ZSTD, std::move(withDictionary), 8);
+  EXPECT_FALSE(result.hasValue());
+}
+
+TEST(PayloadCompressionTest, zstdDictionaryOutputGrows) {
+  auto dictionary = trainDictionary();
+  ZstdDictionaryRegistry::add(
+      7, folly::ByteRange(folly::StringPiece(dictionary)));
+  SCOPE_EXIT {
+    ZstdDictionaryRegistry::remove(7);
+  };
+
+  // Larger than the first output buffer.
+  std::string payload;
+  for (int i = 0; payload.size() < (3 << 20); ++i) {
+    payload += makeSample(i);
+  }
+  EXPECT_EQ(payload, roundTrip(payload, CompressionAlgorithm::ZSTD, 7));
+
+  auto data = folly::IOBuf::copyBuffer(payload);
+  detail::compressPayload(data, CompressionAlgorithm::ZSTD, 7);
+  data->trimEnd(data->length() / 2);
+  auto result = detail::uncompressPayload(
+      CompressionAlgorithm::ZSTD, std::move(data), 7);
+  EXPECT_FALSE(result.hasValue());
+}
+
+TEST(PayloadCompressionTest, unknownAlgorithm) {
+  auto result = detail::uncompressPayload(
+      static_cast<CompressionAlgorithm>(100), folly::IOBuf::copyBuffer("x"));
+  ASSERT_FALSE(result.hasValue());
+  EXPECT_EQ("unknown compression algorithm 100", result.error());
+}
+
+TEST(PayloadCompressionTest, setCompressionCodec) {
+  CompressionConfig config;
+  config.codecConfig_ref().ensure().set_lz4Config();
+  StreamPayloadMetadata metadata;
+  detail::setCompressionCodec(config, metadata, 100);
+  EXPECT_EQ(CompressionAlgorithm::LZ4, *metadata.compression_ref());
+
+  // Dictionaries this side does not have are not used.
+  config.codecConfig_ref()->set_zstdConfig().dictionaryId_ref() = 7;
+  metadata = {};
+  detail::setCompressionCodec(config, metadata, 100);
+  EXPECT_EQ(CompressionAlgorithm::ZSTD, *metadata.compression_ref());
+  EXPECT_FALSE(metadata.compressionDictionaryId_ref());
+
+  auto dictionary = trainDictionary();
+  ZstdDictionaryRegistry::add(
+      7, folly::ByteRange(folly::StringPiece(dictionary)));
+  SCOPE_EXIT {
+    ZstdDictionaryRegistry::remove(7);
+  };
+  metadata = {};
+  detail::setCompressionCodec(config, metadata, 100);
+  EXPECT_EQ(7, *metadata.compressionDictionaryId_ref());
+}
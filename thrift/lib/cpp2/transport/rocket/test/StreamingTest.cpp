@@ -29,6 +29,7 @@
 #include <thrift/lib/cpp2/async/ClientStreamBridge.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
 #include <thrift/lib/cpp2/transport/core/testutil/TAsyncSocketIntercepted.h>
+#include <thrift/lib/cpp2/transport/rocket/framing/FrameType.h>
 #include <thrift/lib/cpp2/transport/rocket/test/util/TestServiceMock.h>
 #include <thrift/lib/cpp2/transport/rocket/test/util/TestUtil.h>
 
@@ -56,6 +57,40 @@ void waitNoLeak(StreamServiceAsyncClient* client) {
   } while (std::chrono::steady_clock::now() < deadline);
   FAIL() << "waitNoLeak failed";
 }
+
+// Counts the Rocket PAYLOAD frames in the bytes read by a client socket.
+class PayloadFrameCounter {
+ public:
+  void onRead(folly::ByteRange bytes) {
+    buffer_.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    size_t pos = 0;
+    while (buffer_.size() - pos >= kFrameHeaderSize) {
+      auto byte = [&](size_t i) { return uint8_t(buffer_[pos + i]); };
+      size_t length = (byte(0) << 16) | (byte(1) << 8) | byte(2);
+      if (buffer_.size() - pos < kLengthSize + length) {
+        break;
+      }
+      // The frame type is in the top 6 bits after the stream id.
+      if ((byte(kLengthSize + 4) >> 2) ==
+          static_cast<uint8_t>(rocket::FrameType::PAYLOAD)) {
+        ++payloadFrames_;
+      }
+      pos += kLengthSize + length;
+    }
+    buffer_.erase(0, pos);
+  }
+
+  size_t payloadFrames() const {
+    return payloadFrames_;
+  }
+
+ private:
+  static constexpr size_t kLengthSize = 3;
+  static constexpr size_t kFrameHeaderSize = kLengthSize + 6;
+
+  std::string buffer_;
+  std::atomic<size_t> payloadFrames_{0};
+};
 } // namespace
 
 // Testing transport layers for their support to Streaming
@@ -490,6 +525,46 @@ TEST_F(StreamingTest, FutureSimpleStream) {
   });
 }
 
+TEST_F(StreamingTest, BatchedStream) {
+  auto counter = std::make_shared<PayloadFrameCounter>();
+  connectToServer(
+      [&](std::unique_ptr<StreamServiceAsyncClient> client) {
+        for (int32_t maxItems : {1, 3, 100}) {
+          auto framesBefore = counter->payloadFrames();
+          StreamBatchingConfig batchingConfig;
+          batchingConfig.maxItems_ref() = maxItems;
+          batchingConfig.maxDelayMs_ref() = 1;
+          RpcOptions rpcOptions;
+          rpcOptions.setChunkBufferSize(7);
+          rpcOptions.setStreamBatchingConfig(std::move(batchingConfig));
+          auto stream = client->sync_range(rpcOptions, 0, 100);
+          int32_t j = 0;
+          std::move(stream).subscribeInline([&j](auto&& next) {
+            if (next.hasValue()) {
+              EXPECT_EQ(j++, *next);
+            } else if (next.hasException()) {
+              FAIL() << "Should not call onError: "
+                     << next.exception().what();
+            }
+          });
+          EXPECT_EQ(100, j);
+
+          // Includes the initial response.
+          auto frames = counter->payloadFrames() - framesBefore;
+          if (maxItems == 1) {
+            EXPECT_GT(frames, 100);
+          } else {
+            EXPECT_LT(frames, 100) << "maxItems " << maxItems;
+          }
+        }
+      },
+      nullptr,
+      [counter](TAsyncSocketIntercepted& socket) {
+        socket.setReadCallback(
+            [counter](folly::ByteRange bytes) { counter->onRead(bytes); });
+      });
+}
+
 TEST_F(StreamingTest, ChecksummingRequest) {
   // TODO (T61528332) why does this fail??
   return;
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Trains a ZSTD dictionary for ZstdDictionaryRegistry from captured payloads,
+// one serialized payload per file:
+//
+//   train_zstd_dictionary --samples_dir=/tmp/payloads --output=/tmp/dict
+//
+// and reports how well the samples compress with and without it.
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <folly/FileUtil.h>
+#include <folly/compression/Compression.h>
+#include <folly/init/Init.h>
+#include <folly/io/IOBuf.h>
+#include <folly/portability/GFlags.h>
+#include <glog/logging.h>
+
+#include <thrift/lib/cpp2/transport/rocket/ZstdDictionary.h>
+
+DEFINE_string(samples_dir, "", "Directory with one captured payload per file");
+DEFINE_string(output, "", "File to write the dictionary to");
+DEFINE_int64(max_size, 16 * 1024, "Maximum dictionary size in bytes");
+
+using apache::thrift::rocket::ZstdDictionary;
+using apache::thrift::rocket::trainZstdDictionary;
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  if (FLAGS_samples_dir.empty() || FLAGS_output.empty()) {
+    LOG(ERROR) << "--samples_dir and --output are required";
+    return 1;
+  }
+
+  std::vector<std::string> samples;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(FLAGS_samples_dir)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    std::string sample;
+    if (!folly::readFile(entry.path().c_str(), sample)) {
+      PLOG(ERROR) << "Failed to read " << entry.path();
+      return 1;
+    }
+    samples.push_back(std::move(sample));
+  }
+  LOG(INFO) << "Training on " << samples.size() << " samples";
+
+  auto dictionary = trainZstdDictionary(samples, FLAGS_max_size);
+  if (!folly::writeFile(dictionary, FLAGS_output.c_str())) {
+    PLOG(ERROR) << "Failed to write " << FLAGS_output;
+    return 1;
+  }
+  LOG(INFO) << "Wrote " << dictionary.size() << " byte dictionary to "
+            << FLAGS_output;
+
+  // Samples the dictionary was trained on compress better than new payloads
+  // will, so this is an upper bound.
+  ZstdDictionary zstdDictionary(
+      0,
+      folly::ByteRange(folly::StringPiece(dictionary)),
+      ZstdDictionary::kDefaultLevel);
+  auto zstd = folly::io::getCodec(folly::io::CodecType::ZSTD);
+  size_t uncompressed = 0, withDictionary = 0, withoutDictionary = 0;
+  for (const auto& sample : samples) {
+    auto buf = folly::IOBuf::wrapBufferAsValue(sample.data(), sample.size());
+    uncompressed += sample.size();
+    withDictionary += zstdDictionary.compress(buf)->computeChainDataLength();
+    withoutDictionary += zstd->compress(&buf)->computeChainDataLength();
+  }
+  LOG(INFO) << "Uncompressed: " << uncompressed << " bytes, ZSTD: "
+            << withoutDictionary << " bytes, ZSTD with dictionary: "
+            << withDictionary << " bytes";
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <scoped_allocator>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <folly/memory/Arena.h>
+
+namespace apache {
+namespace thrift {
+
+// Allocator that carves memory out of a folly::SysArena and never frees it
+// individually: everything goes away with the arena. A default-constructed
+// ArenaAllocator has no arena and uses the heap, so types built on it stay
+// usable outside of a request.
+//
+// Meant to be plugged into generated structs, e.g.
+//
+//   struct Foo {
+//     1: list<Bar> (
+//       cpp.use_allocator,
+//       cpp.template = "::apache::thrift::ArenaVector",
+//     ) bars;
+//     2: string (
+//       cpp.use_allocator,
+//       cpp.type = "::apache::thrift::ArenaString",
+//     ) name;
+//   } (cpp.allocator = "::apache::thrift::ScopedArenaAllocator")
+//
+// and constructed with Cpp2RequestContext::getArenaAllocator(), so that
+// building or deserializing such a struct does not hit malloc for every string
+// and container and the whole tree is released in one shot when the request
+// is destroyed. Generated method arguments are not built this way: they still
+// use the default allocator, so handlers have to construct arena-backed
+// structs themselves (e.g. by deserializing a binary argument into one).
+// Such objects must not outlive the arena. Like std::pmr allocators, the
+// allocator does not propagate on copy, move assignment or swap: copying a
+// container allocates the copy from the heap, and swapping containers backed
+// by different arenas is undefined.
+//
+// A folly::SysArena is not thread-safe; concurrent allocations from one arena
+// have to be serialized by the caller.
+template <class T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(folly::SysArena& arena) noexcept : arena_(&arena) {}
+  template <class U>
+  /* implicit */ ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (!arena_) {
+      return std::allocator<T>().allocate(n);
+    }
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    size_t size = n * sizeof(T);
+    // The arena aligns its allocations for any fundamental type; pad the
+    // allocation of over-aligned types to fit an aligned address.
+    if (alignof(T) <= alignof(std::max_align_t)) {
+      return static_cast<T*>(arena_->allocate(size));
+    }
+    size_t space = size + alignof(T) - 1;
+    void* p = arena_->allocate(space);
+    return static_cast<T*>(std::align(alignof(T), size, p, space));
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    if (!arena_) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator();
+  }
+
+  folly::SysArena* arena() const noexcept {
+    return arena_;
+  }
+
+  template <class U>
+  friend bool operator==(
+      const ArenaAllocator<T>& a,
+      const ArenaAllocator<U>& b) noexcept {
+    return a.arena() == b.arena();
+  }
+
+  template <class U>
+  friend bool operator!=(
+      const ArenaAllocator<T>& a,
+      const ArenaAllocator<U>& b) noexcept {
+    return a.arena() != b.arena();
+  }
+
+ private:
+  folly::SysArena* arena_{nullptr};
+};
+
+// Allocator for structs generated with cpp.allocator. Containers built from
+// it pass the arena down to their elements (nested containers, strings and
+// structs).
+using ScopedArenaAllocator =
+    std::scoped_allocator_adaptor<ArenaAllocator<char>>;
+
+// The container allocators are rebound to the element type; constructing one
+// from a ScopedArenaAllocator keeps its arena.
+template <class T>
+using ArenaVector =
+    std::vector<T, std::scoped_allocator_adaptor<ArenaAllocator<T>>>;
+
+template <class T>
+using ArenaSet = std::
+    set<T, std::less<T>, std::scoped_allocator_adaptor<ArenaAllocator<T>>>;
+
+template <class K, class V>
+using ArenaMap = std::map<
+    K,
+    V,
+    std::less<K>,
+    std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const K, V>>>>;
+
+using ArenaString =
+    std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace thrift
+} // namespace apache
@@ -16,7 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <folly/Range.h>
+#include <folly/hash/Checksum.h>
+#include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
 
 namespace apache {
 namespace thrift {
@@ -25,6 +33,151 @@ namespace checksum {
 // Calculate crc32c of a IOBuf chain start from skipOffset
 uint32_t crc32c(const folly::IOBuf& payload, size_t skipOffset = 0);
 
+/**
+ * CRC32C of data fed in pieces, with the same value as crc32c() of the
+ * pieces concatenated. folly::crc32c() runs three interleaved SSE4.2 streams
+ * and combines them with PCLMUL, and the checksums of separately checksummed
+ * pieces are combined the same way, so pieces need not be fed in order.
+ *
+ * The classes below are header-only so that the protocols can use them.
+ */
+class Crc32c {
+ public:
+  void update(folly::ByteRange data) {
+    crc_ = folly::crc32c(data.data(), data.size(), crc_);
+    length_ += data.size();
+  }
+
+  // Appends data checksummed separately.
+  void append(const Crc32c& next) {
+    if (next.length_ == 0) {
+      return;
+    }
+    crc_ = length_ == 0 ? next.crc_
+                        : folly::crc32c_combine(crc_, next.crc_, next.length_);
+    length_ += next.length_;
+  }
+
+  uint32_t value() const {
+    return crc_;
+  }
+
+  size_t length() const {
+    return length_;
+  }
+
+ private:
+  uint32_t crc_{~0U};
+  size_t length_{0};
+};
+
+/**
+ * Checksums the data of an IOBufQueue while it is being serialized, so that
+ * large values are checksummed right after being copied, while still in
+ * cache, instead of the whole payload being re-read once serialized. See
+ * CompactProtocolWriter::setOutputChecksum(). The queue must not be trimmed
+ * while in use.
+ */
+class QueueChecksum {
+ public:
+  // Smaller values are checksummed along with the data that follows them.
+  static constexpr size_t kMinValueSize = 4096;
+  // Larger values are copied and checksummed this much at a time.
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  explicit QueueChecksum(const folly::IOBufQueue& queue) : queue_(queue) {}
+
+  // Copies data to out and checksums everything written so far.
+  void push(folly::io::QueueAppender& out, folly::ByteRange data) {
+    while (!data.empty()) {
+      auto chunk = std::min(data.size(), kChunkSize);
+      out.push(data.data(), chunk);
+      data.advance(chunk);
+      update();
+    }
+  }
+
+  // Checksums the data written since the last call.
+  void update() {
+    auto head = queue_.front();
+    if (!head) {
+      return;
+    }
+    if (!buf_) {
+      buf_ = head;
+    }
+    while (true) {
+      if (offset_ < buf_->length()) {
+        crc_.update({buf_->data() + offset_, buf_->length() - offset_});
+        offset_ = buf_->length();
+      }
+      if (buf_->next() == head) {
+        break;
+      }
+      buf_ = buf_->next();
+      offset_ = 0;
+    }
+  }
+
+  // Checksum of the whole queue.
+  uint32_t value() {
+    update();
+    return crc_.value();
+  }
+
+ private:
+  const folly::IOBufQueue& queue_;
+  const folly::IOBuf* buf_{nullptr};
+  size_t offset_{0};
+  Crc32c crc_;
+};
+
+/**
+ * Checksums an IOBuf chain while it is being parsed, just ahead of the
+ * parser, so that large values are checksummed right before being copied
+ * instead of the whole payload being read once more before parsing. See
+ * CompactProtocolReader::setInputChecksum().
+ */
+class ChainChecksum {
+ public:
+  static constexpr size_t kMinValueSize = QueueChecksum::kMinValueSize;
+  static constexpr size_t kChunkSize = QueueChecksum::kChunkSize;
+
+  explicit ChainChecksum(const folly::IOBuf& chain)
+      : head_(&chain), buf_(&chain) {}
+
+  // Checksums the data up to position in the chain.
+  void update(size_t position) {
+    while (position_ < position) {
+      if (offset_ == buf_->length()) {
+        if (buf_->next() == head_) {
+          return;
+        }
+        buf_ = buf_->next();
+        offset_ = 0;
+        continue;
+      }
+      auto n = std::min(buf_->length() - offset_, position - position_);
+      crc_.update({buf_->data() + offset_, n});
+      offset_ += n;
+      position_ += n;
+    }
+  }
+
+  // Checksum of the whole chain.
+  uint32_t value() {
+    update(head_->computeChainDataLength());
+    return crc_.value();
+  }
+
+ private:
+  const folly::IOBuf* head_;
+  const folly::IOBuf* buf_;
+  size_t offset_{0};
+  size_t position_{0};
+  Crc32c crc_;
+};
+
 } // namespace checksum
 } // namespace thrift
 } // namespace apache
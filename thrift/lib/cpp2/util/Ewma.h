@@ -81,5 +81,18 @@ class Ewma {
   std::chrono::time_point<Clock> timestamp_;
 };
 
+// Weight of a new sample in sampleEwma() is 1 / kSampleEwmaWeight.
+constexpr int kSampleEwmaWeight = 8;
+
+/**
+ * Adds a sample to an EWMA of evenly-weighted samples, regardless of the time
+ * between them, and returns the new average. The first sample becomes the
+ * average.
+ */
+template <typename T>
+T sampleEwma(T avg, T sample, bool first) {
+  return first ? sample : avg + (sample - avg) / kSampleEwmaWeight;
+}
+
 } // namespace thrift
 } // namespace apache
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <folly/Range.h>
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/lang/Bits.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Immutable map from strings to values, built once from a fixed set of keys
+ * with a perfect hash (hash, displace and compress): a lookup hashes the key
+ * once, reads the displacement of its bucket, and compares the key with the
+ * single entry that can match it. There is no probing, and so no branching
+ * on collisions.
+ *
+ * Used by generated processors to find the handler of a method by name.
+ */
+template <typename Value>
+class PerfectHashMap {
+ public:
+  using value_type = std::pair<std::string, Value>;
+  using const_iterator = const value_type*;
+  using iterator = const_iterator;
+
+  PerfectHashMap() = default;
+
+  PerfectHashMap(std::initializer_list<value_type> entries)
+      : PerfectHashMap(std::vector<value_type>(entries)) {}
+
+  explicit PerfectHashMap(std::vector<value_type> entries)
+      : entries_(std::move(entries)) {
+    if (!entries_.empty()) {
+      build();
+    }
+  }
+
+  const_iterator find(folly::StringPiece key) const {
+    if (entries_.empty()) {
+      return end();
+    }
+    auto hash = hashKey(key, seed_);
+    auto index = slots_[slot(hash, displacements_[hash.first & bucketMask_])];
+    if (index == kEmpty || key != entries_[index].first) {
+      return end();
+    }
+    return &entries_[index];
+  }
+
+  size_t count(folly::StringPiece key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  const_iterator begin() const {
+    return entries_.data();
+  }
+
+  const_iterator end() const {
+    return entries_.data() + entries_.size();
+  }
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+  bool empty() const {
+    return entries_.empty();
+  }
+
+ private:
+  using Hash = std::pair<uint64_t, uint64_t>;
+
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  // Displacements tried for a bucket before starting over with another seed.
+  static constexpr uint32_t kMaxDisplacement = 1 << 16;
+  // Seeds tried before doubling the number of slots.
+  static constexpr uint64_t kSeedsPerSize = 4;
+
+  static Hash hashKey(folly::StringPiece key, uint64_t seed) {
+    Hash hash{seed, seed};
+    folly::hash::SpookyHashV2::Hash128(
+        key.data(), key.size(), &hash.first, &hash.second);
+    return hash;
+  }
+
+  // The low bits of the first half of the hash pick the bucket, and its high
+  // bits the odd step, so every displacement of a key lands on another slot.
+  size_t slot(const Hash& hash, uint32_t displacement) const {
+    return (hash.second + displacement * ((hash.first >> 32) | 1)) &
+        slotMask_;
+  }
+
+  void build() {
+    std::vector<folly::StringPiece> keys;
+    for (auto& entry : entries_) {
+      keys.emplace_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    auto duplicate = std::adjacent_find(keys.begin(), keys.end());
+    CHECK(duplicate == keys.end()) << "Duplicate key: " << *duplicate;
+
+    // Twice as many slots as buckets, so buckets have two keys on average.
+    auto slotCount = folly::nextPowTwo(entries_.size());
+    for (seed_ = 0;; ++seed_) {
+      if (seed_ > 0 && seed_ % kSeedsPerSize == 0) {
+        slotCount *= 2;
+      }
+      if (tryBuild(slotCount, std::max<size_t>(slotCount / 2, 1))) {
+        return;
+      }
+    }
+  }
+
+  bool tryBuild(size_t slotCount, size_t bucketCount) {
+    slotMask_ = slotCount - 1;
+    bucketMask_ = bucketCount - 1;
+
+    std::vector<Hash> hashes;
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+      hashes.push_back(hashKey(entries_[i].first, seed_));
+      buckets[hashes[i].first & bucketMask_].push_back(i);
+    }
+    // Place the largest buckets first, while most slots are free.
+    std::vector<uint32_t> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+      return buckets[a].size() > buckets[b].size();
+    });
+
+    slots_.assign(slotCount, kEmpty);
+    displacements_.assign(bucketCount, 0);
+    std::vector<size_t> taken;
+    for (auto bucket : order) {
+      const auto& indices = buckets[bucket];
+      if (indices.empty()) {
+        break;
+      }
+      bool placed = false;
+      for (uint32_t d = 0; d < kMaxDisplacement && !placed; ++d) {
+        taken.clear();
+        placed = true;
+        for (auto index : indices) {
+          auto s = slot(hashes[index], d);
+          if (slots_[s] != kEmpty ||
+              std::find(taken.begin(), taken.end(), s) != taken.end()) {
+            placed = false;
+            break;
+          }
+          taken.push_back(s);
+        }
+        if (placed) {
+          for (size_t i = 0; i < indices.size(); ++i) {
+            slots_[taken[i]] = indices[i];
+          }
+          displacements_[bucket] = d;
+        }
+      }
+      if (!placed) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<value_type> entries_;
+  std::vector<uint32_t> displacements_;
+  std::vector<uint32_t> slots_;
+  uint64_t seed_{0};
+  size_t bucketMask_{0};
+  size_t slotMask_{0};
+};
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/util/ArenaAllocator.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+
+namespace {
+
+// Nested containers as generated for fields with cpp.use_allocator.
+struct Nested {
+  using allocator_type = ScopedArenaAllocator;
+
+  explicit Nested(const allocator_type& alloc)
+      : names(alloc), byName(alloc) {}
+
+  ArenaVector<ArenaString> names;
+  ArenaMap<ArenaString, ArenaSet<int>> byName;
+};
+
+struct alignas(64) OverAligned {
+  char c;
+};
+
+} // namespace
+
+TEST(ArenaAllocatorTest, DefaultUsesHeap) {
+  ArenaVector<int> v;
+  EXPECT_EQ(nullptr, v.get_allocator().arena());
+  v.assign(100, 7);
+  EXPECT_EQ(100, v.size());
+}
+
+TEST(ArenaAllocatorTest, AllocatesFromArena) {
+  folly::SysArena arena;
+  auto before = arena.totalSize();
+  ArenaVector<int> v{ArenaAllocator<int>(arena)};
+  v.assign(1000, 7);
+  EXPECT_EQ(&arena, v.get_allocator().arena());
+  EXPECT_GT(arena.totalSize(), before);
+}
+
+TEST(ArenaAllocatorTest, OverAligned) {
+  folly::SysArena arena;
+  ArenaAllocator<OverAligned> alloc(arena);
+  for (size_t n = 1; n < 10; ++n) {
+    auto p = alloc.allocate(n);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % alignof(OverAligned));
+    alloc.deallocate(p, n);
+  }
+}
+
+TEST(ArenaAllocatorTest, PropagatesToNestedContainers) {
+  folly::SysArena arena;
+  Nested nested{ScopedArenaAllocator(ArenaAllocator<char>(arena))};
+  nested.names.emplace_back("a string too long for the small buffer");
+  nested.byName["key"].insert(1);
+
+  EXPECT_EQ(&arena, nested.names.get_allocator().arena());
+  EXPECT_EQ(&arena, nested.names[0].get_allocator().arena());
+  EXPECT_EQ(&arena, nested.byName.get_allocator().arena());
+  EXPECT_EQ(&arena, nested.byName.begin()->first.get_allocator().arena());
+  EXPECT_EQ(&arena, nested.byName.begin()->second.get_allocator().arena());
+}
+
+TEST(ArenaAllocatorTest, CopyUsesHeap) {
+  folly::SysArena arena;
+  ArenaVector<ArenaString> v{ArenaAllocator<ArenaString>(arena)};
+  v.emplace_back("a string too long for the small buffer");
+
+  auto copy = v;
+  EXPECT_EQ(nullptr, copy.get_allocator().arena());
+  EXPECT_EQ(v, copy);
+
+  // Move construction keeps the arena.
+  auto moved = std::move(v);
+  EXPECT_EQ(&arena, moved.get_allocator().arena());
+}
+
+TEST(ArenaAllocatorTest, Equality) {
+  folly::SysArena a;
+  folly::SysArena b;
+  EXPECT_EQ(ArenaAllocator<int>(a), ArenaAllocator<char>(a));
+  EXPECT_NE(ArenaAllocator<int>(a), ArenaAllocator<int>(b));
+  EXPECT_NE(ArenaAllocator<int>(a), ArenaAllocator<int>());
+}
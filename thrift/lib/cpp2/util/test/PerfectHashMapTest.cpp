@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/util/PerfectHashMap.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace apache::thrift;
+
+TEST(PerfectHashMapTest, Empty) {
+  PerfectHashMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.find("foo"));
+  EXPECT_EQ(map.end(), map.find(""));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PerfectHashMapTest, Basic) {
+  PerfectHashMap<int> map{{"ping", 1}, {"getUser", 2}, {"Tile.get", 3}};
+  EXPECT_EQ(3, map.size());
+  ASSERT_NE(map.end(), map.find("getUser"));
+  EXPECT_EQ(2, map.find("getUser")->second);
+  EXPECT_EQ(3, map.find("Tile.get")->second);
+  EXPECT_EQ(1, map.count("ping"));
+  EXPECT_EQ(0, map.count("pin"));
+  EXPECT_EQ(0, map.count("pingg"));
+  EXPECT_EQ(0, map.count(""));
+}
+
+TEST(PerfectHashMapTest, ManyKeys) {
+  for (int size : {1, 2, 7, 64, 500, 1000, 5000}) {
+    std::vector<std::pair<std::string, int>> entries;
+    for (int i = 0; i < size; ++i) {
+      entries.emplace_back("method_" + std::to_string(i), i);
+    }
+    PerfectHashMap<int> map(std::move(entries));
+    ASSERT_EQ(size, map.size());
+    for (int i = 0; i < size; ++i) {
+      auto it = map.find("method_" + std::to_string(i));
+      ASSERT_NE(map.end(), it);
+      EXPECT_EQ(i, it->second);
+    }
+    for (int i = size; i < size + 100; ++i) {
+      EXPECT_EQ(map.end(), map.find("method_" + std::to_string(i)));
+    }
+  }
+}
+
+TEST(PerfectHashMapTest, DuplicateKey) {
+  EXPECT_DEATH(
+      (PerfectHashMap<int>{{"ping", 1}, {"ping", 2}}), "Duplicate key: ping");
+}
@@ -58,23 +58,58 @@ enum CompressionAlgorithm {
   NONE = 0,
   ZLIB = 1,
   ZSTD = 2,
+  LZ4 = 3,
 }
 
 struct ZlibCompressionCodecConfig {
 }
 
 struct ZstdCompressionCodecConfig {
+  // Pre-shared dictionary to compress with, see
+  // RequestSetupMetadata.zstdDictionaryIds. Filled in by the client channel.
+  1: optional i32 dictionaryId;
+}
+
+struct Lz4CompressionCodecConfig {
 }
 
 union CodecConfig {
   1: ZlibCompressionCodecConfig zlibConfig;
   2: ZstdCompressionCodecConfig zstdConfig;
+  3: Lz4CompressionCodecConfig lz4Config;
+}
+
+// A batch is sent once it holds maxItems items or maxBytes bytes of data, or
+// maxDelayMs after its first item. With maxDelayMs = 0 only items that are
+// ready at the same time are batched.
+struct StreamBatchingConfig {
+  1: i32 maxItems;
+  2: i64 maxBytes;
+  3: i32 maxDelayMs;
+}
+
+// Strings of RequestRpcMetadata replaced by ids of a table the client and
+// server keep per connection, when negotiated at setup (see
+// RequestSetupMetadata.maxInternedEntries). The server adds the entries
+// defined by a request before resolving its ids, so a request can refer to
+// the entries it defines. An id always maps to the same string.
+struct InternedRequestMetadata {
+  1: optional map<i32, string> newEntries;
+  2: optional i32 name;
+  3: optional i32 clientId;
+  4: optional i32 serviceTraceMeta;
+  // Ids of otherMetadata keys and values, alternating
+  5: optional list<i32> otherMetadata;
 }
 
 // Represent the compression config user set
 struct CompressionConfig {
   1: optional CodecConfig codecConfig;
   2: optional i64 compressionSizeLimit;
+  // Codecs the client can uncompress responses with, using the same encoding
+  // as NegotiationParameters.compressionAlgos. Lets the server pick a cheaper
+  // codec than codecConfig for responses.
+  3: optional i64 (cpp.type = "std::uint64_t") acceptedAlgos;
 }
 
 // A TLS extension used for thrift parameters negotiation during TLS handshake.
@@ -152,6 +187,12 @@ struct RequestRpcMetadata {
   17: optional InteractionCreate interactionCreate;
   18: optional string clientId;
   19: optional string serviceTraceMeta;
+  // The ZSTD dictionary the request was compressed with (if any)
+  20: optional i32 compressionDictionaryId;
+  // Lets the server pack several stream items into one payload frame
+  21: optional StreamBatchingConfig streamBatchingConfig;
+  // Fields of this struct sent as ids of the connection's interning table
+  22: optional InternedRequestMetadata interned;
 }
 
 struct PayloadResponseMetadata {
@@ -224,6 +265,8 @@ struct ResponseRpcMetadata {
   7: optional PayloadMetadata payloadMetadata;
   // Additional metadata for the response payload (if proxied)
   8: optional ProxiedPayloadMetadata proxiedPayloadMetadata;
+  // The ZSTD dictionary the response was compressed with (if any)
+  9: optional i32 compressionDictionaryId;
 }
 
 enum ResponseRpcErrorCategory {
@@ -279,6 +322,10 @@ struct StreamPayloadMetadata {
   // Any frequently used key-value pair in this map should be replaced
   // by a field in this struct.
   2: optional map<string, string> otherMetadata;
+  // The ZSTD dictionary the payload was compressed with (if any)
+  3: optional i32 compressionDictionaryId;
+  // Set if the payload holds several stream items: the data size of each
+  4: optional list<i32> batchItemSizes;
 }
 
 // Setup metadata sent from the client to the server at the time
@@ -314,11 +361,23 @@ struct RequestSetupMetadata {
   5: optional i32 dscpToReflect;
   6: optional i32 markToReflect;
   9: optional ClientMetadata clientMetadata;
+  // Ids of the pre-shared ZSTD dictionaries the client has, most preferred
+  // first.
+  10: optional list<i32> zstdDictionaryIds;
+  // Size of the metadata interning table the client wants to use (see
+  // InternedRequestMetadata)
+  11: optional i32 maxInternedEntries;
 }
 
 struct SetupResponse {
   // the version that server picked
   1: optional i32 version;
+  // the ZSTD dictionary (out of RequestSetupMetadata.zstdDictionaryIds) that
+  // server picked
+  2: optional i32 zstdDictionaryId;
+  // Size of the metadata interning table the server accepted, not set if the
+  // client must not send InternedRequestMetadata
+  3: optional i32 maxInternedEntries;
 }
 
 union ServerPushMetadata {
@@ -337,4 +396,6 @@ struct HeadersPayloadContent {
 struct HeadersPayloadMetadata {
   // The CompressionAlgorithm used to compress responses (if any)
   1: optional CompressionAlgorithm compression;
+  // The ZSTD dictionary the payload was compressed with (if any)
+  2: optional i32 compressionDictionaryId;
 }
@@ -30,6 +30,10 @@ DEFINE_int32(port, 7777, "Server port");
 // Client Settings
 DEFINE_int32(num_clients, 0, "Number of clients to use. (Default: 1 per core)");
 DEFINE_string(transport, "header", "Transport to use: header, rsocket, http2");
+DEFINE_int32(
+    connections_per_client,
+    1,
+    "Number of connections each client opens on its own eventbase");
 
 // General Settings
 DEFINE_int32(stats_interval_sec, 1, "Seconds between stats");
@@ -50,6 +54,15 @@ DEFINE_int32(stream_weight, 0, "Test stream download functionality");
 
 DEFINE_uint32(chunk_size, 1024, "Number of bytes per chunk");
 DEFINE_uint32(batch_size, 16, "Flow control batch size");
+DEFINE_int32(
+    stream_batch_items,
+    0,
+    "Max stream items the server packs into one frame (0 disables batching)");
+DEFINE_int64(stream_batch_bytes, 0, "Max bytes per batched stream frame");
+DEFINE_int32(
+    stream_batch_delay_ms,
+    0,
+    "Max time an item waits for a batched stream frame to fill up");
 
 /*
  * This starts num_clients threads with a unique client in each thread.
@@ -68,39 +81,44 @@ int main(int argc, char** argv) {
   std::vector<std::thread> threads;
   for (int i = 0; i < FLAGS_num_clients; ++i) {
     threads.push_back(std::thread([&]() {
-      // Create Thrift Async Client
       auto evb = std::make_shared<folly::EventBase>();
       auto addr = folly::SocketAddress(FLAGS_host, FLAGS_port);
-      auto client = newClient<StreamBenchmarkAsyncClient>(
-          evb.get(), addr, FLAGS_transport);
+      std::vector<std::unique_ptr<Runner<StreamBenchmarkAsyncClient>>> runners;
+      for (int j = 0; j < FLAGS_connections_per_client; ++j) {
+        // Create Thrift Async Client
+        auto client = newClient<StreamBenchmarkAsyncClient>(
+            evb.get(), addr, FLAGS_transport);
 
-      // Create the Operations and their Discrete Distributions
-      // Every time a new operation is added, the distribution needs to
-      // be updated. Otherwise, it will never be chosen.
-      auto ops = std::make_unique<Operation<StreamBenchmarkAsyncClient>>(
-          std::move(client), &stats);
-      auto weights = std::vector<int32_t>{
-          FLAGS_noop_weight,
-          FLAGS_noop_oneway_weight,
-          FLAGS_sum_weight,
-          FLAGS_timeout_weight,
-          FLAGS_download_weight,
-          FLAGS_upload_weight,
-          FLAGS_stream_weight};
-      int32_t sum = std::accumulate(weights.begin(), weights.end(), 0);
-      if (sum == 0) {
-        weights[0] = 1;
-      }
-      auto distribution = std::make_unique<std::discrete_distribution<int32_t>>(
-          weights.begin(), weights.end());
+        // Create the Operations and their Discrete Distributions
+        // Every time a new operation is added, the distribution needs to
+        // be updated. Otherwise, it will never be chosen.
+        auto ops = std::make_unique<Operation<StreamBenchmarkAsyncClient>>(
+            std::move(client), &stats);
+        auto weights = std::vector<int32_t>{
+            FLAGS_noop_weight,
+            FLAGS_noop_oneway_weight,
+            FLAGS_sum_weight,
+            FLAGS_timeout_weight,
+            FLAGS_download_weight,
+            FLAGS_upload_weight,
+            FLAGS_stream_weight};
+        int32_t sum = std::accumulate(weights.begin(), weights.end(), 0);
+        if (sum == 0) {
+          weights[0] = 1;
+        }
+        auto distribution =
+            std::make_unique<std::discrete_distribution<int32_t>>(
+                weights.begin(), weights.end());
 
-      // Create the runner and execute multiple operations
-      auto r = std::make_unique<Runner<StreamBenchmarkAsyncClient>>(
-          evb,
-          std::move(ops),
-          std::move(distribution),
-          FLAGS_max_outstanding_ops);
-      r->run();
+        // Create the runner and execute multiple operations
+        auto r = std::make_unique<Runner<StreamBenchmarkAsyncClient>>(
+            evb,
+            std::move(ops),
+            std::move(distribution),
+            FLAGS_max_outstanding_ops);
+        r->run();
+        runners.push_back(std::move(r));
+      }
 
       // Run eventbase loop for async operations
       if (!FLAGS_sync) {
@@ -35,6 +35,11 @@ DEFINE_int32(cpu_threads, 0, "Number of CPU threads (0 means number of cores)");
 DEFINE_int32(stats_interval_sec, 1, "Seconds between stats");
 DEFINE_int32(terminate_sec, 0, "How long to run server (0 means forever)");
 DEFINE_bool(use_admission_control, false, "Enable admission control");
+DEFINE_bool(io_uring, false, "Drive IO threads with io_uring instead of epoll");
+DEFINE_uint64(
+    io_uring_capacity,
+    64 * 1024,
+    "Per IO thread io_uring capacity, must exceed connections per IO thread");
 
 using apache::thrift::GlobalAdmissionStrategy;
 using apache::thrift::HTTP2RoutingHandler;
@@ -81,6 +86,13 @@ int main(int argc, char** argv) {
   server->setNumIOWorkerThreads(FLAGS_io_threads);
   server->setNumCPUWorkerThreads(FLAGS_cpu_threads);
   server->setProcessorFactory(cpp2PFac);
+  if (FLAGS_io_uring) {
+    ThriftServer::IOUringOptions ioUringOptions;
+    ioUringOptions.capacity = FLAGS_io_uring_capacity;
+    server->setUseIOUring(ioUringOptions);
+    LOG(INFO) << "Using io_uring: " << std::boolalpha
+              << server->getUseIOUring();
+  }
 
   server->addRoutingHandler(createHTTP2RoutingHandler(server));
   if (FLAGS_use_admission_control) {
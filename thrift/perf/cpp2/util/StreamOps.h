@@ -25,6 +25,9 @@
 
 DECLARE_uint32(chunk_size);
 DECLARE_uint32(batch_size);
+DECLARE_int32(stream_batch_items);
+DECLARE_int64(stream_batch_bytes);
+DECLARE_int32(stream_batch_delay_ms);
 
 using apache::thrift::ClientReceiveState;
 using apache::thrift::RequestCallback;
@@ -179,6 +182,13 @@ class StreamDownload {
     rpcOptions.setQueueTimeout(std::chrono::seconds(10));
     rpcOptions.setTimeout(std::chrono::seconds(10));
     rpcOptions.setChunkBufferSize(FLAGS_batch_size);
+    if (FLAGS_stream_batch_items > 0) {
+      apache::thrift::StreamBatchingConfig batchingConfig;
+      batchingConfig.maxItems_ref() = FLAGS_stream_batch_items;
+      batchingConfig.maxBytes_ref() = FLAGS_stream_batch_bytes;
+      batchingConfig.maxDelayMs_ref() = FLAGS_stream_batch_delay_ms;
+      rpcOptions.setStreamBatchingConfig(std::move(batchingConfig));
+    }
 
     client->sync_streamDownload(rpcOptions)
         .subscribeExTry(